@@ -0,0 +1,138 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/coverage.cmake"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/ouroboros/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/BoostDetectToolset-1.74.0.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_date_time-1.74.0/boost_date_time-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_date_time-1.74.0/boost_date_time-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_date_time-1.74.0/libboost_date_time-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_date_time-1.74.0/libboost_date_time-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/boost_filesystem-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/boost_filesystem-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/libboost_filesystem-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_filesystem-1.74.0/libboost_filesystem-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_regex-1.74.0/boost_regex-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_regex-1.74.0/boost_regex-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_regex-1.74.0/libboost_regex-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_regex-1.74.0/libboost_regex-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/boost_system-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_system-1.74.0/libboost_system-variant-static.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/boost_unit_test_framework-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/boost_unit_test_framework-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/libboost_unit_test_framework-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_unit_test_framework-1.74.0/libboost_unit_test_framework-variant-static.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "ouroboros/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "ouroboros/CMakeFiles/ouroboros.dir/DependInfo.cmake"
+  "examples/CMakeFiles/sample.dir/DependInfo.cmake"
+  "examples/CMakeFiles/writer.dir/DependInfo.cmake"
+  "examples/CMakeFiles/reader.dir/DependInfo.cmake"
+  "tools/CMakeFiles/worker_transaction.dir/DependInfo.cmake"
+  "tools/CMakeFiles/speed_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/lock_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/pagemap_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/cachepool_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/wal_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/commit_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/recovery_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/direct_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/durability_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/readahead_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/simd_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/pushdown_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/aggregate_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/rollup_test.dir/DependInfo.cmake"
+  "tools/CMakeFiles/bsearch_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/error_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/page_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/cache_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/file_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/cachefile_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/sharedcache_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/backupfile_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/journalfile_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/redofile_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/hashmap_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/futexlock_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/commitgroup_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/key_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/field_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/scan_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/table_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/datatable_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/fragtable_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/indexedtable_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/treedatatable_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/dataset_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/indexeddataset_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/treedataset_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/mmapdataset_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/redodataset_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/find_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/archive_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/transaction_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/cachedtransaction_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/indexedtransaction_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/rbtree_test.dir/DependInfo.cmake"
+  "tests/CMakeFiles/coverage.dir/DependInfo.cmake"
+  "tests/CMakeFiles/cppcheck.dir/DependInfo.cmake"
+  "tests/CMakeFiles/clang-tidy.dir/DependInfo.cmake"
+  )
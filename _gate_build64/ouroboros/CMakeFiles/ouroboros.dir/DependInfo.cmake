@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/ouroboros/file.cpp" "ouroboros/CMakeFiles/ouroboros.dir/file.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/file.cpp.o.d"
+  "/root/repo/ouroboros/ioring.cpp" "ouroboros/CMakeFiles/ouroboros.dir/ioring.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/ioring.cpp.o.d"
+  "/root/repo/ouroboros/memory.cpp" "ouroboros/CMakeFiles/ouroboros.dir/memory.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/memory.cpp.o.d"
+  "/root/repo/ouroboros/memoryfile.cpp" "ouroboros/CMakeFiles/ouroboros.dir/memoryfile.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/memoryfile.cpp.o.d"
+  "/root/repo/ouroboros/mmapfile.cpp" "ouroboros/CMakeFiles/ouroboros.dir/mmapfile.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/mmapfile.cpp.o.d"
+  "/root/repo/ouroboros/scan.cpp" "ouroboros/CMakeFiles/ouroboros.dir/scan.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/scan.cpp.o.d"
+  "/root/repo/ouroboros/transaction.cpp" "ouroboros/CMakeFiles/ouroboros.dir/transaction.cpp.o" "gcc" "ouroboros/CMakeFiles/ouroboros.dir/transaction.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ouroboros.dir/file.cpp.o"
+  "CMakeFiles/ouroboros.dir/file.cpp.o.d"
+  "CMakeFiles/ouroboros.dir/ioring.cpp.o"
+  "CMakeFiles/ouroboros.dir/ioring.cpp.o.d"
+  "CMakeFiles/ouroboros.dir/memory.cpp.o"
+  "CMakeFiles/ouroboros.dir/memory.cpp.o.d"
+  "CMakeFiles/ouroboros.dir/memoryfile.cpp.o"
+  "CMakeFiles/ouroboros.dir/memoryfile.cpp.o.d"
+  "CMakeFiles/ouroboros.dir/mmapfile.cpp.o"
+  "CMakeFiles/ouroboros.dir/mmapfile.cpp.o.d"
+  "CMakeFiles/ouroboros.dir/scan.cpp.o"
+  "CMakeFiles/ouroboros.dir/scan.cpp.o.d"
+  "CMakeFiles/ouroboros.dir/transaction.cpp.o"
+  "CMakeFiles/ouroboros.dir/transaction.cpp.o.d"
+  "libouroboros.a"
+  "libouroboros.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ouroboros.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/backupfile_test.dir/backupfile_test.cpp.o"
+  "CMakeFiles/backupfile_test.dir/backupfile_test.cpp.o.d"
+  "backupfile_test"
+  "backupfile_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/backupfile_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cachedtransaction_test.dir/cachedtransaction_test.cpp.o"
+  "CMakeFiles/cachedtransaction_test.dir/cachedtransaction_test.cpp.o.d"
+  "cachedtransaction_test"
+  "cachedtransaction_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cachedtransaction_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
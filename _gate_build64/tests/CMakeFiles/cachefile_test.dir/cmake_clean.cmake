@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cachefile_test.dir/cachefile_test.cpp.o"
+  "CMakeFiles/cachefile_test.dir/cachefile_test.cpp.o.d"
+  "cachefile_test"
+  "cachefile_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cachefile_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/commitgroup_test.dir/commitgroup_test.cpp.o"
+  "CMakeFiles/commitgroup_test.dir/commitgroup_test.cpp.o.d"
+  "commitgroup_test"
+  "commitgroup_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/commitgroup_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datatable_test.dir/datatable_test.cpp.o"
+  "CMakeFiles/datatable_test.dir/datatable_test.cpp.o.d"
+  "datatable_test"
+  "datatable_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/datatable_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
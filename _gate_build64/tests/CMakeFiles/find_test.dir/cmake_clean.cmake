@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/find_test.dir/find_test.cpp.o"
+  "CMakeFiles/find_test.dir/find_test.cpp.o.d"
+  "find_test"
+  "find_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/find_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fragtable_test.dir/fragtable_test.cpp.o"
+  "CMakeFiles/fragtable_test.dir/fragtable_test.cpp.o.d"
+  "fragtable_test"
+  "fragtable_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fragtable_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
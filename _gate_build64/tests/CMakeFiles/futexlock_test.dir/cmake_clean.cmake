@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/futexlock_test.dir/futexlock_test.cpp.o"
+  "CMakeFiles/futexlock_test.dir/futexlock_test.cpp.o.d"
+  "futexlock_test"
+  "futexlock_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/futexlock_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hashmap_test.dir/hashmap_test.cpp.o"
+  "CMakeFiles/hashmap_test.dir/hashmap_test.cpp.o.d"
+  "hashmap_test"
+  "hashmap_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hashmap_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
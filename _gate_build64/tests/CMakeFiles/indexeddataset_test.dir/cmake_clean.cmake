@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/indexeddataset_test.dir/indexeddataset_test.cpp.o"
+  "CMakeFiles/indexeddataset_test.dir/indexeddataset_test.cpp.o.d"
+  "indexeddataset_test"
+  "indexeddataset_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/indexeddataset_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
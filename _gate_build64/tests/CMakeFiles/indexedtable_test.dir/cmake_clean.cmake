@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/indexedtable_test.dir/indexedtable_test.cpp.o"
+  "CMakeFiles/indexedtable_test.dir/indexedtable_test.cpp.o.d"
+  "indexedtable_test"
+  "indexedtable_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/indexedtable_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/indexedtransaction_test.dir/indexedtransaction_test.cpp.o"
+  "CMakeFiles/indexedtransaction_test.dir/indexedtransaction_test.cpp.o.d"
+  "indexedtransaction_test"
+  "indexedtransaction_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/indexedtransaction_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
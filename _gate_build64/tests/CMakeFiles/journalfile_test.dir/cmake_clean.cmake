@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/journalfile_test.dir/journalfile_test.cpp.o"
+  "CMakeFiles/journalfile_test.dir/journalfile_test.cpp.o.d"
+  "journalfile_test"
+  "journalfile_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/journalfile_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
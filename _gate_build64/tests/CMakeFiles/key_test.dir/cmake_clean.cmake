@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/key_test.dir/key_test.cpp.o"
+  "CMakeFiles/key_test.dir/key_test.cpp.o.d"
+  "key_test"
+  "key_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/key_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mmapdataset_test.dir/mmapdataset_test.cpp.o"
+  "CMakeFiles/mmapdataset_test.dir/mmapdataset_test.cpp.o.d"
+  "mmapdataset_test"
+  "mmapdataset_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mmapdataset_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
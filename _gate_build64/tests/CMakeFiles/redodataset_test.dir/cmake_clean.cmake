@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/redodataset_test.dir/redodataset_test.cpp.o"
+  "CMakeFiles/redodataset_test.dir/redodataset_test.cpp.o.d"
+  "redodataset_test"
+  "redodataset_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/redodataset_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/redofile_test.dir/redofile_test.cpp.o"
+  "CMakeFiles/redofile_test.dir/redofile_test.cpp.o.d"
+  "redofile_test"
+  "redofile_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/redofile_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sharedcache_test.dir/sharedcache_test.cpp.o"
+  "CMakeFiles/sharedcache_test.dir/sharedcache_test.cpp.o.d"
+  "sharedcache_test"
+  "sharedcache_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sharedcache_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/table_test.dir/table_test.cpp.o"
+  "CMakeFiles/table_test.dir/table_test.cpp.o.d"
+  "table_test"
+  "table_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/table_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
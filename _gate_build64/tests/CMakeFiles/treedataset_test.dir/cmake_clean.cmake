@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/treedataset_test.dir/treedataset_test.cpp.o"
+  "CMakeFiles/treedataset_test.dir/treedataset_test.cpp.o.d"
+  "treedataset_test"
+  "treedataset_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/treedataset_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
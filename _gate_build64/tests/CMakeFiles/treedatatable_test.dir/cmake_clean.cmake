@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/treedatatable_test.dir/treedatatable_test.cpp.o"
+  "CMakeFiles/treedatatable_test.dir/treedatatable_test.cpp.o.d"
+  "treedatatable_test"
+  "treedatatable_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/treedatatable_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
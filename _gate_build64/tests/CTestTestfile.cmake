@@ -0,0 +1,68 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_gate_build64/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(error_test "error_test")
+set_tests_properties(error_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;24;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(page_test "page_test")
+set_tests_properties(page_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;25;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(cache_test "cache_test")
+set_tests_properties(cache_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;26;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(file_test "file_test")
+set_tests_properties(file_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;27;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(cachefile_test "cachefile_test")
+set_tests_properties(cachefile_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;28;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(sharedcache_test "sharedcache_test")
+set_tests_properties(sharedcache_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;29;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(backupfile_test "backupfile_test")
+set_tests_properties(backupfile_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;30;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(journalfile_test "journalfile_test")
+set_tests_properties(journalfile_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;31;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(redofile_test "redofile_test")
+set_tests_properties(redofile_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;32;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(hashmap_test "hashmap_test")
+set_tests_properties(hashmap_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;33;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(futexlock_test "futexlock_test")
+set_tests_properties(futexlock_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;34;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(commitgroup_test "commitgroup_test")
+set_tests_properties(commitgroup_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;35;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(key_test "key_test")
+set_tests_properties(key_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;36;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(field_test "field_test")
+set_tests_properties(field_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;37;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(scan_test "scan_test")
+set_tests_properties(scan_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;38;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(table_test "table_test")
+set_tests_properties(table_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;39;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(datatable_test "datatable_test")
+set_tests_properties(datatable_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;40;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(fragtable_test "fragtable_test")
+set_tests_properties(fragtable_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;41;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(indexedtable_test "indexedtable_test")
+set_tests_properties(indexedtable_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;42;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(treedatatable_test "treedatatable_test")
+set_tests_properties(treedatatable_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;43;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(dataset_test "dataset_test")
+set_tests_properties(dataset_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;44;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(indexeddataset_test "indexeddataset_test")
+set_tests_properties(indexeddataset_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;45;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(treedataset_test "treedataset_test")
+set_tests_properties(treedataset_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;46;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(mmapdataset_test "mmapdataset_test")
+set_tests_properties(mmapdataset_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;47;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(redodataset_test "redodataset_test")
+set_tests_properties(redodataset_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;48;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(find_test "find_test")
+set_tests_properties(find_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;49;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(archive_test "archive_test")
+set_tests_properties(archive_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;50;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(transaction_test "transaction_test")
+set_tests_properties(transaction_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;51;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(cachedtransaction_test "cachedtransaction_test")
+set_tests_properties(cachedtransaction_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;52;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(indexedtransaction_test "indexedtransaction_test")
+set_tests_properties(indexedtransaction_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;53;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(rbtree_test "rbtree_test")
+set_tests_properties(rbtree_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;54;ouroboros_add_test;/root/repo/tests/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/aggregate_test.dir/aggregate_test.cpp.o"
+  "CMakeFiles/aggregate_test.dir/aggregate_test.cpp.o.d"
+  "aggregate_test"
+  "aggregate_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/aggregate_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bsearch_test.dir/bsearch_test.cpp.o"
+  "CMakeFiles/bsearch_test.dir/bsearch_test.cpp.o.d"
+  "bsearch_test"
+  "bsearch_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bsearch_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cachepool_test.dir/cachepool_test.cpp.o"
+  "CMakeFiles/cachepool_test.dir/cachepool_test.cpp.o.d"
+  "cachepool_test"
+  "cachepool_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cachepool_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/durability_test.dir/durability_test.cpp.o"
+  "CMakeFiles/durability_test.dir/durability_test.cpp.o.d"
+  "durability_test"
+  "durability_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/durability_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
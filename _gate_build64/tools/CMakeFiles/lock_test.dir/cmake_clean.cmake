@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/lock_test.dir/lock_test.cpp.o"
+  "CMakeFiles/lock_test.dir/lock_test.cpp.o.d"
+  "lock_test"
+  "lock_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/lock_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
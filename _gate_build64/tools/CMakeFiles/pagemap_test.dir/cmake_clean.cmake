@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pagemap_test.dir/pagemap_test.cpp.o"
+  "CMakeFiles/pagemap_test.dir/pagemap_test.cpp.o.d"
+  "pagemap_test"
+  "pagemap_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pagemap_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
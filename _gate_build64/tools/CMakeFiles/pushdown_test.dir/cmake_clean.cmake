@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pushdown_test.dir/pushdown_test.cpp.o"
+  "CMakeFiles/pushdown_test.dir/pushdown_test.cpp.o.d"
+  "pushdown_test"
+  "pushdown_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pushdown_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/ouroboros/file.cpp" "tools/CMakeFiles/speed_test.dir/__/ouroboros/file.cpp.o" "gcc" "tools/CMakeFiles/speed_test.dir/__/ouroboros/file.cpp.o.d"
+  "/root/repo/ouroboros/ioring.cpp" "tools/CMakeFiles/speed_test.dir/__/ouroboros/ioring.cpp.o" "gcc" "tools/CMakeFiles/speed_test.dir/__/ouroboros/ioring.cpp.o.d"
+  "/root/repo/ouroboros/memory.cpp" "tools/CMakeFiles/speed_test.dir/__/ouroboros/memory.cpp.o" "gcc" "tools/CMakeFiles/speed_test.dir/__/ouroboros/memory.cpp.o.d"
+  "/root/repo/ouroboros/transaction.cpp" "tools/CMakeFiles/speed_test.dir/__/ouroboros/transaction.cpp.o" "gcc" "tools/CMakeFiles/speed_test.dir/__/ouroboros/transaction.cpp.o.d"
+  "/root/repo/tools/speed_test.cpp" "tools/CMakeFiles/speed_test.dir/speed_test.cpp.o" "gcc" "tools/CMakeFiles/speed_test.dir/speed_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
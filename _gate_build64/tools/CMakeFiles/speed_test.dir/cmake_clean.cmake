@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/speed_test.dir/__/ouroboros/file.cpp.o"
+  "CMakeFiles/speed_test.dir/__/ouroboros/file.cpp.o.d"
+  "CMakeFiles/speed_test.dir/__/ouroboros/ioring.cpp.o"
+  "CMakeFiles/speed_test.dir/__/ouroboros/ioring.cpp.o.d"
+  "CMakeFiles/speed_test.dir/__/ouroboros/memory.cpp.o"
+  "CMakeFiles/speed_test.dir/__/ouroboros/memory.cpp.o.d"
+  "CMakeFiles/speed_test.dir/__/ouroboros/transaction.cpp.o"
+  "CMakeFiles/speed_test.dir/__/ouroboros/transaction.cpp.o.d"
+  "CMakeFiles/speed_test.dir/speed_test.cpp.o"
+  "CMakeFiles/speed_test.dir/speed_test.cpp.o.d"
+  "speed_test"
+  "speed_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/speed_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/worker_transaction.dir/worker_transaction.cpp.o"
+  "CMakeFiles/worker_transaction.dir/worker_transaction.cpp.o.d"
+  "worker_transaction"
+  "worker_transaction.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/worker_transaction.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
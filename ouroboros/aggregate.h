@@ -0,0 +1,243 @@
+/**
+ * @file   aggregate.h
+ * The aggregation of the fields of the records in a table
+ */
+
+#ifndef OUROBOROS_AGGREGATE_H
+#define	OUROBOROS_AGGREGATE_H
+
+#include <stdint.h>
+
+#include "ouroboros/global.h"
+#include "ouroboros/find.h"
+
+namespace ouroboros
+{
+
+/**
+ * The type of the sum of the fields: the integer fields are summed up
+ * by the 64-bit integers, the other fields are summed up by double
+ */
+template <typename T> struct aggregate_sum { typedef double type; };
+template <> struct aggregate_sum<int8_t> { typedef int64_t type; };
+template <> struct aggregate_sum<uint8_t> { typedef uint64_t type; };
+template <> struct aggregate_sum<int16_t> { typedef int64_t type; };
+template <> struct aggregate_sum<uint16_t> { typedef uint64_t type; };
+template <> struct aggregate_sum<int32_t> { typedef int64_t type; };
+template <> struct aggregate_sum<uint32_t> { typedef uint64_t type; };
+template <> struct aggregate_sum<int64_t> { typedef int64_t type; };
+template <> struct aggregate_sum<uint64_t> { typedef uint64_t type; };
+
+/**
+ * The aggregates of a field of the records: count, sum, min, max, average
+ * and the value of the last record
+ */
+template <typename Field>
+struct aggregate_result
+{
+    typedef Field field_type;
+    typedef typename aggregate_sum<field_type>::type sum_type;
+
+    aggregate_result();
+
+    inline void add(const field_type& value); ///< add the value of the field
+    inline void add(const aggregate_result& result); ///< add the aggregates of the next records
+    inline double avg() const; ///< get the average value
+
+    count_type count;   ///< the count of the records
+    sum_type sum;       ///< the sum of the fields
+    field_type min;     ///< the minimum value of the field
+    field_type max;     ///< the maximum value of the field
+    field_type last;    ///< the value of the field of the last record
+};
+
+/**
+ * The comparator that matches all records
+ */
+template <typename Record>
+struct comp_any
+{
+    typedef Record record_type;
+    typedef packed_compare_tag compare_category;
+    inline bool operator ()(const record_type& ) const
+    {
+        return true;
+    }
+    inline bool operator ()(const void *) const
+    {
+        return true;
+    }
+};
+
+/**
+ * The scanner of the blocks of the packed records that aggregates the field
+ * of the records matched by the comparator, the fields are read at the static
+ * offset; the records are unpacked only for the comparator that doesn't have
+ * the packed form
+ */
+template <typename Index, typename Comparator>
+class aggregate_scanner
+{
+public:
+    typedef Index index_type;
+    typedef Comparator comparator_type;
+    typedef typename comparator_type::record_type record_type;
+    typedef typename index_type::field_type field_type;
+    typedef aggregate_result<field_type> result_type;
+
+    aggregate_scanner(const comparator_type& comp, const size_type stride);
+
+    pos_type find(const char *data, const count_type count); ///< aggregate the records of the block
+    inline const result_type& result() const; ///< get the aggregates
+private:
+    aggregate_scanner();
+    inline bool match(const char *data, packed_compare_tag); ///< compare the packed record
+    inline bool match(const char *data, unpacked_compare_tag); ///< compare the unpacked record
+private:
+    const comparator_type m_comp; ///< the comparator
+    const size_type m_stride; ///< the distance between the records
+    record_type m_record; ///< the buffer of the unpacked record
+    result_type m_result; ///< the aggregates
+};
+
+//==============================================================================
+//  aggregate_result
+//==============================================================================
+/**
+ * Constructor
+ */
+template <typename Field>
+aggregate_result<Field>::aggregate_result() :
+    count(0),
+    sum(),
+    min(),
+    max(),
+    last()
+{
+}
+
+/**
+ * Add the value of the field
+ * @param value the value of the field
+ */
+template <typename Field>
+inline void aggregate_result<Field>::add(const field_type& value)
+{
+    if (0 == count || value < min)
+    {
+        min = value;
+    }
+    if (0 == count || max < value)
+    {
+        max = value;
+    }
+    sum += value;
+    last = value;
+    ++count;
+}
+
+/**
+ * Add the aggregates of the next records
+ * @param result the aggregates of the next records
+ */
+template <typename Field>
+inline void aggregate_result<Field>::add(const aggregate_result& result)
+{
+    if (0 == result.count)
+    {
+        return;
+    }
+    if (0 == count || result.min < min)
+    {
+        min = result.min;
+    }
+    if (0 == count || max < result.max)
+    {
+        max = result.max;
+    }
+    sum += result.sum;
+    last = result.last;
+    count += result.count;
+}
+
+/**
+ * Get the average value
+ * @return the average value (0 if there aren't any records)
+ */
+template <typename Field>
+inline double aggregate_result<Field>::avg() const
+{
+    return 0 == count ? 0.0 : double(sum) / count;
+}
+
+//==============================================================================
+//  aggregate_scanner
+//==============================================================================
+/**
+ * Constructor
+ * @param comp the comparator
+ * @param stride the distance between the records
+ */
+template <typename Index, typename Comparator>
+aggregate_scanner<Index, Comparator>::aggregate_scanner(const comparator_type& comp, const size_type stride) :
+    m_comp(comp),
+    m_stride(stride)
+{
+}
+
+/**
+ * Aggregate the records of the block
+ * @param data the packed records
+ * @param count the count of the records
+ * @return NIL, all records are aggregated
+ */
+template <typename Index, typename Comparator>
+pos_type aggregate_scanner<Index, Comparator>::find(const char *data, const count_type count)
+{
+    for (const char *end = data + count * m_stride; data < end; data += m_stride)
+    {
+        if (match(data, typename compare_traits<comparator_type>::compare_category()))
+        {
+            m_result.add(index_type::value(static_cast<const void *>(data)));
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Compare the packed record by the comparator
+ * @param data the packed record
+ * @return the record is matched
+ */
+template <typename Index, typename Comparator>
+inline bool aggregate_scanner<Index, Comparator>::match(const char *data, packed_compare_tag)
+{
+    return m_comp(static_cast<const void *>(data));
+}
+
+/**
+ * Unpack the record and compare it by the comparator
+ * @param data the packed record
+ * @return the record is matched
+ */
+template <typename Index, typename Comparator>
+inline bool aggregate_scanner<Index, Comparator>::match(const char *data, unpacked_compare_tag)
+{
+    m_record.unpack(data);
+    return m_comp(m_record);
+}
+
+/**
+ * Get the aggregates
+ * @return the aggregates
+ */
+template <typename Index, typename Comparator>
+inline const typename aggregate_scanner<Index, Comparator>::result_type&
+    aggregate_scanner<Index, Comparator>::result() const
+{
+    return m_result;
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_AGGREGATE_H */
@@ -0,0 +1,654 @@
+/**
+ * @file   archive.h
+ * The round-robin archives of the consolidated records
+ */
+
+#ifndef OUROBOROS_ARCHIVE_H
+#define	OUROBOROS_ARCHIVE_H
+
+#include <unistd.h>
+#include <map>
+#include <vector>
+#include <sstream>
+
+#include "ouroboros/index.h"
+#include "ouroboros/record.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/aggregate.h"
+#include "ouroboros/field_types.h"
+
+namespace ouroboros
+{
+
+/** The function that consolidates the values of the records of the step */
+enum consolidation_function
+{
+    CONSOLIDATION_AVERAGE,  ///< the average value of the records
+    CONSOLIDATION_MIN,      ///< the minimum value of the records
+    CONSOLIDATION_MAX,      ///< the maximum value of the records
+    CONSOLIDATION_LAST      ///< the value of the last record
+};
+
+/**
+ * The definition of the round-robin archive
+ */
+struct archive_def
+{
+    archive_def(const count_type step, const count_type depth, const consolidation_function function) :
+        step(step),
+        depth(depth),
+        function(function)
+    {}
+    count_type step;    ///< the step of the archive (the units of the time field)
+    count_type depth;   ///< the count of the records in the archive
+    consolidation_function function; ///< the consolidation function
+};
+
+/**
+ * Make the name of the dataset of the archive
+ * @param name the name of the archives
+ * @param index the index of the archive
+ * @return the name of the dataset of the archive
+ */
+inline const std::string make_archive_name(const std::string& name, const pos_type index)
+{
+    std::ostringstream out;
+    out << name << "." << index;
+    return out.str();
+}
+
+/**
+ * Make the name of the dataset of the states of the archives
+ * @param name the name of the archives
+ * @return the name of the dataset of the states
+ */
+inline const std::string make_archive_state_name(const std::string& name)
+{
+    return name + ".state";
+}
+
+/**
+ * The set of the round-robin archives of the consolidated records, one key
+ * maps to the table of each archive. Each archive is the dataset that has
+ * its own depth of the tables, the record of the archive keeps the values
+ * of the step: the time field is the begin of the step, the value field is
+ * consolidated by the function of the archive, the other fields are taken
+ * from the last record of the step.
+ *
+ * The record is added to all archives: the last record of the table
+ * is rewritten while the time of the record is in the step of it, otherwise
+ * the next record is added. The consolidation of the current step is kept
+ * in the memory, so only one set of the archives must add the records
+ * of a key; it is also written to the dataset of the states (one record
+ * for each archive in the table of the key), so when the archives are
+ * reopened or the transaction is canceled the consolidation continues
+ * with the same count and sum of the values. If the state doesn't match
+ * the last record of the table then the consolidated value of the last
+ * record is counted as one record.
+ * @attention the time field must be an integer and must not decrease
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+class archive_set
+{
+public:
+    typedef data_set<Key, Record, index_null, Interface> dataset_type;
+    typedef typename dataset_type::key_type key_type; ///< the type of key field
+    typedef typename dataset_type::record_type record_type; ///< the record of data
+    typedef typename dataset_type::record_list record_list; ///< the list of records
+    typedef typename dataset_type::session_read session_read; ///< the session for read data from a table
+    typedef typename dataset_type::session_write session_write; ///< the session for write data to a table
+    typedef TimeIndex<record_type> time_index; ///< the index of the time field
+    typedef ValueIndex<record_type> value_index; ///< the index of the value field
+    typedef typename time_index::field_type time_type; ///< the type of the time field
+    typedef typename value_index::field_type value_type; ///< the type of the value field
+    typedef aggregate_result<value_type> result_type; ///< the consolidation of the step
+    typedef std::vector<archive_def> archive_list; ///< the list of the definitions of the archives
+
+    archive_set(const std::string& name, const count_type tbl_count, const archive_list& archives);
+    ~archive_set();
+
+    inline count_type archive_count() const; ///< get the count of the archives
+    inline const archive_def& archive(const pos_type index) const; ///< get the definition of the archive
+    inline dataset_type& dataset(const pos_type index); ///< get the dataset of the archive
+
+    void add_table(const key_type key); ///< add the table to the archives
+    void remove_table(const key_type key); ///< remove the table from the archives
+    void add(const key_type key, const record_type& record); ///< add the record to the archives
+    pos_type fetch(const key_type key, const consolidation_function function, const time_type from,
+        const time_type to, const count_type step, record_list& records); ///< read the records of the best archive
+
+    void start();  ///< start the transaction of the archives
+    void stop();   ///< stop the transaction of the archives
+    void cancel(); ///< cancel the transaction of the archives
+
+    static void remove(const std::string& name, const count_type count); ///< remove the archives
+protected:
+    /** The consolidation of the current step of the archive */
+    struct state_type
+    {
+        state_type() : time() {}
+        time_type time; ///< the begin of the step
+        result_type result; ///< the consolidation of the step
+    };
+    typedef std::vector<state_type> state_list;
+    typedef std::map<key_type, state_list> key_state_list;
+    typedef std::vector<dataset_type*> dataset_list;
+    /// the record of the state: time, count, sum, min, max, last
+    typedef record6<data_field<time_type>, data_field<count_type>, data_field<typename result_type::sum_type>,
+        data_field<value_type>, data_field<value_type>, data_field<value_type> > state_record_type;
+    typedef data_set<Key, state_record_type, index_null, Interface> state_dataset_type;
+    typedef typename state_dataset_type::record_list state_record_list;
+
+    /** The header of the archive that is kept in the user data of the dataset */
+    struct header_type
+    {
+        count_type index;   ///< the index of the archive
+        count_type count;   ///< the count of the archives
+        count_type step;    ///< the step of the archive
+        count_type function; ///< the consolidation function
+    };
+
+    inline time_type step_time(const time_type time, const pos_type index) const; ///< get the begin of the step
+    void load_states(const key_type key, state_list& states); ///< read the states from the tables
+    void save_states(const key_type key, const state_list& states); ///< write the states to the dataset of the states
+    static inline value_type consolidate(const result_type& result, const consolidation_function function); ///< get the consolidated value
+    static inline bool closer(const count_type step, const count_type best, const count_type required); ///< check the step is closer to the required step
+private:
+    archive_set(const archive_set& );
+    archive_set& operator= (const archive_set& );
+private:
+    const std::string m_name; ///< the name of the archives
+    const archive_list m_defs; ///< the definitions of the archives
+    dataset_list m_archives; ///< the datasets of the archives
+    state_dataset_type *m_state; ///< the dataset of the states
+    key_state_list m_states; ///< the consolidation of the current steps
+};
+
+/**
+ * Constructor, the datasets of the archives are created or opened
+ * @param name the name of the archives
+ * @param tbl_count the count of the tables in each created archive
+ * @param archives the definitions of the archives
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::archive_set(const std::string& name,
+        const count_type tbl_count, const archive_list& archives) :
+    m_name(name),
+    m_defs(archives),
+    m_state(NULL)
+{
+    OUROBOROS_RANGE_ASSERT(!m_defs.empty());
+    try
+    {
+        for (pos_type index = 0; index < m_defs.size(); ++index)
+        {
+            const archive_def& def = m_defs[index];
+            OUROBOROS_RANGE_ASSERT(def.step > 0 && def.depth > 0);
+            header_type header;
+            header.index = index;
+            header.count = m_defs.size();
+            header.step = def.step;
+            header.function = def.function;
+            const std::string archive_name = make_archive_name(name, index);
+            if (access(make_dbname(archive_name).c_str(), F_OK) != 0)
+            {
+                m_archives.push_back(new dataset_type(archive_name, tbl_count, def.depth,
+                    0, &header, sizeof(header)));
+            }
+            else
+            {
+                // the existing archive must have the same definition
+                m_archives.push_back(new dataset_type(archive_name));
+                m_archives.back()->open();
+                header_type exist;
+                memset(&exist, 0, sizeof(exist));
+                m_archives.back()->get_user_data(&exist, sizeof(exist));
+                if (m_archives.back()->rec_count() != def.depth || 0 != memcmp(&exist, &header, sizeof(header)))
+                {
+                    OUROBOROS_THROW_ERROR(compatibility_error, PR(name) << PR(index) << PR(def.step) <<
+                        PR(exist.step) << "the archive is different");
+                }
+            }
+        }
+        const std::string state_name = make_archive_state_name(name);
+        if (access(make_dbname(state_name).c_str(), F_OK) != 0)
+        {
+            m_state = new state_dataset_type(state_name, tbl_count, m_defs.size());
+        }
+        else
+        {
+            m_state = new state_dataset_type(state_name);
+            m_state->open();
+            if (m_state->rec_count() != m_defs.size())
+            {
+                OUROBOROS_THROW_ERROR(compatibility_error, PR(name) << PR(m_state->rec_count()) <<
+                    "the states are different");
+            }
+        }
+    }
+    catch (...)
+    {
+        delete m_state;
+        for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+        {
+            delete *it;
+        }
+        throw;
+    }
+}
+
+/**
+ * Destructor
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::~archive_set()
+{
+    delete m_state;
+    for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        delete *it;
+    }
+}
+
+/**
+ * Get the count of the archives
+ * @return the count of the archives
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+inline count_type archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::archive_count() const
+{
+    return m_defs.size();
+}
+
+/**
+ * Get the definition of the archive
+ * @param index the index of the archive
+ * @return the definition of the archive
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+inline const archive_def& archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::archive(const pos_type index) const
+{
+    OUROBOROS_RANGE_ASSERT(index < m_defs.size());
+    return m_defs[index];
+}
+
+/**
+ * Get the dataset of the archive
+ * @param index the index of the archive
+ * @return the dataset of the archive
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+inline typename archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::dataset_type&
+    archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::dataset(const pos_type index)
+{
+    OUROBOROS_RANGE_ASSERT(index < m_archives.size());
+    return *m_archives[index];
+}
+
+/**
+ * Add the table to the archives
+ * @param key the key of the table
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::add_table(const key_type key)
+{
+    for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        (*it)->add_table(key);
+    }
+    m_state->add_table(key);
+}
+
+/**
+ * Remove the table from the archives
+ * @param key the key of the table
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::remove_table(const key_type key)
+{
+    m_states.erase(key);
+    for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        (*it)->remove_table(key);
+    }
+    m_state->remove_table(key);
+}
+
+/**
+ * Add the record to the archives, the value of the record is consolidated
+ * with the values of the current step of each archive, the consolidation
+ * in the memory is changed only if all archives are written
+ * @param key the key of the table
+ * @param record the record
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::add(const key_type key, const record_type& record)
+{
+    const time_type time = time_index::value(record);
+    state_list& states = m_states[key];
+    if (states.empty())
+    {
+        load_states(key, states);
+    }
+    // the time is checked by all archives before the writing
+    for (pos_type index = 0; index < m_archives.size(); ++index)
+    {
+        const state_type& state = states[index];
+        if (state.result.count > 0 && step_time(time, index) < state.time)
+        {
+            OUROBOROS_THROW_ERROR(range_error, PR(m_name) << PR(key) << PR(index) <<
+                "the time of the record is less than the time of the archive");
+        }
+    }
+    const value_type value = value_index::value(record);
+    record_type step_record(record);
+    state_list next(states);
+    try
+    {
+        for (pos_type index = 0; index < m_archives.size(); ++index)
+        {
+            state_type& state = next[index];
+            const time_type beg = step_time(time, index);
+            const bool added = 0 == state.result.count || state.time != beg;
+            if (added)
+            {
+                state.time = beg;
+                state.result = result_type();
+            }
+            state.result.add(value);
+            time_index::set_value(step_record, beg);
+            value_index::set_value(step_record, consolidate(state.result, m_defs[index].function));
+            session_write session = m_archives[index]->session_wr(key);
+            if (added)
+            {
+                session->add(step_record);
+            }
+            else
+            {
+                session->write(step_record, session->dec_pos(session->end_pos()));
+            }
+        }
+        save_states(key, next);
+    }
+    catch (...)
+    {
+        // the consolidation will be read from the tables
+        m_states.erase(key);
+        throw;
+    }
+    states.swap(next);
+}
+
+/**
+ * Read the records of the best archive: the archive keeps the records since
+ * the begin of the range and has the step that is closest to the required
+ * step (the step that is not greater is preferred), if there isn't such
+ * archive then the archive that has the oldest records is read
+ * @param key the key of the table
+ * @param function the consolidation function
+ * @param from the begin of the range
+ * @param to the end of the range (inclusive)
+ * @param step the required step
+ * @param [out] records the records of the steps that are in the range
+ * @return the index of the archive or NIL if there isn't the archive of the function
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+pos_type archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::fetch(const key_type key,
+    const consolidation_function function, const time_type from, const time_type to, const count_type step,
+    record_list& records)
+{
+    records.clear();
+    pos_type best = NIL;
+    bool best_covers = false;
+    time_type best_time = time_type();
+    for (pos_type index = 0; index < m_archives.size(); ++index)
+    {
+        const archive_def& def = m_defs[index];
+        if (def.function != function)
+        {
+            continue;
+        }
+        // the archive that isn't full keeps all records
+        bool covers = true;
+        time_type time = time_type();
+        {
+            session_read session = m_archives[index]->session_rd(key);
+            record_type first;
+            if (session->read_front(first) != NIL)
+            {
+                time = time_index::value(first);
+                covers = session->count() < def.depth || time <= from;
+            }
+        }
+        if (NIL == best ||
+            (covers && !best_covers) ||
+            (covers && best_covers && closer(def.step, m_defs[best].step, step)) ||
+            (!covers && !best_covers && (time < best_time ||
+                (time == best_time && closer(def.step, m_defs[best].step, step)))))
+        {
+            best = index;
+            best_covers = covers;
+            best_time = time;
+        }
+    }
+    if (best != NIL)
+    {
+        session_read session = m_archives[best]->session_rd(key);
+        session->template read_by<TimeIndex>(records, step_time(from, best), to);
+    }
+    return best;
+}
+
+/**
+ * Start the transaction of the archives
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::start()
+{
+    for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        (*it)->start();
+    }
+    m_state->start();
+}
+
+/**
+ * Stop the transaction of the archives
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::stop()
+{
+    for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        (*it)->stop();
+    }
+    m_state->stop();
+}
+
+/**
+ * Cancel the transaction of the archives, the consolidation of the current
+ * steps is read from the dataset of the states again
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::cancel()
+{
+    m_states.clear();
+    for (typename dataset_list::iterator it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        (*it)->cancel();
+    }
+    m_state->cancel();
+}
+
+/**
+ * Remove the archives
+ * @param name the name of the archives
+ * @param count the count of the archives
+ */
+//static
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::remove(const std::string& name, const count_type count)
+{
+    for (pos_type index = 0; index < count; ++index)
+    {
+        dataset_type::remove(make_archive_name(name, index));
+    }
+    state_dataset_type::remove(make_archive_state_name(name));
+}
+
+/**
+ * Get the begin of the step
+ * @param time the time
+ * @param index the index of the archive
+ * @return the begin of the step of the archive that has the time
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+inline typename archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::time_type
+    archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::step_time(const time_type time, const pos_type index) const
+{
+    const time_type step = static_cast<time_type>(m_defs[index].step);
+    return time - time % step;
+}
+
+/**
+ * Read the states of the current steps, the state is taken from the dataset
+ * of the states if it matches the last record of the table, otherwise
+ * the consolidated value of the last record is counted as one record
+ * @param key the key of the table
+ * @param [out] states the states of the current steps
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::load_states(const key_type key, state_list& states)
+{
+    states.assign(m_archives.size(), state_type());
+    state_record_list saved;
+    {
+        typename state_dataset_type::session_read session = m_state->session_rd(key);
+        if (session->count() == states.size())
+        {
+            saved.resize(states.size());
+            session->read_front(saved);
+        }
+    }
+    for (pos_type index = 0; index < m_archives.size(); ++index)
+    {
+        state_type& state = states[index];
+        session_read session = m_archives[index]->session_rd(key);
+        record_type record;
+        if (NIL == session->read_back(record))
+        {
+            continue;
+        }
+        state.time = time_index::value(record);
+        if (!saved.empty() && saved[index].field2() > 0 && saved[index].field1() == state.time)
+        {
+            const state_record_type& rec = saved[index];
+            state.result.count = rec.field2();
+            state.result.sum = rec.field3();
+            state.result.min = rec.field4();
+            state.result.max = rec.field5();
+            state.result.last = rec.field6();
+        }
+        else
+        {
+            state.result.add(value_index::value(record));
+        }
+    }
+}
+
+/**
+ * Write the states of the current steps to the dataset of the states
+ * @param key the key of the table
+ * @param states the states of the current steps
+ */
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+void archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::save_states(const key_type key,
+    const state_list& states)
+{
+    state_record_list records;
+    records.reserve(states.size());
+    for (typename state_list::const_iterator it = states.begin(); it != states.end(); ++it)
+    {
+        records.push_back(state_record_type(it->time, it->result.count, it->result.sum,
+            it->result.min, it->result.max, it->result.last));
+    }
+    typename state_dataset_type::session_write session = m_state->session_wr(key);
+    if (session->count() == records.size())
+    {
+        session->write(records, session->beg_pos());
+    }
+    else
+    {
+        session->clear();
+        session->add(records);
+    }
+}
+
+/**
+ * Get the consolidated value
+ * @param result the consolidation of the step
+ * @param function the consolidation function
+ * @return the consolidated value
+ */
+//static
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+inline typename archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::value_type
+    archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::consolidate(const result_type& result,
+    const consolidation_function function)
+{
+    switch (function)
+    {
+        case CONSOLIDATION_AVERAGE:
+            return static_cast<value_type>(result.avg());
+        case CONSOLIDATION_MIN:
+            return result.min;
+        case CONSOLIDATION_MAX:
+            return result.max;
+        case CONSOLIDATION_LAST:
+        default:
+            return result.last;
+    }
+}
+
+/**
+ * Check the step is closer to the required step than the best step,
+ * the steps that are not greater than the required step are preferred
+ * @param step the step
+ * @param best the best step
+ * @param required the required step
+ * @return the result of the checking
+ */
+//static
+template <typename Key, typename Record, template <typename> class TimeIndex,
+    template <typename> class ValueIndex, typename Interface>
+inline bool archive_set<Key, Record, TimeIndex, ValueIndex, Interface>::closer(const count_type step,
+    const count_type best, const count_type required)
+{
+    if (step <= required)
+    {
+        return best > required || step > best;
+    }
+    return best > required && step < best;
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_ARCHIVE_H */
@@ -6,7 +6,10 @@
 #ifndef OUROBOROS_BUCKUPFILE_H
 #define OUROBOROS_BUCKUPFILE_H
 
+#include <sys/uio.h>
+#include <algorithm>
 #include <set>
+#include <vector>
 #include "ouroboros/cachefile.h"
 
 namespace ouroboros
@@ -39,9 +42,7 @@ public:
 
     static void remove(const std::string& name); ///< remove a file by the name
     static void copy(const std::string& source, const std::string& dest); ///< copy a file
-#ifdef OUROBOROS_SYNC_ENABLED
     virtual void save_page(const pos_type index, void *data); ///< save data of the cache page
-#endif
 protected:
     virtual size_type do_resize(const size_type size); ///< change the size of the file
     virtual void *get_page(const pos_type index); ///< get the buffer of the cache page
@@ -51,24 +52,32 @@ protected:
     void remove_index(const pos_type index); ///< remove the index of the page to the backup set
     void recovery(); ///< restore the file from the backup file
     void clear_indexes(); ///< remove all indexes of pages from the backup set
-#ifdef OUROBOROS_SYNC_ENABLED
+    void add_backup(const pos_type index, const void *page); ///< add the copy of the page to the backup file
+    void flush_backup(); ///< write the copies of the pages to the backup file
+    void complete_backup(); ///< wait for the end of writing of the copies of the pages
     void sync_backup() const; ///< forced synchronization data of the backup file
-#endif
+    virtual void do_set_durability(const durability_level level); ///< set the level of the durability
     virtual void do_before_add_index(const pos_type index, void *page); ///< perform an action before add the index
     virtual void do_after_add_index(const pos_type index, void *page); ///< perform an action after add the index
     virtual void do_before_remove_index(const pos_type index); ///< perform an action before remove the index
     virtual void do_after_remove_index(const pos_type index); ///< perform an action after remove the index
     virtual void do_before_clear_indexes(); ///< perform an action before remove all indexes
     virtual void do_after_clear_indexes(); ///< perform an action after remove all indexes
+    virtual void do_before_write_pages(); ///< perform an action before the pages are written to the file
 
     typedef std::set<pos_type> index_list; ///< containter of a backup set
+    typedef std::vector<std::pair<pos_type, pos_type> > range_list; ///< container of ranges of pages
+    void get_ranges(range_list& ranges) const; ///< get the ranges of pages of the backup set
+    void publish_ranges(const range_list& ranges); ///< publish the ranges of the changed pages
 protected:
     simple_file m_backup; ///< the backup file
     index_list m_indexes; ///< the backup set
 private:
-#ifdef OUROBOROS_SYNC_ENABLED
+    typedef std::vector<std::pair<pos_type, size_t> > backup_list; ///< the indexes of the pages and the offsets of their copies
+    backup_list m_backup_pages; ///< the pages whose copies are not written to the backup file
+    std::vector<char> m_backup_data; ///< the copies of the pages that are not written to the backup file
+    std::vector<char> m_backup_flight; ///< the copies of the pages that are being written to the backup file
     mutable size_t m_sync_count; ///< the count of allowed sync the backup
-#endif
 };
 
 //==============================================================================
@@ -110,11 +119,10 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 backup_file<FilePage, pageCount, File, Cache>::backup_file(const std::string& name) :
     base_class(name),
-    m_backup(name + ".bak")
-#ifdef OUROBOROS_SYNC_ENABLED
-    , m_sync_count(0)
-#endif
+    m_backup(name + ".bak"),
+    m_sync_count(0)
 {
+    m_backup.set_durability(base_class::durability());
 }
 
 /**
@@ -127,11 +135,10 @@ template <typename FilePage, int pageCount, typename File,
 backup_file<FilePage, pageCount, File, Cache>::backup_file(const std::string& name,
         const file_region_type& region) :
     base_class(name, region),
-    m_backup(name + ".bak")
-#ifdef OUROBOROS_SYNC_ENABLED
-    , m_sync_count(0)
-#endif
+    m_backup(name + ".bak"),
+    m_sync_count(0)
 {
+    m_backup.set_durability(base_class::durability());
 }
 
 /**
@@ -157,18 +164,27 @@ template <typename FilePage, int pageCount, typename File,
 void *backup_file<FilePage, pageCount, File, Cache>::get_page(const pos_type index)
 {
     const page_status_type status = base_class::m_cache.page_exists(index);
+    const char *ahead = status.state() == PG_DETACHED ? base_class::load_ahead(index) : NULL;
     void *page = base_class::m_cache.get_page(status);
     // check the page was loaded
     if (status.state() == PG_DETACHED)
     {
         // if the page has not been loaded then load data to the page
-        simple_file::do_read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        if (ahead != NULL)
+        {
+            memcpy(page, ahead, base_class::CACHE_PAGE_SIZE);
+        }
+        else
+        {
+            simple_file::do_read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        }
+        base_class::m_cache.page_loaded(index);
     }
     // check if the page exists in the backup set
     if (TR_STARTED == base_class::state() && m_indexes.find(index) == m_indexes.end())
     {
         // store the page into the backup file
-        m_backup.write(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        add_backup(index, page);
         add_index(index, page);
     }
     return page;
@@ -185,12 +201,21 @@ template <typename FilePage, int pageCount, typename File,
 void *backup_file<FilePage, pageCount, File, Cache>::get_page(const pos_type index) const
 {
     const page_status_type status = base_class::m_cache.page_exists(index);
+    const char *ahead = status.state() == PG_DETACHED ? base_class::load_ahead(index) : NULL;
     void *page = base_class::m_cache.get_page(status);
     // check the page was loaded
     if (status.state() == PG_DETACHED)
     {
         // if the page has not been loaded then load data to the page
-        simple_file::do_read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        if (ahead != NULL)
+        {
+            memcpy(page, ahead, base_class::CACHE_PAGE_SIZE);
+        }
+        else
+        {
+            simple_file::do_read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        }
+        base_class::m_cache.page_loaded(index);
     }
     return page;
 }
@@ -203,9 +228,7 @@ template <typename FilePage, int pageCount, typename File,
 void backup_file<FilePage, pageCount, File, Cache>::start()
 {
     base_class::start();
-#ifdef OUROBOROS_SYNC_ENABLED
     m_sync_count = 0;
-#endif
 }
 
 /**
@@ -215,11 +238,16 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void backup_file<FilePage, pageCount, File, Cache>::stop()
 {
-#ifdef OUROBOROS_SYNC_ENABLED
     m_sync_count = 1;
-#endif
-    base_class::stop();
+    range_list ranges;
+    get_ranges(ranges);
+    base_class::do_stop();
+    // the pages that are not saved don't need the copies
+    complete_backup();
+    m_backup_pages.clear();
+    m_backup_data.clear();
     clear_indexes();
+    publish_ranges(ranges);
 }
 
 /**
@@ -229,8 +257,48 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void backup_file<FilePage, pageCount, File, Cache>::cancel()
 {
-    base_class::cancel();
+    range_list ranges;
+    get_ranges(ranges);
+    base_class::do_cancel();
     recovery();
+    publish_ranges(ranges);
+}
+
+/**
+ * Get the ranges of pages of the backup set
+ * @param ranges the ranges of pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::get_ranges(range_list& ranges) const
+{
+    index_list::const_iterator end = m_indexes.end();
+    for (index_list::const_iterator it = m_indexes.begin(); it != end; ++it)
+    {
+        if (ranges.empty() || ranges.back().second != *it)
+        {
+            ranges.push_back(std::make_pair(*it, *it + 1));
+        }
+        else
+        {
+            ++ranges.back().second;
+        }
+    }
+}
+
+/**
+ * Publish the ranges of the changed pages
+ * @param ranges the ranges of pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::publish_ranges(const range_list& ranges)
+{
+    range_list::const_iterator end = ranges.end();
+    for (range_list::const_iterator it = ranges.begin(); it != end; ++it)
+    {
+        base_class::publish_pages(it->first, it->second);
+    }
 }
 
 /**
@@ -241,20 +309,132 @@ template <typename FilePage, int pageCount, typename File,
 inline void backup_file<FilePage, pageCount, File, Cache>::recovery()
 {
     OUROBOROS_INFO("restore the file " << base_class::name());
-    char page[base_class::CACHE_PAGE_SIZE];
-    index_list::const_iterator end = m_indexes.end();
-    for (index_list::const_iterator it = m_indexes.begin(); it != end; ++it)
+    flush_backup();
+    complete_backup();
+    // the adjacent pages are restored by one block
+    const count_type block_count = size_type(OUROBOROS_RECOVERY_BLOCK) > size_type(base_class::CACHE_PAGE_SIZE) ?
+        size_type(OUROBOROS_RECOVERY_BLOCK) / base_class::CACHE_PAGE_SIZE : 1;
+    range_list ranges;
+    get_ranges(ranges);
+    range_list blocks;
+    range_list::const_iterator end = ranges.end();
+    for (range_list::const_iterator it = ranges.begin(); it != end; ++it)
     {
-        const pos_type index = *it;
-        OUROBOROS_INFO("\trestore the page " << index);
-        m_backup.read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
-        simple_file::do_write(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
-        base_class::m_cache.free_page(index);
+        for (pos_type beg = it->first; beg < it->second; beg += block_count)
+        {
+            blocks.push_back(std::make_pair(beg, std::min<pos_type>(beg + block_count, it->second)));
+        }
+    }
+    // the blocks of the batch are read by one submission and written by
+    // the other one, the batch holds no more than the size of one block
+    std::vector<char> buffer;
+    for (size_t first = 0; first < blocks.size();)
+    {
+        size_t last = first;
+        count_type count = 0;
+        do
+        {
+            count += blocks[last].second - blocks[last].first;
+            ++last;
+        }
+        while (last < blocks.size() && last - first < size_t(OUROBOROS_IO_RING_SIZE) &&
+            count + blocks[last].second - blocks[last].first <= block_count);
+        buffer.resize(count * base_class::CACHE_PAGE_SIZE);
+        char *data = &buffer[0];
+        for (size_t n = first; n < last; ++n)
+        {
+            const size_type size = (blocks[n].second - blocks[n].first) * base_class::CACHE_PAGE_SIZE;
+            m_backup.submit_read(data, size, blocks[n].first * base_class::CACHE_PAGE_SIZE);
+            data += size;
+        }
+        m_backup.complete();
+        data = &buffer[0];
+        for (size_t n = first; n < last; ++n)
+        {
+            const size_type size = (blocks[n].second - blocks[n].first) * base_class::CACHE_PAGE_SIZE;
+            OUROBOROS_INFO("\trestore the pages " << blocks[n].first << "-" << blocks[n].second - 1);
+            simple_file::submit_write(data, size, blocks[n].first * base_class::CACHE_PAGE_SIZE);
+            data += size;
+        }
+        simple_file::complete();
+        for (size_t n = first; n < last; ++n)
+        {
+            for (pos_type index = blocks[n].first; index < blocks[n].second; ++index)
+            {
+                base_class::m_cache.free_page(index);
+            }
+        }
+        first = last;
     }
     m_indexes.clear();
     OUROBOROS_INFO("recovery completed");
 }
 
+/**
+ * Add the copy of the page to the backup file, the copies are written
+ * before the pages get into the file
+ * @param index the index of the page
+ * @param page the pointer to the buffer of the page
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::add_backup(const pos_type index, const void *page)
+{
+    const char *data = static_cast<const char *>(page);
+    m_backup_pages.push_back(std::make_pair(index, m_backup_data.size()));
+    m_backup_data.insert(m_backup_data.end(), data, data + base_class::CACHE_PAGE_SIZE);
+}
+
+/**
+ * Write the copies of the pages to the backup file, the copies of
+ * the adjacent pages are written by one call; the copies are submitted
+ * asynchronously, the pages of the file are written after the end of
+ * the writing of the copies (method complete_backup)
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::flush_backup()
+{
+    if (m_backup_pages.empty())
+    {
+        return;
+    }
+    complete_backup();
+    std::sort(m_backup_pages.begin(), m_backup_pages.end());
+    std::vector<struct iovec> iov;
+    iov.reserve(m_backup_pages.size());
+    for (size_t n = 0; n < m_backup_pages.size();)
+    {
+        const pos_type beg = m_backup_pages[n].first;
+        iov.clear();
+        do
+        {
+            struct iovec page;
+            page.iov_base = &m_backup_data[m_backup_pages[n].second];
+            page.iov_len = base_class::CACHE_PAGE_SIZE;
+            iov.push_back(page);
+            ++n;
+        }
+        while (n < m_backup_pages.size() && m_backup_pages[n].first == beg + iov.size());
+        m_backup.submit_writev(&iov[0], iov.size(), beg * base_class::CACHE_PAGE_SIZE);
+    }
+    m_backup_pages.clear();
+    // the copies are kept until the end of the writing
+    m_backup_flight.swap(m_backup_data);
+    m_backup_data.clear();
+}
+
+/**
+ * Wait for the end of writing of the copies of the pages to the backup file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::complete_backup()
+{
+    m_backup.complete();
+    m_backup_flight.clear();
+}
+
 /**
  * Add the index of the page to the backup set
  * @param index the index of the page
@@ -346,9 +526,7 @@ void backup_file<FilePage, pageCount, File, Cache>::do_after_add_index(const pos
 {
     OUROBOROS_UNUSED(index);
     OUROBOROS_UNUSED(page);
-#ifdef OUROBOROS_SYNC_ENABLED
     ++m_sync_count;
-#endif
 }
 
 /**
@@ -376,14 +554,31 @@ void backup_file<FilePage, pageCount, File, Cache>::do_after_remove_index(const
 }
 
 /**
- * Perform an action before remove all indexes
+ * Perform an action before the pages are written to the file, the copies of
+ * the pages must be in the backup file before
  */
 //virtual
 template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
-void backup_file<FilePage, pageCount, File, Cache>::do_before_clear_indexes()
+void backup_file<FilePage, pageCount, File, Cache>::do_before_write_pages()
 {
+    complete_backup();
+}
 
+/**
+ * Perform an action before remove all indexes, the pages changed by
+ * the stopped transaction are synchronized by the commit
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::do_before_clear_indexes()
+{
+    if (TR_STOPPED == base_class::m_trans && !m_indexes.empty() &&
+        base_class::durability() >= DURABILITY_COMMIT)
+    {
+        base_class::defer_sync();
+    }
 }
 
 /**
@@ -397,7 +592,28 @@ void backup_file<FilePage, pageCount, File, Cache>::do_after_clear_indexes()
 
 }
 
-#ifdef OUROBOROS_SYNC_ENABLED
+/**
+ * Save data of the cache page, the copies of the pages are written to
+ * the backup file before the page gets into the file
+ * @param index the index of the cache page
+ * @param page the cache page
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void backup_file<FilePage, pageCount, File, Cache>::save_page(const pos_type index, void *data)
+{
+    if (TR_CANCELED != base_class::m_trans)
+    {
+        flush_backup();
+        if (base_class::durability() >= DURABILITY_SYNC)
+        {
+            sync_backup();
+        }
+    }
+    base_class::save_page(index, data);
+}
+
 /**
  * Forced synchronization data of the backup file
  */
@@ -413,22 +629,17 @@ void backup_file<FilePage, pageCount, File, Cache>::sync_backup() const
 }
 
 /**
- * Save data of the cache page
- * @param index the index of the cache page
- * @param page the cache page
+ * Set the level of the durability of the file and the backup file
+ * @param level the level of the durability
  */
 //virtual
 template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
-void backup_file<FilePage, pageCount, File, Cache>::save_page(const pos_type index, void *data)
+void backup_file<FilePage, pageCount, File, Cache>::do_set_durability(const durability_level level)
 {
-    if (TR_CANCELED != base_class::m_trans)
-    {
-        sync_backup();
-    }
-    base_class::save_page(index, data);
+    base_class::do_set_durability(level);
+    m_backup.set_durability(level);
 }
-#endif
 
 }   //namespace ouroboros
 
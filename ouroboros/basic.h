@@ -109,10 +109,12 @@ public:
     inline bool refresh(); ///< refresh the metadata of the table by the key
     inline void update(); ///< update the key by the metadata of the table
     inline void recovery(); ///< recovery the metadata of the table by the key
+    inline void invalidate(); ///< drop the cached data and the metadata of the table
 
     inline void start();  ///< start the transaction
     inline void stop();   ///< stop the transaction
     inline void cancel(); ///< cancel the transaction
+    inline void sync_commit(); ///< synchronize the data of the stopped transaction
     inline transaction_state state() const; ///< get the state of the transaction
 
     inline const skey_type& skey() const; ///< get the reference to the key of the table
@@ -133,8 +135,8 @@ protected:
     pos_type dec_end_pos(const count_type count = 1); ///< decrement the end position of records
 
     inline const skey_type& cast_skey() const; ///< get the cast of the key at the begin of the transaction
-    inline count_type rec_size() const; ///< get the size of a record
-    inline count_type rec_space() const; ///< get the size of the records separator
+    inline size_type rec_size() const; ///< get the size of a record
+    inline size_type rec_space() const; ///< get the size of the records separator
     offset_type rec_offset(const pos_type pos) const; ///< get the offset of the record
     inline offset_type offset() const; ///< get the offset of the table
     inline bool inc_count(const count_type count = 1); ///< increment the records count of the table
@@ -144,6 +146,7 @@ protected:
     virtual pos_type do_dec_pos(const pos_type pos, const count_type count) const = 0; ///< decrement the position
     inline void read(void *data, const size_type size, const offset_type offset) const; ///< read raw data
     inline void write(const void *data, const size_type size, const offset_type offset); ///< write raw data
+    inline void prefetch(const size_type size, const offset_type offset) const; ///< read raw data ahead
     virtual void do_before_remove(const pos_type pos) = 0; ///< perform an action before deleting record
     virtual void do_before_move(const pos_type source, const pos_type dest) = 0; ///< perform an action before moving record
     inline void do_before_remove(pos_type pos, count_type count); ///< perform an action before removing record
@@ -639,6 +642,17 @@ inline void base_table<Source, Key>::recovery()
     m_cast_skey = m_skey;
 }
 
+/**
+ * Drop the cached data and the metadata of the table, the next refreshing
+ * will read them again
+ */
+template <typename Source, typename Key>
+inline void base_table<Source, Key>::invalidate()
+{
+    m_source.refresh(m_offset);
+    m_cast_skey.rev = m_skey.rev - 1;
+}
+
 /**
  * Start the transaction
  */
@@ -666,6 +680,16 @@ inline void base_table<Source, Key>::cancel()
     m_source.cancel();
 }
 
+/**
+ * Synchronize the data of the stopped transaction, it's done after
+ * the unlocking of the table so the synchronization is shared by the group commit
+ */
+template <typename Source, typename Key>
+inline void base_table<Source, Key>::sync_commit()
+{
+    m_source.sync_commit();
+}
+
 /**
  * Get the state of the transaction
  * @return the state of the transaction
@@ -847,6 +871,17 @@ inline void base_table<Source, Key>::write(const void *data, const size_type siz
     m_source.write(data, size, offset);
 }
 
+/**
+ * Read raw data ahead
+ * @param size the size of the data
+ * @param offset the offset of the data
+ */
+template <typename Source, typename Key>
+inline void base_table<Source, Key>::prefetch(const size_type size, const offset_type offset) const
+{
+    m_source.prefetch(size, offset);
+}
+
 /**
  * Perform an action before removing records
  * @param pos the position of records to be deleted
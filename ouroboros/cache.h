@@ -7,12 +7,16 @@
 #define	OUROBOROS_CACHE_H
 
 #include <stddef.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <new>
 #include <string>
 #include <vector>
 
 #include "ouroboros/global.h"
 #include "ouroboros/object.h"
 #include "ouroboros/hashmap.h"
+#include "ouroboros/probemap.h"
 
 namespace ouroboros
 {
@@ -31,7 +35,8 @@ enum page_state
 template <typename PPage>
 class page_status
 {
-    template <typename, int, int> friend class cache;
+    template <typename, int, int, template <typename, typename, int> class,
+        template <typename, int, int> class> friend class basic_cache;
 public:
     typedef PPage page_pointer;
     page_status(const pos_type index, page_pointer page);
@@ -53,7 +58,8 @@ private:
 template <typename Cache, int pageSize = 1024>
 class cache_page
 {
-    template <typename, int, int> friend class cache;
+    template <typename, int, int, template <typename, typename, int> class,
+        template <typename, int, int> class> friend class basic_cache;
 public:
     enum { SIZE = pageSize };
     typedef Cache cache_type;
@@ -78,13 +84,14 @@ public:
     inline const page_status_type status(); ///< get the status of the page
     inline void dirty(); ///< dirty the page
     inline void clean(); ///< clean the page
+    inline void assign(char *data); ///< set the memory of data of the page
 protected:
     typedef typename cache_type::iterator iterator;
     inline void detach(const iterator& it); ///< detach the page from the cache
     inline void clean(const iterator& it); ///< clean the page in the cache
     inline void reset(); ///< reset the page
 private:
-    char m_data[SIZE]; ///< data of the page
+    char *m_data; ///< data of the page (the memory of the pool)
     cache_page *m_prev; ///< the previous page
     cache_page *m_next; ///< the next page
     cache_type *m_cache; ///< the cache
@@ -92,9 +99,32 @@ private:
     bool m_dirty; ///< the sign of dirty data
 };
 
+/**
+ * The memory of data of the cache pages, the pages are placed one after
+ * another in the block that is aligned by OUROBOROS_PAGE_ALIGNMENT, so
+ * the pages whose size is a multiple of the alignment can be read and
+ * written by the direct I/O
+ */
+template <int pageSize>
+class page_memory
+{
+public:
+    inline page_memory();
+    inline ~page_memory();
+
+    template <typename Page>
+    inline void assign(std::vector<Page>& pages); ///< allocate the memory of the pages
+private:
+    page_memory(const page_memory&);
+    page_memory& operator= (const page_memory&);
+private:
+    void *m_data; ///< the block of the memory
+};
+
 /**
  * The page pool is a circular doubly linked list that has cache pages whose
- * amount is equal the pageCount argument
+ * amount is equal the pageCount argument, the least recently used page is
+ * replaced by a new page (LRU)
  */
 template <typename Cache, int pageSize = 1024, int pageCount = 1024>
 class cache_pool
@@ -106,15 +136,18 @@ public:
 
     inline cache_pool();
 
-    inline page_type* make_page(); ///< make the new page of the cache
+    inline page_type* make_page(const pos_type index); ///< make the new page of the cache
     inline void up_page(page_type *page); ///< increment the raiting of the page
     inline void init(); ///< initialize the pool
+    inline void resize(const count_type count); ///< change the count of the pages
+    inline count_type count() const; ///< get the count of the pages
 #ifdef OUROBOROS_TEST_ENABLED
     count_type test_page_count() const; ///< test the count of the cache page
     pos_type test_page_index(page_type *page) const; ///< test the index of the cache page
 #endif
 private:
     std::vector<page_type> m_pages;
+    page_memory<pageSize> m_memory; ///< the memory of data of the pages
     page_type *m_beg;
     page_type *m_end;
 };
@@ -122,14 +155,19 @@ private:
 /**
  * The cache
  * The size of the page is determined pageSize argument
- * The count of the page is determined pageCount argument
+ * The count of the page is determined pageCount argument, it can be changed
+ * when the cache is used (set_capacity)
+ * The map of the pages is determined PageMap argument
+ * The replacement policy of the pages is determined Pool argument
  * The amount of the page required for a full cache object is determined
  * when the cache is created
  */
-template <typename Saver, int pageSize = 1024, int pageCount = 1024>
-class cache
+template <typename Saver, int pageSize = 1024, int pageCount = 1024,
+    template <typename, typename, int> class PageMap = hash_map,
+    template <typename, int, int> class Pool = cache_pool>
+class basic_cache
 {
-    friend class cache_page<cache<Saver, pageSize, pageCount>, pageSize>;
+    friend class cache_page<basic_cache<Saver, pageSize, pageCount, PageMap, Pool>, pageSize>;
 public:
     enum
     {
@@ -137,19 +175,20 @@ public:
         CACHE_PAGE_COUNT = pageCount  ///< the count of the pages
     };
     typedef Saver saver_type;
-    typedef cache<Saver, pageSize, pageCount> cache_type;
-    typedef cache_pool<cache_type, pageSize, pageCount> page_pool_type;
+    typedef basic_cache<Saver, pageSize, pageCount, PageMap, Pool> cache_type;
+    typedef Pool<cache_type, pageSize, pageCount> page_pool_type;
     typedef cache_page<cache_type, pageSize> page_type;
     typedef page_status<page_type *> page_status_type;
 
-    inline cache();
-    explicit inline cache(saver_type& saver);
+    inline basic_cache();
+    explicit inline basic_cache(saver_type& saver);
 
     inline page_status_type page_exists(const pos_type index) const; ///< check the page exists
     inline void* get_page(const pos_type index); ///< get data of the page
     inline void* get_page(const page_status_type& status); ///< get data of the page
     inline void* get_page(const pos_type index) const; ///< get data of the page
     inline void* get_page(const page_status_type& status) const; ///< get data of the page
+    inline void page_loaded(const pos_type index) const; ///< the page is loaded from the file
     inline size_type aligned_size(const size_type size); ///< change the size of the cache object
     inline size_type size() const; ///< get the size of the cache
     inline bool empty() const; ///< chech the cache is empty
@@ -160,8 +199,11 @@ public:
     inline void clean(); ///< clean all dirty pages
     inline void free(); ///< release the cache
     inline void free_page(const pos_type index); ///< release the page from the pool
+    inline void set_capacity(const count_type count); ///< change the count of the pages in the pool
+    inline count_type capacity() const; ///< get the count of the pages in the pool
+    inline void reset_shared(); ///< clear the pages shared between processes
 protected:
-    typedef hash_map<pos_type, page_type *, pageCount> page_list;
+    typedef PageMap<pos_type, page_type *, pageCount> page_list;
     typedef typename page_list::iterator iterator;
     inline page_type* do_page_exists(const pos_type index) const; ///< check the page exists
     inline page_type* do_get_page(const pos_type index) const; ///< get the page
@@ -175,11 +217,48 @@ protected:
     inline void clean(const iterator& it); ///< clean the page
     void save_page(const page_type *page); ///< save the page
     inline void init_pool(); ///< initialize the cache pool
+    static inline bool index_less(const page_type *page1, const page_type *page2); ///< compare the indexes of the pages
 private:
     saver_type *m_saver; ///< the saver of the pages
     mutable page_pool_type m_pool; ///< the page pool
     mutable page_list m_pages; ///< the map of the pages
     page_list m_dirty_pages; ///< the map of the dirty pages
+    std::vector<page_type *> m_clean_pages; ///< the dirty pages sorted by the indexes for cleaning
+};
+
+/**
+ * The cache that looks up the pages through the chained hash map
+ */
+template <typename Saver, int pageSize = 1024, int pageCount = 1024>
+class cache : public basic_cache<Saver, pageSize, pageCount, hash_map>
+{
+    typedef basic_cache<Saver, pageSize, pageCount, hash_map> base_class;
+public:
+    typedef typename base_class::saver_type saver_type;
+    inline cache() :
+        base_class()
+    {}
+    explicit inline cache(saver_type& saver) :
+        base_class(saver)
+    {}
+};
+
+/**
+ * The cache that looks up the pages through the map with open addressing,
+ * so neither a hit nor a miss allocates memory
+ */
+template <typename Saver, int pageSize = 1024, int pageCount = 1024>
+class probe_cache : public basic_cache<Saver, pageSize, pageCount, probe_map>
+{
+    typedef basic_cache<Saver, pageSize, pageCount, probe_map> base_class;
+public:
+    typedef typename base_class::saver_type saver_type;
+    inline probe_cache() :
+        base_class()
+    {}
+    explicit inline probe_cache(saver_type& saver) :
+        base_class(saver)
+    {}
 };
 
 /**
@@ -264,8 +343,8 @@ inline pos_type page_status<PPage>::index() const
  * @param next the next page
  */
 template <typename Cache, int pageSize>
-// cppcheck-suppress uninitMemberVar symbolName=cache_page::m_data
 inline cache_page<Cache, pageSize>::cache_page(cache_page *prev, cache_page *next) :
+    m_data(NULL),
     m_prev(prev),
     m_next(next),
     m_cache(NULL),
@@ -278,8 +357,8 @@ inline cache_page<Cache, pageSize>::cache_page(cache_page *prev, cache_page *nex
  * Constructor
  */
 template <typename Cache, int pageSize>
-// cppcheck-suppress uninitMemberVar symbolName=cache_page::m_data
 inline cache_page<Cache, pageSize>::cache_page() :
+    m_data(NULL),
     m_prev(NULL),
     m_next(NULL),
     m_cache(NULL),
@@ -353,7 +432,17 @@ inline void* cache_page<Cache, pageSize>::data()
 template <typename Cache, int pageSize>
 inline void* cache_page<Cache, pageSize>::data() const
 {
-    return const_cast<char *>(m_data);
+    return m_data;
+}
+
+/**
+ * Set the memory of data of the page
+ * @param data the memory of data of the page
+ */
+template <typename Cache, int pageSize>
+inline void cache_page<Cache, pageSize>::assign(char *data)
+{
+    m_data = data;
 }
 
 /**
@@ -498,6 +587,50 @@ inline void cache_page<Cache, pageSize>::reset()
     m_dirty = false;
 }
 
+//==============================================================================
+//  page_memory
+//==============================================================================
+/**
+ * Constructor
+ */
+template <int pageSize>
+inline page_memory<pageSize>::page_memory() :
+    m_data(NULL)
+{
+}
+
+/**
+ * Destructor
+ */
+template <int pageSize>
+inline page_memory<pageSize>::~page_memory()
+{
+    ::free(m_data);
+}
+
+/**
+ * Allocate the memory of the pages and assign it to the pages, the previous
+ * memory is released
+ * @param pages the pages
+ */
+template <int pageSize>
+template <typename Page>
+inline void page_memory<pageSize>::assign(std::vector<Page>& pages)
+{
+    ::free(m_data);
+    m_data = NULL;
+    if (posix_memalign(&m_data, OUROBOROS_PAGE_ALIGNMENT, pages.size() * pageSize) != 0)
+    {
+        m_data = NULL;
+        throw std::bad_alloc();
+    }
+    char *data = static_cast<char *>(m_data);
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        pages[i].assign(data + i * pageSize);
+    }
+}
+
 //==============================================================================
 //  cache_pool
 //==============================================================================
@@ -508,6 +641,7 @@ template <typename Cache, int pageSize, int pageCount>
 inline cache_pool<Cache, pageSize, pageCount>::cache_pool() :
     m_pages(COUNT)
 {
+    m_memory.assign(m_pages);
     init();
 }
 
@@ -521,24 +655,49 @@ inline void cache_pool<Cache, pageSize, pageCount>::init()
     m_end = NULL;
 
     m_pages[0].next(&m_pages[1]);
-    m_pages[0].prev(&m_pages[pageCount - 1]);
-    for (pos_type i = 1; i < pageCount - 1; ++i)
+    const count_type count = m_pages.size();
+    m_pages[0].prev(&m_pages[count - 1]);
+    for (pos_type i = 1; i < count - 1; ++i)
     {
         m_pages[i].prev(&m_pages[i - 1]);
         m_pages[i].next(&m_pages[i + 1]);
     }
-    m_pages[pageCount - 1].prev(&m_pages[pageCount - 2]);
-    m_pages[pageCount - 1].next(&m_pages[0]);
+    m_pages[count - 1].prev(&m_pages[count - 2]);
+    m_pages[count - 1].next(&m_pages[0]);
+}
+
+/**
+ * Change the count of the pages, the pages must be detached
+ * @param count the count of the pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void cache_pool<Cache, pageSize, pageCount>::resize(const count_type count)
+{
+    std::vector<page_type>(count).swap(m_pages);
+    m_memory.assign(m_pages);
+    init();
+}
+
+/**
+ * Get the count of the pages
+ * @return the count of the pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline count_type cache_pool<Cache, pageSize, pageCount>::count() const
+{
+    return m_pages.size();
 }
 
 /**
  * Make the new page of the cache
+ * @param index the index of the new page
  * @return the new page of the cache
  */
 template <typename Cache, int pageSize, int pageCount>
 inline typename cache_pool<Cache, pageSize, pageCount>::page_type*
-    cache_pool<Cache, pageSize, pageCount>::make_page()
+    cache_pool<Cache, pageSize, pageCount>::make_page(const pos_type index)
 {
+    OUROBOROS_UNUSED(index);
     if (m_end == m_beg)
     {
         m_beg->detach();
@@ -592,7 +751,7 @@ count_type cache_pool<Cache, pageSize, pageCount>::test_page_count() const
             std::cout << test_page_index(page) << "->";
             page = page->next();
             ++count;
-            if (count > pageCount)
+            if (count > m_pages.size())
             {
                 std::cout << "Error";
                 return count;
@@ -616,13 +775,15 @@ pos_type cache_pool<Cache, pageSize, pageCount>::test_page_index(page_type *page
 #endif
 
 //==============================================================================
-//  cache
+//  basic_cache
 //==============================================================================
 /**
  * Constructor
  */
-template <typename Saver, int pageSize, int pageCount>
-inline cache<Saver, pageSize, pageCount>::cache() :
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::basic_cache() :
     m_saver(NULL)
 {
 }
@@ -631,8 +792,10 @@ inline cache<Saver, pageSize, pageCount>::cache() :
  * Constructor
  * @param saver the saver of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline cache<Saver, pageSize, pageCount>::cache(saver_type& saver) :
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::basic_cache(saver_type& saver) :
     m_saver(&saver)
 {
 }
@@ -642,9 +805,11 @@ inline cache<Saver, pageSize, pageCount>::cache(saver_type& saver) :
  * @param index the index of the page
  * @return the pointer to the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline typename cache<Saver, pageSize, pageCount>::page_type*
-    cache<Saver, pageSize, pageCount>::do_page_exists(const pos_type index) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline typename basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::page_type*
+    basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::do_page_exists(const pos_type index) const
 {
     const typename page_list::const_iterator it = m_pages.find(index);
     return m_pages.end() == it ? NULL : it->second;
@@ -655,9 +820,11 @@ inline typename cache<Saver, pageSize, pageCount>::page_type*
  * @param index the index of the page
  * @return the status of the cache page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline typename cache<Saver, pageSize, pageCount>::page_status_type
-    cache<Saver, pageSize, pageCount>::page_exists(const pos_type index) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline typename basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::page_status_type
+    basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::page_exists(const pos_type index) const
 {
     return page_status_type(index, do_page_exists(index));
 }
@@ -667,9 +834,11 @@ inline typename cache<Saver, pageSize, pageCount>::page_status_type
  * @param index the index of the page
  * @return the pointer to the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline typename cache<Saver, pageSize, pageCount>::page_type*
-    cache<Saver, pageSize, pageCount>::do_get_page(const pos_type index) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline typename basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::page_type*
+    basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::do_get_page(const pos_type index) const
 {
     const page_status_type status = page_exists(index);
     return do_get_page(status);
@@ -680,9 +849,11 @@ inline typename cache<Saver, pageSize, pageCount>::page_type*
  * @param status the status of the page
  * @return the pointer to the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline typename cache<Saver, pageSize, pageCount>::page_type*
-    cache<Saver, pageSize, pageCount>::do_get_page(const page_status_type& status) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline typename basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::page_type*
+    basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::do_get_page(const page_status_type& status) const
 {
     page_type *page = status.page();
     if (page != NULL)
@@ -692,9 +863,9 @@ inline typename cache<Saver, pageSize, pageCount>::page_type*
     else
     {
         const pos_type index = status.index();
-        page = m_pool.make_page();
+        page = m_pool.make_page(index);
         m_pages.insert(std::make_pair(index, page));
-        page->attach(*const_cast<cache<Saver, pageSize, pageCount> *>(this), index);
+        page->attach(*const_cast<basic_cache<Saver, pageSize, pageCount, PageMap, Pool> *>(this), index);
     }
     return page;
 }
@@ -704,8 +875,10 @@ inline typename cache<Saver, pageSize, pageCount>::page_type*
  * @param index the index of the page
  * @return data of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void* cache<Saver, pageSize, pageCount>::get_page(const pos_type index)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void* basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::get_page(const pos_type index)
 {
     page_type *page = do_get_page(index);
     page->dirty();
@@ -717,8 +890,10 @@ inline void* cache<Saver, pageSize, pageCount>::get_page(const pos_type index)
  * @param status the status of the page
  * @return data of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void* cache<Saver, pageSize, pageCount>::get_page(const page_status_type& status)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void* basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::get_page(const page_status_type& status)
 {
     page_type *page = do_get_page(status);
     page->dirty();
@@ -730,8 +905,10 @@ inline void* cache<Saver, pageSize, pageCount>::get_page(const page_status_type&
  * @param index the index of the page
  * @return data of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void* cache<Saver, pageSize, pageCount>::get_page(const pos_type index) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void* basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::get_page(const pos_type index) const
 {
     return do_get_page(index)->data();
 }
@@ -741,18 +918,34 @@ inline void* cache<Saver, pageSize, pageCount>::get_page(const pos_type index) c
  * @param status the status of the page
  * @return data of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void* cache<Saver, pageSize, pageCount>::get_page(const page_status_type& status) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void* basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::get_page(const page_status_type& status) const
 {
     return do_get_page(status)->data();
 }
 
+/**
+ * The page is loaded from the file, nothing to do for the local cache
+ * @param index the index of the page
+ */
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::page_loaded(const pos_type index) const
+{
+    OUROBOROS_UNUSED(index);
+}
+
 /**
  * Dirty the page
  * @param page the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::dirty(page_type *page)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::dirty(page_type *page)
 {
     m_dirty_pages.insert(std::make_pair(page->index(), page));
 }
@@ -761,8 +954,10 @@ inline void cache<Saver, pageSize, pageCount>::dirty(page_type *page)
  * Clean the page
  * @param page the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::clean(page_type *page)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::clean(page_type *page)
 {
     save_page(page);
     m_dirty_pages.erase(page->index());
@@ -772,8 +967,10 @@ inline void cache<Saver, pageSize, pageCount>::clean(page_type *page)
  * Clean the page
  * @param it the dirty page iterator of the cache
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::clean(const iterator& it)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::clean(const iterator& it)
 {
     save_page(it->second);
     m_dirty_pages.erase(it);
@@ -784,8 +981,10 @@ inline void cache<Saver, pageSize, pageCount>::clean(const iterator& it)
  * @param size the size of object
  * @return the aligned size of object
  */
-template <typename Saver, int pageSize, int pageCount>
-inline size_type cache<Saver, pageSize, pageCount>::aligned_size(const size_type size)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline size_type basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::aligned_size(const size_type size)
 {
     const count_type count = calc_page_count(size);
     return pageSize * count;
@@ -795,8 +994,10 @@ inline size_type cache<Saver, pageSize, pageCount>::aligned_size(const size_type
  * Get the size of the cache
  * @return the size of the cache
  */
-template <typename Saver, int pageSize, int pageCount>
-inline size_type cache<Saver, pageSize, pageCount>::size() const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline size_type basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::size() const
 {
     return pageSize * get_page_count();
 }
@@ -805,8 +1006,10 @@ inline size_type cache<Saver, pageSize, pageCount>::size() const
  * Check the cache is empty
  * @return the result of the checking
  */
-template <typename Saver, int pageSize, int pageCount>
-inline bool cache<Saver, pageSize, pageCount>::empty() const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline bool basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::empty() const
 {
     return m_pages.empty();
 }
@@ -815,8 +1018,10 @@ inline bool cache<Saver, pageSize, pageCount>::empty() const
  * Check the cache is dirty
  * @return the result of the checking
  */
-template <typename Saver, int pageSize, int pageCount>
-inline bool cache<Saver, pageSize, pageCount>::dirty() const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline bool basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::dirty() const
 {
     return !m_dirty_pages.empty();
 }
@@ -826,8 +1031,10 @@ inline bool cache<Saver, pageSize, pageCount>::dirty() const
  * Test the count of the page in the cache pool
  * @return the count of the pages in the cache pool
  */
-template <typename Saver, int pageSize, int pageCount>
-count_type cache<Saver, pageSize, pageCount>::test_pool_page_count() const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+count_type basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::test_pool_page_count() const
 {
     return m_pool.test_page_count();
 }
@@ -838,8 +1045,10 @@ count_type cache<Saver, pageSize, pageCount>::test_pool_page_count() const
  * @param size the size of the object
  * @return the count of pages
  */
-template <typename Saver, int pageSize, int pageCount>
-inline count_type cache<Saver, pageSize, pageCount>::calc_page_count(const size_type size) const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline count_type basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::calc_page_count(const size_type size) const
 {
     return calc_cache_page_count(size, pageSize);
 }
@@ -848,8 +1057,10 @@ inline count_type cache<Saver, pageSize, pageCount>::calc_page_count(const size_
  * Get the count of the pages
  * @return the count of the pages
  */
-template <typename Saver, int pageSize, int pageCount>
-inline count_type cache<Saver, pageSize, pageCount>::get_page_count() const
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline count_type basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::get_page_count() const
 {
     return m_pages.size();
 }
@@ -857,8 +1068,10 @@ inline count_type cache<Saver, pageSize, pageCount>::get_page_count() const
 /**
  * Initialize the cache pool
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::init_pool()
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::init_pool()
 {
     m_pool.init();
 }
@@ -867,8 +1080,10 @@ inline void cache<Saver, pageSize, pageCount>::init_pool()
  * Detach the page from the cache
  * @param index the index of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::detach(const pos_type index)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::detach(const pos_type index)
 {
     iterator it = cache_type::m_pages.find(index);
     if (it != cache_type::m_pages.end())
@@ -881,8 +1096,10 @@ inline void cache<Saver, pageSize, pageCount>::detach(const pos_type index)
  * Detach the page from the cache
  * @param it the page iterator of the cache
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::detach(const iterator& it)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::detach(const iterator& it)
 {
     if (it->second->state() == PG_DIRTY)
     {
@@ -896,8 +1113,10 @@ inline void cache<Saver, pageSize, pageCount>::detach(const iterator& it)
  * Save the page
  * @param page the page
  */
-template <typename Saver, int pageSize, int pageCount>
-void cache<Saver, pageSize, pageCount>::save_page(const page_type *page)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::save_page(const page_type *page)
 {
     if (m_saver != NULL)
     {
@@ -906,25 +1125,51 @@ void cache<Saver, pageSize, pageCount>::save_page(const page_type *page)
 }
 
 /**
- * Clean all dirty pages
+ * Compare the indexes of the pages
+ * @param page1 the first page
+ * @param page2 the second page
+ * @return true if the index of the first page is less
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::clean()
+//static
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline bool basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::index_less(const page_type *page1,
+    const page_type *page2)
 {
-    iterator it = m_dirty_pages.begin();
-    while (it != m_dirty_pages.end())
+    return page1->index() < page2->index();
+}
+
+/**
+ * Clean all dirty pages, the pages are saved in the order of the indexes,
+ * so the saver can join the adjacent pages
+ */
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::clean()
+{
+    m_clean_pages.clear();
+    const iterator end = m_dirty_pages.end();
+    for (iterator it = m_dirty_pages.begin(); it != end; ++it)
     {
-        page_type *page = it->second;
-        page->clean(it);
-        it = m_dirty_pages.begin();
+        m_clean_pages.push_back(it->second);
     }
+    std::sort(m_clean_pages.begin(), m_clean_pages.end(), index_less);
+    for (size_t i = 0; i < m_clean_pages.size(); ++i)
+    {
+        m_clean_pages[i]->clean();
+    }
+    m_clean_pages.clear();
 }
 
 /**
  * Release the cache
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::free()
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::free()
 {
     iterator it = m_pages.begin();
     while (it != m_pages.end())
@@ -940,8 +1185,10 @@ inline void cache<Saver, pageSize, pageCount>::free()
  * Release the page from the pool
  * @param index the index of the page
  */
-template <typename Saver, int pageSize, int pageCount>
-inline void cache<Saver, pageSize, pageCount>::free_page(const pos_type index)
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::free_page(const pos_type index)
 {
     iterator it = m_pages.find(index);
     if (it != m_pages.end())
@@ -951,7 +1198,47 @@ inline void cache<Saver, pageSize, pageCount>::free_page(const pos_type index)
     }
 }
 
+/**
+ * Change the count of the pages in the pool, the cache is released
+ * @param count the count of the pages
+ */
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::set_capacity(const count_type count)
+{
+    if (count < 2)
+    {
+        OUROBOROS_THROW_ERROR(range_error, PR(count) << "the count of the cache pages is too small");
+    }
+    free();
+    m_pages.reserve(count);
+    m_dirty_pages.reserve(count);
+    m_pool.resize(count);
+}
+
+/**
+ * Get the count of the pages in the pool
+ * @return the count of the pages
+ */
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline count_type basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::capacity() const
+{
+    return m_pool.count();
+}
+
+/**
+ * Clear the pages shared between processes, the pages of the cache are local
+ */
+template <typename Saver, int pageSize, int pageCount,
+    template <typename, typename, int> class PageMap,
+    template <typename, int, int> class Pool>
+inline void basic_cache<Saver, pageSize, pageCount, PageMap, Pool>::reset_shared()
+{
+}
+
 }   //namespace ouroboros
 
 #endif	/* OUROBOROS_CACHE_H */
-
@@ -6,10 +6,16 @@
 #ifndef OUROBOROS_CACHEFILE_H
 #define	OUROBOROS_CACHEFILE_H
 
+#include <fcntl.h>
 #include <string.h>
+#include <sys/uio.h>
+#include <algorithm>
+#include <vector>
 
 #include "ouroboros/filelock.h"
 #include "ouroboros/cache.h"
+#include "ouroboros/pagelog.h"
+#include "ouroboros/commitgroup.h"
 
 namespace ouroboros
 {
@@ -37,6 +43,7 @@ public:
 
     typedef Cache<cache_file, CACHE_PAGE_SIZE, CACHE_PAGE_COUNT> cache_type;
     typedef typename cache_type::page_status_type page_status_type;
+    typedef page_log<> page_log_type;
 
     explicit cache_file(const std::string& name);
     cache_file(const std::string& name, const file_region_type& region);
@@ -53,10 +60,33 @@ public:
     void cancel(); ///< cancel the transaction
     transaction_state state() const; ///< get the state of the transaction
     void reset(); ///< reset the cache
+    void set_page_log(page_log_type& log); ///< set the log of the changed pages
+    void set_commit_group(commit_group& group); ///< set the group commit
+    void sync_commit(); ///< synchronize the data of the stopped transaction
+    void set_cache_capacity(const count_type count); ///< change the count of the cache pages
+    count_type cache_capacity() const; ///< get the count of the cache pages
+    void set_read_ahead(const count_type count); ///< change the maximum count of the pages that are read ahead
+    count_type read_ahead() const; ///< get the maximum count of the pages that are read ahead
+    bool set_direct(const bool direct); ///< turn on/off the direct I/O for the pages aligned by OUROBOROS_PAGE_ALIGNMENT
 
     virtual void save_page(const pos_type index, void *data); ///< save data of the cache page
 protected:
     void clean(); ///< clean dirty pages of a cache
+    void write_back(); ///< save the dirty pages, the adjacent pages are written by one call
+    void flush_pages(); ///< write the joined pages to the file
+    void do_stop(); ///< stop the transaction without publishing the changed pages
+    void do_cancel(); ///< cancel the transaction without publishing the changed pages
+    void publish_pages(const pos_type beg, const pos_type end); ///< publish the range of the changed pages
+    void release_pages(size_type size, const pos_type pos); ///< release the pages changed by others
+    void commit_sync(const base_file& file) const; ///< synchronize the data of the commit
+    void defer_sync(); ///< synchronize the data of the commit after the unlocking
+    void do_sync_commit(); ///< synchronize the data of the stopped transaction, the errors are thrown
+    virtual void do_after_sync(); ///< perform an action after the synchronization of the commit
+    virtual void do_before_write_pages(); ///< perform an action before the pages are written to the file
+    const char *load_ahead(const pos_type index) const; ///< read the pages following the missed page by one call
+    void load_page(void *page, const pos_type index, const char *ahead) const; ///< load data of the cache page
+    virtual bool can_read_ahead(const pos_type index) const; ///< check the page can be read ahead from the file
+    virtual void do_prefetch(size_type size, const pos_type pos) const; ///< read data ahead
     virtual void do_read(void *buffer, size_type size, const pos_type pos) const; ///< read data
     virtual void do_write(const void *buffer, size_type size, const pos_type pos); ///< write data
     virtual void do_refresh(size_type size, const pos_type pos); ///< refresh data
@@ -66,6 +96,19 @@ protected:
 protected:
     cache_type m_cache; ///< the cache
     transaction_state m_trans; ///< the state of the transaction
+    page_log_type *m_page_log; ///< the log of the changed pages
+    revision_type m_page_seq; ///< the number of the next range of the log to be released
+    commit_group *m_commit_group; ///< the group commit
+    bool m_sync_pending; ///< the sign that the synchronization of the commit is deferred
+    bool m_write_back; ///< the sign that the saved pages are joined
+    pos_type m_write_index; ///< the index of the first joined page
+    std::vector<struct iovec> m_write_pages; ///< the joined adjacent pages
+    count_type m_ahead_capacity; ///< the maximum count of the pages that are read ahead
+    mutable pos_type m_ahead_index; ///< the index of the page that continues the sequential reading
+    mutable count_type m_ahead_count; ///< the count of the pages that are read ahead by the sequential reading
+    mutable pos_type m_read_end; ///< the index of the page that ends the current reading
+    mutable bool m_sequential; ///< the sign that the system is advised of the sequential reading
+    mutable std::vector<char> m_ahead_buffer; ///< the buffer of the pages that are read ahead
 };
 
 //==============================================================================
@@ -80,8 +123,20 @@ template <typename FilePage, int pageCount, typename File,
 cache_file<FilePage, pageCount, File, Cache>::cache_file(const std::string& name) :
     base_class(name),
     m_cache(*this),
-    m_trans(TR_STOPPED)
+    m_trans(TR_STOPPED),
+    m_page_log(NULL),
+    m_page_seq(0),
+    m_commit_group(NULL),
+    m_sync_pending(false),
+    m_write_back(false),
+    m_write_index(NIL),
+    m_ahead_capacity(OUROBOROS_READ_AHEAD),
+    m_ahead_index(NIL),
+    m_ahead_count(0),
+    m_read_end(NIL),
+    m_sequential(false)
 {
+    base_class::set_durability(OUROBOROS_DURABILITY);
 }
 
 /**
@@ -95,8 +150,20 @@ cache_file<FilePage, pageCount, File, Cache>::cache_file(const std::string& name
         const file_region_type& region) :
     base_class(name, region),
     m_cache(*this),
-    m_trans(TR_STOPPED)
+    m_trans(TR_STOPPED),
+    m_page_log(NULL),
+    m_page_seq(0),
+    m_commit_group(NULL),
+    m_sync_pending(false),
+    m_write_back(false),
+    m_write_index(NIL),
+    m_ahead_capacity(OUROBOROS_READ_AHEAD),
+    m_ahead_index(NIL),
+    m_ahead_count(0),
+    m_read_end(NIL),
+    m_sequential(false)
 {
+    base_class::set_durability(OUROBOROS_DURABILITY);
 }
 
 /**
@@ -120,11 +187,22 @@ void cache_file<FilePage, pageCount, File, Cache>::
     }
     else
     {
-        for (file_page_type page = page0; page < page1; ++page)
+        // the missed pages of the range are read ahead by one call
+        m_read_end = page1.index() + 1;
+        try
         {
-            page.assign(get_page(page.index()));
-            buffer = page.read(buffer);
+            for (file_page_type page = page0; page < page1; ++page)
+            {
+                page.assign(get_page(page.index()));
+                buffer = page.read(buffer);
+            }
         }
+        catch (...)
+        {
+            m_read_end = NIL;
+            throw;
+        }
+        m_read_end = NIL;
         page1.assign(get_page(page1.index()));
         page1.read_rest(buffer);
     }
@@ -181,8 +259,9 @@ void *cache_file<FilePage, pageCount, File, Cache>::get_page(const pos_type inde
     }
     else
     {
+        const char *ahead = load_ahead(index);
         void *page = m_cache.get_page(status);
-        base_class::do_read(page, CACHE_PAGE_SIZE, status.index() * CACHE_PAGE_SIZE);
+        load_page(page, index, ahead);
         return page;
     }
 }
@@ -204,8 +283,9 @@ void *cache_file<FilePage, pageCount, File, Cache>::get_page(const pos_type inde
     }
     else
     {
+        const char *ahead = load_ahead(index);
         void *page = m_cache.get_page(status);
-        base_class::do_read(page, CACHE_PAGE_SIZE, status.index() * CACHE_PAGE_SIZE);
+        load_page(page, index, ahead);
         return page;
     }
 }
@@ -221,15 +301,29 @@ void cache_file<FilePage, pageCount, File, Cache>::start()
     {
         OUROBOROS_THROW_BUG("there already is some transaction");
     }
+    // the previous commit must be synchronized before the changes
+    do_sync_commit();
     m_trans = TR_STARTED;
 }
 
 /**
- * Stop the transaction
+ * Stop the transaction, the file doesn't know which pages are changed so all
+ * pages are published as changed
  */
 template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void cache_file<FilePage, pageCount, File, Cache>::stop()
+{
+    do_stop();
+    publish_pages(0, NIL);
+}
+
+/**
+ * Stop the transaction without publishing the changed pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::do_stop()
 {
     if (TR_STARTED != m_trans)
     {
@@ -237,16 +331,28 @@ void cache_file<FilePage, pageCount, File, Cache>::stop()
     }
     /*@attention if the line will be executed after the next line then
      * your data may be lost! */
-    m_cache.clean();
+    write_back();
     m_trans = TR_STOPPED;
 }
 
 /**
- * Cancel the transaction
+ * Cancel the transaction, the file doesn't know which pages are changed so all
+ * pages are published as changed
  */
 template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void cache_file<FilePage, pageCount, File, Cache>::cancel()
+{
+    do_cancel();
+    publish_pages(0, NIL);
+}
+
+/**
+ * Cancel the transaction without publishing the changed pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::do_cancel()
 {
     if (TR_STARTED != m_trans)
     {
@@ -278,10 +384,80 @@ template <typename FilePage, int pageCount, typename File,
 void cache_file<FilePage, pageCount, File, Cache>::save_page(const pos_type index, void *page)
 {
     OUROBOROS_ASSERT(page != NULL);
-    if (TR_CANCELED != m_trans)
+    if (TR_CANCELED == m_trans)
     {
+        return;
+    }
+    if (!m_write_back)
+    {
+        do_before_write_pages();
         base_class::do_write(page, CACHE_PAGE_SIZE, index * CACHE_PAGE_SIZE);
+        return;
     }
+    // the pages are saved in the order of the indexes
+    if (!m_write_pages.empty() && index != m_write_index + m_write_pages.size())
+    {
+        flush_pages();
+    }
+    if (m_write_pages.empty())
+    {
+        m_write_index = index;
+    }
+    struct iovec iov;
+    iov.iov_base = page;
+    iov.iov_len = CACHE_PAGE_SIZE;
+    m_write_pages.push_back(iov);
+}
+
+/**
+ * Submit the joined pages to the file, the cache continues to save
+ * the next pages while the pages are written (the end of the writing is
+ * waited by the method write_back)
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::flush_pages()
+{
+    if (m_write_pages.empty())
+    {
+        return;
+    }
+    do_before_write_pages();
+    if (1 == m_write_pages.size())
+    {
+        base_class::submit_write(m_write_pages.front().iov_base, CACHE_PAGE_SIZE, m_write_index * CACHE_PAGE_SIZE);
+    }
+    else
+    {
+        base_class::submit_writev(&m_write_pages[0], m_write_pages.size(), m_write_index * CACHE_PAGE_SIZE);
+    }
+    m_write_pages.clear();
+}
+
+/**
+ * Save the dirty pages of the cache, the cache saves the pages in the order
+ * of the indexes and the adjacent pages are written by one call; the pages
+ * stay in the cache until the end of the writing
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::write_back()
+{
+    m_write_back = true;
+    try
+    {
+        m_cache.clean();
+        flush_pages();
+    }
+    catch (...)
+    {
+        m_write_back = false;
+        m_write_pages.clear();
+        base_class::complete();
+        throw;
+    }
+    m_write_back = false;
+    base_class::complete();
 }
 
 /**
@@ -296,6 +472,7 @@ void cache_file<FilePage, pageCount, File, Cache>::save_page(const file_page_typ
     if (TR_STARTED != m_trans)
     {
         base_class::do_write(page.get(), CACHE_PAGE_SIZE, page.index() * CACHE_PAGE_SIZE);
+        publish_pages(page.index(), page.index() + 1);
     }
 }
 
@@ -311,6 +488,372 @@ void cache_file<FilePage, pageCount, File, Cache>::reset()
     m_trans = TR_STOPPED;
 }
 
+/**
+ * Change the count of the cache pages, the cache is released
+ * @param count the count of the cache pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::set_cache_capacity(const count_type count)
+{
+    if (m_trans != TR_STOPPED)
+    {
+        OUROBOROS_THROW_BUG("the transaction is in progress");
+    }
+    m_cache.set_capacity(count);
+}
+
+/**
+ * Get the count of the cache pages
+ * @return the count of the cache pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+count_type cache_file<FilePage, pageCount, File, Cache>::cache_capacity() const
+{
+    return m_cache.capacity();
+}
+
+/**
+ * Change the maximum count of the pages that are read ahead, the window of
+ * the sequential reading doesn't exceed a half of the cache
+ * @param count the count of the pages (0 - the pages are not read ahead)
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::set_read_ahead(const count_type count)
+{
+    m_ahead_capacity = count;
+    m_ahead_index = NIL;
+    m_ahead_count = 0;
+}
+
+/**
+ * Get the maximum count of the pages that are read ahead
+ * @return the count of the pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+count_type cache_file<FilePage, pageCount, File, Cache>::read_ahead() const
+{
+    return m_ahead_capacity;
+}
+
+/**
+ * Turn on/off the direct I/O, it is turned on only if the size of the page
+ * is a multiple of OUROBOROS_PAGE_ALIGNMENT, otherwise no page would be
+ * aligned and all data would still go through the page cache of the system
+ * @param direct the sign of the direct I/O
+ * @return the direct I/O is turned on
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+bool cache_file<FilePage, pageCount, File, Cache>::set_direct(const bool direct)
+{
+    const bool aligned = 0 == size_type(CACHE_PAGE_SIZE) % size_type(OUROBOROS_PAGE_ALIGNMENT);
+    if (direct && !aligned)
+    {
+        OUROBOROS_DEBUG("the size of the page isn't aligned for the direct I/O: " << PR(CACHE_PAGE_SIZE));
+    }
+    return base_class::set_direct(direct && aligned);
+}
+
+/**
+ * Read the pages following the missed page by one call, the count of
+ * the pages is doubled while the misses continue the sequential reading
+ * and it is extended up to the end of the current reading; the pages that
+ * are read ahead are put to the cache, the missed page is loaded
+ * by the caller
+ * @param index the index of the missed page
+ * @return data of the missed page or NULL if the pages are not read ahead
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+const char *cache_file<FilePage, pageCount, File, Cache>::load_ahead(const pos_type index) const
+{
+    if (0 == m_ahead_capacity)
+    {
+        return NULL;
+    }
+    const count_type max_count = std::min(m_ahead_capacity, m_cache.capacity() / 2);
+    if (index == m_ahead_index)
+    {
+        m_ahead_count = std::min(m_ahead_count > 0 ? 2 * m_ahead_count : 1, max_count);
+    }
+    else
+    {
+        if (m_sequential)
+        {
+            base_class::advise(0, 0, POSIX_FADV_NORMAL);
+            m_sequential = false;
+        }
+        m_ahead_count = 0;
+    }
+    count_type count = m_ahead_count;
+    if (m_read_end != NIL && m_read_end > index + 1)
+    {
+        count = std::max(count, std::min(count_type(m_read_end - index - 1), max_count));
+    }
+    count_type n = 0;
+    if (count > 0)
+    {
+        const pos_type end = base_class::do_size() / CACHE_PAGE_SIZE;
+        while (n < count && index + n + 1 < end && can_read_ahead(index + n + 1) &&
+            m_cache.page_exists(index + n + 1).state() == PG_DETACHED)
+        {
+            ++n;
+        }
+    }
+    m_ahead_index = index + n + 1;
+    if (0 == n)
+    {
+        return NULL;
+    }
+
+    // the buffer is aligned to be read by the direct I/O
+    const size_type size = (n + 1) * CACHE_PAGE_SIZE;
+    m_ahead_buffer.resize(size + OUROBOROS_PAGE_ALIGNMENT);
+    const size_t addr = reinterpret_cast<size_t>(&m_ahead_buffer[0]);
+    char *buffer = reinterpret_cast<char *>((addr + OUROBOROS_PAGE_ALIGNMENT - 1) &
+        ~size_t(OUROBOROS_PAGE_ALIGNMENT - 1));
+    base_class::do_read(buffer, size, index * CACHE_PAGE_SIZE);
+    for (count_type i = 1; i <= n; ++i)
+    {
+        const page_status_type status = m_cache.page_exists(index + i);
+        if (PG_DETACHED == status.state())
+        {
+            load_page(m_cache.get_page(status), index + i, buffer + i * CACHE_PAGE_SIZE);
+        }
+    }
+    if (m_ahead_count == max_count)
+    {
+        // the system reads the next pages while the cached pages are processed
+        if (!m_sequential)
+        {
+            base_class::advise(0, 0, POSIX_FADV_SEQUENTIAL);
+            m_sequential = true;
+        }
+        base_class::advise(max_count * CACHE_PAGE_SIZE, m_ahead_index * CACHE_PAGE_SIZE, POSIX_FADV_WILLNEED);
+    }
+    return buffer;
+}
+
+/**
+ * Load data of the cache page
+ * @param page the buffer of the cache page
+ * @param index the index of the cache page
+ * @param ahead data of the page that is read ahead or NULL
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::load_page(void *page, const pos_type index,
+    const char *ahead) const
+{
+    if (ahead != NULL)
+    {
+        memcpy(page, ahead, CACHE_PAGE_SIZE);
+    }
+    else
+    {
+        base_class::do_read(page, CACHE_PAGE_SIZE, index * CACHE_PAGE_SIZE);
+    }
+    m_cache.page_loaded(index);
+}
+
+/**
+ * Check the page can be read ahead from the file
+ * @param index the index of the page
+ * @return the result of the checking
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+bool cache_file<FilePage, pageCount, File, Cache>::can_read_ahead(const pos_type index) const
+{
+    OUROBOROS_UNUSED(index);
+    return true;
+}
+
+/**
+ * Read data ahead, the system is advised to read the data and the missed
+ * pages are put to the cache, a half of the cache is filled at most
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::do_prefetch(size_type size, const pos_type pos) const
+{
+    base_class::do_prefetch(size, pos);
+    if (0 == size)
+    {
+        return;
+    }
+    const pos_type beg = pos / CACHE_PAGE_SIZE;
+    const pos_type end = std::min(std::min((pos + size - 1) / CACHE_PAGE_SIZE + 1,
+        beg + m_cache.capacity() / 2), pos_type(base_class::do_size() / CACHE_PAGE_SIZE));
+    m_read_end = end;
+    try
+    {
+        for (pos_type index = beg; index < end; ++index)
+        {
+            get_page(index);
+        }
+    }
+    catch (...)
+    {
+        m_read_end = NIL;
+        throw;
+    }
+    m_read_end = NIL;
+}
+
+/**
+ * Set the log of the changed pages, after that only the pages that are
+ * published by the log are released by the refreshing
+ * @param log the log of the changed pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::set_page_log(page_log_type& log)
+{
+    m_page_log = &log;
+    m_page_seq = log.head();
+}
+
+/**
+ * Set the group commit, after that the commits that arrive within the window
+ * of the group share one synchronization of the file
+ * @param group the group commit
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::set_commit_group(commit_group& group)
+{
+    m_commit_group = &group;
+}
+
+/**
+ * Synchronize the data of the commit, the synchronization is shared by
+ * the group commit
+ * @param file the file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::commit_sync(const base_file& file) const
+{
+    if (m_commit_group != NULL)
+    {
+        // the synchronization of the group covers only the written data
+        file.complete();
+        m_commit_group->commit(file);
+    }
+    else
+    {
+        file.sync();
+    }
+}
+
+/**
+ * Synchronize the data of the commit after the unlocking of the file
+ * (method sync_commit), so the synchronization is shared by the commits of
+ * the other processes; the data is synchronized at once without the group commit
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::defer_sync()
+{
+    m_sync_pending = true;
+    if (NULL == m_commit_group)
+    {
+        sync_commit();
+    }
+}
+
+/**
+ * Synchronize the data of the stopped transaction, the method returns when
+ * the data is synchronized by the own synchronization or by the shared one;
+ * the transaction is already committed and visible to the other processes,
+ * so an error of the synchronization is not thrown: it is logged and
+ * the synchronization is repeated by the start of the next transaction
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::sync_commit()
+{
+    try
+    {
+        do_sync_commit();
+    }
+    catch (const std::exception& e)
+    {
+        OUROBOROS_ERROR("error of the synchronization of the commit: " << PR(base_class::name()) << PE(e.what()));
+    }
+}
+
+/**
+ * Synchronize the data of the stopped transaction, the synchronization
+ * stays pending if it fails
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::do_sync_commit()
+{
+    if (m_sync_pending)
+    {
+        if (m_commit_group != NULL)
+        {
+            m_commit_group->commit(*this);
+        }
+        else
+        {
+            base_class::sync();
+        }
+        m_sync_pending = false;
+        do_after_sync();
+    }
+}
+
+/**
+ * Perform an action after the synchronization of the deferred commit
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::do_after_sync()
+{
+}
+
+/**
+ * Perform an action before the pages are written to the file
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::do_before_write_pages()
+{
+}
+
+/**
+ * Publish the range of the changed pages
+ * @param beg the first changed page
+ * @param end the page after the last changed page
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::publish_pages(const pos_type beg, const pos_type end)
+{
+    if (m_page_log != NULL)
+    {
+        // the own cache already has the changed pages
+        if (m_page_log->publish(beg, end) == m_page_seq)
+        {
+            ++m_page_seq;
+        }
+    }
+}
+
 /**
  * Clean dirty pages of a cache
  */
@@ -318,7 +861,7 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void cache_file<FilePage, pageCount, File, Cache>::clean()
 {
-    m_cache.clean();
+    write_back();
 }
 
 /**
@@ -332,12 +875,46 @@ template <typename FilePage, int pageCount, typename File,
 void cache_file<FilePage, pageCount, File, Cache>::do_refresh(size_type size, const pos_type pos)
 {
     OUROBOROS_ASSERT(m_trans != TR_STARTED || !m_cache.dirty());
-    const pos_type beg = pos / CACHE_PAGE_SIZE;
-    const pos_type end = (pos + size) / CACHE_PAGE_SIZE + 1;
-    for (pos_type i = beg; i < end; ++i)
+    release_pages(size, pos);
+}
+
+/**
+ * Release the pages that were changed by others
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void cache_file<FilePage, pageCount, File, Cache>::release_pages(size_type size, const pos_type pos)
+{
+    if (NULL == m_page_log)
+    {
+        const pos_type beg = pos / CACHE_PAGE_SIZE;
+        const pos_type end = (pos + size) / CACHE_PAGE_SIZE + 1;
+        for (pos_type i = beg; i < end; ++i)
+        {
+            m_cache.free_page(i);
+        }
+        return;
+    }
+    // release the pages that were changed since the last refreshing
+    const revision_type head = m_page_log->head();
+    bool full = head - m_page_seq > page_log_type::LOG_SIZE;
+    for (revision_type seq = m_page_seq; !full && seq != head; ++seq)
+    {
+        pos_type beg;
+        pos_type end;
+        full = !m_page_log->read(seq, beg, end) || end - beg > m_cache.capacity();
+        for (pos_type i = beg; !full && i < end; ++i)
+        {
+            m_cache.free_page(i);
+        }
+    }
+    if (full)
     {
-        m_cache.free_page(i);
+        m_cache.free();
     }
+    m_page_seq = head;
 }
 
 }   //namespace ouroboros
@@ -0,0 +1,841 @@
+/**
+ * @file   cachepool.h
+ * The page pools with scan-resistant replacement policies
+ */
+
+#ifndef OUROBOROS_CACHEPOOL_H
+#define	OUROBOROS_CACHEPOOL_H
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "ouroboros/global.h"
+#include "ouroboros/cache.h"
+#include "ouroboros/probemap.h"
+
+namespace ouroboros
+{
+
+/**
+ * The queue of cache pages, it's a doubly linked list that is made of
+ * the pointers of the pages
+ */
+template <typename Page>
+class page_queue
+{
+public:
+    typedef Page page_type;
+
+    inline page_queue();
+
+    inline void push_back(page_type *page); ///< add the page to the end of the queue
+    inline void remove(page_type *page); ///< remove the page from the queue
+    inline page_type* front() const; ///< get the first page of the queue
+    inline page_type* back() const; ///< get the last page of the queue
+    inline count_type size() const; ///< get the count of the pages in the queue
+    inline bool empty() const; ///< check the queue is empty
+    inline void clear(); ///< clear the queue
+private:
+    page_type *m_front; ///< the first page
+    page_type *m_back; ///< the last page
+    count_type m_size; ///< the count of the pages
+};
+
+/**
+ * The queue of the indexes of pages that were replaced (ghost pages),
+ * the oldest index is removed when the queue is full
+ */
+template <int indexCount>
+class ghost_queue
+{
+public:
+    enum { COUNT = indexCount };
+
+    inline ghost_queue();
+
+    inline void resize(const count_type count); ///< change the count of the indexes, the queue is cleared
+
+    inline void push_back(const pos_type index); ///< add the index to the end of the queue
+    inline void pop_front(); ///< remove the first index of the queue
+    inline bool remove(const pos_type index); ///< remove the index from the queue
+    inline bool exists(const pos_type index) const; ///< check the index exists
+    inline count_type size() const; ///< get the count of the indexes in the queue
+    inline void clear(); ///< clear the queue
+protected:
+    inline void unlink(const pos_type node); ///< unlink the node from the queue
+private:
+    struct node_type
+    {
+        pos_type index;
+        pos_type prev;
+        pos_type next;
+    };
+    typedef probe_map<pos_type, pos_type, indexCount> node_map;
+    std::vector<node_type> m_nodes; ///< the nodes of the indexes
+    node_map m_map; ///< the map of the nodes
+    pos_type m_front; ///< the first node
+    pos_type m_back; ///< the last node
+    pos_type m_free; ///< the first free node
+};
+
+/**
+ * The page pool with 2Q replacement policy: a new page is placed in the FIFO
+ * queue (A1in), the page that is replaced from this queue is remembered in
+ * the queue of ghost pages (A1out) and only a page that is requested again
+ * while it is remembered is placed in the LRU queue of hot pages (Am), so
+ * a single scan of a big table replaces only the pages of A1in
+ */
+template <typename Cache, int pageSize = 1024, int pageCount = 1024>
+class twoq_pool
+{
+public:
+    enum
+    {
+        COUNT = pageCount,
+        OUT_COUNT = pageCount / 2 > 0 ? pageCount / 2 : 1   ///< the count of indexes in A1out
+    };
+    typedef Cache cache_type;
+    typedef cache_page<cache_type, pageSize> page_type;
+
+    inline twoq_pool();
+
+    inline page_type* make_page(const pos_type index); ///< make the new page of the cache
+    inline void up_page(page_type *page); ///< increment the raiting of the page
+    inline void init(); ///< initialize the pool
+    inline void resize(const count_type count); ///< change the count of the pages
+    inline count_type count() const; ///< get the count of the pages
+#ifdef OUROBOROS_TEST_ENABLED
+    count_type test_page_count() const; ///< test the count of the cache page
+    pos_type test_page_index(page_type *page) const; ///< test the index of the cache page
+#endif
+protected:
+    enum queue_type
+    {
+        Q_IN,   ///< the FIFO queue of new pages
+        Q_HOT   ///< the LRU queue of hot pages
+    };
+    inline page_type* reclaim_page(); ///< get a free page or replace a page
+private:
+    std::vector<page_type> m_pages;
+    page_memory<pageSize> m_memory; ///< the memory of data of the pages
+    std::vector<char> m_queues; ///< the queue of each page
+    count_type m_used; ///< the count of pages that have been used
+    count_type m_in_count; ///< the count of pages in A1in
+    page_queue<page_type> m_in; ///< the FIFO queue of new pages (A1in)
+    page_queue<page_type> m_hot; ///< the LRU queue of hot pages (Am)
+    ghost_queue<OUT_COUNT> m_out; ///< the queue of replaced pages (A1out)
+};
+
+/**
+ * The page pool with ARC (adaptive replacement cache) policy: the pages that
+ * were requested once (T1) and several times (T2) are kept in two LRU queues,
+ * the indexes of the pages replaced from them are remembered (B1, B2) and
+ * the hits of the remembered pages adapt the target size of T1, so a single
+ * scan of a big table replaces only the pages of T1
+ */
+template <typename Cache, int pageSize = 1024, int pageCount = 1024>
+class arc_pool
+{
+public:
+    enum { COUNT = pageCount };
+    typedef Cache cache_type;
+    typedef cache_page<cache_type, pageSize> page_type;
+
+    inline arc_pool();
+
+    inline page_type* make_page(const pos_type index); ///< make the new page of the cache
+    inline void up_page(page_type *page); ///< increment the raiting of the page
+    inline void init(); ///< initialize the pool
+    inline void resize(const count_type count); ///< change the count of the pages
+    inline count_type count() const; ///< get the count of the pages
+#ifdef OUROBOROS_TEST_ENABLED
+    count_type test_page_count() const; ///< test the count of the cache page
+    pos_type test_page_index(page_type *page) const; ///< test the index of the cache page
+#endif
+protected:
+    enum queue_type
+    {
+        Q_RECENT,   ///< the queue of the pages requested once
+        Q_FREQUENT  ///< the queue of the pages requested several times
+    };
+    inline page_type* reclaim_page(const bool frequent); ///< get a free page or replace a page
+    inline page_type* replace_page(const bool frequent); ///< replace a page
+private:
+    std::vector<page_type> m_pages;
+    page_memory<pageSize> m_memory; ///< the memory of data of the pages
+    std::vector<char> m_queues; ///< the queue of each page
+    count_type m_used; ///< the count of pages that have been used
+    count_type m_target; ///< the target size of T1
+    page_queue<page_type> m_recent; ///< the pages requested once (T1)
+    page_queue<page_type> m_frequent; ///< the pages requested several times (T2)
+    ghost_queue<pageCount> m_recent_ghosts; ///< the pages replaced from T1 (B1)
+    ghost_queue<pageCount> m_frequent_ghosts; ///< the pages replaced from T2 (B2)
+};
+
+/**
+ * The cache with 2Q replacement policy
+ */
+template <typename Saver, int pageSize = 1024, int pageCount = 1024>
+class twoq_cache : public basic_cache<Saver, pageSize, pageCount, hash_map, twoq_pool>
+{
+    typedef basic_cache<Saver, pageSize, pageCount, hash_map, twoq_pool> base_class;
+public:
+    typedef typename base_class::saver_type saver_type;
+    inline twoq_cache() :
+        base_class()
+    {}
+    explicit inline twoq_cache(saver_type& saver) :
+        base_class(saver)
+    {}
+};
+
+/**
+ * The cache with ARC replacement policy
+ */
+template <typename Saver, int pageSize = 1024, int pageCount = 1024>
+class arc_cache : public basic_cache<Saver, pageSize, pageCount, hash_map, arc_pool>
+{
+    typedef basic_cache<Saver, pageSize, pageCount, hash_map, arc_pool> base_class;
+public:
+    typedef typename base_class::saver_type saver_type;
+    inline arc_cache() :
+        base_class()
+    {}
+    explicit inline arc_cache(saver_type& saver) :
+        base_class(saver)
+    {}
+};
+
+//==============================================================================
+//  page_queue
+//==============================================================================
+/**
+ * Constructor
+ */
+template <typename Page>
+inline page_queue<Page>::page_queue() :
+    m_front(NULL),
+    m_back(NULL),
+    m_size(0)
+{
+}
+
+/**
+ * Add the page to the end of the queue
+ * @param page the page
+ */
+template <typename Page>
+inline void page_queue<Page>::push_back(page_type *page)
+{
+    page->prev(m_back);
+    page->next(NULL);
+    if (m_back != NULL)
+    {
+        m_back->next(page);
+    }
+    else
+    {
+        m_front = page;
+    }
+    m_back = page;
+    ++m_size;
+}
+
+/**
+ * Remove the page from the queue
+ * @param page the page
+ */
+template <typename Page>
+inline void page_queue<Page>::remove(page_type *page)
+{
+    if (page->prev() != NULL)
+    {
+        page->prev()->next(page->next());
+    }
+    else
+    {
+        m_front = page->next();
+    }
+    if (page->next() != NULL)
+    {
+        page->next()->prev(page->prev());
+    }
+    else
+    {
+        m_back = page->prev();
+    }
+    page->prev(NULL);
+    page->next(NULL);
+    assert(m_size > 0);
+    --m_size;
+}
+
+/**
+ * Get the first page of the queue
+ * @return the first page of the queue
+ */
+template <typename Page>
+inline typename page_queue<Page>::page_type* page_queue<Page>::front() const
+{
+    return m_front;
+}
+
+/**
+ * Get the last page of the queue
+ * @return the last page of the queue
+ */
+template <typename Page>
+inline typename page_queue<Page>::page_type* page_queue<Page>::back() const
+{
+    return m_back;
+}
+
+/**
+ * Get the count of the pages in the queue
+ * @return the count of the pages
+ */
+template <typename Page>
+inline count_type page_queue<Page>::size() const
+{
+    return m_size;
+}
+
+/**
+ * Check the queue is empty
+ * @return the result of the checking
+ */
+template <typename Page>
+inline bool page_queue<Page>::empty() const
+{
+    return 0 == m_size;
+}
+
+/**
+ * Clear the queue
+ */
+template <typename Page>
+inline void page_queue<Page>::clear()
+{
+    m_front = NULL;
+    m_back = NULL;
+    m_size = 0;
+}
+
+//==============================================================================
+//  ghost_queue
+//==============================================================================
+/**
+ * Constructor
+ */
+template <int indexCount>
+inline ghost_queue<indexCount>::ghost_queue() :
+    m_nodes(COUNT)
+{
+    clear();
+}
+
+/**
+ * Change the count of the indexes, the queue is cleared
+ * @param count the count of the indexes
+ */
+template <int indexCount>
+inline void ghost_queue<indexCount>::resize(const count_type count)
+{
+    std::vector<node_type>(count).swap(m_nodes);
+    m_map.reserve(count);
+    clear();
+}
+
+/**
+ * Add the index to the end of the queue, the first index is removed
+ * if the queue is full
+ * @param index the index
+ */
+template <int indexCount>
+inline void ghost_queue<indexCount>::push_back(const pos_type index)
+{
+    if (exists(index))
+    {
+        return;
+    }
+    if (NIL == m_free)
+    {
+        pop_front();
+    }
+    const pos_type node = m_free;
+    m_free = m_nodes[node].next;
+    m_nodes[node].index = index;
+    m_nodes[node].prev = m_back;
+    m_nodes[node].next = NIL;
+    if (m_back != NIL)
+    {
+        m_nodes[m_back].next = node;
+    }
+    else
+    {
+        m_front = node;
+    }
+    m_back = node;
+    m_map.insert(std::make_pair(index, node));
+}
+
+/**
+ * Remove the first index of the queue
+ */
+template <int indexCount>
+inline void ghost_queue<indexCount>::pop_front()
+{
+    if (m_front != NIL)
+    {
+        m_map.erase(m_nodes[m_front].index);
+        unlink(m_front);
+    }
+}
+
+/**
+ * Remove the index from the queue
+ * @param index the index
+ * @return the index was in the queue
+ */
+template <int indexCount>
+inline bool ghost_queue<indexCount>::remove(const pos_type index)
+{
+    typename node_map::iterator it = m_map.find(index);
+    if (m_map.end() == it)
+    {
+        return false;
+    }
+    const pos_type node = it->second;
+    m_map.erase(it);
+    unlink(node);
+    return true;
+}
+
+/**
+ * Check the index exists
+ * @param index the index
+ * @return the result of the checking
+ */
+template <int indexCount>
+inline bool ghost_queue<indexCount>::exists(const pos_type index) const
+{
+    return m_map.find(index) != m_map.end();
+}
+
+/**
+ * Get the count of the indexes in the queue
+ * @return the count of the indexes
+ */
+template <int indexCount>
+inline count_type ghost_queue<indexCount>::size() const
+{
+    return m_map.size();
+}
+
+/**
+ * Clear the queue
+ */
+template <int indexCount>
+inline void ghost_queue<indexCount>::clear()
+{
+    m_map.clear();
+    m_front = NIL;
+    m_back = NIL;
+    m_free = 0;
+    const count_type count = m_nodes.size();
+    for (pos_type i = 0; i < count; ++i)
+    {
+        m_nodes[i].next = i + 1 < count ? i + 1 : NIL;
+    }
+}
+
+/**
+ * Unlink the node from the queue and add it to the free nodes
+ * @param node the node
+ */
+template <int indexCount>
+inline void ghost_queue<indexCount>::unlink(const pos_type node)
+{
+    const pos_type prev = m_nodes[node].prev;
+    const pos_type next = m_nodes[node].next;
+    if (prev != NIL)
+    {
+        m_nodes[prev].next = next;
+    }
+    else
+    {
+        m_front = next;
+    }
+    if (next != NIL)
+    {
+        m_nodes[next].prev = prev;
+    }
+    else
+    {
+        m_back = prev;
+    }
+    m_nodes[node].next = m_free;
+    m_free = node;
+}
+
+//==============================================================================
+//  twoq_pool
+//==============================================================================
+/**
+ * Constructor
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline twoq_pool<Cache, pageSize, pageCount>::twoq_pool() :
+    m_pages(COUNT),
+    m_queues(COUNT),
+    m_in_count(std::max<count_type>(COUNT / 4, 1))
+{
+    m_memory.assign(m_pages);
+    init();
+}
+
+/**
+ * Change the count of the pages, the pages must be detached
+ * @param count the count of the pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void twoq_pool<Cache, pageSize, pageCount>::resize(const count_type count)
+{
+    std::vector<page_type>(count).swap(m_pages);
+    m_memory.assign(m_pages);
+    m_queues.assign(count, 0);
+    m_in_count = std::max<count_type>(count / 4, 1);
+    m_out.resize(std::max<count_type>(count / 2, 1));
+    init();
+}
+
+/**
+ * Get the count of the pages
+ * @return the count of the pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline count_type twoq_pool<Cache, pageSize, pageCount>::count() const
+{
+    return m_pages.size();
+}
+
+/**
+ * Initialize the pool
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void twoq_pool<Cache, pageSize, pageCount>::init()
+{
+    m_used = 0;
+    m_in.clear();
+    m_hot.clear();
+    m_out.clear();
+}
+
+/**
+ * Get a free page or replace a page, the page of A1in is replaced if
+ * A1in is greater than its size, otherwise the page of Am is replaced
+ * @return the free page
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline typename twoq_pool<Cache, pageSize, pageCount>::page_type*
+    twoq_pool<Cache, pageSize, pageCount>::reclaim_page()
+{
+    if (m_used < m_pages.size())
+    {
+        return &m_pages[m_used++];
+    }
+    page_type *page = NULL;
+    if (m_in.size() > m_in_count || m_hot.empty())
+    {
+        page = m_in.front();
+        m_in.remove(page);
+        if (page->index() != NIL)
+        {
+            m_out.push_back(page->index());
+        }
+    }
+    else
+    {
+        page = m_hot.front();
+        m_hot.remove(page);
+    }
+    page->detach();
+    return page;
+}
+
+/**
+ * Make the new page of the cache
+ * @param index the index of the new page
+ * @return the new page of the cache
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline typename twoq_pool<Cache, pageSize, pageCount>::page_type*
+    twoq_pool<Cache, pageSize, pageCount>::make_page(const pos_type index)
+{
+    page_type *page = reclaim_page();
+    if (m_out.remove(index))
+    {
+        m_hot.push_back(page);
+        m_queues[page - &m_pages[0]] = Q_HOT;
+    }
+    else
+    {
+        m_in.push_back(page);
+        m_queues[page - &m_pages[0]] = Q_IN;
+    }
+    return page;
+}
+
+/**
+ * Increment the raiting of the page, the requests of the page of A1in are
+ * considered to be correlated and don't change anything
+ * @param page the page of the cache
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void twoq_pool<Cache, pageSize, pageCount>::up_page(page_type *page)
+{
+    if (Q_HOT == m_queues[page - &m_pages[0]] && page != m_hot.back())
+    {
+        m_hot.remove(page);
+        m_hot.push_back(page);
+    }
+}
+
+#ifdef OUROBOROS_TEST_ENABLED
+/**
+ * Test the count of the cache page
+ * @return the count of the cache pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+count_type twoq_pool<Cache, pageSize, pageCount>::test_page_count() const
+{
+    return m_in.size() + m_hot.size();
+}
+
+/**
+ * Test the index of the cache page
+ * @param page the page of the cache
+ * @return the index of the page
+ */
+template <typename Cache, int pageSize, int pageCount>
+pos_type twoq_pool<Cache, pageSize, pageCount>::test_page_index(page_type *page) const
+{
+    return pos_type(page - &m_pages[0]);
+}
+#endif
+
+//==============================================================================
+//  arc_pool
+//==============================================================================
+/**
+ * Constructor
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline arc_pool<Cache, pageSize, pageCount>::arc_pool() :
+    m_pages(COUNT),
+    m_queues(COUNT)
+{
+    m_memory.assign(m_pages);
+    init();
+}
+
+/**
+ * Change the count of the pages, the pages must be detached
+ * @param count the count of the pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void arc_pool<Cache, pageSize, pageCount>::resize(const count_type count)
+{
+    std::vector<page_type>(count).swap(m_pages);
+    m_memory.assign(m_pages);
+    m_queues.assign(count, 0);
+    m_recent_ghosts.resize(count);
+    m_frequent_ghosts.resize(count);
+    init();
+}
+
+/**
+ * Get the count of the pages
+ * @return the count of the pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline count_type arc_pool<Cache, pageSize, pageCount>::count() const
+{
+    return m_pages.size();
+}
+
+/**
+ * Initialize the pool
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void arc_pool<Cache, pageSize, pageCount>::init()
+{
+    m_used = 0;
+    m_target = 0;
+    m_recent.clear();
+    m_frequent.clear();
+    m_recent_ghosts.clear();
+    m_frequent_ghosts.clear();
+}
+
+/**
+ * Replace a page, the page of T1 is replaced if T1 is greater than its
+ * target size, otherwise the page of T2 is replaced
+ * @param frequent the new page was replaced from T2
+ * @return the free page
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline typename arc_pool<Cache, pageSize, pageCount>::page_type*
+    arc_pool<Cache, pageSize, pageCount>::replace_page(const bool frequent)
+{
+    page_type *page = NULL;
+    const count_type size = m_recent.size();
+    if (size > 0 && (m_frequent.empty() || size > m_target || (frequent && size == m_target)))
+    {
+        page = m_recent.front();
+        m_recent.remove(page);
+        if (page->index() != NIL)
+        {
+            m_recent_ghosts.push_back(page->index());
+        }
+    }
+    else
+    {
+        page = m_frequent.front();
+        m_frequent.remove(page);
+        if (page->index() != NIL)
+        {
+            m_frequent_ghosts.push_back(page->index());
+        }
+    }
+    page->detach();
+    return page;
+}
+
+/**
+ * Get a free page or replace a page
+ * @param frequent the new page was replaced from T2
+ * @return the free page
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline typename arc_pool<Cache, pageSize, pageCount>::page_type*
+    arc_pool<Cache, pageSize, pageCount>::reclaim_page(const bool frequent)
+{
+    return m_used < m_pages.size() ? &m_pages[m_used++] : replace_page(frequent);
+}
+
+/**
+ * Make the new page of the cache
+ * @param index the index of the new page
+ * @return the new page of the cache
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline typename arc_pool<Cache, pageSize, pageCount>::page_type*
+    arc_pool<Cache, pageSize, pageCount>::make_page(const pos_type index)
+{
+    page_type *page = NULL;
+    const count_type count = m_pages.size();
+    const count_type recent_ghosts = m_recent_ghosts.size();
+    const count_type frequent_ghosts = m_frequent_ghosts.size();
+    if (m_recent_ghosts.exists(index))
+    {
+        // T1 is too small, increase its target size
+        const count_type delta = std::max<count_type>(frequent_ghosts / recent_ghosts, 1);
+        m_target = std::min<count_type>(m_target + delta, count);
+        page = reclaim_page(false);
+        m_recent_ghosts.remove(index);
+    }
+    else if (m_frequent_ghosts.exists(index))
+    {
+        // T2 is too small, decrease the target size of T1
+        const count_type delta = std::max<count_type>(recent_ghosts / frequent_ghosts, 1);
+        m_target = m_target > delta ? m_target - delta : 0;
+        page = reclaim_page(true);
+        m_frequent_ghosts.remove(index);
+    }
+    else
+    {
+        const count_type recent = m_recent.size() + recent_ghosts;
+        if (recent >= count)
+        {
+            if (m_recent.size() < count)
+            {
+                m_recent_ghosts.pop_front();
+                page = reclaim_page(false);
+            }
+            else
+            {
+                page = m_recent.front();
+                m_recent.remove(page);
+                page->detach();
+            }
+        }
+        else
+        {
+            if (recent + m_frequent.size() + frequent_ghosts >= 2 * count)
+            {
+                m_frequent_ghosts.pop_front();
+            }
+            page = reclaim_page(false);
+        }
+        m_recent.push_back(page);
+        m_queues[page - &m_pages[0]] = Q_RECENT;
+        return page;
+    }
+    m_frequent.push_back(page);
+    m_queues[page - &m_pages[0]] = Q_FREQUENT;
+    return page;
+}
+
+/**
+ * Increment the raiting of the page, the page is moved to the end of T2,
+ * the requests of the last new page are considered to be correlated and
+ * don't change anything
+ * @param page the page of the cache
+ */
+template <typename Cache, int pageSize, int pageCount>
+inline void arc_pool<Cache, pageSize, pageCount>::up_page(page_type *page)
+{
+    if (Q_RECENT == m_queues[page - &m_pages[0]])
+    {
+        if (page != m_recent.back())
+        {
+            m_recent.remove(page);
+            m_frequent.push_back(page);
+            m_queues[page - &m_pages[0]] = Q_FREQUENT;
+        }
+    }
+    else if (page != m_frequent.back())
+    {
+        m_frequent.remove(page);
+        m_frequent.push_back(page);
+    }
+}
+
+#ifdef OUROBOROS_TEST_ENABLED
+/**
+ * Test the count of the cache page
+ * @return the count of the cache pages
+ */
+template <typename Cache, int pageSize, int pageCount>
+count_type arc_pool<Cache, pageSize, pageCount>::test_page_count() const
+{
+    return m_recent.size() + m_frequent.size();
+}
+
+/**
+ * Test the index of the cache page
+ * @param page the page of the cache
+ * @return the index of the page
+ */
+template <typename Cache, int pageSize, int pageCount>
+pos_type arc_pool<Cache, pageSize, pageCount>::test_page_index(page_type *page) const
+{
+    return pos_type(page - &m_pages[0]);
+}
+#endif
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_CACHEPOOL_H */
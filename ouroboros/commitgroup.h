@@ -0,0 +1,315 @@
+/**
+ * @file   commitgroup.h
+ * The group commit of the transactions of a file
+ */
+
+#ifndef OUROBOROS_COMMITGROUP_H
+#define	OUROBOROS_COMMITGROUP_H
+
+#include <limits.h>
+#include <algorithm>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "ouroboros/global.h"
+
+namespace ouroboros
+{
+
+/** the statistics of the group commit */
+struct commit_stats
+{
+    commit_stats() :
+        commits(0),
+        syncs(0),
+        max_batch(0),
+        wait_time(0)
+    {}
+    uint64_t commits;   ///< the count of the commits
+    uint64_t syncs;     ///< the count of the synchronizations of the file
+    uint64_t max_batch; ///< the maximum count of the commits that shared one synchronization
+    uint64_t wait_time; ///< the total time of the commits (us)
+};
+
+/**
+ * The group commit, the commits that arrive within the window share one
+ * synchronization of the file: the first commit becomes the leader, it
+ * waits for the window or until the batch is full and synchronizes the file
+ * for all commits that arrived before the synchronization, the others wait
+ * for the end of the synchronization; each commit returns when its data is
+ * synchronized. Without the window the leader synchronizes the file at once
+ * and the commits that arrive during the synchronization share the next one.
+ * The group is placed in a shared memory, the waiting processes are parked
+ * on a futex (the other platforms use the polling).
+ * @attention if the leader doesn't finish the synchronization in time
+ * (OUROBOROS_LOCK_TIMEOUT), the commit synchronizes the file itself
+ */
+class commit_group
+{
+public:
+    inline commit_group();
+
+    template <typename File>
+    inline void commit(const File& file); ///< synchronize the data that is written to the file
+    inline void set_window(const uint32_t window); ///< set the window of the commits (us)
+    inline uint32_t window() const; ///< get the window of the commits (us)
+    inline void set_batch(const uint32_t batch); ///< set the maximum count of the commits in the window
+    inline uint32_t batch() const; ///< get the maximum count of the commits in the window
+    inline commit_stats stats() const; ///< get the statistics
+protected:
+    inline uint64_t synced() const; ///< get the number of the last synchronized commit
+    inline int32_t sequence() const; ///< get the sequence of the signals
+    inline void wait(const int32_t seq, const uint64_t timeout); ///< wait for the signal
+    inline void wake(); ///< wake up all the waiting processes
+    static inline uint64_t time_us(); ///< get the monotonic time (us)
+private:
+    volatile uint64_t m_written; ///< the number of the last commit
+    volatile uint64_t m_synced; ///< the number of the last synchronized commit
+    volatile int32_t m_leader; ///< the sign of the leader
+    volatile int32_t m_seq; ///< the sequence of the signals (the futex word)
+    volatile uint32_t m_window; ///< the window of the commits (us)
+    volatile uint32_t m_batch; ///< the maximum count of the commits in the window
+    volatile uint64_t m_commits; ///< the count of the commits
+    volatile uint64_t m_syncs; ///< the count of the synchronizations
+    volatile uint64_t m_max_batch; ///< the maximum count of the commits that shared one synchronization
+    volatile uint64_t m_wait_time; ///< the total time of the commits (us)
+};
+
+//==============================================================================
+//  commit_group
+//==============================================================================
+/**
+ * Constructor
+ */
+inline commit_group::commit_group() :
+    m_written(0),
+    m_synced(0),
+    m_leader(0),
+    m_seq(0),
+    m_window(OUROBOROS_COMMIT_WINDOW),
+    m_batch(OUROBOROS_COMMIT_BATCH),
+    m_commits(0),
+    m_syncs(0),
+    m_max_batch(0),
+    m_wait_time(0)
+{
+}
+
+/**
+ * Get the monotonic time
+ * @return the time (us)
+ */
+//static
+inline uint64_t commit_group::time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Get the number of the last synchronized commit
+ * @return the number of the commit
+ */
+inline uint64_t commit_group::synced() const
+{
+    const uint64_t result = m_synced;
+    __sync_synchronize();
+    return result;
+}
+
+/**
+ * Get the sequence of the signals
+ * @return the sequence of the signals
+ */
+inline int32_t commit_group::sequence() const
+{
+    const int32_t result = m_seq;
+    __sync_synchronize();
+    return result;
+}
+
+/**
+ * Wait for the signal
+ * @param seq the sequence of the signals that was before checking the condition
+ * @param timeout the timeout (us)
+ */
+inline void commit_group::wait(const int32_t seq, const uint64_t timeout)
+{
+#ifdef __linux__
+    struct timespec rest;
+    rest.tv_sec = timeout / 1000000;
+    rest.tv_nsec = (timeout % 1000000) * 1000;
+    syscall(SYS_futex, &m_seq, FUTEX_WAIT, seq, &rest, NULL, 0);
+#else
+    OUROBOROS_UNUSED(seq);
+    usleep(std::min<uint64_t>(timeout, 10));
+#endif
+}
+
+/**
+ * Wake up all the waiting processes
+ */
+inline void commit_group::wake()
+{
+    __sync_fetch_and_add(&m_seq, 1);
+#ifdef __linux__
+    syscall(SYS_futex, &m_seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+/**
+ * Synchronize the data that is written to the file, the data of the commit
+ * must be written before the call
+ * @param file the file (the method sync)
+ */
+template <typename File>
+inline void commit_group::commit(const File& file)
+{
+    const uint64_t beg = time_us();
+    // the number of the commit, all data of the commit is already written
+    const uint64_t number = __sync_add_and_fetch(&m_written, 1);
+    if (m_batch <= 1)
+    {
+        file.sync();
+        __sync_fetch_and_add(&m_syncs, 1);
+        __sync_fetch_and_add(&m_commits, 1);
+        __sync_fetch_and_add(&m_wait_time, time_us() - beg);
+        return;
+    }
+    if (number - synced() >= m_batch)
+    {
+        // the batch is full, so the leader doesn't wait for the window
+        wake();
+    }
+    const uint64_t timeout = uint64_t(OUROBOROS_LOCK_TIMEOUT) * 1000;
+    for (;;)
+    {
+        const int32_t seq = sequence();
+        if (synced() >= number)
+        {
+            break;
+        }
+        const uint64_t now = time_us();
+        if (__sync_bool_compare_and_swap(&m_leader, 0, 1))
+        {
+            if (synced() >= number)
+            {
+                // the previous leader has synchronized the commit
+                m_leader = 0;
+                break;
+            }
+            // the leader waits for the others
+            const uint64_t end = now + m_window;
+            for (uint64_t time = now; time < end; time = time_us())
+            {
+                const int32_t wseq = sequence();
+                if (m_written - synced() >= m_batch)
+                {
+                    break;
+                }
+                wait(wseq, end - time);
+            }
+            const uint64_t last = synced();
+            const uint64_t target = m_written;
+            __sync_synchronize();
+            try
+            {
+                file.sync();
+            }
+            catch (...)
+            {
+                // the next commit will be the leader
+                m_leader = 0;
+                wake();
+                throw;
+            }
+            __sync_fetch_and_add(&m_syncs, 1);
+            if (target - last > m_max_batch)
+            {
+                m_max_batch = target - last;
+            }
+            if (target > last)
+            {
+                m_synced = target;
+            }
+            __sync_synchronize();
+            m_leader = 0;
+            wake();
+        }
+        else if (now - beg >= timeout)
+        {
+            // the leader is lost, the next commit will be the leader
+            __sync_bool_compare_and_swap(&m_leader, 1, 0);
+            file.sync();
+            __sync_fetch_and_add(&m_syncs, 1);
+            break;
+        }
+        else
+        {
+            wait(seq, timeout - (now - beg));
+        }
+    }
+    __sync_fetch_and_add(&m_commits, 1);
+    __sync_fetch_and_add(&m_wait_time, time_us() - beg);
+}
+
+/**
+ * Set the window of the commits
+ * @param window the window (us)
+ */
+inline void commit_group::set_window(const uint32_t window)
+{
+    m_window = window;
+}
+
+/**
+ * Get the window of the commits
+ * @return the window (us)
+ */
+inline uint32_t commit_group::window() const
+{
+    return m_window;
+}
+
+/**
+ * Set the maximum count of the commits in the window, the leader doesn't
+ * wait for the end of the window if the batch is full
+ * @param batch the count of the commits (1 - each commit synchronizes the file itself)
+ */
+inline void commit_group::set_batch(const uint32_t batch)
+{
+    m_batch = batch;
+}
+
+/**
+ * Get the maximum count of the commits in the window
+ * @return the count of the commits
+ */
+inline uint32_t commit_group::batch() const
+{
+    return m_batch;
+}
+
+/**
+ * Get the statistics
+ * @return the statistics
+ */
+inline commit_stats commit_group::stats() const
+{
+    commit_stats result;
+    result.commits = m_commits;
+    result.syncs = m_syncs;
+    result.max_batch = m_max_batch;
+    result.wait_time = m_wait_time;
+    return result;
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_COMMITGROUP_H */
@@ -15,6 +15,7 @@
 #include "ouroboros/transaction.h"
 #include "ouroboros/lockedtable.h"
 #include "ouroboros/page.h"
+#include "ouroboros/commitgroup.h"
 
 namespace ouroboros
 {
@@ -60,6 +61,7 @@ public:
     typedef Interface interface_type; ///< the interface
     typedef typename interface_type::file_type file_type; ///< the file of the dataset
     typedef typename interface_type::file_page_type file_page_type; ///< the file page the dataset
+    typedef typename file_type::page_log_type page_log_type; ///< the log of the changed pages of the file
     typedef file_region<file_page_type> file_region_type; ///< the file region of the dataset
     typedef typename interface_type::template table_type<Record, Index, Key> table_type; ///< the table of data
     typedef typename interface_type::template key_table_type<skey_type, simple_key> key_table_type; ///< the table of keys
@@ -78,6 +80,13 @@ public:
     ~data_set();
     void open(const bool verify = true); ///< open the dataset
     inline const std::string& name() const; ///< get the name of the dataset
+    inline void set_cache_capacity(const count_type count); ///< change the count of the cache pages of the file
+    inline count_type cache_capacity() const; ///< get the count of the cache pages of the file
+    inline bool set_direct_io(const bool direct); ///< turn on/off the direct I/O of the file
+    inline void set_durability(const durability_level level); ///< set the level of the durability of the file
+    inline durability_level durability() const; ///< get the level of the durability of the file
+    inline void set_group_commit(const uint32_t window, const uint32_t batch); ///< set the parameters of the group commit
+    inline commit_stats group_commit_stats() const; ///< get the statistics of the group commit
 
     pos_type add_table(const key_type key); ///< add the table to the dataset
     count_type remove_table(const key_type key); ///< remove the table from the dataset
@@ -85,6 +94,8 @@ public:
 
     inline session_read session_rd(const key_type key); ///< open the session to read data from the table
     inline session_write session_wr(const key_type key); ///< open the session to write data to the table
+    template <typename Reader>
+    bool read_optimistic(const key_type key, Reader& reader); ///< read data from the table without locking if it's possible
     inline void start();  ///< start the transaction
     inline void stop();   ///< stop the transaction
     inline void cancel(); ///< cancel the transaction
@@ -141,6 +152,8 @@ protected:
     const std::string m_name; ///< the name of the dataset
     bool m_opened; ///< the sign that the dataset is open
     file_type m_file; ///< the file of the dataset
+    object<page_log_type, interface_type::template object_type> m_page_log; ///< the log of the changed pages of the file
+    object<commit_group, interface_type::template object_type> m_commit_group; ///< the group commit of the file
     info_type m_info; ///< the information about the dataset
     info_source_type m_info_source; ///< the source of the information
     object<skey_type, interface_type::template object_type> m_skey_info; ///< the key of the information table
@@ -227,6 +240,8 @@ data_set<Key, Record, Index, Interface>::data_set(const std::string& name) :
     m_name(name),
     m_opened(false),
     m_file(make_dbname(name).c_str()),
+    m_page_log(make_object_name(name, "pageLog")),
+    m_commit_group(make_object_name(name, "commitGroup")),
     m_info(0, 0),
     m_info_source(m_file, 1, 1),
     m_skey_info(make_object_name(m_info_source.name(), "info")),
@@ -242,6 +257,8 @@ data_set<Key, Record, Index, Interface>::data_set(const std::string& name) :
         skey_type::static_size(), 0)),
     m_gateway(make_object_name(name, "gateway"))
 {
+    m_file.set_page_log(m_page_log());
+    m_file.set_commit_group(m_commit_group());
     m_file_region.make_cache(m_info_source.size());
     m_info_source.set_file_region(m_file_region);
     m_key_source.set_file_region(m_file_region);
@@ -263,6 +280,8 @@ data_set<Key, Record, Index, Interface>::data_set(const std::string& name, const
     m_name(name),
     m_opened(false),
     m_file(make_dbname(name).c_str()),
+    m_page_log(make_object_name(name, "pageLog")),
+    m_commit_group(make_object_name(name, "commitGroup")),
     m_info(tbl_count, rec_count, 0, ver, user_data, user_size),
     m_info_source(m_file, 1, 1),
     m_skey_info(make_object_name(m_info_source.name(), "info")),
@@ -280,6 +299,16 @@ data_set<Key, Record, Index, Interface>::data_set(const std::string& name, const
     m_gateway(make_object_name(name, "gateway"))
 {
     OUROBOROS_DEBUG("create the dataset " << PR(name) << PR(tbl_count) << PE(rec_count));
+    // check the file of the dataset can be addressed by the positions
+    const uint64_t data_size = m_info_source.size() + (uint64_t(skey_type::static_size()) +
+        uint64_t(raw_record_type::static_size() + table_type::REC_SPACE) * rec_count) * tbl_count;
+    if ((data_size / file_page_type::DATA_SIZE + 1) * file_page_type::TOTAL_SIZE > std::numeric_limits<size_type>::max())
+    {
+        OUROBOROS_THROW_ERROR(range_error, PR(name) << PR(tbl_count) << PR(rec_count) <<
+            "the dataset is too big for the size of the positions (OUROBOROS_64BIT_OFFSETS)");
+    }
+    m_file.set_page_log(m_page_log());
+    m_file.set_commit_group(m_commit_group());
     m_info_source.set_file_region(m_file_region);
     m_key_source.set_file_region(m_file_region);
     m_source.set_file_region(m_file_region);
@@ -297,6 +326,11 @@ data_set<Key, Record, Index, Interface>::data_set(const std::string& name, const
     // check the current information about the dataset
     if (info.tbl_count > 0)
     {
+        // check the layout of the file
+        if (!info.compatible())
+        {
+            OUROBOROS_THROW_ERROR(compatibility_error, PR(m_name) << PR(info.pos_size()) << "the size of the positions is different, the dataset must be migrated");
+        }
         // check the count of the records in the tables
         if (m_info.rec_count != info.rec_count)
         {
@@ -440,6 +474,10 @@ void data_set<Key, Record, Index, Interface>::open(const bool verify)
     {
         OUROBOROS_THROW_BUG("error opening the dataset " << PE(m_name));
     }
+    if (!info.compatible())
+    {
+        OUROBOROS_THROW_ERROR(compatibility_error, PR(m_name) << PR(info.pos_size()) << "the size of the positions is different, the dataset must be migrated");
+    }
     // initialize the dataset
     m_info = info;
     m_file_region = make_file_regions<file_region_type>(m_info_source.size(),
@@ -465,6 +503,87 @@ inline const std::string& data_set<Key, Record, Index, Interface>::name() const
     return m_name;
 }
 
+/**
+ * Change the count of the cache pages of the file, the cache is released
+ * so it should be done before the dataset is used
+ * @param count the count of the cache pages
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline void data_set<Key, Record, Index, Interface>::set_cache_capacity(const count_type count)
+{
+    m_file.set_cache_capacity(count);
+}
+
+/**
+ * Get the count of the cache pages of the file
+ * @return the count of the cache pages
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline count_type data_set<Key, Record, Index, Interface>::cache_capacity() const
+{
+    return m_file.cache_capacity();
+}
+
+/**
+ * Turn on/off the direct I/O of the file, the pages of the file are cached
+ * only by the cache of the file (the size of the page must be a multiple of
+ * OUROBOROS_PAGE_ALIGNMENT)
+ * @param direct the sign of the direct I/O
+ * @return the direct I/O is turned on, false if the size of the page isn't
+ * a multiple of OUROBOROS_PAGE_ALIGNMENT
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline bool data_set<Key, Record, Index, Interface>::set_direct_io(const bool direct)
+{
+    return m_file.set_direct(direct);
+}
+
+/**
+ * Set the level of the durability of the file, the level is applied to
+ * the file of the dataset and to its backup files; the level is not shared
+ * by the processes
+ * @param level the level of the durability
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline void data_set<Key, Record, Index, Interface>::set_durability(const durability_level level)
+{
+    m_file.set_durability(level);
+}
+
+/**
+ * Get the level of the durability of the file
+ * @return the level of the durability
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline durability_level data_set<Key, Record, Index, Interface>::durability() const
+{
+    return m_file.durability();
+}
+
+/**
+ * Set the parameters of the group commit, the commits of the processes
+ * that arrive within the window share one synchronization of the file
+ * (DURABILITY_COMMIT and higher); the parameters are shared by all processes
+ * @param window the window of the commits (us)
+ * @param batch the maximum count of the commits in the window (1 - the group commit is disabled)
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline void data_set<Key, Record, Index, Interface>::set_group_commit(const uint32_t window, const uint32_t batch)
+{
+    m_commit_group().set_window(window);
+    m_commit_group().set_batch(batch);
+}
+
+/**
+ * Get the statistics of the group commit
+ * @return the statistics of the group commit
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+inline commit_stats data_set<Key, Record, Index, Interface>::group_commit_stats() const
+{
+    return m_commit_group().stats();
+}
+
 /**
  * Add the table to the dataset
  * @param key the key of the table
@@ -712,6 +831,96 @@ inline typename data_set<Key, Record, Index, Interface>::session_write
     return session_write(*this, key);
 }
 
+/**
+ * Read data from the table without locking if it's possible: the reader is
+ * called for the table without setting the interprocess locks, then the
+ * sequences of writing of the table and the dataset are validated, if they are
+ * changed then the read data is discarded and the reading is repeated; the
+ * sequences are also validated after the refreshing of the metadata of
+ * the table, so the reader doesn't get the torn metadata; after
+ * OUROBOROS_OPTIMISTIC_ATTEMPTS unsuccessful attempts the reader is called
+ * in the session for reading
+ * @attention the reader can be called several times and can get inconsistent
+ * data of the table, so the reader must only copy the data and must be ready
+ * to an exception
+ * @param key the key of the table
+ * @param reader the functor that gets the table (session_read::table_type&)
+ * @return the result of the reading (false if the table isn't found)
+ */
+template <typename Key, typename Record, template <typename> class Index, typename Interface>
+template <typename Reader>
+bool data_set<Key, Record, Index, Interface>::read_optimistic(const key_type key, Reader& reader)
+{
+    typedef typename session_read::table_type readable_table_type;
+    for (size_t i = 0; i < OUROBOROS_OPTIMISTIC_ATTEMPTS; ++i)
+    {
+        revision_type gseq;
+        if (!lazy_lock_type::read_begin(gseq))
+        {
+            break;
+        }
+        // the list of the tables can be used only if the table of the keys isn't changed
+        const typename table_list::iterator it = m_tables.find(key);
+        if (m_tables.end() == it || !static_cast<const unsafe_table_key&>(m_key_table).relevant())
+        {
+            break;
+        }
+        table_type& table = *it->second;
+        revision_type seq;
+        if (!table.lock_optimistic(seq))
+        {
+            break;
+        }
+        const bool primary = TR_STARTED != table.state();
+        bool consistent = false;
+        try
+        {
+            if (primary)
+            {
+                static_cast<unsafe_table&>(table).start();
+            }
+            table.refresh();
+            // the reader gets the table only if its metadata isn't torn
+            consistent = table.count() <= table.limit() && table.validate_optimistic(seq) &&
+                lazy_lock_type::read_validate(gseq);
+            if (consistent)
+            {
+                reader(static_cast<readable_table_type&>(table));
+            }
+            if (primary)
+            {
+                static_cast<unsafe_table&>(table).stop();
+            }
+        }
+        catch (...)
+        {
+            if (primary && TR_STARTED == table.state())
+            {
+                static_cast<unsafe_table&>(table).stop();
+            }
+            if (table.unlock_optimistic(seq) && lazy_lock_type::read_validate(gseq))
+            {
+                // the data is consistent, so the error isn't caused by writing
+                throw;
+            }
+            static_cast<unsafe_table&>(table).invalidate();
+            continue;
+        }
+        if (table.unlock_optimistic(seq) && lazy_lock_type::read_validate(gseq) && consistent)
+        {
+            return true;
+        }
+        static_cast<unsafe_table&>(table).invalidate();
+    }
+    session_read session(*this, key);
+    if (!session.valid())
+    {
+        return false;
+    }
+    reader(session.table());
+    return true;
+}
+
 /**
  * Start the transaction
  */
@@ -764,6 +973,7 @@ inline void data_set<Key, Record, Index, Interface>::stop()
         throw;
     }
     m_key_table.unlock_scoped();
+    m_file.sync_commit();
 }
 
 /**
@@ -787,6 +997,7 @@ inline void data_set<Key, Record, Index, Interface>::lazy_stop()
         throw;
     }
     m_key_table.unlock_sharable();
+    m_file.sync_commit();
 }
 
 /**
@@ -806,6 +1017,7 @@ inline void data_set<Key, Record, Index, Interface>::cancel()
         throw;
     }
     m_key_table.unlock_scoped();
+    m_file.sync_commit();
 }
 
 /**
@@ -829,6 +1041,7 @@ inline void data_set<Key, Record, Index, Interface>::lazy_cancel()
         throw;
     }
     m_key_table.unlock_sharable();
+    m_file.sync_commit();
 }
 
 /**
@@ -10,6 +10,8 @@
 #include <vector>
 
 #include "ouroboros/global.h"
+#include "ouroboros/aggregate.h"
+#include "ouroboros/find.h"
 #include "ouroboros/lockedtable.h"
 #include "ouroboros/record.h"
 #include "ouroboros/scoped_buffer.h"
@@ -100,7 +102,32 @@ public:
     pos_type find(Finder& finder, const pos_type beg, const count_type count) const; ///< find a record [beg, end)
     template <typename Finder>
     pos_type rfind(Finder& finder, const pos_type end, const count_type count) const; ///< reverse find a record [beg, end)
+    template <template <typename> class Index>
+    aggregate_result<typename Index<record_type>::field_type>
+        aggregate(const pos_type beg, const count_type count) const; ///< aggregate the field of the records [beg, beg + count)
+    template <template <typename> class Index, typename Comparator>
+    aggregate_result<typename Index<record_type>::field_type>
+        aggregate(const Comparator& comp, const pos_type beg, const count_type count) const; ///< aggregate the field of the records [beg, beg + count) that are matched by the comparator
+    template <template <typename> class Index>
+    pos_type lower_bound_by(const typename Index<record_type>::field_type& value) const; ///< find the first record which field isn't less than the value
+    template <template <typename> class Index>
+    pos_type upper_bound_by(const typename Index<record_type>::field_type& value) const; ///< find the first record which field is greater than the value
+    template <template <typename> class Index>
+    pos_type read_by(record_list& records, const typename Index<record_type>::field_type& from,
+        const typename Index<record_type>::field_type& to) const; ///< read the records which field is in the range [from, to]
 protected:
+    template <typename Finder>
+    inline pos_type do_find(Finder& finder, const pos_type beg, const count_type count,
+        packed_compare_tag) const; ///< find a record [beg, end) by the packed records
+    template <typename Finder>
+    inline pos_type do_find(Finder& finder, const pos_type beg, const count_type count,
+        unpacked_compare_tag) const; ///< find a record [beg, end) by the unpacked records
+    template <typename Finder>
+    inline pos_type do_rfind(Finder& finder, const pos_type end, const count_type count,
+        packed_compare_tag) const; ///< reverse find a record [beg, end) by the packed records
+    template <typename Finder>
+    inline pos_type do_rfind(Finder& finder, const pos_type end, const count_type count,
+        unpacked_compare_tag) const; ///< reverse find a record [beg, end) by the unpacked records
     template <typename T>
     inline pos_type do_read(record_type& record, const pos_type pos) const; ///< read a record
     template <typename T>
@@ -490,7 +517,10 @@ pos_type data_table<Table, Record, Key, Interface>::rfind(const record_type& rec
 }
 
 /**
- * Find a record in the range [beg, beg + count)
+ * Find a record in the range [beg, beg + count), if the finder has the packed
+ * category of comparing then the comparator is evaluated on the packed records
+ * of the blocks of the table and only the found records are unpacked,
+ * otherwise each record is unpacked and compared by the finder
  * @param finder the finder
  * @param beg the begin position of the records
  * @param count the count of the find records
@@ -502,26 +532,18 @@ template <typename Finder>
 pos_type data_table<Table, Record, Key, Interface>::find(Finder& finder, const pos_type beg, const count_type count) const
 {
     typename base_class::lock_read lock(*this);
-    if (!unsafe_table::empty())
+    if (!unsafe_table::empty() && count > 0)
     {
-        void *pbuffer = m_buffer.get();
-        pos_type pos = beg;
-        for (count_type i = 0; i < count; ++i)
-        {
-            const pos_type result = pos;
-            pos = unsafe_table::read(pbuffer, result);
-            finder.record(pos).unpack(pbuffer);
-            if (!finder())
-            {
-                return result;
-            }
-        }
+        return do_find(finder, beg, count, typename compare_traits<Finder>::compare_category());
     }
     return NIL;
 }
 
 /**
- * Reverse find a record in the range [end - count, end)
+ * Reverse find a record in the range [end - count, end), if the finder has
+ * the packed category of comparing then the comparator is evaluated on
+ * the packed records of the blocks of the table and only the found records
+ * are unpacked, otherwise each record is unpacked and compared by the finder
  * @param finder the finder of records
  * @param end the end position of the records
  * @param count the count of the find records
@@ -532,24 +554,202 @@ template <typename Finder>
 pos_type data_table<Table, Record, Key, Interface>::rfind(Finder& finder, const pos_type end, const count_type count) const
 {
     typename base_class::lock_read lock(*this);
-    if (!unsafe_table::empty())
+    if (!unsafe_table::empty() && count > 0)
     {
-        void *pbuffer = m_buffer.get();
-        pos_type pos = unsafe_table::dec_pos(end);
-        for (count_type i = 0; i < count; ++i)
+        return do_rfind(finder, end, count, typename compare_traits<Finder>::compare_category());
+    }
+    return NIL;
+}
+
+/**
+ * Find a record in the range [beg, beg + count) by the packed records
+ * @param finder the finder
+ * @param beg the begin position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <typename Finder>
+inline pos_type data_table<Table, Record, Key, Interface>::do_find(Finder& finder, const pos_type beg,
+    const count_type count, packed_compare_tag) const
+{
+    finder_scanner<unsafe_table, Finder> scanner(*this, finder,
+        unsafe_table::rec_size() + unsafe_table::rec_space(), beg);
+    return unsafe_table::scan(scanner, beg, count);
+}
+
+/**
+ * Find a record in the range [beg, beg + count) by the unpacked records
+ * @param finder the finder
+ * @param beg the begin position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <typename Finder>
+inline pos_type data_table<Table, Record, Key, Interface>::do_find(Finder& finder, const pos_type beg,
+    const count_type count, unpacked_compare_tag) const
+{
+    void *pbuffer = m_buffer.get();
+    pos_type pos = beg;
+    for (count_type i = 0; i < count; ++i)
+    {
+        const pos_type result = pos;
+        pos = unsafe_table::read(pbuffer, result);
+        finder.record(pos).unpack(pbuffer);
+        if (!finder())
+        {
+            return result;
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Reverse find a record in the range [end - count, end) by the packed records
+ * @param finder the finder of records
+ * @param end the end position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <typename Finder>
+inline pos_type data_table<Table, Record, Key, Interface>::do_rfind(Finder& finder, const pos_type end,
+    const count_type count, packed_compare_tag) const
+{
+    finder_scanner<unsafe_table, Finder> scanner(*this, finder,
+        unsafe_table::rec_size() + unsafe_table::rec_space(), end);
+    return unsafe_table::rscan(scanner, end, count);
+}
+
+/**
+ * Reverse find a record in the range [end - count, end) by the unpacked records
+ * @param finder the finder of records
+ * @param end the end position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <typename Finder>
+inline pos_type data_table<Table, Record, Key, Interface>::do_rfind(Finder& finder, const pos_type end,
+    const count_type count, unpacked_compare_tag) const
+{
+    void *pbuffer = m_buffer.get();
+    pos_type pos = unsafe_table::dec_pos(end);
+    for (count_type i = 0; i < count; ++i)
+    {
+        const pos_type result = pos;
+        pos = unsafe_table::rread(pbuffer, result);
+        finder.record(pos).unpack(pbuffer);
+        if (!finder())
         {
-            const pos_type result = pos;
-            pos = unsafe_table::rread(pbuffer, result);
-            finder.record(pos).unpack(pbuffer);
-            if (!finder())
-            {
-                return result;
-            }
+            return result;
         }
     }
     return NIL;
 }
 
+/**
+ * Aggregate the field of the records in the range [beg, beg + count),
+ * the records are read by the blocks and they are not unpacked
+ * @param beg the begin position of the records
+ * @param count the count of the records
+ * @return the aggregates of the field
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <template <typename> class Index>
+aggregate_result<typename Index<Record>::field_type>
+    data_table<Table, Record, Key, Interface>::aggregate(const pos_type beg, const count_type count) const
+{
+    return aggregate<Index>(comp_any<record_type>(), beg, count);
+}
+
+/**
+ * Aggregate the field of the records in the range [beg, beg + count) that are
+ * matched by the comparator of find.h, the comparator is evaluated on
+ * the packed records of the blocks
+ * @param comp the comparator
+ * @param beg the begin position of the records
+ * @param count the count of the records
+ * @return the aggregates of the field
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <template <typename> class Index, typename Comparator>
+aggregate_result<typename Index<Record>::field_type>
+    data_table<Table, Record, Key, Interface>::aggregate(const Comparator& comp, const pos_type beg, const count_type count) const
+{
+    typename base_class::lock_read lock(*this);
+    aggregate_scanner<Index<record_type>, Comparator> scanner(comp, unsafe_table::rec_size() + unsafe_table::rec_space());
+    if (!unsafe_table::empty() && count > 0)
+    {
+        unsafe_table::scan(scanner, beg, count);
+    }
+    return scanner.result();
+}
+
+/**
+ * Find the first record which field isn't less than the value by the binary
+ * search in the order of the records, the field must not decrease from
+ * the first record to the last one (e.g. the time of the added records)
+ * @param value the value of the field
+ * @return the position of the found record or the end position of the table
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <template <typename> class Index>
+pos_type data_table<Table, Record, Key, Interface>::lower_bound_by(const typename Index<record_type>::field_type& value) const
+{
+    typename base_class::lock_read lock(*this);
+    return unsafe_table::lower_bound(comp_less<record_type, Index>(value), unsafe_table::beg_pos(), unsafe_table::count());
+}
+
+/**
+ * Find the first record which field is greater than the value by the binary
+ * search in the order of the records, the field must not decrease from
+ * the first record to the last one
+ * @param value the value of the field
+ * @return the position of the found record or the end position of the table
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <template <typename> class Index>
+pos_type data_table<Table, Record, Key, Interface>::upper_bound_by(const typename Index<record_type>::field_type& value) const
+{
+    typename base_class::lock_read lock(*this);
+    return unsafe_table::lower_bound(comp_less_equal<record_type, Index>(value), unsafe_table::beg_pos(), unsafe_table::count());
+}
+
+/**
+ * Read the records which field is in the range [from, to], the bounds
+ * of the records are found by the binary search, the field must not
+ * decrease from the first record to the last one
+ * @param [out] records the records
+ * @param from the begin of the range
+ * @param to the end of the range (inclusive)
+ * @return the position of the record after the read records
+ */
+template <template <typename, typename, typename> class Table, typename Record, typename Key, typename Interface>
+template <template <typename> class Index>
+pos_type data_table<Table, Record, Key, Interface>::read_by(record_list& records,
+    const typename Index<record_type>::field_type& from, const typename Index<record_type>::field_type& to) const
+{
+    typename base_class::lock_read lock(*this);
+    records.clear();
+    const count_type skip = unsafe_table::do_lower_bound(comp_less<record_type, Index>(from),
+        unsafe_table::beg_pos(), unsafe_table::count());
+    const pos_type beg = unsafe_table::inc_pos(unsafe_table::beg_pos(), skip);
+    if (skip == unsafe_table::count() || to < from)
+    {
+        return beg;
+    }
+    const count_type count = unsafe_table::do_lower_bound(comp_less_equal<record_type, Index>(to),
+        beg, unsafe_table::count() - skip);
+    if (0 == count)
+    {
+        return beg;
+    }
+    records.resize(count);
+    return do_read<unsafe_table>(records, beg);
+}
+
 /**
  * Read a record
  * @param record data of the record
@@ -2,8 +2,16 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <algorithm>
+#include <vector>
 
 #include "ouroboros/file.h"
+#include "ouroboros/ioring.h"
+
+#ifdef OUROBOROS_FALLOCATE_ENABLED
+#include <linux/falloc.h>
+#endif
 
 #include <boost/filesystem/operations.hpp>
 
@@ -13,9 +21,26 @@
 namespace ouroboros
 {
 
+static file_stats s_stats; ///< the statistics of the system calls of the process
+
 //==============================================================================
 //  base_file
 //==============================================================================
+/**
+ * Get the statistics of the system calls of the files of the process
+ * @return the statistics
+ */
+//static
+file_stats base_file::stats()
+{
+    file_stats result;
+    result.reads = s_stats.reads;
+    result.writes = s_stats.writes;
+    result.syncs = s_stats.syncs;
+    result.submits = io_ring::submits();
+    return result;
+}
+
 /**
  * Remove a base_file by the name
  * @param name the name of the base_file
@@ -68,7 +93,10 @@ static int open_file(const std::string& name)
  */
 base_file::base_file(const std::string& name) :
     m_name(name),
-    m_fd(open_file(name))
+    m_fd(open_file(name)),
+    m_ring(NULL),
+    m_direct_fd(-1),
+    m_durability(DURABILITY_NONE)
 {
 }
 
@@ -78,6 +106,22 @@ base_file::base_file(const std::string& name) :
 //virtual
 base_file::~base_file()
 {
+    if (m_ring != NULL)
+    {
+        try
+        {
+            complete();
+        }
+        catch (std::exception& e)
+        {
+            OUROBOROS_ERROR("error of completion: " << PR(m_fd) << PR(m_name) << PE(e.what()));
+        }
+        delete m_ring;
+    }
+    if (m_direct_fd != -1)
+    {
+        close(m_direct_fd);
+    }
     size_t count = 0;
     while (close(m_fd) == -1)
     {
@@ -118,7 +162,9 @@ bool base_file::init()
 void base_file::do_read(void *buffer, size_type size, const pos_type pos) const
 {
     size_t count = 0;
-    ssize_t result = pread(m_fd, buffer, size, pos);
+    const int fd = select_fd(buffer, size, pos);
+    __sync_fetch_and_add(&s_stats.reads, 1);
+    ssize_t result = pread(fd, buffer, size, pos);
     while (result != static_cast<ssize_t>(size))
     {
         if (result != -1)
@@ -139,7 +185,8 @@ void base_file::do_read(void *buffer, size_type size, const pos_type pos) const
             }
         }
         usleep(OUROBOROS_IO_ERROR_DELAY);
-        result = pread(m_fd, buffer, size, pos);
+        __sync_fetch_and_add(&s_stats.reads, 1);
+        result = pread(fd, buffer, size, pos);
     }
 }
 
@@ -153,7 +200,9 @@ void base_file::do_read(void *buffer, size_type size, const pos_type pos) const
 void base_file::do_write(const void *buffer, size_type size, const pos_type pos)
 {
     size_t count = 0;
-    ssize_t result = pwrite(m_fd, buffer, size, pos);
+    const int fd = select_fd(buffer, size, pos);
+    __sync_fetch_and_add(&s_stats.writes, 1);
+    ssize_t result = pwrite(fd, buffer, size, pos);
     while (result != static_cast<ssize_t>(size))
     {
         if (result != -1)
@@ -174,7 +223,59 @@ void base_file::do_write(const void *buffer, size_type size, const pos_type pos)
             }
         }
         usleep(OUROBOROS_IO_ERROR_DELAY);
-        result = pwrite(m_fd, buffer, size, pos);
+        __sync_fetch_and_add(&s_stats.writes, 1);
+        result = pwrite(fd, buffer, size, pos);
+    }
+}
+
+/**
+ * Write the buffers of the adjacent data by one call
+ * @param iov the buffers
+ * @param count the count of the buffers
+ * @param pos the position of the data
+ */
+void base_file::do_writev(const struct iovec *iov, const int count, const pos_type pos)
+{
+    std::vector<struct iovec> rest(iov, iov + count);
+    size_t index = 0;
+    pos_type offset = pos;
+    size_t errors = 0;
+    while (index < rest.size())
+    {
+        const size_t first = index;
+        const int part = std::min<size_t>(rest.size() - index, IOV_MAX);
+        __sync_fetch_and_add(&s_stats.writes, 1);
+        ssize_t result = pwritev(select_fdv(&rest[index], part, offset), &rest[index], part, offset);
+        if (-1 == result)
+        {
+            const int err = errno;
+            if (err != EINTR && ++errors >= OUROBOROS_IO_ERROR_MAX)
+            {
+                OUROBOROS_THROW_ERROR(io_error, "error of writing: " <<
+                    PR(m_fd) << PR(m_name) << PR(count) << PR(offset) << PR(result) << PE(err));
+            }
+            usleep(OUROBOROS_IO_ERROR_DELAY);
+            continue;
+        }
+        offset += result;
+        // skip the written buffers
+        while (index < rest.size() && size_t(result) >= rest[index].iov_len)
+        {
+            result -= rest[index].iov_len;
+            ++index;
+        }
+        if (index < first + part)
+        {
+            // the rest of the partial buffer is written again
+            rest[index].iov_base = static_cast<char *>(rest[index].iov_base) + result;
+            rest[index].iov_len -= result;
+            if (++errors >= OUROBOROS_IO_ERROR_MAX)
+            {
+                OUROBOROS_THROW_ERROR(io_error, "error of writing: " <<
+                    PR(m_fd) << PR(m_name) << PR(count) << PR(offset) << PE(result));
+            }
+            usleep(OUROBOROS_IO_ERROR_DELAY);
+        }
     }
 }
 
@@ -201,32 +302,89 @@ void base_file::write(const void *buffer, size_type size, const offset_type pos)
 }
 
 /**
- * Change the size of the base_file
+ * Write the buffers of the adjacent data
+ * @param iov the buffers
+ * @param count the count of the buffers
+ * @param pos the position of the data
+ */
+void base_file::writev(const struct iovec *iov, const int count, const pos_type pos)
+{
+    do_writev(iov, count, pos);
+}
+
+/**
+ * Change the size of the base_file, the growth is preallocated by
+ * the zeroed blocks if the file system supports it, otherwise the file
+ * becomes sparse (or the growth is filled by zeros with
+ * OUROBOROS_SECURE_FILE_SIZEUP)
  * @param size the size of the base_file
  */
 //virtual
 size_type base_file::do_resize(const size_type size)
 {
-#ifdef OUROBOROS_SECURE_FILE_SIZEUP
     const size_type current_size = base_file::do_size();
+    if (size <= current_size || !allocate(current_size, size - current_size))
+    {
+        if (ftruncate(m_fd, size) == -1)
+        {
+            OUROBOROS_THROW_ERROR(io_error, "error of changing size: " <<
+                PR(m_fd) << PR(m_name) << PR(size) << PE(errno));
+        }
+#ifdef OUROBOROS_SECURE_FILE_SIZEUP
+        if (current_size < size)
+        {
+            std::vector<char> buffer(std::min(static_cast<size_type>(OUROBOROS_ZERO_BLOCK), size - current_size), 0);
+            for (pos_type pos = current_size; pos < size; pos += buffer.size())
+            {
+                const size_type count = std::min(static_cast<size_type>(buffer.size()), size - pos);
+                base_file::do_write(&buffer[0], count, pos);
+            }
+        }
 #endif
-    if (ftruncate(m_fd, size) == -1)
+    }
+    if (DURABILITY_FULL == m_durability)
     {
-        OUROBOROS_THROW_ERROR(io_error, "error of changing size: " << 
-            PR(m_fd) << PR(m_name) << PR(size) << PE(errno));
+        sync_entry();
     }
-#ifdef OUROBOROS_SECURE_FILE_SIZEUP
-    if (current_size < size)
+    return size;
+}
+
+/**
+ * Allocate the zeroed blocks of the range of the file, the file is sized up
+ * if the range is beyond the end of the file; the blocks are not written,
+ * they are read as zeros (FALLOC_FL_ZERO_RANGE or the plain allocation if
+ * the file system doesn't support the zeroing of the range)
+ * @param pos the position of the range
+ * @param size the size of the range
+ * @return false if the file system doesn't support the preallocation
+ */
+bool base_file::allocate(const pos_type pos, const size_type size)
+{
+#ifdef OUROBOROS_FALLOCATE_ENABLED
+    int mode = FALLOC_FL_ZERO_RANGE;
+    while (fallocate(m_fd, mode, pos, size) == -1)
     {
-        char buffer[OUROBOROS_PAGE_SIZE] = { 0 };
-        for (pos_type pos = current_size; pos < size; pos += OUROBOROS_PAGE_SIZE)
+        const int err = errno;
+        if (EOPNOTSUPP == err || ENOSYS == err || EINVAL == err)
+        {
+            if (0 == mode)
+            {
+                return false;
+            }
+            mode = 0;
+        }
+        else if (err != EINTR)
         {
-            const size_type count = std::min(static_cast<size_type>(OUROBOROS_PAGE_SIZE), size - pos);
-            base_file::do_write(buffer, count, pos);
+            OUROBOROS_THROW_ERROR(io_error, "error of allocation: " <<
+                PR(m_fd) << PR(m_name) << PR(pos) << PR(size) << PE(err));
         }
     }
+    return true;
+#else
+    OUROBOROS_UNUSED(pos);
+    OUROBOROS_UNUSED(size);
+    return false;
 #endif
-    return size;
 }
 
 /**
@@ -308,11 +466,61 @@ void base_file::refresh(size_type size, const pos_type pos)
 }
 
 /**
- * Forced synchronization data of the base_file
+ * Read data ahead, the system is advised to read the data into the page cache
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+//virtual
+void base_file::do_prefetch(size_type size, const pos_type pos) const
+{
+    advise(size, pos, POSIX_FADV_WILLNEED);
+}
+
+/**
+ * Read data ahead
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+void base_file::prefetch(size_type size, const pos_type pos) const
+{
+    do_prefetch(size, pos);
+}
+
+/**
+ * Give the advice about the access to data, the advice is only a hint
+ * therefore the errors are ignored
+ * @param size the size of the data (0 - up to the end of the file)
+ * @param pos the position of the data
+ * @param advice the advice (POSIX_FADV_*)
+ */
+void base_file::advise(size_type size, const pos_type pos, const int advice) const
+{
+    posix_fadvise(m_fd, pos, size, advice);
+}
+
+/**
+ * Forced synchronization data of the base_file, if the asynchronous requests
+ * are not completed the synchronization is submitted after them and
+ * the method waits for the end of all requests
  */
 void base_file::sync() const
+{
+    if (m_ring != NULL && m_ring->pending() > 0)
+    {
+        submit_request(io_request());
+        complete();
+        return;
+    }
+    do_sync();
+}
+
+/**
+ * Synchronize data of the file by the system call
+ */
+void base_file::do_sync() const
 {
     size_t count = 0;
+    __sync_fetch_and_add(&s_stats.syncs, 1);
     while (fdatasync(m_fd) != 0)
     {
         const int err = errno;
@@ -324,6 +532,353 @@ void base_file::sync() const
     }
 }
 
+/**
+ * Get the ring of the asynchronous requests, the ring is created by
+ * the first request; the child process creates the own ring
+ * @return the ring or NULL if the asynchronous requests are not supported
+ */
+io_ring* base_file::ring() const
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    if (m_ring != NULL && m_ring->owner() != getpid())
+    {
+        // the requests of the parent process are not waited
+        delete m_ring;
+        m_ring = NULL;
+    }
+    if (NULL == m_ring)
+    {
+        m_ring = new io_ring(OUROBOROS_IO_RING_SIZE);
+    }
+    return m_ring->valid() ? m_ring : NULL;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * Add the asynchronous request, if the ring is full the previous requests
+ * are waited; without the ring the request is executed at once
+ * @param request the request
+ */
+void base_file::submit_request(const io_request& request) const
+{
+    io_ring *ring = this->ring();
+    // the synchronization is started after the end of the previous requests
+    const bool drain = IO_SYNC == request.type;
+    const int fd = select_fd(request);
+    if (ring != NULL && !ring->add(fd, request, drain))
+    {
+        // the ring is full
+        complete();
+        ring = this->ring();
+        if (ring != NULL && !ring->add(fd, request, drain))
+        {
+            ring = NULL;
+        }
+    }
+    if (NULL == ring)
+    {
+        complete();
+        execute(request);
+        return;
+    }
+    switch (request.type)
+    {
+        case IO_READ:
+            __sync_fetch_and_add(&s_stats.reads, 1);
+            break;
+        case IO_SYNC:
+            __sync_fetch_and_add(&s_stats.syncs, 1);
+            break;
+        default:
+            __sync_fetch_and_add(&s_stats.writes, 1);
+            break;
+    }
+}
+
+/**
+ * Execute the request by the synchronous calls
+ * @param request the request
+ */
+void base_file::execute(const io_request& request) const
+{
+    // the requests of writing are added only by the non-constant methods
+    base_file *file = const_cast<base_file *>(this);
+    switch (request.type)
+    {
+        case IO_READ:
+            base_file::do_read(request.buffer, request.size, request.pos);
+            break;
+        case IO_WRITE:
+            file->base_file::do_write(request.buffer, request.size, request.pos);
+            break;
+        case IO_WRITEV:
+            if (!request.iov.empty())
+            {
+                file->do_writev(&request.iov[0], request.iov.size(), request.pos);
+            }
+            break;
+        case IO_SYNC:
+            do_sync();
+            break;
+    }
+}
+
+/**
+ * Wait for the end of the asynchronous requests, the rest of the requests
+ * that are not completed by the ring is executed by the synchronous calls;
+ * if the requests contained the synchronization, the data of the rest of
+ * the writes is synchronized again after them
+ */
+void base_file::complete() const
+{
+    if (NULL == m_ring || 0 == m_ring->pending() || m_ring->owner() != getpid())
+    {
+        return;
+    }
+    std::vector<io_request> unfinished;
+    const bool synced = m_ring->wait(unfinished);
+    bool written = false;
+    for (size_t i = 0; i < unfinished.size(); ++i)
+    {
+        execute(unfinished[i]);
+        written = written || IO_WRITE == unfinished[i].type || IO_WRITEV == unfinished[i].type;
+    }
+    if (synced && written)
+    {
+        do_sync();
+    }
+}
+
+/**
+ * Read data asynchronously, the data is in the buffer after the end of
+ * the requests (method complete)
+ * @param buffer the buffer of the data
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+void base_file::submit_read(void *buffer, size_type size, const pos_type pos)
+{
+    io_request request;
+    request.type = IO_READ;
+    request.buffer = buffer;
+    request.size = size;
+    request.pos = pos;
+    submit_request(request);
+}
+
+/**
+ * Write data asynchronously, the buffer must be valid until the end of
+ * the requests (method complete)
+ * @param buffer the buffer of the data
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+void base_file::submit_write(const void *buffer, size_type size, const pos_type pos)
+{
+    io_request request;
+    request.type = IO_WRITE;
+    request.buffer = const_cast<void *>(buffer);
+    request.size = size;
+    request.pos = pos;
+    submit_request(request);
+}
+
+/**
+ * Write the buffers of the adjacent data asynchronously, the buffers must be
+ * valid until the end of the requests (method complete)
+ * @param iov the buffers
+ * @param count the count of the buffers
+ * @param pos the position of the data
+ */
+void base_file::submit_writev(const struct iovec *iov, const int count, const pos_type pos)
+{
+    io_request request;
+    request.type = IO_WRITEV;
+    request.iov.assign(iov, iov + count);
+    request.pos = pos;
+    submit_request(request);
+}
+
+/**
+ * Turn on/off the direct I/O, the file is opened once more with O_DIRECT;
+ * the data whose buffer, size and position are aligned by
+ * OUROBOROS_PAGE_ALIGNMENT is read and written bypassing the page cache of
+ * the system, the other data uses the page cache (Linux keeps both ways
+ * coherent)
+ * @param direct the sign of the direct I/O
+ * @return the direct I/O is turned on (the file system may not support it)
+ */
+bool base_file::set_direct(const bool direct)
+{
+    complete();
+    if (m_direct_fd != -1)
+    {
+        close(m_direct_fd);
+        m_direct_fd = -1;
+    }
+#ifdef O_DIRECT
+    if (direct)
+    {
+        m_direct_fd = open(m_name.c_str(), O_RDWR | O_DIRECT);
+        if (-1 == m_direct_fd)
+        {
+            OUROBOROS_DEBUG("the direct I/O is not supported: " << PR(m_name) << PE(errno));
+        }
+    }
+#else
+    OUROBOROS_UNUSED(direct);
+#endif
+    return m_direct_fd != -1;
+}
+
+/**
+ * Check the direct I/O is turned on
+ * @return the result of the checking
+ */
+bool base_file::direct() const
+{
+    return m_direct_fd != -1;
+}
+
+/**
+ * Set the level of the durability
+ * @param level the level of the durability
+ */
+void base_file::set_durability(const durability_level level)
+{
+    do_set_durability(level);
+}
+
+/**
+ * Set the level of the durability, the full level synchronizes the entry of
+ * the created file at once
+ * @param level the level of the durability
+ */
+//virtual
+void base_file::do_set_durability(const durability_level level)
+{
+    m_durability = level;
+    if (DURABILITY_FULL == level)
+    {
+        sync_entry();
+    }
+}
+
+/**
+ * Get the level of the durability
+ * @return the level of the durability
+ */
+durability_level base_file::durability() const
+{
+    return m_durability;
+}
+
+/**
+ * Forced synchronization of the metadata and the directory entry of the file,
+ * so the created or resized file is found with its size after the crash of
+ * the system
+ */
+void base_file::sync_entry() const
+{
+    complete();
+    size_t count = 0;
+    __sync_fetch_and_add(&s_stats.syncs, 1);
+    while (fsync(m_fd) != 0)
+    {
+        const int err = errno;
+        if (err != EINTR && ++count >= OUROBOROS_IO_ERROR_MAX)
+        {
+            OUROBOROS_THROW_ERROR(io_error, "error of synchronization: " << PR(m_fd) << PR(m_name) << PE(err));
+        }
+        usleep(OUROBOROS_IO_ERROR_DELAY);
+    }
+    const std::string::size_type slash = m_name.rfind('/');
+    const std::string dir = std::string::npos == slash ? std::string(".") :
+        (0 == slash ? std::string("/") : m_name.substr(0, slash));
+    const int dir_fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (-1 == dir_fd)
+    {
+        OUROBOROS_THROW_ERROR(io_error, "error of opening the directory: " << PR(dir) << PR(m_name) << PE(errno));
+    }
+    count = 0;
+    __sync_fetch_and_add(&s_stats.syncs, 1);
+    while (fsync(dir_fd) != 0)
+    {
+        const int err = errno;
+        if (err != EINTR && ++count >= OUROBOROS_IO_ERROR_MAX)
+        {
+            close(dir_fd);
+            OUROBOROS_THROW_ERROR(io_error, "error of synchronization of the directory: " <<
+                PR(dir) << PR(m_name) << PE(err));
+        }
+        usleep(OUROBOROS_IO_ERROR_DELAY);
+    }
+    close(dir_fd);
+}
+
+/**
+ * Get the file descriptor for the data, the aligned data is read and
+ * written by the direct I/O
+ * @param buffer the buffer of the data
+ * @param size the size of the data
+ * @param pos the position of the data
+ * @return the file descriptor
+ */
+int base_file::select_fd(const void *buffer, const size_type size, const pos_type pos) const
+{
+    const size_t mask = OUROBOROS_PAGE_ALIGNMENT - 1;
+    if (-1 == m_direct_fd || (reinterpret_cast<size_t>(buffer) & mask) != 0 ||
+        (size & mask) != 0 || (pos & mask) != 0)
+    {
+        return m_fd;
+    }
+    return m_direct_fd;
+}
+
+/**
+ * Get the file descriptor for the buffers of the adjacent data
+ * @param iov the buffers
+ * @param count the count of the buffers
+ * @param pos the position of the data
+ * @return the file descriptor
+ */
+int base_file::select_fdv(const struct iovec *iov, const int count, const pos_type pos) const
+{
+    if (-1 == m_direct_fd)
+    {
+        return m_fd;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        if (select_fd(iov[i].iov_base, iov[i].iov_len, pos) != m_direct_fd)
+        {
+            return m_fd;
+        }
+    }
+    return m_direct_fd;
+}
+
+/**
+ * Get the file descriptor for the asynchronous request
+ * @param request the request
+ * @return the file descriptor
+ */
+int base_file::select_fd(const io_request& request) const
+{
+    switch (request.type)
+    {
+        case IO_READ:
+        case IO_WRITE:
+            return select_fd(request.buffer, request.size, request.pos);
+        case IO_WRITEV:
+            return request.iov.empty() ? m_fd : select_fdv(&request.iov[0], request.iov.size(), request.pos);
+        default:
+            return m_fd;
+    }
+}
+
 /**
  * Get the base_file descriptor
  * @return the base_file descriptor
@@ -357,6 +912,14 @@ void base_file::cancel()
     OUROBOROS_THROW_BUG("method not supported");
 }
 
+/**
+ * Synchronize the data of the stopped transaction
+ */
+void base_file::sync_commit()
+{
+//    OUROBOROS_THROW_BUG("method not supported");
+}
+
 /**
  * Get the state of the transaction
  * @return the state of the transaction
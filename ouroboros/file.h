@@ -6,6 +6,8 @@
 #ifndef OUROBOROS_FILE_H
 #define OUROBOROS_FILE_H
 
+#include <stdint.h>
+#include <sys/uio.h>
 #include <string>
 
 #include "ouroboros/global.h"
@@ -23,6 +25,41 @@ enum transaction_state
     TR_UNKNOWN      ///< the transaction has unknown state
 };
 
+/** The level of the durability of the data of a file */
+enum durability_level
+{
+    DURABILITY_NONE,    ///< the data is not synchronized, the system writes it back by itself
+    DURABILITY_COMMIT,  ///< the data is synchronized only by the commit of the transaction
+    DURABILITY_SYNC,    ///< the copies of the pages are synchronized before the pages get into the file too
+    DURABILITY_FULL     ///< the directory entries are synchronized after the creating and the resizing of the files too
+};
+
+#ifndef OUROBOROS_DURABILITY
+#ifdef OUROBOROS_SYNC_ENABLED
+#define OUROBOROS_DURABILITY DURABILITY_SYNC ///< the default level of the durability of the files
+#else
+#define OUROBOROS_DURABILITY DURABILITY_NONE ///< the default level of the durability of the files
+#endif
+#endif
+
+/** the statistics of the system calls of the files of the process */
+struct file_stats
+{
+    file_stats() :
+        reads(0),
+        writes(0),
+        syncs(0),
+        submits(0)
+    {}
+    uint64_t reads;     ///< the count of the calls of reading (and the asynchronous reads)
+    uint64_t writes;    ///< the count of the calls of writing (and the asynchronous writes)
+    uint64_t syncs;     ///< the count of the synchronizations
+    uint64_t submits;   ///< the count of the submissions of the asynchronous requests
+};
+
+class io_ring;
+struct io_request;
+
 /**
  * The base file
  */
@@ -43,30 +80,59 @@ public:
     bool init(); ///< ititialize
     void read(void *buffer, size_type size, const pos_type pos) const; ///< read data
     void write(const void *buffer, size_type size, const pos_type pos); ///< write data
+    void writev(const struct iovec *iov, const int count, const pos_type pos); ///< write the buffers of the adjacent data
     size_type resize(const size_type size); ///< change the size of the file
     size_type sizeup(const size_type size); ///< size up the file
     size_type size() const; ///< get the size of the file
     void refresh(size_type size, const pos_type pos); ///< refresh data
+    void prefetch(size_type size, const pos_type pos) const; ///< read data ahead
+    void advise(size_type size, const pos_type pos, const int advice) const; ///< give the advice about the access to data
     void sync() const; ///< forced synchronization data of the file
 
+    void submit_read(void *buffer, size_type size, const pos_type pos); ///< read data asynchronously
+    void submit_write(const void *buffer, size_type size, const pos_type pos); ///< write data asynchronously
+    void submit_writev(const struct iovec *iov, const int count, const pos_type pos); ///< write the buffers of the adjacent data asynchronously
+    void complete() const; ///< wait for the end of the asynchronous requests
+    bool set_direct(const bool direct); ///< turn on/off the direct I/O
+    bool direct() const; ///< check the direct I/O is turned on
+    void set_durability(const durability_level level); ///< set the level of the durability
+    durability_level durability() const; ///< get the level of the durability
+    void sync_entry() const; ///< forced synchronization of the metadata and the directory entry of the file
+
     void start();  ///< start the transaction
     void stop();   ///< stop the transaction
     void cancel(); ///< cancel the transaction
+    void sync_commit(); ///< synchronize the data of the stopped transaction
     transaction_state state() const; ///< get the state of the transaction
 
     static void remove(const std::string& name); ///< remove a file by the name
     static void copy(const std::string& source, const std::string& dest); ///< copy a file
+    static file_stats stats(); ///< get the statistics of the system calls
 protected:
     virtual void do_read(void *buffer, size_type size, const pos_type pos) const; ///< read data
     virtual void do_write(const void *buffer, size_type size, const pos_type pos); ///< write data
+    void do_writev(const struct iovec *iov, const int count, const pos_type pos); ///< write the buffers of the adjacent data
     virtual size_type do_resize(const size_type size); ///< change the size of the file
+    bool allocate(const pos_type pos, const size_type size); ///< allocate the zeroed blocks of the file
     virtual size_type do_sizeup(const size_type size); ///< size up the file
     virtual size_type do_size() const; ///< get the size of the file
     virtual void do_refresh(size_type size, const pos_type pos); ///< refresh data
+    virtual void do_prefetch(size_type size, const pos_type pos) const; ///< read data ahead
+    virtual void do_set_durability(const durability_level level); ///< set the level of the durability
     int fd() const; ///< get the file descriptor
+    io_ring* ring() const; ///< get the ring of the asynchronous requests
+    void submit_request(const io_request& request) const; ///< add the asynchronous request
+    void execute(const io_request& request) const; ///< execute the request by the synchronous calls
+    void do_sync() const; ///< synchronize data of the file by the system call
+    int select_fd(const void *buffer, const size_type size, const pos_type pos) const; ///< get the descriptor for the data
+    int select_fdv(const struct iovec *iov, const int count, const pos_type pos) const; ///< get the descriptor for the buffers
+    int select_fd(const io_request& request) const; ///< get the descriptor for the request
 private:
     const std::string m_name; ///< the file name
     const int m_fd; ///< the file descriptor
+    mutable io_ring *m_ring; ///< the ring of the asynchronous requests (it is created by the first request)
+    int m_direct_fd; ///< the file descriptor of the direct I/O (-1 if the direct I/O is turned off)
+    durability_level m_durability; ///< the level of the durability
 };
 
 /**
@@ -84,9 +150,11 @@ public:
     void set_region(const file_region_type& region); ///< the region of the file
     void read(void *buffer, size_type size, const pos_type pos) const; ///< read data
     void write(const void *buffer, size_type size, const pos_type pos); ///< write data
+    void writev(const struct iovec *iov, const int count, const pos_type pos); ///< write the buffers of the adjacent data
     size_type resize(const size_type size); ///< change the size of the file
     size_type sizeup(const size_type size); ///< size up the file
     void refresh(size_type size, const pos_type pos); ///< refresh data
+    void prefetch(size_type size, const pos_type pos) const; ///< read data ahead
 protected:
     inline offset_type convert_offset(const offset_type raw_offset) const; ///< convert the raw offset to the real offset in the file
     inline size_type convert_size(const offset_type raw_size) const; ///< convert the raw size to the real size in the file
@@ -174,6 +242,18 @@ void file<FilePage>::write(const void *buffer, size_type size, const pos_type po
     base_file::write(buffer, size, convert_offset(pos));
 }
 
+/**
+ * Write the buffers of the adjacent data
+ * @param iov the buffers
+ * @param count the count of the buffers
+ * @param pos the position of the data
+ */
+template <typename FilePage>
+void file<FilePage>::writev(const struct iovec *iov, const int count, const pos_type pos)
+{
+    base_file::writev(iov, count, convert_offset(pos));
+}
+
 /**
  * Change the size of the base_file
  * @param size the size of the base_file
@@ -208,6 +288,19 @@ void file<FilePage>::refresh(size_type size, const pos_type pos)
     do_refresh(real_size, convert_offset(pos));
 }
 
+/**
+ * Read data ahead
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+template <typename FilePage>
+void file<FilePage>::prefetch(size_type size, const pos_type pos) const
+{
+    const offset_type offset = convert_offset(pos);
+    const offset_type real_size = convert_offset(pos + size) - offset;
+    base_file::prefetch(real_size, offset);
+}
+
 }   //namespace ouroboros
 
 #endif  /* OUROBOROS_FILE_H */
@@ -6,12 +6,62 @@
 #ifndef OUROBOROS_FIND_H
 #define	OUROBOROS_FIND_H
 
+#include <stdint.h>
+#include <algorithm>
+
 #include "ouroboros/record.h"
 #include "ouroboros/container.h"
 
 namespace ouroboros
 {
 
+/** The tag of the comparator that compares only the unpacked records */
+struct unpacked_compare_tag {};
+/** The tag of the comparator that also compares the packed records by operator ()(const void *data) */
+struct packed_compare_tag {};
+
+/**
+ * The traits of the comparator or the finder: the category of comparing is
+ * the type compare_category of it, or unpacked_compare_tag if the type isn't
+ * defined, so the comparator that doesn't have the packed form is evaluated
+ * on the unpacked records
+ */
+template <typename T, typename Category = void>
+struct compare_traits
+{
+    typedef unpacked_compare_tag compare_category;
+};
+
+/** The helper that maps the type to void */
+template <typename T>
+struct compare_void
+{
+    typedef void type;
+};
+
+/**
+ * The traits of the comparator or the finder that defines the category of comparing
+ */
+template <typename T>
+struct compare_traits<T, typename compare_void<typename T::compare_category>::type>
+{
+    typedef typename T::compare_category compare_category;
+};
+
+/** The category of comparing of two comparators, the packed records are compared if both can */
+template <typename Category1, typename Category2>
+struct compare_both
+{
+    typedef unpacked_compare_tag compare_category;
+};
+
+/** The category of comparing of two comparators that can compare the packed records */
+template <>
+struct compare_both<packed_compare_tag, packed_compare_tag>
+{
+    typedef packed_compare_tag compare_category;
+};
+
 /**
  * The class for comparing a field with a value
  */
@@ -23,9 +73,11 @@ public:
     typedef Index<record_type> index_type;
     typedef typename index_type::field_type field_type;
     typedef Operator<field_type> operator_type;
+    typedef packed_compare_tag compare_category;
 
     explicit value_comparator(const field_type& field);
     inline bool operator ()(const record_type& record) const;
+    inline bool operator ()(const void *data) const;
 private:
     value_comparator();
     field_type m_field;
@@ -44,8 +96,10 @@ struct fields_comparator
     typedef typename index1_type::field_type field1_type;
     typedef typename index2_type::field_type field2_type;
     typedef Operator<field1_type> operator_type;
+    typedef packed_compare_tag compare_category;
 
     inline bool operator ()(const record_type& record) const;
+    inline bool operator ()(const void *data) const;
 };
 
 /**
@@ -59,9 +113,12 @@ public:
     typedef Comparator1 comparator1_type;
     typedef Comparator2 comparator2_type;
     typedef typename comparator1_type::record_type record_type;
+    typedef typename compare_both<typename compare_traits<comparator1_type>::compare_category,
+        typename compare_traits<comparator2_type>::compare_category>::compare_category compare_category;
 
     combiner(const comparator1_type& comp1, const comparator2_type& comp2);
     inline bool operator ()(const record_type& record) const;
+    inline bool operator ()(const void *data) const;
 private:
     const comparator1_type m_comp1;
     const comparator2_type m_comp2;
@@ -77,14 +134,17 @@ public:
     typedef Comparator comparator_type;
     typedef typename comparator_type::record_type record_type;
     typedef typename Container<record_type>::vector_type result_type;
+    typedef typename compare_traits<comparator_type>::compare_category compare_category;
 
     explicit finder(const comparator_type& comp);
     finder(const comparator_type& comp, const count_type count);
 
     inline bool operator()(); ///< compare
+    inline bool found(); ///< add the record that is already found
     inline record_type& record(const pos_type pos); ///< get the buffer of a record
     inline const result_type& result() const; ///< get the search result
     inline pos_type pos() const; ///< get the position of the last processed record
+    inline const comparator_type& comparator() const; ///< get the comparator
     void reset(const count_type count = 0); ///< reset to the first state
 protected:
     inline bool push(const record_type& record); ///< push a found record
@@ -96,6 +156,59 @@ protected:
     pos_type m_pos; ///< the position of the last processed record
 };
 
+/**
+ * The kernel of the searching that evaluates the comparator on the packed
+ * records: the fields are read at the static offsets, so the records are
+ * not unpacked. The records are compared by the groups of GROUP_SIZE records
+ * without branches, so the compiler can vectorize the comparing if the type
+ * of the fields allows it.
+ */
+template <typename Comparator>
+class find_kernel
+{
+public:
+    typedef Comparator comparator_type;
+    enum { GROUP_SIZE = 32 };
+
+    find_kernel(const comparator_type& comp, const size_type stride);
+
+    inline uint32_t match(const char *data, const count_type count) const; ///< get the mask of the found records of the group
+    inline pos_type find(const char *data, const count_type count) const; ///< find the first record
+    inline pos_type rfind(const char *data, const count_type count) const; ///< find the last record
+private:
+    find_kernel();
+private:
+    const comparator_type m_comp; ///< the comparator
+    const size_type m_stride; ///< the distance between the records
+};
+
+/**
+ * The scanner of the blocks of the packed records for the finder: the records
+ * are selected by the kernel and only the found records are unpacked and
+ * passed to the finder by found() without comparing again
+ */
+template <typename Table, typename Finder>
+class finder_scanner
+{
+public:
+    typedef Table table_type;
+    typedef Finder finder_type;
+    typedef find_kernel<typename finder_type::comparator_type> kernel_type;
+
+    finder_scanner(const table_type& table, finder_type& finder, const size_type stride, const pos_type pos);
+
+    pos_type find(const char *data, const count_type count); ///< pass the found records of the block to the finder
+    pos_type rfind(const char *data, const count_type count); ///< pass the found records of the block to the finder in the reverse order
+private:
+    finder_scanner();
+private:
+    const table_type& m_table; ///< the table
+    finder_type& m_finder; ///< the finder
+    const kernel_type m_kernel; ///< the kernel of the searching
+    const size_type m_stride; ///< the distance between the records
+    pos_type m_pos; ///< the position of the first record of the next block (the end position of the block for the reverse order)
+};
+
 /**
  * Comparator (field == val)
  */
@@ -303,6 +416,18 @@ inline bool value_comparator<Record, Index, Operator>::operator ()(const record_
     return operator_type()(field, m_field);
 }
 
+/**
+ * Operator of comparing the packed record
+ * @param data the packed record for the comparing
+ * @return result of the comparing
+ */
+template <typename Record, template <typename> class Index, template <typename> class Operator>
+inline bool value_comparator<Record, Index, Operator>::operator ()(const void *data) const
+{
+    const field_type field = index_type::value(data);
+    return operator_type()(field, m_field);
+}
+
 //==============================================================================
 //  fields_comparator
 //==============================================================================
@@ -320,6 +445,20 @@ inline bool fields_comparator<Record, Index1, Index2, Operator>::operator ()(con
     return operator_type()(field1, field2);
 }
 
+/**
+ * Operator of comparing the packed record
+ * @param data the packed record for the comparing
+ * @return result of the comparing
+ */
+template <typename Record, template <typename> class Index1, template <typename> class Index2,
+        template <typename> class Operator>
+inline bool fields_comparator<Record, Index1, Index2, Operator>::operator ()(const void *data) const
+{
+    const field1_type field1 = index1_type::value(data);
+    const field2_type field2 = index2_type::value(data);
+    return operator_type()(field1, field2);
+}
+
 //==============================================================================
 //  combiner
 //==============================================================================
@@ -347,6 +486,17 @@ inline bool combiner<TComparer1, TComparer2, Operator>::operator ()(const record
     return operator_type()(m_comp1(record), m_comp2(record));
 }
 
+/**
+ * Operator of comparing the packed record
+ * @param data the packed record for the comparing
+ * @return result of the comparing
+ */
+template <typename TComparer1, typename TComparer2, template <typename> class Operator>
+inline bool combiner<TComparer1, TComparer2, Operator>::operator ()(const void *data) const
+{
+    return operator_type()(m_comp1(data), m_comp2(data));
+}
+
 //==============================================================================
 //  finder
 //==============================================================================
@@ -403,6 +553,16 @@ inline bool finder<Comparator, Container>::operator ()()
     return true;
 }
 
+/**
+ * Add the record that is already found by the comparator on the packed record
+ * @return true - continue the searching
+ */
+template <typename Comparator, template <typename> class Container>
+inline bool finder<Comparator, Container>::found()
+{
+    return push(m_record);
+}
+
 /**
  * Get the buffer of a record
  * @param pos the position of the record
@@ -437,6 +597,17 @@ inline pos_type finder<Comparator, Container>::pos() const
     return m_pos;
 }
 
+/**
+ * Get the comparator
+ * @return the comparator
+ */
+template <typename Comparator, template <typename> class Container>
+inline const typename finder<Comparator, Container>::comparator_type&
+    finder<Comparator, Container>::comparator() const
+{
+    return m_comp;
+}
+
 /**
  * Reset to the first state
  */
@@ -448,6 +619,162 @@ void finder<Comparator, Container>::reset(count_type count)
     m_result.clear();
 }
 
+//==============================================================================
+//  find_kernel
+//==============================================================================
+/**
+ * Constructor
+ * @param comp the comparator
+ * @param stride the distance between the records
+ */
+template <typename Comparator>
+find_kernel<Comparator>::find_kernel(const comparator_type& comp, const size_type stride) :
+    m_comp(comp),
+    m_stride(stride)
+{
+}
+
+/**
+ * Get the mask of the found records of the group, the bit i of the mask is
+ * set if the record i is found
+ * @param data the packed records
+ * @param count the count of the records (GROUP_SIZE at most)
+ * @return the mask of the found records
+ */
+template <typename Comparator>
+inline uint32_t find_kernel<Comparator>::match(const char *data, const count_type count) const
+{
+    uint32_t mask = 0;
+    for (count_type i = 0; i < count; ++i)
+    {
+        mask |= uint32_t(m_comp(static_cast<const void *>(data + i * m_stride))) << i;
+    }
+    return mask;
+}
+
+/**
+ * Find the first record
+ * @param data the packed records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+template <typename Comparator>
+inline pos_type find_kernel<Comparator>::find(const char *data, const count_type count) const
+{
+    for (count_type i = 0; i < count; i += GROUP_SIZE)
+    {
+        const uint32_t mask = match(data + i * m_stride, std::min(count_type(GROUP_SIZE), count - i));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Find the last record
+ * @param data the packed records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+template <typename Comparator>
+inline pos_type find_kernel<Comparator>::rfind(const char *data, const count_type count) const
+{
+    for (count_type i = (count + GROUP_SIZE - 1) / GROUP_SIZE * GROUP_SIZE; i > 0; i -= GROUP_SIZE)
+    {
+        const count_type beg = i - GROUP_SIZE;
+        const uint32_t mask = match(data + beg * m_stride, std::min(count_type(GROUP_SIZE), count - beg));
+        if (mask != 0)
+        {
+            return beg + 31 - __builtin_clz(mask);
+        }
+    }
+    return NIL;
+}
+
+//==============================================================================
+//  finder_scanner
+//==============================================================================
+/**
+ * Constructor
+ * @param table the table
+ * @param finder the finder
+ * @param stride the distance between the records
+ * @param pos the begin position of the records (the end position for
+ * the reverse order)
+ */
+template <typename Table, typename Finder>
+finder_scanner<Table, Finder>::finder_scanner(const table_type& table, finder_type& finder,
+        const size_type stride, const pos_type pos) :
+    m_table(table),
+    m_finder(finder),
+    m_kernel(finder.comparator(), stride),
+    m_stride(stride),
+    m_pos(pos)
+{
+}
+
+/**
+ * Pass the found records of the block to the finder
+ * @param data the packed records
+ * @param count the count of the records
+ * @return the index of the record that stops the searching or NIL
+ */
+template <typename Table, typename Finder>
+pos_type finder_scanner<Table, Finder>::find(const char *data, const count_type count)
+{
+    const pos_type beg = m_pos;
+    m_pos = m_table.inc_pos(beg, count);
+    for (count_type i = 0; i < count; i += kernel_type::GROUP_SIZE)
+    {
+        for (uint32_t mask = m_kernel.match(data + i * m_stride,
+                std::min(count_type(kernel_type::GROUP_SIZE), count - i)); mask != 0; mask &= mask - 1)
+        {
+            const count_type index = i + __builtin_ctz(mask);
+            m_finder.record(m_table.inc_pos(beg, index + 1)).unpack(data + index * m_stride);
+            if (!m_finder.found())
+            {
+                return index;
+            }
+        }
+    }
+    m_finder.record(m_pos);
+    return NIL;
+}
+
+/**
+ * Pass the found records of the block to the finder in the reverse order
+ * @param data the packed records
+ * @param count the count of the records
+ * @return the index of the record that stops the searching or NIL
+ */
+template <typename Table, typename Finder>
+pos_type finder_scanner<Table, Finder>::rfind(const char *data, const count_type count)
+{
+    const pos_type beg = m_table.dec_pos(m_pos, count);
+    m_pos = beg;
+    for (count_type i = (count + kernel_type::GROUP_SIZE - 1) / kernel_type::GROUP_SIZE * kernel_type::GROUP_SIZE;
+        i > 0; i -= kernel_type::GROUP_SIZE)
+    {
+        const count_type group = i - kernel_type::GROUP_SIZE;
+        for (uint32_t mask = m_kernel.match(data + group * m_stride,
+                std::min(count_type(kernel_type::GROUP_SIZE), count - group)); mask != 0; )
+        {
+            const count_type bit = 31 - __builtin_clz(mask);
+            const count_type index = group + bit;
+            mask &= ~(uint32_t(1) << bit);
+            m_finder.record(m_table.dec_pos(beg + index)).unpack(data + index * m_stride);
+            if (!m_finder.found())
+            {
+                return index;
+            }
+        }
+    }
+    m_finder.record(m_table.dec_pos(beg));
+    return NIL;
+}
+
 }   //namespace ouroboros
 
 #endif	/* OUROBOROS_FIND_H */
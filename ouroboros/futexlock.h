@@ -0,0 +1,806 @@
+/**
+ * @file    futexlock.h
+ */
+
+#ifndef OUROBOROS_FUTEX_LOCK_H
+#define OUROBOROS_FUTEX_LOCK_H
+
+#ifndef OUROBOROS_BOOST_ENABLED
+#error Can not use futex_lock (OUROBOROS_BOOST_ENABLED)
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <algorithm>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include <boost/thread/thread_time.hpp>
+
+#include "ouroboros/global.h"
+
+namespace ouroboros
+{
+
+/**
+ * The event which is placed in a shared memory, the waiting processes are
+ * parked on a futex and are woken up by the signal (the other platforms use
+ * the polling)
+ */
+class futex_event
+{
+public:
+    inline futex_event();
+    inline int32_t waiters() const;
+protected:
+    inline int32_t sequence() const;
+    inline bool wait(const int32_t seq, const boost::posix_time::ptime& abs_time);
+    inline void wake();
+private:
+    futex_event(const futex_event& );
+    futex_event& operator=(const futex_event& );
+private:
+    volatile int32_t m_seq;      ///< the sequence of signals (the futex word)
+    volatile int32_t m_waiters;  ///< the count of the waiting processes
+};
+
+/**
+ * The RW lock which is placed in a shared memory, the lock prefers writers:
+ * a writer books the lock and new readers can't set the lock after that
+ */
+class futex_lock : protected futex_event
+{
+public:
+    using futex_event::waiters;
+    inline futex_lock();
+    inline void lock();
+    inline bool timed_lock(const boost::posix_time::ptime& abs_time);
+    inline bool try_lock();
+    inline void unlock();
+    inline void lock_sharable();
+    inline bool timed_lock_sharable(const boost::posix_time::ptime& abs_time);
+    inline bool try_lock_sharable();
+    inline void unlock_sharable();
+private:
+    volatile int32_t m_scoped;   ///< the flag of the exclusive lock
+    volatile int32_t m_sharable; ///< the count of the sharable locks
+};
+
+/**
+ * The RW lock which is placed in a shared memory, the lock prefers readers:
+ * a writer can set the lock only when there are no readers
+ */
+class read_futex_lock : protected futex_event
+{
+public:
+    using futex_event::waiters;
+    inline read_futex_lock();
+    inline void lock();
+    inline bool timed_lock(const boost::posix_time::ptime& abs_time);
+    inline bool try_lock();
+    inline void unlock();
+    inline void lock_sharable();
+    inline bool timed_lock_sharable(const boost::posix_time::ptime& abs_time);
+    inline bool try_lock_sharable();
+    inline void unlock_sharable();
+private:
+    volatile int32_t m_scoped;   ///< the flag of the exclusive lock
+    volatile int32_t m_sharable; ///< the count of the sharable locks
+};
+
+/**
+ * The RW lock which is placed in a shared memory, the lock is fair: readers
+ * and writers set the lock in the order of their tickets (FIFO), the
+ * neighboring readers hold the lock together; the turn of a ticket whose
+ * process has died is skipped by the waiting processes
+ */
+class ticket_futex_lock : protected futex_event
+{
+public:
+    enum
+    {
+        SLOT_COUNT = 1024,  ///< the max count of the tickets that are not served (the waiting and the abandoned ones)
+        CHECK_PERIOD = 100  ///< the period of the checking of the process of the served ticket (ms)
+    };
+    using futex_event::waiters;
+    inline ticket_futex_lock();
+    inline void lock();
+    inline bool timed_lock(const boost::posix_time::ptime& abs_time);
+    inline bool try_lock();
+    inline void unlock();
+    inline void lock_sharable();
+    inline bool timed_lock_sharable(const boost::posix_time::ptime& abs_time);
+    inline bool try_lock_sharable();
+    inline void unlock_sharable();
+protected:
+    inline bool try_take_ticket(uint32_t& ticket);
+    inline bool take_ticket(uint32_t& ticket, const boost::posix_time::ptime& abs_time);
+    inline void own_ticket(const uint32_t ticket, const pid_t pid);
+    inline bool wait_check(const int32_t seq, const boost::posix_time::ptime& abs_time,
+        boost::posix_time::ptime& check);
+    inline bool wait_turn(const uint32_t ticket, const boost::posix_time::ptime& abs_time);
+    inline void pass_turn(const uint32_t ticket);
+    inline void skip_dead();
+private:
+    /** the owner of the ticket */
+    struct slot_type
+    {
+        volatile uint32_t ticket; ///< the ticket
+        volatile pid_t pid;       ///< the process of the ticket (0 - the ticket is abandoned)
+    };
+    volatile uint32_t m_next;    ///< the next free ticket
+    volatile uint32_t m_serving; ///< the ticket which is served
+    volatile int32_t m_sharable; ///< the count of the sharable locks
+    slot_type m_slots[SLOT_COUNT]; ///< the owners of the tickets that are not served
+};
+
+//==============================================================================
+//  futex_event
+//==============================================================================
+/**
+ * Constructor
+ */
+inline futex_event::futex_event() :
+    m_seq(0),
+    m_waiters(0)
+{
+}
+
+/**
+ * Get the count of the waiting processes
+ * @return the count of the waiting processes
+ */
+inline int32_t futex_event::waiters() const
+{
+    return m_waiters;
+}
+
+/**
+ * Get the current sequence of signals
+ * @return the current sequence of signals
+ */
+inline int32_t futex_event::sequence() const
+{
+    const int32_t seq = m_seq;
+    __sync_synchronize();
+    return seq;
+}
+
+/**
+ * Wait for a signal until the time comes
+ * @param seq the sequence of signals that was before checking the condition
+ * @param abs_time the time
+ * @return false if the time has come
+ */
+inline bool futex_event::wait(const int32_t seq, const boost::posix_time::ptime& abs_time)
+{
+    struct timespec timeout;
+    struct timespec *ptimeout = NULL;
+    if (!abs_time.is_pos_infinity())
+    {
+        const boost::posix_time::ptime now = boost::get_system_time();
+        if (now >= abs_time)
+        {
+            return false;
+        }
+        const boost::posix_time::time_duration rest = abs_time - now;
+        timeout.tv_sec = rest.total_seconds();
+        timeout.tv_nsec = (rest.total_microseconds() % 1000000) * 1000;
+        ptimeout = &timeout;
+    }
+    __sync_fetch_and_add(&m_waiters, 1);
+#ifdef __linux__
+    syscall(SYS_futex, &m_seq, FUTEX_WAIT, seq, ptimeout, NULL, 0);
+#else
+    OUROBOROS_UNUSED(seq);
+    OUROBOROS_UNUSED(ptimeout);
+    usleep(10);
+#endif
+    __sync_fetch_and_sub(&m_waiters, 1);
+    return true;
+}
+
+/**
+ * Wake up all the waiting processes
+ */
+inline void futex_event::wake()
+{
+    __sync_fetch_and_add(&m_seq, 1);
+#ifdef __linux__
+    if (m_waiters > 0)
+    {
+        syscall(SYS_futex, &m_seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+#endif
+}
+
+//==============================================================================
+//  futex_lock
+//==============================================================================
+/**
+ * Constructor
+ */
+inline futex_lock::futex_lock() :
+    futex_event(),
+    m_scoped(0),
+    m_sharable(0)
+{
+}
+
+/**
+ * Try to set the exclusive lock
+ * @return the result of the setting
+ */
+inline bool futex_lock::try_lock()
+{
+    if (__sync_bool_compare_and_swap(&m_scoped, 0, 1))
+    {
+        if (0 == m_sharable)
+        {
+            return true;
+        }
+        unlock();
+    }
+    return false;
+}
+
+/**
+ * Set the exclusive lock
+ */
+inline void futex_lock::lock()
+{
+    timed_lock(boost::posix_time::ptime(boost::posix_time::pos_infin));
+}
+
+/**
+ * Try to set the exclusive lock until the time comes
+ * @param abs_time the time
+ * @return the result of the setting
+ */
+inline bool futex_lock::timed_lock(const boost::posix_time::ptime& abs_time)
+{
+    // book the exclusive lock, new sharable locks can't be set after that
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (__sync_bool_compare_and_swap(&m_scoped, 0, 1))
+        {
+            break;
+        }
+        if (!wait(seq, abs_time))
+        {
+            return false;
+        }
+    }
+    // wait until all sharable locks are removed
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (0 == m_sharable)
+        {
+            return true;
+        }
+        if (!wait(seq, abs_time))
+        {
+            unlock();
+            return false;
+        }
+    }
+}
+
+/**
+ * Remove the exclusive lock
+ */
+inline void futex_lock::unlock()
+{
+    assert(1 == m_scoped);
+    __sync_lock_release(&m_scoped);
+    wake();
+}
+
+/**
+ * Try to set the sharable lock
+ * @return the result of the setting
+ */
+inline bool futex_lock::try_lock_sharable()
+{
+    if (0 == m_scoped)
+    {
+        __sync_fetch_and_add(&m_sharable, 1);
+        if (0 == m_scoped)
+        {
+            return true;
+        }
+        unlock_sharable();
+    }
+    return false;
+}
+
+/**
+ * Set the sharable lock
+ */
+inline void futex_lock::lock_sharable()
+{
+    timed_lock_sharable(boost::posix_time::ptime(boost::posix_time::pos_infin));
+}
+
+/**
+ * Try to set the sharable lock until the time comes
+ * @param abs_time the time
+ * @return the result of the setting
+ */
+inline bool futex_lock::timed_lock_sharable(const boost::posix_time::ptime& abs_time)
+{
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (try_lock_sharable())
+        {
+            return true;
+        }
+        if (!wait(seq, abs_time))
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ * Remove the sharable lock
+ */
+inline void futex_lock::unlock_sharable()
+{
+    assert(m_sharable > 0);
+    if (1 == __sync_fetch_and_sub(&m_sharable, 1))
+    {
+        // the last sharable lock is removed, a booked exclusive lock can be set
+        wake();
+    }
+}
+
+//==============================================================================
+//  read_futex_lock
+//==============================================================================
+/**
+ * Constructor
+ */
+inline read_futex_lock::read_futex_lock() :
+    futex_event(),
+    m_scoped(0),
+    m_sharable(0)
+{
+}
+
+/**
+ * Try to set the exclusive lock
+ * @return the result of the setting
+ */
+inline bool read_futex_lock::try_lock()
+{
+    if (0 == m_sharable && __sync_bool_compare_and_swap(&m_scoped, 0, 1))
+    {
+        if (0 == m_sharable)
+        {
+            return true;
+        }
+        unlock();
+    }
+    return false;
+}
+
+/**
+ * Set the exclusive lock
+ */
+inline void read_futex_lock::lock()
+{
+    timed_lock(boost::posix_time::ptime(boost::posix_time::pos_infin));
+}
+
+/**
+ * Try to set the exclusive lock until the time comes
+ * @param abs_time the time
+ * @return the result of the setting
+ */
+inline bool read_futex_lock::timed_lock(const boost::posix_time::ptime& abs_time)
+{
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (try_lock())
+        {
+            return true;
+        }
+        if (!wait(seq, abs_time))
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ * Remove the exclusive lock
+ */
+inline void read_futex_lock::unlock()
+{
+    assert(1 == m_scoped);
+    __sync_lock_release(&m_scoped);
+    wake();
+}
+
+/**
+ * Try to set the sharable lock
+ * @return the result of the setting
+ */
+inline bool read_futex_lock::try_lock_sharable()
+{
+    __sync_fetch_and_add(&m_sharable, 1);
+    if (0 == m_scoped)
+    {
+        return true;
+    }
+    unlock_sharable();
+    return false;
+}
+
+/**
+ * Set the sharable lock
+ */
+inline void read_futex_lock::lock_sharable()
+{
+    timed_lock_sharable(boost::posix_time::ptime(boost::posix_time::pos_infin));
+}
+
+/**
+ * Try to set the sharable lock until the time comes
+ * @param abs_time the time
+ * @return the result of the setting
+ */
+inline bool read_futex_lock::timed_lock_sharable(const boost::posix_time::ptime& abs_time)
+{
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (try_lock_sharable())
+        {
+            return true;
+        }
+        if (!wait(seq, abs_time))
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ * Remove the sharable lock
+ */
+inline void read_futex_lock::unlock_sharable()
+{
+    assert(m_sharable > 0);
+    if (1 == __sync_fetch_and_sub(&m_sharable, 1))
+    {
+        // the last sharable lock is removed, a writer can set the lock
+        wake();
+    }
+}
+
+//==============================================================================
+//  ticket_futex_lock
+//==============================================================================
+/**
+ * Constructor
+ */
+inline ticket_futex_lock::ticket_futex_lock() :
+    futex_event(),
+    m_next(0),
+    m_serving(0),
+    m_sharable(0)
+{
+    for (uint32_t i = 0; i < SLOT_COUNT; ++i)
+    {
+        // the slot mustn't contain any ticket which can be placed into it
+        m_slots[i].ticket = i + 1;
+        m_slots[i].pid = 0;
+    }
+}
+
+/**
+ * Try to take the ticket which is served now
+ * @param ticket the taken ticket
+ * @return the result of the taking
+ */
+inline bool ticket_futex_lock::try_take_ticket(uint32_t& ticket)
+{
+    ticket = m_serving;
+    if (m_next == ticket && __sync_bool_compare_and_swap(&m_next, ticket, ticket + 1))
+    {
+        own_ticket(ticket, getpid());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Take the next ticket until the time comes, the ticket is not given while
+ * SLOT_COUNT tickets are not served, so the slots of the tickets are not
+ * overwritten
+ * @param ticket the taken ticket
+ * @param abs_time the time
+ * @return the result of the taking
+ */
+inline bool ticket_futex_lock::take_ticket(uint32_t& ticket, const boost::posix_time::ptime& abs_time)
+{
+    boost::posix_time::ptime check;
+    while (1)
+    {
+        const int32_t seq = sequence();
+        ticket = m_next;
+        if (ticket - m_serving < uint32_t(SLOT_COUNT))
+        {
+            if (__sync_bool_compare_and_swap(&m_next, ticket, ticket + 1))
+            {
+                own_ticket(ticket, getpid());
+                return true;
+            }
+            continue;
+        }
+        if (!wait_check(seq, abs_time, check))
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ * Wait for a signal until the time comes, the process of the served ticket
+ * is checked by the period of CHECK_PERIOD
+ * @param seq the sequence of signals that was before checking the condition
+ * @param abs_time the time
+ * @param[in,out] check the time of the next checking of the process
+ * @return false if the time has come
+ */
+inline bool ticket_futex_lock::wait_check(const int32_t seq, const boost::posix_time::ptime& abs_time,
+    boost::posix_time::ptime& check)
+{
+    if (check.is_not_a_date_time())
+    {
+        check = boost::get_system_time() + boost::posix_time::millisec(long(CHECK_PERIOD));
+    }
+    if (wait(seq, std::min(check, abs_time)))
+    {
+        return true;
+    }
+    if (check >= abs_time)
+    {
+        return false;
+    }
+    skip_dead();
+    check = boost::get_system_time() + boost::posix_time::millisec(long(CHECK_PERIOD));
+    return true;
+}
+
+/**
+ * Set the owner of the ticket, the process is set before the ticket, so
+ * the process of the slot is valid when the slot contains the ticket
+ * @param ticket the ticket
+ * @param pid the process of the ticket (0 - the ticket is abandoned)
+ */
+inline void ticket_futex_lock::own_ticket(const uint32_t ticket, const pid_t pid)
+{
+    slot_type& slot = m_slots[ticket % SLOT_COUNT];
+    slot.pid = pid;
+    __sync_synchronize();
+    slot.ticket = ticket;
+    __sync_synchronize();
+}
+
+/**
+ * Wait for the turn of the ticket until the time comes, the ticket is
+ * abandoned if the time has come; the process of the served ticket is
+ * checked by the period, the turn of the dead process is skipped
+ * @param ticket the ticket
+ * @param abs_time the time
+ * @return the result of the waiting
+ */
+inline bool ticket_futex_lock::wait_turn(const uint32_t ticket, const boost::posix_time::ptime& abs_time)
+{
+    boost::posix_time::ptime check;
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (m_serving == ticket)
+        {
+            return true;
+        }
+        if (!wait_check(seq, abs_time, check))
+        {
+            break;
+        }
+    }
+    // the next owner of the turn will skip the ticket, but the turn may have
+    // come already, therefore it is checked once again
+    own_ticket(ticket, 0);
+    if (m_serving == ticket)
+    {
+        pass_turn(ticket);
+    }
+    return false;
+}
+
+/**
+ * Pass the turn to the next ticket, the abandoned tickets are skipped
+ * @param ticket the ticket which is served now
+ */
+inline void ticket_futex_lock::pass_turn(const uint32_t ticket)
+{
+    uint32_t next = ticket;
+    while (__sync_bool_compare_and_swap(&m_serving, next, next + 1))
+    {
+        ++next;
+        const slot_type& slot = m_slots[next % SLOT_COUNT];
+        if (slot.ticket != next)
+        {
+            break;
+        }
+        __sync_synchronize();
+        if (slot.pid != 0)
+        {
+            break;
+        }
+    }
+    wake();
+}
+
+/**
+ * Skip the turn of the served ticket if its process has died (it was
+ * killed while waiting or holding the lock), otherwise the lock would
+ * never be passed to the next tickets
+ */
+inline void ticket_futex_lock::skip_dead()
+{
+    const uint32_t ticket = m_serving;
+    if (ticket == m_next)
+    {
+        // no ticket is served
+        return;
+    }
+    const slot_type& slot = m_slots[ticket % SLOT_COUNT];
+    if (slot.ticket != ticket)
+    {
+        // the process is taking the ticket now
+        return;
+    }
+    __sync_synchronize();
+    const pid_t pid = slot.pid;
+    if (pid != 0 && -1 == kill(pid, 0) && ESRCH == errno)
+    {
+        OUROBOROS_DEBUG("the turn of the dead process is skipped: " << PR(pid) << PR(ticket));
+        pass_turn(ticket);
+    }
+}
+
+/**
+ * Try to set the exclusive lock
+ * @return the result of the setting
+ */
+inline bool ticket_futex_lock::try_lock()
+{
+    uint32_t ticket;
+    if (try_take_ticket(ticket))
+    {
+        if (0 == m_sharable)
+        {
+            return true;
+        }
+        pass_turn(ticket);
+    }
+    return false;
+}
+
+/**
+ * Set the exclusive lock
+ */
+inline void ticket_futex_lock::lock()
+{
+    timed_lock(boost::posix_time::ptime(boost::posix_time::pos_infin));
+}
+
+/**
+ * Try to set the exclusive lock until the time comes
+ * @param abs_time the time
+ * @return the result of the setting
+ */
+inline bool ticket_futex_lock::timed_lock(const boost::posix_time::ptime& abs_time)
+{
+    uint32_t ticket;
+    if (!take_ticket(ticket, abs_time) || !wait_turn(ticket, abs_time))
+    {
+        return false;
+    }
+    // the turn is held, wait until all previous sharable locks are removed
+    while (1)
+    {
+        const int32_t seq = sequence();
+        if (0 == m_sharable)
+        {
+            return true;
+        }
+        if (!wait(seq, abs_time))
+        {
+            pass_turn(ticket);
+            return false;
+        }
+    }
+}
+
+/**
+ * Remove the exclusive lock
+ */
+inline void ticket_futex_lock::unlock()
+{
+    pass_turn(m_serving);
+}
+
+/**
+ * Try to set the sharable lock
+ * @return the result of the setting
+ */
+inline bool ticket_futex_lock::try_lock_sharable()
+{
+    uint32_t ticket;
+    if (try_take_ticket(ticket))
+    {
+        __sync_fetch_and_add(&m_sharable, 1);
+        pass_turn(ticket);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Set the sharable lock
+ */
+inline void ticket_futex_lock::lock_sharable()
+{
+    timed_lock_sharable(boost::posix_time::ptime(boost::posix_time::pos_infin));
+}
+
+/**
+ * Try to set the sharable lock until the time comes
+ * @param abs_time the time
+ * @return the result of the setting
+ */
+inline bool ticket_futex_lock::timed_lock_sharable(const boost::posix_time::ptime& abs_time)
+{
+    uint32_t ticket;
+    if (!take_ticket(ticket, abs_time) || !wait_turn(ticket, abs_time))
+    {
+        return false;
+    }
+    __sync_fetch_and_add(&m_sharable, 1);
+    pass_turn(ticket);
+    return true;
+}
+
+/**
+ * Remove the sharable lock
+ */
+inline void ticket_futex_lock::unlock_sharable()
+{
+    assert(m_sharable > 0);
+    if (1 == __sync_fetch_and_sub(&m_sharable, 1))
+    {
+        // the last sharable lock is removed, a writer can set the lock
+        wake();
+    }
+}
+
+} // namespace ouroboros
+
+#endif /* OUROBOROS_FUTEX_LOCK_H */
@@ -21,24 +21,35 @@
 
 #ifndef OUROBOROS_SETTINGS
 #define OUROBOROS_LOCK_TIMEOUT 5000 ///< timeout for unlocking (ms)
+#define OUROBOROS_OPTIMISTIC_ATTEMPTS 3 ///< count of attempts of the optimistic reading before locking
 #define OUROBOROS_OPTIMIZATION_NODE_RW ///< optimize i/o opeartions of rbtree
 #define OUROBOROS_FASTRBTREE_ENABLED ///< use fastrbtree
 #define OUROBOROS_NODECACHE_ENABLED ///< use cache of nodes for rbtree
 #define OUROBOROS_FILE_REGION_CACHE_TYPE 1 ///< use the first type of file region cache
-//#define OUROBOROS_SYNC_ENABLED ///< use sync operation for fixation of file data
+//#define OUROBOROS_SYNC_ENABLED ///< use sync operation for fixation of file data (the default level of the durability is DURABILITY_SYNC)
 //#define OUROBOROS_SHOW_MEMORY_INFO ///< show information about the status of shared memory
 //#define OUROBOROS_STRICT_ASSERT_ENABLED ///< use strict assert
+//#define OUROBOROS_64BIT_OFFSETS ///< use 64-bit positions, offsets and sizes (the layout of the file is changed)
 #endif
 
 namespace ouroboros
 {
 
+#ifdef OUROBOROS_64BIT_OFFSETS
+typedef uint64_t pos_type;      ///< position
+typedef int64_t  spos_type;     ///< signed position
+typedef uint64_t offset_type;   ///< offset
+typedef uint32_t revision_type; ///< revision
+typedef uint32_t count_type;    ///< count
+typedef uint64_t size_type;     ///< size
+#else
 typedef uint32_t pos_type;      ///< position
 typedef int32_t  spos_type;     ///< signed position
 typedef uint32_t offset_type;   ///< offset
 typedef uint32_t revision_type; ///< revision
 typedef uint32_t count_type;    ///< count
 typedef uint32_t size_type;     ///< size
+#endif
 
 const pos_type NIL = std::numeric_limits<pos_type>::max(); ///< pointer of position NULL
 
@@ -55,7 +66,20 @@ enum
 enum
 {
     OUROBOROS_PAGE_SIZE = 512,    ///< size of cache page
-    OUROBOROS_PAGE_COUNT = 16     ///< count of cache pages
+    OUROBOROS_PAGE_COUNT = 16,    ///< count of cache pages
+    OUROBOROS_SHARED_PAGE_COUNT = 256, ///< count of cache pages that are shared between processes
+    OUROBOROS_PAGE_LOG_SIZE = 64, ///< count of ranges of changed pages that are kept for readers
+    OUROBOROS_REDO_LOG_SIZE = 1048576, ///< size of the redo log that starts the checkpoint
+    OUROBOROS_MANIFEST_SIZE = 65536, ///< maximum count of the pages in the manifest of the journal
+    OUROBOROS_COMMIT_WINDOW = 0,  ///< window of the group commit (us), 0 - the commits share the next synchronization
+    OUROBOROS_COMMIT_BATCH = 16,  ///< maximum count of the commits that share one synchronization
+    OUROBOROS_RECOVERY_BLOCK = 1048576, ///< size of the block that is read and written by the recovery
+    OUROBOROS_RECOVERY_THREADS = 4, ///< count of the threads of the recovery
+    OUROBOROS_IO_RING_SIZE = 64, ///< maximum count of the asynchronous requests of a file
+    OUROBOROS_PAGE_ALIGNMENT = 4096, ///< alignment of the memory of the cache pages and of the direct I/O
+    OUROBOROS_ZERO_BLOCK = 1048576, ///< size of the block of zeros that fills the growth of the file without the preallocation
+    OUROBOROS_READ_AHEAD = 64, ///< maximum count of the cache pages that are read ahead by the sequential reading
+    OUROBOROS_SCAN_BLOCK = 65536 ///< size of the block of the records that is read by the scanning of the table
 };
 #endif
 
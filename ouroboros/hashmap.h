@@ -94,6 +94,8 @@ public:
     hash_map();
     ~hash_map();
 
+    void reserve(const size_t count); ///< set the count of items, the container is cleared
+
     iterator find(const key_type& key) const;
     void insert(const value_type& value);
     void erase(const key_type& key);
@@ -364,6 +366,18 @@ hash_map<Key, Value, slotCount>::~hash_map()
     clear();
 }
 
+/**
+ * Set the count of items, the container is cleared; the count of slots is
+ * fixed, the chains of the slots grow
+ * @param count the count of items
+ */
+template <typename Key, typename Value, int slotCount>
+void hash_map<Key, Value, slotCount>::reserve(const size_t count)
+{
+    OUROBOROS_UNUSED(count);
+    clear();
+}
+
 /**
  * Find an item of the container by the key
  * @param key the key
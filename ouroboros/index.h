@@ -28,6 +28,14 @@ public:
     {
         return record.field1();
     }
+    static inline field_type value(const void *data)
+    {
+        return record_type::unpack_field1(data);
+    }
+    static inline void set_value(record_type& record, const field_type& value)
+    {
+        record.field1(value);
+    }
 };
 
 /**
@@ -43,6 +51,14 @@ public:
     {
         return record.field2();
     }
+    static inline field_type value(const void *data)
+    {
+        return record_type::unpack_field2(data);
+    }
+    static inline void set_value(record_type& record, const field_type& value)
+    {
+        record.field2(value);
+    }
 };
 
 /**
@@ -58,6 +74,14 @@ public:
     {
         return record.field3();
     }
+    static inline field_type value(const void *data)
+    {
+        return record_type::unpack_field3(data);
+    }
+    static inline void set_value(record_type& record, const field_type& value)
+    {
+        record.field3(value);
+    }
 };
 
 /**
@@ -73,6 +97,14 @@ public:
     {
         return record.field4();
     }
+    static inline field_type value(const void *data)
+    {
+        return record_type::unpack_field4(data);
+    }
+    static inline void set_value(record_type& record, const field_type& value)
+    {
+        record.field4(value);
+    }
 };
 
 /**
@@ -88,6 +120,14 @@ public:
     {
         return record.field5();
     }
+    static inline field_type value(const void *data)
+    {
+        return record_type::unpack_field5(data);
+    }
+    static inline void set_value(record_type& record, const field_type& value)
+    {
+        record.field5(value);
+    }
 };
 
 /**
@@ -103,6 +143,14 @@ public:
     {
         return record.field6();
     }
+    static inline field_type value(const void *data)
+    {
+        return record_type::unpack_field6(data);
+    }
+    static inline void set_value(record_type& record, const field_type& value)
+    {
+        record.field6(value);
+    }
 };
 
 }   //namespace ouroboros
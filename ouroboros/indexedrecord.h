@@ -16,13 +16,169 @@
 namespace ouroboros
 {
 
+/**
+ * The fields of the record that is packed after the node of the tree,
+ * the packed fields are unpacked with the offset of the node
+ */
+template <typename Record, int Count = Record::COUNT>
+class indexed_record_fields;
+
+/**
+ * The node of the tree that is packed ahead of the fields
+ */
+template <typename Record>
+class indexed_record_fields<Record, 0> : public Record
+{
+public:
+    enum {NODE_SIZE = 3 * sizeof(pos_type) + sizeof(node_color)};
+    inline indexed_record_fields() : Record() {}
+    explicit inline indexed_record_fields(const Record& record) : Record(record) {}
+protected:
+    /**
+     * Get the packed fields of the record
+     * @param in the pointer to data of the indexed record
+     * @return the pointer to the packed fields
+     */
+    static inline const void *fields(const void *in)
+    {
+        return static_cast<const char *>(in) + NODE_SIZE;
+    }
+};
+
+/**
+ * The field number 1 of the record that is packed after the node of the tree
+ */
+template <typename Record>
+class indexed_record_fields<Record, 1> : public indexed_record_fields<Record, 0>
+{
+    typedef indexed_record_fields<Record, 0> base_class;
+public:
+    inline indexed_record_fields() : base_class() {}
+    explicit inline indexed_record_fields(const Record& record) : base_class(record) {}
+    /**
+     * Unpack the field from the packed indexed record
+     * @param in the pointer to data of the indexed record
+     * @return the field
+     */
+    static inline typename Record::field1_type unpack_field1(const void *in)
+    {
+        return Record::unpack_field1(base_class::fields(in));
+    }
+};
+
+/**
+ * The field number 2 of the record that is packed after the node of the tree
+ */
+template <typename Record>
+class indexed_record_fields<Record, 2> : public indexed_record_fields<Record, 1>
+{
+    typedef indexed_record_fields<Record, 1> base_class;
+public:
+    inline indexed_record_fields() : base_class() {}
+    explicit inline indexed_record_fields(const Record& record) : base_class(record) {}
+    /**
+     * Unpack the field from the packed indexed record
+     * @param in the pointer to data of the indexed record
+     * @return the field
+     */
+    static inline typename Record::field2_type unpack_field2(const void *in)
+    {
+        return Record::unpack_field2(base_class::fields(in));
+    }
+};
+
+/**
+ * The field number 3 of the record that is packed after the node of the tree
+ */
+template <typename Record>
+class indexed_record_fields<Record, 3> : public indexed_record_fields<Record, 2>
+{
+    typedef indexed_record_fields<Record, 2> base_class;
+public:
+    inline indexed_record_fields() : base_class() {}
+    explicit inline indexed_record_fields(const Record& record) : base_class(record) {}
+    /**
+     * Unpack the field from the packed indexed record
+     * @param in the pointer to data of the indexed record
+     * @return the field
+     */
+    static inline typename Record::field3_type unpack_field3(const void *in)
+    {
+        return Record::unpack_field3(base_class::fields(in));
+    }
+};
+
+/**
+ * The field number 4 of the record that is packed after the node of the tree
+ */
+template <typename Record>
+class indexed_record_fields<Record, 4> : public indexed_record_fields<Record, 3>
+{
+    typedef indexed_record_fields<Record, 3> base_class;
+public:
+    inline indexed_record_fields() : base_class() {}
+    explicit inline indexed_record_fields(const Record& record) : base_class(record) {}
+    /**
+     * Unpack the field from the packed indexed record
+     * @param in the pointer to data of the indexed record
+     * @return the field
+     */
+    static inline typename Record::field4_type unpack_field4(const void *in)
+    {
+        return Record::unpack_field4(base_class::fields(in));
+    }
+};
+
+/**
+ * The field number 5 of the record that is packed after the node of the tree
+ */
+template <typename Record>
+class indexed_record_fields<Record, 5> : public indexed_record_fields<Record, 4>
+{
+    typedef indexed_record_fields<Record, 4> base_class;
+public:
+    inline indexed_record_fields() : base_class() {}
+    explicit inline indexed_record_fields(const Record& record) : base_class(record) {}
+    /**
+     * Unpack the field from the packed indexed record
+     * @param in the pointer to data of the indexed record
+     * @return the field
+     */
+    static inline typename Record::field5_type unpack_field5(const void *in)
+    {
+        return Record::unpack_field5(base_class::fields(in));
+    }
+};
+
+/**
+ * The field number 6 of the record that is packed after the node of the tree
+ */
+template <typename Record>
+class indexed_record_fields<Record, 6> : public indexed_record_fields<Record, 5>
+{
+    typedef indexed_record_fields<Record, 5> base_class;
+public:
+    inline indexed_record_fields() : base_class() {}
+    explicit inline indexed_record_fields(const Record& record) : base_class(record) {}
+    /**
+     * Unpack the field from the packed indexed record
+     * @param in the pointer to data of the indexed record
+     * @return the field
+     */
+    static inline typename Record::field6_type unpack_field6(const void *in)
+    {
+        return Record::unpack_field6(base_class::fields(in));
+    }
+};
+
 /**
  * The indexed record
  */
 template <typename Record, template <typename> class Index>
-class indexed_record : public Record
+class indexed_record : public indexed_record_fields<Record>
 {
     typedef indexed_record<Record, Index> self_type;
+    typedef indexed_record_fields<Record> base_class;
     typedef typename Index<Record>::field_type key_type;
     struct converter
     {
@@ -70,7 +226,7 @@ private:
  */
 template <typename Record, template <typename> class Index>
 inline indexed_record<Record, Index>::indexed_record() :
-    record_type(),
+    base_class(),
     m_parent(NIL),
     m_left(NIL),
     m_right(NIL),
@@ -84,7 +240,7 @@ inline indexed_record<Record, Index>::indexed_record() :
  */
 template <typename Record, template <typename> class Index>
 inline indexed_record<Record, Index>::indexed_record(const node_type& node) :
-    record_type(node.body()),
+    base_class(node.body()),
     m_parent(node.parent()),
     m_left(node.left()),
     m_right(node.right()),
@@ -203,8 +359,7 @@ inline size_type indexed_record<Record, Index>::size() const
 template <typename Record, template <typename> class Index>
 size_type indexed_record<Record, Index>::static_size()
 {
-    return sizeof(pos_type) + sizeof(pos_type) + sizeof(pos_type) +
-        sizeof(node_color) + record_type::static_size();
+    return base_class::NODE_SIZE + record_type::static_size();
 }
 
 /**
@@ -77,6 +77,12 @@ public:
     template <typename Finder>
     pos_type rfind_in_range(Finder& finder, const field_type& beg, const field_type& end) const; ///< reverse find a record that has index in range [beg, end)
     count_type get_range_size(const field_type& beg, const field_type& end) const; ///< get a count of records that have index in range [beg, end)
+    template <template <typename> class FieldIndex>
+    aggregate_result<typename FieldIndex<Record>::field_type>
+        aggregate_by_index(const field_type& beg, const field_type& end) const; ///< aggregate the field of the records by index [beg, end)
+    template <template <typename> class FieldIndex, typename Comparator>
+    aggregate_result<typename FieldIndex<Record>::field_type>
+        aggregate_by_index(const Comparator& comp, const field_type& beg, const field_type& end) const; ///< aggregate the field of the records by index [beg, end) that are matched by the comparator
 
     void clear(); ///< clear the table
     inline void build_indexes(); ///< build the indexes of the records
@@ -841,6 +847,49 @@ count_type indexed_table<Table, Record, Index, Key, Interface>::
     return count;
 }
 
+/**
+ * Aggregate the field of the records by index [beg, end)
+ * @param beg the begin value of the index field
+ * @param end the end value of the index field
+ * @return the aggregates of the field
+ */
+template <template <typename, typename, typename> class Table, typename Record,
+        template <typename> class Index, typename Key, typename Interface>
+template <template <typename> class FieldIndex>
+aggregate_result<typename FieldIndex<Record>::field_type> indexed_table<Table, Record, Index, Key, Interface>::
+    aggregate_by_index(const field_type& beg, const field_type& end) const
+{
+    return aggregate_by_index<FieldIndex>(comp_any<record_type>(), beg, end);
+}
+
+/**
+ * Aggregate the field of the records by index [beg, end) that are matched by
+ * the comparator of find.h, the comparator is evaluated on the packed records
+ * @param comp the comparator
+ * @param beg the begin value of the index field
+ * @param end the end value of the index field
+ * @return the aggregates of the field
+ */
+template <template <typename, typename, typename> class Table, typename Record,
+        template <typename> class Index, typename Key, typename Interface>
+template <template <typename> class FieldIndex, typename Comparator>
+aggregate_result<typename FieldIndex<Record>::field_type> indexed_table<Table, Record, Index, Key, Interface>::
+    aggregate_by_index(const Comparator& comp, const field_type& beg, const field_type& end) const
+{
+    OUROBOROS_RANGE_ASSERT(beg <= end);
+    typename base_class::lock_read lock(*this);
+    aggregate_scanner<FieldIndex<record_type>, Comparator> scanner(comp, unsafe_table::rec_size());
+    scoped_buffer<char> buffer(unsafe_table::rec_size());
+    typename index_list::const_iterator itbeg = m_indexes.lower_bound(beg);
+    typename index_list::const_iterator itend = m_indexes.upper_bound(end);
+    for (typename index_list::const_iterator it = itbeg; it != itend; ++it)
+    {
+        unsafe_table::read(buffer.get(), it->second);
+        scanner.find(buffer.get(), 1);
+    }
+    return scanner.result();
+}
+
 /**
  * Clear the table
  */
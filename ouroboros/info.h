@@ -35,6 +35,8 @@ public:
     inline size_type get_data(void *buffer, const size_type size) const;
     inline size_type set_data(const void *buffer, const size_type size);
     inline bool compare_data(const info& o) const;
+    inline size_type pos_size() const;
+    inline bool compatible() const;
 
     static size_type static_size()
     {
@@ -53,7 +55,7 @@ public:
     count_type rec_count;      ///< the count of records in a table
     count_type key_count;      ///< the count of keys
 private:
-    char reserve[RESERVE_SIZE]; ///< the reserved region
+    char reserve[RESERVE_SIZE]; ///< the reserved region, the first byte is the size of the positions
     char data[DATA_SIZE];       ///< the user data region
 };
 
@@ -101,6 +103,7 @@ inline info::info(const count_type tc, const count_type rc, const count_type kc,
     version(ver), tbl_count(tc), rec_count(rc), key_count(kc)
 {
     memset(reserve, 0, sizeof(reserve));
+    reserve[0] = sizeof(pos_type);
     if (NULL == user_data || 0 == user_size)
     {
         memset(data, 0, sizeof(data));
@@ -228,6 +231,26 @@ inline bool info::compare_data(const info& o) const
     return 0 == memcmp(data, o.data, sizeof(data));
 }
 
+/**
+ * Get the size of the positions in the file of the dataset, the size isn't
+ * stored by the old versions (32-bit positions)
+ * @return the size of the positions
+ */
+inline size_type info::pos_size() const
+{
+    return 0 == reserve[0] ? sizeof(uint32_t) : reserve[0];
+}
+
+/**
+ * Check the file of the dataset has the same size of the positions as
+ * the library (OUROBOROS_64BIT_OFFSETS)
+ * @return the result of the checking
+ */
+inline bool info::compatible() const
+{
+    return pos_size() == sizeof(pos_type);
+}
+
 /**
  * Output the information
  * @param s the stream
@@ -241,6 +264,7 @@ inline std::ostream& operator << (std::ostream& s, const info& info)
       << ", tbl_count = " << info.tbl_count
       << ", rec_count = " << info.rec_count
       << ", key_count = " << info.key_count
+      << ", pos_size = " << info.pos_size()
       << ", data = [ " << dump << " ]";
     return s;
 }
@@ -11,6 +11,8 @@
 #include "ouroboros/container.h"
 #include "ouroboros/memoryfile.h"
 #include "ouroboros/journalfile.h"
+#include "ouroboros/redofile.h"
+#include "ouroboros/mmapfile.h"
 #include "ouroboros/indexedtable.h"
 #include "ouroboros/locker.h"
 #include "ouroboros/page.h"
@@ -35,12 +37,20 @@ struct base_table_memory_interface
 /**
  * The base interface for working with a table in local memory
  * (without separation between processes)
+ * @param pageCount the count of cache pages
+ * @param Cache the type of the cache of a file
+ * @param File the type of the file (file_lock, mmap_file)
+ * @param Journal the type of the transactional file (journal_file, redo_file),
+ * the layout of the file is the same, so the type can be changed after
+ * the dataset is closed
  */
-template <int pageCount = OUROBOROS_PAGE_COUNT>
+template <int pageCount = OUROBOROS_PAGE_COUNT, template <typename, int, int> class Cache = cache,
+    template <typename> class File = file_lock,
+    template <typename, int, typename, template <typename, int, int> class> class Journal = journal_file>
 struct base_table_local_interface : public base_table_memory_interface
 {
     typedef file_page<OUROBOROS_PAGE_SIZE, sizeof(journal_status_type)> file_page_type;
-    typedef journal_file<file_page_type, pageCount> file_type;
+    typedef Journal<file_page_type, pageCount, File<file_page_type>, Cache> file_type;
 };
 
 /**
@@ -121,8 +131,10 @@ struct base_interface : public TableInterface
  * (without separation between processes)
  */
 template <template <template <typename, typename, typename> class, typename, template <typename> class,
-        typename, typename> class Table, int pageCount = OUROBOROS_PAGE_COUNT>
-struct base_local_interface : public base_interface<base_table_local_interface<pageCount>, Table>,
+        typename, typename> class Table, int pageCount = OUROBOROS_PAGE_COUNT,
+        template <typename, int, int> class Cache = cache, template <typename> class File = file_lock,
+        template <typename, int, typename, template <typename, int, int> class> class Journal = journal_file>
+struct base_local_interface : public base_interface<base_table_local_interface<pageCount, Cache, File, Journal>, Table>,
     public base_dataset_local_interface {};
 
 /**
@@ -139,6 +151,20 @@ struct base_memory_interface : public base_interface<base_table_memory_interface
  */
 typedef base_local_interface<indexed_table> local_interface;
 
+/**
+ * The interface for working with a dataset in local memory
+ * (without separation between processes), the file is read through
+ * the memory mapping
+ */
+typedef base_local_interface<indexed_table, OUROBOROS_PAGE_COUNT, cache, mmap_file> mmap_local_interface;
+
+/**
+ * The interface for working with a dataset in local memory
+ * (without separation between processes), the transactions are stored
+ * in the redo log
+ */
+typedef base_local_interface<indexed_table, OUROBOROS_PAGE_COUNT, cache, file_lock, redo_file> redo_local_interface;
+
 }   //namespace ouroboros
 
 
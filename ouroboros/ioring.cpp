@@ -0,0 +1,425 @@
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#ifdef OUROBOROS_IO_URING_ENABLED
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <linux/io_uring.h>
+#endif
+
+#include "ouroboros/ioring.h"
+
+#define OUROBOROS_IO_ERROR_DELAY 100
+
+namespace ouroboros
+{
+
+static uint64_t s_submits = 0; ///< the count of the submissions of the process
+
+//==============================================================================
+//  io_request
+//==============================================================================
+/**
+ * Skip the transferred data, the rest of the request is transferred again
+ * @param count the size of the transferred data
+ */
+void io_request::advance(size_t count)
+{
+    pos += count;
+    if (type != IO_WRITEV)
+    {
+        buffer = static_cast<char *>(buffer) + count;
+        size -= count;
+        return;
+    }
+    size_t index = 0;
+    while (index < iov.size() && count >= iov[index].iov_len)
+    {
+        count -= iov[index].iov_len;
+        ++index;
+    }
+    iov.erase(iov.begin(), iov.begin() + index);
+    if (!iov.empty())
+    {
+        iov.front().iov_base = static_cast<char *>(iov.front().iov_base) + count;
+        iov.front().iov_len -= count;
+    }
+}
+
+//==============================================================================
+//  io_ring
+//==============================================================================
+/**
+ * Get the count of the submissions of the process
+ * @return the count of the calls of the submission
+ */
+//static
+uint64_t io_ring::submits()
+{
+    return s_submits;
+}
+
+/**
+ * Constructor
+ * @param entries the count of the entries of the submission queue
+ */
+io_ring::io_ring(const unsigned entries) :
+    m_fd(-1),
+    m_event_fd(-1),
+    m_owner(getpid()),
+    m_broken(false),
+    m_entries(0),
+    m_queued(0),
+    m_submitted(0),
+    m_sq_ptr(NULL),
+    m_sq_size(0),
+    m_cq_ptr(NULL),
+    m_cq_size(0),
+    m_sqes(NULL),
+    m_sqes_size(0),
+    m_sq_tail(NULL),
+    m_sq_mask(NULL),
+    m_sq_array(NULL),
+    m_cq_head(NULL),
+    m_cq_tail(NULL),
+    m_cq_mask(NULL),
+    m_cqes(NULL)
+{
+    init(entries);
+}
+
+/**
+ * Destructor, the requests must be completed before (method wait)
+ */
+io_ring::~io_ring()
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    if (m_sqes != NULL)
+    {
+        munmap(m_sqes, m_sqes_size);
+    }
+    if (m_cq_ptr != NULL && m_cq_ptr != m_sq_ptr)
+    {
+        munmap(m_cq_ptr, m_cq_size);
+    }
+    if (m_sq_ptr != NULL)
+    {
+        munmap(m_sq_ptr, m_sq_size);
+    }
+#endif
+    if (m_event_fd != -1)
+    {
+        close(m_event_fd);
+    }
+    if (m_fd != -1)
+    {
+        close(m_fd);
+    }
+}
+
+/**
+ * Create the ring, the ring stays invalid if an error occurs
+ * @param entries the count of the entries of the submission queue
+ */
+void io_ring::init(const unsigned entries)
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    const int fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (-1 == fd)
+    {
+        OUROBOROS_DEBUG("io_uring is not available: " << PE(errno));
+        return;
+    }
+    m_fd = fd;
+    m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single)
+    {
+        m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+    }
+    void *sq_ptr = mmap(NULL, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == sq_ptr)
+    {
+        return;
+    }
+    m_sq_ptr = sq_ptr;
+    void *cq_ptr = single ? sq_ptr : mmap(NULL, m_cq_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (MAP_FAILED == cq_ptr)
+    {
+        return;
+    }
+    m_cq_ptr = cq_ptr;
+    const size_t sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        fd, IORING_OFF_SQES);
+    if (MAP_FAILED == sqes)
+    {
+        return;
+    }
+    m_sqes = sqes;
+    m_sqes_size = sqes_size;
+
+    char *sq = static_cast<char *>(sq_ptr);
+    m_sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    m_sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(cq_ptr);
+    m_cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    m_cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    m_cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    m_cqes = cq + params.cq_off.cqes;
+
+    // the completions are signaled by the eventfd, without it the completions
+    // are waited by io_uring_enter
+    const int event_fd = eventfd(0, EFD_CLOEXEC);
+    if (event_fd != -1)
+    {
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, &event_fd, 1) == 0)
+        {
+            m_event_fd = event_fd;
+        }
+        else
+        {
+            close(event_fd);
+        }
+    }
+    // the storage of the requests is not reallocated, so the buffers of
+    // the submitted requests (IO_WRITEV) are not moved
+    m_requests.reserve(params.sq_entries);
+    m_entries = params.sq_entries;
+#else
+    OUROBOROS_UNUSED(entries);
+#endif
+}
+
+/**
+ * Check the ring can be used
+ * @return the result of the checking
+ */
+bool io_ring::valid() const
+{
+    return m_entries > 0 && !m_broken;
+}
+
+/**
+ * Get the process that created the ring
+ * @return the identifier of the process
+ */
+pid_t io_ring::owner() const
+{
+    return m_owner;
+}
+
+/**
+ * Get the count of the requests that are not completed
+ * @return the count of the requests
+ */
+count_type io_ring::pending() const
+{
+    return m_queued + m_submitted;
+}
+
+/**
+ * Add the request to the submission queue
+ * @param fd the file descriptor
+ * @param request the request
+ * @param drain the sign that the request is started after the end of
+ * the previous requests
+ * @return the request is added or the queue is full (the requests must be
+ * waited before)
+ */
+bool io_ring::add(const int fd, const io_request& request, const bool drain)
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    if (!valid() || m_requests.size() >= m_entries)
+    {
+        return false;
+    }
+    m_requests.push_back(request);
+    io_request& req = m_requests.back();
+    // only this process changes the tail of the submission queue
+    const unsigned tail = *m_sq_tail;
+    const unsigned index = tail & *m_sq_mask;
+    struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(m_sqes) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    switch (req.type)
+    {
+        case IO_READ:
+            sqe->opcode = IORING_OP_READ;
+            sqe->addr = reinterpret_cast<uintptr_t>(req.buffer);
+            sqe->len = req.size;
+            break;
+        case IO_WRITE:
+            sqe->opcode = IORING_OP_WRITE;
+            sqe->addr = reinterpret_cast<uintptr_t>(req.buffer);
+            sqe->len = req.size;
+            break;
+        case IO_WRITEV:
+            sqe->opcode = IORING_OP_WRITEV;
+            sqe->addr = reinterpret_cast<uintptr_t>(&req.iov[0]);
+            sqe->len = req.iov.size();
+            break;
+        case IO_SYNC:
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            break;
+    }
+    sqe->fd = fd;
+    sqe->off = req.pos;
+    sqe->flags = drain ? IOSQE_IO_DRAIN : 0;
+    sqe->user_data = m_requests.size() - 1;
+    m_sq_array[index] = index;
+    __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++m_queued;
+    return true;
+#else
+    OUROBOROS_UNUSED(fd);
+    OUROBOROS_UNUSED(request);
+    OUROBOROS_UNUSED(drain);
+    return false;
+#endif
+}
+
+/**
+ * Submit the added requests to the kernel, the method doesn't wait for
+ * the end of the requests; if the submission fails the ring becomes invalid
+ * and the requests that are not submitted are returned as unfinished by
+ * the method wait
+ */
+void io_ring::submit()
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    while (m_queued > 0 && !m_broken)
+    {
+        __sync_fetch_and_add(&s_submits, 1);
+        const int result = syscall(__NR_io_uring_enter, m_fd, m_queued, 0, 0, NULL, 0);
+        if (-1 == result)
+        {
+            const int err = errno;
+            if (err != EINTR && err != EAGAIN)
+            {
+                OUROBOROS_ERROR("error of submission: " << PR(m_fd) << PR(m_queued) << PE(err));
+                m_broken = true;
+                break;
+            }
+            usleep(OUROBOROS_IO_ERROR_DELAY);
+            continue;
+        }
+        m_queued -= result;
+        m_submitted += result;
+    }
+#endif
+}
+
+/**
+ * Finish the request by the result of the completion
+ * @param request the request
+ * @param result the result of the request (the size of the data or the error)
+ * @param[out] unfinished the rest of the requests that are not transferred
+ */
+void io_ring::finish(io_request& request, const int result, std::vector<io_request>& unfinished)
+{
+    request.done = true;
+    if (result < 0)
+    {
+        unfinished.push_back(request);
+        return;
+    }
+    if (IO_SYNC == request.type)
+    {
+        return;
+    }
+    size_t size = request.size;
+    if (IO_WRITEV == request.type)
+    {
+        size = 0;
+        for (size_t i = 0; i < request.iov.size(); ++i)
+        {
+            size += request.iov[i].iov_len;
+        }
+    }
+    if (size_t(result) < size)
+    {
+        unfinished.push_back(request);
+        unfinished.back().advance(result);
+    }
+}
+
+/**
+ * Take the completions of the requests
+ * @param[out] unfinished the requests that are not transferred completely
+ */
+void io_ring::reap(std::vector<io_request>& unfinished)
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    unsigned head = *m_cq_head;
+    const unsigned tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        const struct io_uring_cqe *cqe = static_cast<const struct io_uring_cqe *>(m_cqes) +
+            (head & *m_cq_mask);
+        finish(m_requests[cqe->user_data], cqe->res, unfinished);
+        --m_submitted;
+    }
+    __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+#else
+    OUROBOROS_UNUSED(unfinished);
+#endif
+}
+
+/**
+ * Wait for the end of all requests, the added requests are submitted before
+ * @param[out] unfinished the requests (or the rest of the requests) that
+ * are not transferred, they must be transferred by the synchronous calls
+ * @return the requests contained the synchronization, so the unfinished
+ * writes are not synchronized by it
+ */
+bool io_ring::wait(std::vector<io_request>& unfinished)
+{
+#ifdef OUROBOROS_IO_URING_ENABLED
+    submit();
+    reap(unfinished);
+    while (m_submitted > 0)
+    {
+        if (m_event_fd != -1)
+        {
+            eventfd_t value = 0;
+            if (eventfd_read(m_event_fd, &value) == -1 && errno != EINTR)
+            {
+                OUROBOROS_THROW_ERROR(io_error, "error of waiting: " << PR(m_event_fd) << PE(errno));
+            }
+        }
+        else if (syscall(__NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) == -1 &&
+            errno != EINTR)
+        {
+            OUROBOROS_THROW_ERROR(io_error, "error of waiting: " << PR(m_fd) << PE(errno));
+        }
+        reap(unfinished);
+    }
+    bool synced = false;
+    for (size_t i = 0; i < m_requests.size(); ++i)
+    {
+        synced = synced || IO_SYNC == m_requests[i].type;
+        if (!m_requests[i].done)
+        {
+            // the request is not submitted
+            unfinished.push_back(m_requests[i]);
+        }
+    }
+    m_requests.clear();
+    m_queued = 0;
+    return synced;
+#else
+    OUROBOROS_UNUSED(unfinished);
+    return false;
+#endif
+}
+
+}   //namespace ouroboros
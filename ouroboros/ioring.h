@@ -0,0 +1,101 @@
+/**
+ * @file   ioring.h
+ * The ring of the asynchronous requests of the file (io_uring)
+ */
+
+#ifndef OUROBOROS_IORING_H
+#define	OUROBOROS_IORING_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <vector>
+
+#include "ouroboros/global.h"
+
+namespace ouroboros
+{
+
+/** The type of the asynchronous request */
+enum io_request_type
+{
+    IO_READ,    ///< read data
+    IO_WRITE,   ///< write data
+    IO_WRITEV,  ///< write the buffers of the adjacent data
+    IO_SYNC     ///< synchronize data of the file
+};
+
+/** the asynchronous request */
+struct io_request
+{
+    io_request() :
+        type(IO_SYNC),
+        buffer(NULL),
+        size(0),
+        pos(0),
+        done(false)
+    {}
+    io_request_type type;   ///< the type of the request
+    void *buffer;           ///< the buffer of the data (IO_READ, IO_WRITE)
+    size_type size;         ///< the size of the data (IO_READ, IO_WRITE)
+    pos_type pos;           ///< the position of the data
+    std::vector<struct iovec> iov; ///< the buffers of the data (IO_WRITEV)
+    bool done;              ///< the sign that the request is completed
+
+    void advance(size_t count); ///< skip the transferred data
+};
+
+/**
+ * The ring of the asynchronous requests (io_uring), the requests are added
+ * to the submission queue and they are submitted to the kernel by one call;
+ * the end of the requests is signaled by the eventfd. The ring is created
+ * by the raw system calls, if the ring can't be created (the old kernel,
+ * the library is built without OUROBOROS_IO_URING_ENABLED) the method valid
+ * returns false and the file uses the synchronous calls.
+ * @attention the buffers of the requests must be valid until the end of
+ * the method wait; the ring belongs to the process that created it
+ */
+class io_ring
+{
+public:
+    explicit io_ring(const unsigned entries);
+    ~io_ring();
+
+    bool valid() const; ///< check the ring can be used
+    pid_t owner() const; ///< get the process that created the ring
+    count_type pending() const; ///< get the count of the requests that are not completed
+    bool add(const int fd, const io_request& request, const bool drain); ///< add the request to the submission queue
+    void submit(); ///< submit the added requests to the kernel
+    bool wait(std::vector<io_request>& unfinished); ///< wait for the end of all requests
+    static uint64_t submits(); ///< get the count of the submissions of the process
+protected:
+    void init(const unsigned entries); ///< create the ring
+    void reap(std::vector<io_request>& unfinished); ///< take the completions of the requests
+    void finish(io_request& request, const int result, std::vector<io_request>& unfinished); ///< finish the request by the result
+private:
+    int m_fd; ///< the file descriptor of the ring
+    int m_event_fd; ///< the eventfd of the completions
+    const pid_t m_owner; ///< the process that created the ring
+    bool m_broken; ///< the sign that the submission failed
+    unsigned m_entries; ///< the count of the entries of the submission queue
+    unsigned m_queued; ///< the count of the requests that are not submitted
+    unsigned m_submitted; ///< the count of the submitted requests that are not completed
+    void *m_sq_ptr; ///< the mapping of the submission queue
+    size_t m_sq_size; ///< the size of the mapping of the submission queue
+    void *m_cq_ptr; ///< the mapping of the completion queue
+    size_t m_cq_size; ///< the size of the mapping of the completion queue
+    void *m_sqes; ///< the mapping of the entries of the submission queue
+    size_t m_sqes_size; ///< the size of the mapping of the entries
+    unsigned *m_sq_tail; ///< the tail of the submission queue
+    unsigned *m_sq_mask; ///< the mask of the submission queue
+    unsigned *m_sq_array; ///< the indexes of the entries of the submission queue
+    unsigned *m_cq_head; ///< the head of the completion queue
+    unsigned *m_cq_tail; ///< the tail of the completion queue
+    unsigned *m_cq_mask; ///< the mask of the completion queue
+    void *m_cqes; ///< the entries of the completion queue
+    std::vector<io_request> m_requests; ///< the requests that are not completed (user_data is the index)
+};
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_IORING_H */
@@ -8,10 +8,13 @@
 
 #include <unistd.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
 #include <map>
 #include <vector>
 #include "ouroboros/backupfile.h"
 #include "ouroboros/page.h"
+#include "ouroboros/parallel.h"
 
 namespace ouroboros
 {
@@ -30,13 +33,45 @@ struct journal_status_type
     journal_status_type() :
         transaction_id(0),
         state(JS_CLEAN)
+#ifdef OUROBOROS_64BIT_OFFSETS
+        , reserve(0)
+#endif
     {}
     journal_status_type(const pos_type id, const journal_state_type st) :
         transaction_id(id),
         state(st)
+#ifdef OUROBOROS_64BIT_OFFSETS
+        , reserve(0)
+#endif
     {}
     pos_type transaction_id;
     journal_state_type state;
+#ifdef OUROBOROS_64BIT_OFFSETS
+    uint32_t reserve; ///< the padding after the state is written to the page, so it must be defined
+#endif
+};
+
+/**
+ * The header of the manifest of the journal, the manifest (*.jnl) keeps
+ * the indexes of the pages that can be marked by the transactions in
+ * progress, so the recovery reads only these pages
+ */
+struct journal_manifest_header
+{
+    enum
+    {
+        MAGIC = 0x4e414d4a ///< the signature of the manifest ("JMAN")
+    };
+    journal_manifest_header() :
+        magic(MAGIC),
+        active(0),
+        overflow(0),
+        reserved(0)
+    {}
+    uint32_t magic;     ///< the signature of the manifest
+    uint32_t active;    ///< the count of the transactions in progress
+    uint32_t overflow;  ///< the sign that some indexes were not stored (the full scan is needed)
+    uint32_t reserved;  ///< reserved
 };
 
 /**
@@ -62,19 +97,51 @@ public:
     explicit journal_file(const std::string& name);
     journal_file(const std::string& name, const file_region_type& region);
     bool init(); ///< initialize
+    void cancel(); ///< cancel the transaction
+
+    static void remove(const std::string& name); ///< remove a file by the name
+    static void copy(const std::string& source, const std::string& dest); ///< copy a file
+    virtual void save_page(const pos_type index, void *data); ///< save data of the cache page
 protected:
     bool init_indexes(); ///< initialize the indexes of backup pages
+    bool read_manifest(std::vector<pos_type>& pages); ///< read the indexes of the pages from the manifest
+    void reset_manifest(); ///< remove all indexes from the manifest
+    void add_manifest(const pos_type index); ///< add the index of the page to the manifest
+    void finish_manifest(); ///< remove the transaction from the manifest
+    virtual void do_after_sync(); ///< perform an action after the synchronization of the commit
+    virtual void do_set_durability(const durability_level level); ///< set the level of the durability
     virtual void do_before_add_index(const pos_type index, void *page); ///< perform an action before add the index
     virtual void do_after_add_index(const pos_type index, void *page); ///< perform an action after add the index
     virtual void do_after_remove_index(const pos_type index); ///< perform an action after remove the index
+    virtual void do_before_clear_indexes(); ///< perform an action before remove all indexes
     virtual void do_after_clear_indexes(); ///< perform an action after remove all indexes
 private:
+    enum
+    {
+        /// the count of the pages in the block of the recovery
+        RECOVERY_PAGE_COUNT = size_type(OUROBOROS_RECOVERY_BLOCK) > size_type(base_class::CACHE_PAGE_SIZE) ?
+            size_type(OUROBOROS_RECOVERY_BLOCK) / base_class::CACHE_PAGE_SIZE : 1
+    };
     typedef std::vector<pos_type> page_list_type;
-    void restore_transaction(const page_list_type& page_list); ///< restore a transaction
-    void commit_transaction(const page_list_type& page_list); ///< commit a transaction
+    typedef std::pair<pos_type, page_list_type> transaction_state_type; ///< the reference page and the marked pages
+    typedef std::map<pos_type, transaction_state_type> transaction_list_type;
+    typedef std::vector<std::pair<pos_type, journal_status_type> > status_list_type;
+    typedef typename base_class::range_list range_list;
+    class scan_task;
+    class recovery_task;
+    void scan_pages(const range_list& ranges, transaction_list_type& transaction_list) const; ///< look for the pages marked by the transactions
+    void scan_block(const pos_type beg, const pos_type end, char *buffer,
+        status_list_type& status_list) const; ///< read the statuses of the marked pages of the block
+    void recover_transactions(transaction_list_type& transaction_list); ///< restore or commit the transactions
+    void restore_transaction(const page_list_type& page_list, char *buffer); ///< restore a transaction
+    void commit_transaction(const page_list_type& page_list, char *buffer); ///< commit a transaction
 protected:
+    typedef file_lock<FilePage> manifest_file;
     static pos_type s_transaction_id;
     pos_type m_reference_index;
+    manifest_file m_manifest; ///< the manifest of the pages of the transactions
+    bool m_manifest_active; ///< the sign that the transaction is added to the manifest
+    bool m_manifest_sync; ///< the sign that the manifest must be synchronized
 };
 
 //==============================================================================
@@ -85,6 +152,34 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 pos_type journal_file<FilePage, pageCount, File, Cache>::s_transaction_id = getpid();
 
+/**
+ * Remove a file by the name
+ * @param name the name of the file
+ */
+//static
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::remove(const std::string& name)
+{
+    base_class::remove(name + ".jnl");
+    base_class::remove(name);
+}
+
+/**
+ * Copy a file
+ * @param source the source file name
+ * @param dest the dest file name
+ */
+//static
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::copy(const std::string& source,
+    const std::string& dest)
+{
+    base_class::copy(source + ".jnl", dest + ".jnl");
+    base_class::copy(source, dest);
+}
+
 /**
  * Constructor
  * @param name the name of the file
@@ -93,8 +188,12 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 journal_file<FilePage, pageCount, File, Cache>::journal_file(const std::string& name) :
     base_class(name),
-    m_reference_index(NIL)
+    m_reference_index(NIL),
+    m_manifest(name + ".jnl"),
+    m_manifest_active(false),
+    m_manifest_sync(false)
 {
+    m_manifest.set_durability(base_class::durability());
 }
 
 /**
@@ -107,8 +206,12 @@ template <typename FilePage, int pageCount, typename File,
 journal_file<FilePage, pageCount, File, Cache>::journal_file(const std::string& name,
         const file_region_type& region) :
     base_class(name, region),
-    m_reference_index(NIL)
+    m_reference_index(NIL),
+    m_manifest(name + ".jnl"),
+    m_manifest_active(false),
+    m_manifest_sync(false)
 {
+    m_manifest.set_durability(base_class::durability());
 }
 
 /**
@@ -126,45 +229,430 @@ bool journal_file<FilePage, pageCount, File, Cache>::init()
 }
 
 /**
- * Restore a transaction
+ * Cancel the transaction, the restored pages are clean so the transaction
+ * is removed from the manifest
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::cancel()
+{
+    base_class::cancel();
+    if (m_manifest_active)
+    {
+        if (base_class::durability() >= DURABILITY_SYNC)
+        {
+            base_class::sync();
+        }
+        finish_manifest();
+    }
+}
+
+/**
+ * Read the indexes of the pages from the manifest
+ * @param pages the sorted indexes of the pages
+ * @return false if the manifest is not valid or overflowed
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+bool journal_file<FilePage, pageCount, File, Cache>::read_manifest(std::vector<pos_type>& pages)
+{
+    const size_type size = m_manifest.size();
+    if (size < sizeof(journal_manifest_header))
+    {
+        return false;
+    }
+    journal_manifest_header header;
+    m_manifest.read(&header, sizeof(header), 0);
+    if (header.magic != journal_manifest_header::MAGIC || header.overflow != 0)
+    {
+        return false;
+    }
+    pages.resize((size - sizeof(header)) / sizeof(pos_type));
+    if (!pages.empty())
+    {
+        m_manifest.read(&pages[0], pages.size() * sizeof(pos_type), sizeof(header));
+        std::sort(pages.begin(), pages.end());
+        pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+    }
+    return true;
+}
+
+/**
+ * Remove all indexes from the manifest, the pages of the file must be clean
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::reset_manifest()
+{
+    const journal_manifest_header header;
+    m_manifest.resize(sizeof(header));
+    m_manifest.write(&header, sizeof(header), 0);
+    if (base_class::durability() >= DURABILITY_SYNC)
+    {
+        m_manifest.sync();
+    }
+    m_manifest_active = false;
+}
+
+/**
+ * Add the index of the page to the manifest, the first index of
+ * the transaction adds the transaction to the manifest; the indexes of
+ * the finished transactions are removed when there is no transaction in
+ * progress
+ * @param index the index of the page
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::add_manifest(const pos_type index)
+{
+    m_manifest.lock(0, 0);
+    try
+    {
+        size_type size = m_manifest.size();
+        if (!m_manifest_active)
+        {
+            journal_manifest_header header;
+            if (size >= sizeof(header))
+            {
+                m_manifest.read(&header, sizeof(header), 0);
+            }
+            if (header.magic != journal_manifest_header::MAGIC || 0 == header.active)
+            {
+                header = journal_manifest_header();
+                size = m_manifest.resize(sizeof(header));
+            }
+            ++header.active;
+            m_manifest.write(&header, sizeof(header), 0);
+            m_manifest_active = true;
+        }
+        if (size < sizeof(journal_manifest_header) + OUROBOROS_MANIFEST_SIZE * sizeof(pos_type))
+        {
+            m_manifest.write(&index, sizeof(index), size);
+        }
+        else if (size == sizeof(journal_manifest_header) + OUROBOROS_MANIFEST_SIZE * sizeof(pos_type))
+        {
+            // the recovery will scan the whole file
+            const uint32_t overflow = 1;
+            m_manifest.write(&overflow, sizeof(overflow), offsetof(journal_manifest_header, overflow));
+            m_manifest.write(&index, sizeof(index), size);
+        }
+        m_manifest_sync = base_class::durability() >= DURABILITY_SYNC;
+    }
+    catch (...)
+    {
+        m_manifest.unlock(0, 0);
+        throw;
+    }
+    m_manifest.unlock(0, 0);
+}
+
+/**
+ * Remove the transaction from the manifest, the pages of the transaction
+ * must be clean in the file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::finish_manifest()
+{
+    m_manifest_active = false;
+    m_manifest.lock(0, 0);
+    try
+    {
+        journal_manifest_header header;
+        m_manifest.read(&header, sizeof(header), 0);
+        if (header.magic == journal_manifest_header::MAGIC && header.active > 0)
+        {
+            --header.active;
+            m_manifest.write(&header.active, sizeof(header.active),
+                offsetof(journal_manifest_header, active));
+        }
+    }
+    catch (...)
+    {
+        m_manifest.unlock(0, 0);
+        throw;
+    }
+    m_manifest.unlock(0, 0);
+}
+
+/**
+ * Perform an action after the synchronization of the commit, the pages of
+ * the transaction are clean in the file
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::do_after_sync()
+{
+    if (m_manifest_active)
+    {
+        finish_manifest();
+    }
+}
+
+/**
+ * Save data of the cache page, the manifest is synchronized before the page
+ * that is marked by the transaction gets into the file
+ * @param index the index of the cache page
+ * @param data the cache page
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::save_page(const pos_type index, void *data)
+{
+    if (m_manifest_sync)
+    {
+        m_manifest.sync();
+        m_manifest_sync = false;
+    }
+    base_class::save_page(index, data);
+}
+
+/**
+ * The task of looking for the marked pages in the blocks of the file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+class journal_file<FilePage, pageCount, File, Cache>::scan_task
+{
+public:
+    scan_task(const journal_file& file, const range_list& blocks) :
+        m_file(file),
+        m_blocks(blocks),
+        m_status_lists(blocks.size())
+    {}
+    /** read the statuses of the marked pages of the block */
+    void operator()(const pos_type number)
+    {
+        std::vector<char> buffer((m_blocks[number].second - m_blocks[number].first) *
+            base_class::CACHE_PAGE_SIZE);
+        m_file.scan_block(m_blocks[number].first, m_blocks[number].second, &buffer[0],
+            m_status_lists[number]);
+    }
+    /** get the statuses of the marked pages of the block */
+    const status_list_type& status_list(const pos_type number) const
+    {
+        return m_status_lists[number];
+    }
+private:
+    const journal_file& m_file; ///< the file
+    const range_list& m_blocks; ///< the blocks of the pages
+    std::vector<status_list_type> m_status_lists; ///< the statuses of the marked pages of the blocks
+};
+
+/**
+ * The task of the recovery of the transactions
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+class journal_file<FilePage, pageCount, File, Cache>::recovery_task
+{
+public:
+    explicit recovery_task(journal_file& file) :
+        m_file(file)
+    {}
+    /** add the transaction */
+    void add(const pos_type id, transaction_state_type& state)
+    {
+        m_transactions.push_back(std::make_pair(id, &state));
+    }
+    /** get the count of the transactions */
+    count_type count() const
+    {
+        return m_transactions.size();
+    }
+    /** restore or commit the transaction */
+    void operator()(const pos_type number)
+    {
+        transaction_state_type& state = *m_transactions[number].second;
+        const size_t page_count = state.second.size() + 1;
+        std::vector<char> buffer(std::min<size_t>(page_count, RECOVERY_PAGE_COUNT) *
+            base_class::CACHE_PAGE_SIZE);
+        if (NIL == state.first)
+        {
+            OUROBOROS_INFO("\trestore the transaction " << m_transactions[number].first);
+            m_file.restore_transaction(state.second, &buffer[0]);
+        }
+        else
+        {
+            OUROBOROS_INFO("\tcommit the transaction " << m_transactions[number].first);
+            state.second.push_back(state.first);
+            std::sort(state.second.begin(), state.second.end());
+            m_file.commit_transaction(state.second, &buffer[0]);
+        }
+    }
+private:
+    journal_file& m_file; ///< the file
+    std::vector<std::pair<pos_type, transaction_state_type *> > m_transactions; ///< the transactions
+};
+
+/**
+ * Restore a transaction, the adjacent pages are copied from the backup
+ * file by one block
+ * @param page_list the sorted indexes of the pages of the transaction
+ * @param buffer the buffer of the block
  */
 template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void journal_file<FilePage, pageCount, File, Cache>::
-    restore_transaction(const page_list_type& page_list)
+    restore_transaction(const page_list_type& page_list, char *buffer)
 {
-    char buffer[base_class::CACHE_PAGE_SIZE];
-    page_list_type::const_iterator end = page_list.end();
-    for (page_list_type::const_iterator it = page_list.begin(); it != end; ++it)
+    const size_type page_size = base_class::CACHE_PAGE_SIZE;
+    for (size_t n = 0; n < page_list.size();)
     {
-        const pos_type index = *it;
-        OUROBOROS_INFO("\t\trestore the page " << index);
-        base_class::m_backup.read(buffer, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
-        simple_file::do_write(buffer, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        const pos_type beg = page_list[n];
+        pos_type end = beg + 1;
+        for (++n; n < page_list.size() && page_list[n] == end && end - beg < RECOVERY_PAGE_COUNT; ++n)
+        {
+            ++end;
+        }
+        OUROBOROS_INFO("\t\trestore the pages " << beg << "-" << end - 1);
+        base_class::m_backup.read(buffer, (end - beg) * page_size, beg * page_size);
+        // the file is written directly, the pages are written in parallel
+        base_file::do_write(buffer, (end - beg) * page_size, beg * page_size);
     }
 }
 
 /**
- * Commit a transaction
+ * Commit a transaction, the adjacent pages are read and written by one block
+ * @param page_list the sorted indexes of the pages of the transaction
+ * @param buffer the buffer of the block
  */
 template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 void journal_file<FilePage, pageCount, File, Cache>::
-    commit_transaction(const page_list_type& page_list)
+    commit_transaction(const page_list_type& page_list, char *buffer)
 {
-    char buffer[base_class::CACHE_PAGE_SIZE];
-    status_file_page_type status_page(buffer);
-    page_list_type::const_iterator end = page_list.end();
-    for (page_list_type::const_iterator it = page_list.begin(); it != end; ++it)
+    const size_type page_size = base_class::CACHE_PAGE_SIZE;
+    for (size_t n = 0; n < page_list.size();)
     {
-        const pos_type index = *it;
-        OUROBOROS_INFO("\t\tcommit the page " << index);
-        simple_file::do_read(buffer, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
-        status_page.set_status(journal_status_type());
-        simple_file::do_write(buffer, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        const pos_type beg = page_list[n];
+        pos_type end = beg + 1;
+        for (++n; n < page_list.size() && page_list[n] == end && end - beg < RECOVERY_PAGE_COUNT; ++n)
+        {
+            ++end;
+        }
+        OUROBOROS_INFO("\t\tcommit the pages " << beg << "-" << end - 1);
+        base_file::do_read(buffer, (end - beg) * page_size, beg * page_size);
+        for (pos_type index = beg; index < end; ++index)
+        {
+            status_file_page_type status_page(buffer + (index - beg) * page_size);
+            status_page.set_status(journal_status_type());
+        }
+        base_file::do_write(buffer, (end - beg) * page_size, beg * page_size);
+    }
+}
+
+/**
+ * Read the statuses of the marked pages of the block
+ * @param beg the index of the first page of the block
+ * @param end the index of the page after the block
+ * @param buffer the buffer of the block
+ * @param status_list the statuses of the marked pages
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::scan_block(const pos_type beg,
+    const pos_type end, char *buffer, status_list_type& status_list) const
+{
+    const size_type page_size = base_class::CACHE_PAGE_SIZE;
+    base_file::do_read(buffer, (end - beg) * page_size, beg * page_size);
+    for (pos_type index = beg; index < end; ++index)
+    {
+        const status_file_page_type status_page(buffer + (index - beg) * page_size);
+        const journal_status_type index_status = status_page.get_status();
+        if (index_status.state != JS_CLEAN)
+        {
+            status_list.push_back(std::make_pair(index, index_status));
+        }
     }
 }
 
+/**
+ * Look for the pages marked by the transactions, the ranges are read by
+ * the big blocks in parallel
+ * @param ranges the ranges of the pages
+ * @param transaction_list the found transactions
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::scan_pages(const range_list& ranges,
+    transaction_list_type& transaction_list) const
+{
+    range_list blocks;
+    typename range_list::const_iterator end = ranges.end();
+    for (typename range_list::const_iterator it = ranges.begin(); it != end; ++it)
+    {
+        for (pos_type beg = it->first; beg < it->second; beg += RECOVERY_PAGE_COUNT)
+        {
+            blocks.push_back(std::make_pair(beg, std::min<pos_type>(beg + RECOVERY_PAGE_COUNT, it->second)));
+        }
+    }
+    scan_task task(*this, blocks);
+    parallel_for(task, blocks.size(), OUROBOROS_RECOVERY_THREADS);
+    // the pages of the transactions are sorted because the blocks are sorted
+    for (pos_type n = 0; n < blocks.size(); ++n)
+    {
+        const status_list_type& status_list = task.status_list(n);
+        for (typename status_list_type::const_iterator status = status_list.begin();
+            status != status_list.end(); ++status)
+        {
+            const pos_type index = status->first;
+            const journal_status_type& index_status = status->second;
+            typename transaction_list_type::iterator it = transaction_list.find(index_status.transaction_id);
+            switch (index_status.state)
+            {
+                case JS_DIRTY:
+                    if (it != transaction_list.end())
+                    {
+                        it->second.second.push_back(index);
+                    }
+                    else
+                    {
+                        transaction_list.insert(std::make_pair(index_status.transaction_id,
+                                std::make_pair(NIL, page_list_type(1, index))));
+                    }
+                    break;
+                case JS_FIXED:
+                    if (it != transaction_list.end())
+                    {
+                        OUROBOROS_ASSERT(it->second.first == NIL);
+                        it->second.first = index;
+                    }
+                    else
+                    {
+                        transaction_list.insert(std::make_pair(index_status.transaction_id,
+                                std::make_pair(index, page_list_type())));
+                    }
+                    break;
+                case JS_CLEAN:
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * Restore or commit the transactions, the transactions don't have common
+ * pages so they are processed in parallel
+ * @param transaction_list the transactions
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::recover_transactions(
+    transaction_list_type& transaction_list)
+{
+    recovery_task task(*this);
+    typename transaction_list_type::iterator end = transaction_list.end();
+    for (typename transaction_list_type::iterator it = transaction_list.begin(); it != end; ++it)
+    {
+        task.add(it->first, it->second);
+    }
+    parallel_for(task, task.count(), OUROBOROS_RECOVERY_THREADS);
+}
+
 /**
  * Initialize the indexes of backup pages
  * @return the result of the initialization
@@ -173,71 +661,59 @@ template <typename FilePage, int pageCount, typename File,
     template <typename, int, int> class Cache>
 bool journal_file<FilePage, pageCount, File, Cache>::init_indexes()
 {
-    typedef std::pair<pos_type, page_list_type> transaction_state_type;
-    typedef std::map<pos_type, transaction_state_type> transaction_list_type;
     transaction_list_type transaction_list;
-    // look for all transaction that were not finished
-    char buffer[base_class::CACHE_PAGE_SIZE];
-    status_file_page_type status_page(buffer);
-    const count_type count = base_class::size() / base_class::CACHE_PAGE_SIZE;
-    for (pos_type index = 0; index < count; ++index)
+    // look for all transaction that were not finished, only the pages of
+    // the manifest can be marked by them
+    m_manifest.lock(0, 0);
+    try
     {
-        simple_file::do_read(buffer, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
-        journal_status_type index_status = status_page.get_status();
-        transaction_list_type::iterator it = transaction_list.find(index_status.transaction_id);
-        switch (index_status.state)
+        page_list_type pages;
+        range_list ranges;
+        const count_type count = base_class::size() / base_class::CACHE_PAGE_SIZE;
+        if (read_manifest(pages))
         {
-            case JS_DIRTY:
-                if (it != transaction_list.end())
-                {
-                    it->second.second.push_back(index);
-                }
-                else
-                {
-                    transaction_list.insert(std::make_pair(index_status.transaction_id,
-                            std::make_pair(NIL, page_list_type(1, index))));
-                }
-                break;
-            case JS_FIXED:
-                if (it != transaction_list.end())
+            page_list_type::const_iterator end = pages.end();
+            for (page_list_type::const_iterator it = pages.begin(); it != end && *it < count; ++it)
+            {
+                if (ranges.empty() || ranges.back().second != *it)
                 {
-                    OUROBOROS_ASSERT(it->second.first == NIL);
-                    it->second.first = index;
+                    ranges.push_back(std::make_pair(*it, *it + 1));
                 }
                 else
                 {
-                    transaction_list.insert(std::make_pair(index_status.transaction_id,
-                            std::make_pair(index, page_list_type())));
+                    ++ranges.back().second;
                 }
-                break;
-            case JS_CLEAN:
-            default:
-                break;
+            }
         }
-    }
-    if (!transaction_list.empty())
-    {
-        // pocessing found transactions
-        OUROBOROS_INFO("restore the file " << base_class::name());
-        for (transaction_list_type::iterator transaction = transaction_list.begin();
-                transaction != transaction_list.end(); ++transaction)
+        else if (count > 0)
         {
-            if (NIL == transaction->second.first)
-            {
-                OUROBOROS_INFO("\trestore the transaction " << transaction->first);
-                restore_transaction(transaction->second.second);
-            }
-            else
+            ranges.push_back(std::make_pair(0, count));
+        }
+        scan_pages(ranges, transaction_list);
+        if (!transaction_list.empty())
+        {
+            // pocessing found transactions
+            OUROBOROS_INFO("restore the file " << base_class::name());
+            recover_transactions(transaction_list);
+            OUROBOROS_INFO("recovery completed");
+            if (base_class::durability() >= DURABILITY_SYNC)
             {
-                transaction->second.second.push_back(transaction->second.first);
-                OUROBOROS_INFO("\tcommit the transaction " << transaction->first);
-                commit_transaction(transaction->second.second);
+                base_class::sync();
             }
         }
-        OUROBOROS_INFO("recovery completed");
-        return false;
+        // the shared pages can be rolled back by the recovery or be left
+        // busy by the crashed process
+        base_class::m_cache.reset_shared();
+        // all pages are clean
+        reset_manifest();
     }
-    return true;
+    catch (...)
+    {
+        m_manifest.unlock(0, 0);
+        throw;
+    }
+    m_manifest.unlock(0, 0);
+    return transaction_list.empty();
 }
 
 /**
@@ -271,11 +747,8 @@ void journal_file<FilePage, pageCount, File, Cache>::do_after_add_index(const po
     // mark the page as not fixed
     status_file_page_type status_page(page);
     status_page.set_status(journal_status_type(s_transaction_id, JS_DIRTY));
-#ifdef OUROBOROS_SYNC_ENABLED
+    add_manifest(index);
     base_class::do_after_add_index(index, page);
-#else
-    OUROBOROS_UNUSED(index);
-#endif
 }
 
 /**
@@ -302,10 +775,16 @@ void journal_file<FilePage, pageCount, File, Cache>::do_after_remove_index(const
         status_page.set_status(index_status);
         if (is_reference_page)
         {
-            simple_file::do_write(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
-#ifdef OUROBOROS_SYNC_ENABLED
-            base_class::sync();
-#endif
+            if (base_class::durability() >= DURABILITY_COMMIT)
+            {
+                // the page and the synchronization are submitted by one call
+                simple_file::submit_write(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+                base_class::commit_sync(*this);
+            }
+            else
+            {
+                simple_file::do_write(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+            }
         }
     }
     else
@@ -349,12 +828,42 @@ void journal_file<FilePage, pageCount, File, Cache>::do_after_clear_indexes()
         }
         base_class::clean();
         m_reference_index = NIL;
-#ifdef OUROBOROS_SYNC_ENABLED
-        base_class::sync();
-#endif
+        if (base_class::durability() >= DURABILITY_COMMIT)
+        {
+            base_class::defer_sync();
+        }
+        else
+        {
+            finish_manifest();
+        }
     }
 }
 
+/**
+ * Perform an action before remove all indexes, the commit is synchronized
+ * by the reference page
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::do_before_clear_indexes()
+{
+}
+
+/**
+ * Set the level of the durability of the file, the backup file and
+ * the manifest
+ * @param level the level of the durability
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void journal_file<FilePage, pageCount, File, Cache>::do_set_durability(const durability_level level)
+{
+    base_class::do_set_durability(level);
+    m_manifest.set_durability(level);
+}
+
 }    //namespace ouroboros
 
 #endif	/* OUROBOROS_JOURNALFILE_H */
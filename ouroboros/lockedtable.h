@@ -134,6 +134,9 @@ public:
     inline pos_type read_back(void *data, const count_type count) const; ///< read the last records
     inline pos_type find(const void *data, const pos_type beg, const count_type count) const; ///< find a record [beg, beg + count)
     inline pos_type rfind(const void *data, const pos_type end, const count_type count) const; ///< reverse find a record [end - count, end)
+    inline pos_type find(const scan_field& field, const pos_type beg, const count_type count) const; ///< find a record by the field [beg, beg + count)
+    inline pos_type rfind(const scan_field& field, const pos_type end, const count_type count) const; ///< reverse find a record by the field [end - count, end)
+    inline void prefetch(const pos_type beg, const count_type count) const; ///< read the records [beg, beg + count) ahead
 
     inline pos_type beg_pos() const; ///< get the begin position of records
     inline void set_beg_pos(const pos_type pos); ///< set the begin position of records
@@ -167,6 +170,9 @@ public:
     inline void lock_scoped() const; ///< lock the table for writing
     inline void lock_scoped(const size_t timeout) const; ///< lock the table for writing with a timeout
     inline void unlock_scoped() const; ///< unlock the table for writing
+    inline bool lock_optimistic(revision_type& seq) const; ///< begin the optimistic reading of the table
+    inline bool validate_optimistic(const revision_type seq) const; ///< validate the optimistic reading of the table
+    inline bool unlock_optimistic(const revision_type seq) const; ///< end the optimistic reading of the table
 
     inline count_type sharable_count() const; ///< get the count of the reading lock
     inline count_type scoped_count() const; ///< get the count of the writing lock
@@ -767,7 +773,7 @@ inline pos_type locked_table<Table, Source, Key, Interface, Locker>::add(const v
  * @return the position of the next record
  */
 template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
-inline count_type locked_table<Table, Source, Key, Interface, Locker>::remove(const pos_type pos)
+inline pos_type locked_table<Table, Source, Key, Interface, Locker>::remove(const pos_type pos)
 {
     lock_write lock(*this);
     return base_class::remove(pos);
@@ -780,7 +786,7 @@ inline count_type locked_table<Table, Source, Key, Interface, Locker>::remove(co
  * @return the position of the next record
  */
 template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
-inline count_type locked_table<Table, Source, Key, Interface, Locker>::remove(const pos_type beg, const count_type count)
+inline pos_type locked_table<Table, Source, Key, Interface, Locker>::remove(const pos_type beg, const count_type count)
 {
     lock_write lock(*this);
     return base_class::remove(beg, count);
@@ -823,6 +829,18 @@ inline pos_type locked_table<Table, Source, Key, Interface, Locker>::read_front(
     return base_class::read_front(data, count);
 }
 
+/**
+ * Read the records in the range [beg, beg + count) ahead
+ * @param beg the begin position of the records
+ * @param count the count of the records
+ */
+template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
+inline void locked_table<Table, Source, Key, Interface, Locker>::prefetch(const pos_type beg, const count_type count) const
+{
+    lock_read lock(*this);
+    base_class::prefetch(beg, count);
+}
+
 /**
  * Read the last record
  * @param data data of the last record
@@ -876,6 +894,34 @@ inline pos_type locked_table<Table, Source, Key, Interface, Locker>::rfind(const
     return base_class::rfind(data, end, count);
 }
 
+/**
+ * Find a record by the field in the range [beg, beg + count)
+ * @param field the field of the record
+ * @param beg the begin position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
+inline pos_type locked_table<Table, Source, Key, Interface, Locker>::find(const scan_field& field, const pos_type beg, const count_type count) const
+{
+    lock_read lock(*this);
+    return base_class::find(field, beg, count);
+}
+
+/**
+ * Reverse find a record by the field in the range [end - count, end)
+ * @param field the field of the record
+ * @param end the end position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
+inline pos_type locked_table<Table, Source, Key, Interface, Locker>::rfind(const scan_field& field, const pos_type end, const count_type count) const
+{
+    lock_read lock(*this);
+    return base_class::rfind(field, end, count);
+}
+
 /**
  * Get the begin position of records
  * @return the begin position of records
@@ -1113,6 +1159,50 @@ inline void locked_table<Table, Source, Key, Interface, Locker>::unlock_scoped()
     table_lock<table_type, locker_type>::unlock_scoped(*this);
 }
 
+/**
+ * Begin the optimistic reading of the table, the table is read without
+ * the interprocess lock, all read operations are treated as the operations
+ * under the reading lock until the end of the optimistic reading
+ * @param seq the sequence of writing that should be validated after reading
+ * @return the result of the beginning (false if the table is being written)
+ */
+template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
+inline bool locked_table<Table, Source, Key, Interface, Locker>::lock_optimistic(revision_type& seq) const
+{
+    if (m_locker.read_begin(seq))
+    {
+        ++m_sharable_count;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Validate the optimistic reading of the table without ending it
+ * @param seq the sequence of writing that was got at the beginning
+ * @return the result of the validation (false if the table could be changed
+ * since the beginning, so the read data must be discarded)
+ */
+template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
+inline bool locked_table<Table, Source, Key, Interface, Locker>::validate_optimistic(const revision_type seq) const
+{
+    return m_locker.read_validate(seq);
+}
+
+/**
+ * End the optimistic reading of the table
+ * @param seq the sequence of writing that was got at the beginning
+ * @return the result of the validation (false if the table could be changed
+ * while it was being read, so the read data must be discarded)
+ */
+template <template <typename, typename, typename> class Table, typename Source, typename Key, typename Interface, typename Locker>
+inline bool locked_table<Table, Source, Key, Interface, Locker>::unlock_optimistic(const revision_type seq) const
+{
+    assert(m_sharable_count > 0);
+    --m_sharable_count;
+    return m_locker.read_validate(seq);
+}
+
 /**
  * Get the count of the reading lock
  * @return the count of the reading lock
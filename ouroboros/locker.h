@@ -25,6 +25,8 @@ public:
     inline bool lock_sharable(); ///< set the shared lock
     inline bool lock_sharable(const size_t timeout); ///< set the shared lock with a timeout
     inline bool unlock_sharable(); ///< remove the shared lock
+    inline bool read_begin(revision_type& seq) const; ///< begin the optimistic reading
+    inline bool read_validate(const revision_type seq) const; ///< validate the optimistic reading
     inline const char* name() const; ///< get the name of the locker
 private:
     count_type& m_scoped_count;
@@ -89,6 +91,8 @@ struct locker : public Locker, private base_locker
     inline bool lock_sharable(); ///< set the shared lock
     inline bool lock_sharable(const size_t timeout); ///< set the shared lock with a timeout
     inline bool unlock_sharable(); ///< remove the shared lock
+    inline bool read_begin(revision_type& seq) const; ///< begin the optimistic reading
+    inline bool read_validate(const revision_type seq) const; ///< validate the optimistic reading
     inline const char* name() const; ///< get the name of the locker
 };
 
@@ -168,6 +172,28 @@ inline bool base_locker::unlock_sharable()
     return 0 == m_scoped_count && 0 == --m_sharable_count;
 }
 
+/**
+ * Begin the optimistic reading
+ * @param seq the sequence of writing
+ * @return the result of the beginning (false if the exclusive lock is set)
+ */
+inline bool base_locker::read_begin(revision_type& seq) const
+{
+    seq = 0;
+    return 0 == m_scoped_count;
+}
+
+/**
+ * Validate the optimistic reading
+ * @param seq the sequence of writing
+ * @return the result of the validation
+ */
+inline bool base_locker::read_validate(const revision_type seq) const
+{
+    OUROBOROS_UNUSED(seq);
+    return true;
+}
+
 /**
  * Get the name of the locker
  * @return the name of the locker
@@ -299,6 +325,29 @@ inline bool locker<Locker>::unlock_sharable()
     return false;
 }
 
+/**
+ * Begin the optimistic reading, the data can be read without the lock if
+ * the process doesn't hold the exclusive lock and nobody is writing the data
+ * @param seq the sequence of writing that should be validated after reading
+ * @return the result of the beginning
+ */
+template <typename Locker>
+inline bool locker<Locker>::read_begin(revision_type& seq) const
+{
+    return base_locker::read_begin(seq) && Locker::read_begin(seq);
+}
+
+/**
+ * Validate the optimistic reading
+ * @param seq the sequence of writing that was got at the beginning
+ * @return the result of the validation (false if the data could be changed)
+ */
+template <typename Locker>
+inline bool locker<Locker>::read_validate(const revision_type seq) const
+{
+    return Locker::read_validate(seq);
+}
+
 /**
  * Get the name of the locker
  * @return the name of the locker
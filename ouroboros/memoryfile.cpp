@@ -127,6 +127,17 @@ void memory_file::refresh(size_type size, const pos_type pos)
 //    OUROBOROS_THROW_BUG("method not supported");
 }
 
+/**
+ * Read data ahead
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+void memory_file::prefetch(size_type size, const pos_type pos) const
+{
+    OUROBOROS_UNUSED(size);
+    OUROBOROS_UNUSED(pos);
+}
+
 /**
  * Forced synchronization data of the file
  */
@@ -159,6 +170,14 @@ void memory_file::cancel()
     OUROBOROS_THROW_BUG("method not supported");
 }
 
+/**
+ * Synchronize the data of the stopped transaction
+ */
+void memory_file::sync_commit()
+{
+//    OUROBOROS_THROW_BUG("method not supported");
+}
+
 /**
  * Get the state of the transaction
  * @return the state of the transaction
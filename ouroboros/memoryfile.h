@@ -35,11 +35,13 @@ public:
     size_type resize(const size_type size); ///< change the size of the file
     size_type size() const; ///< get the size of the file
     void refresh(size_type size, const pos_type pos); ///< refresh data
+    void prefetch(size_type size, const pos_type pos) const; ///< read data ahead
     void sync() const; ///< forced synchronization data of the file
 
     void start();  ///< start the transaction
     void stop();   ///< stop the transaction
     void cancel(); ///< cancel the transaction
+    void sync_commit(); ///< synchronize the data of the stopped transaction
     transaction_state state() const; ///< get the state of the transaction
 
     static void remove(const std::string& name); ///< remove a file by the name
@@ -0,0 +1,203 @@
+/**
+ * @file   migration.h
+ * The migration of a dataset between the layouts of the file (the size of
+ * the positions is determined by OUROBOROS_64BIT_OFFSETS)
+ */
+
+#ifndef OUROBOROS_MIGRATION_H
+#define	OUROBOROS_MIGRATION_H
+
+#include <iostream>
+#include <vector>
+
+#include "ouroboros/global.h"
+#include "ouroboros/info.h"
+
+namespace ouroboros
+{
+
+/**
+ * The dump of a dataset doesn't depend on the layout of the file: it has
+ * the information about the dataset, the keys of the tables and the packed
+ * records of each table from the first record to the last record, the size
+ * of the numbers is fixed
+ */
+enum
+{
+    DUMP_MAGIC = 0x4f55524f,    ///< the signature of the dump ("OURO")
+    DUMP_VERSION = 1            ///< the version of the dump
+};
+
+/**
+ * Write the number to the dump
+ * @param out the stream of the dump
+ * @param value the number
+ */
+inline void write_dump(std::ostream& out, const uint64_t value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    if (!out)
+    {
+        OUROBOROS_THROW_ERROR(io_error, "error of writing the dump");
+    }
+}
+
+/**
+ * Write the data to the dump
+ * @param out the stream of the dump
+ * @param data the data
+ * @param size the size of the data
+ */
+inline void write_dump(std::ostream& out, const void *data, const size_t size)
+{
+    out.write(static_cast<const char *>(data), size);
+    if (!out)
+    {
+        OUROBOROS_THROW_ERROR(io_error, "error of writing the dump");
+    }
+}
+
+/**
+ * Read the number from the dump
+ * @param in the stream of the dump
+ * @return the number
+ */
+inline uint64_t read_dump(std::istream& in)
+{
+    uint64_t value = 0;
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    if (!in)
+    {
+        OUROBOROS_THROW_ERROR(io_error, "error of reading the dump");
+    }
+    return value;
+}
+
+/**
+ * Read the data from the dump
+ * @param in the stream of the dump
+ * @param data the data
+ * @param size the size of the data
+ */
+inline void read_dump(std::istream& in, void *data, const size_t size)
+{
+    in.read(static_cast<char *>(data), size);
+    if (!in)
+    {
+        OUROBOROS_THROW_ERROR(io_error, "error of reading the dump");
+    }
+}
+
+/**
+ * Write the dump of the dataset, it's done by the build of the library
+ * that created the dataset
+ * @param dataset the dataset
+ * @param out the stream of the dump
+ */
+template <typename DataSet>
+void export_dataset(DataSet& dataset, std::ostream& out)
+{
+    typedef typename DataSet::key_type key_type;
+    typedef typename DataSet::key_list key_list;
+    typedef typename DataSet::record_type record_type;
+    typedef typename DataSet::record_list record_list;
+
+    char user_data[info::DATA_SIZE];
+    dataset.get_user_data(user_data, sizeof(user_data));
+    key_list keys;
+    dataset.get_key_list(keys);
+    write_dump(out, DUMP_MAGIC);
+    write_dump(out, DUMP_VERSION);
+    write_dump(out, dataset.version());
+    write_dump(out, dataset.table_count());
+    write_dump(out, dataset.rec_count());
+    write_dump(out, record_type::static_size());
+    write_dump(out, user_data, sizeof(user_data));
+    write_dump(out, keys.size());
+
+    std::vector<char> buffer;
+    const typename key_list::const_iterator end = keys.end();
+    for (typename key_list::const_iterator it = keys.begin(); it != end; ++it)
+    {
+        const key_type key = *it;
+        typename DataSet::session_read session = dataset.session_rd(key);
+        record_list records(session->count());
+        if (!records.empty())
+        {
+            session->read_front(records);
+        }
+        buffer.resize(records.size() * record_type::static_size());
+        char *data = buffer.empty() ? NULL : &buffer[0];
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            data = static_cast<char *>(records[i].pack(data));
+        }
+        write_dump(out, &key, sizeof(key));
+        write_dump(out, records.size());
+        if (!buffer.empty())
+        {
+            write_dump(out, &buffer[0], buffer.size());
+        }
+    }
+}
+
+/**
+ * Create the dataset from the dump, it's done by the build of the library
+ * that will use the dataset
+ * @param name the name of the new dataset
+ * @param in the stream of the dump
+ */
+template <typename DataSet>
+void import_dataset(const std::string& name, std::istream& in)
+{
+    typedef typename DataSet::key_type key_type;
+    typedef typename DataSet::record_type record_type;
+    typedef typename DataSet::record_list record_list;
+
+    const uint64_t magic = read_dump(in);
+    const uint64_t version = read_dump(in);
+    if (magic != DUMP_MAGIC || version != DUMP_VERSION)
+    {
+        OUROBOROS_THROW_ERROR(compatibility_error, PR(name) << PR(magic) << PR(version) << "the dump is not supported");
+    }
+    const count_type ds_version = read_dump(in);
+    const count_type tbl_count = read_dump(in);
+    const count_type rec_count = read_dump(in);
+    const uint64_t rec_size = read_dump(in);
+    if (rec_size != record_type::static_size())
+    {
+        OUROBOROS_THROW_ERROR(compatibility_error, PR(name) << PR(rec_size) << "the size of the records is different");
+    }
+    char user_data[info::DATA_SIZE];
+    read_dump(in, user_data, sizeof(user_data));
+    const uint64_t key_count = read_dump(in);
+
+    DataSet::remove(name);
+    DataSet dataset(name, tbl_count, rec_count, ds_version, user_data, sizeof(user_data));
+    std::vector<char> buffer;
+    for (uint64_t n = 0; n < key_count; ++n)
+    {
+        key_type key;
+        read_dump(in, &key, sizeof(key));
+        record_list records(read_dump(in));
+        buffer.resize(records.size() * record_type::static_size());
+        if (!buffer.empty())
+        {
+            read_dump(in, &buffer[0], buffer.size());
+        }
+        const char *data = buffer.empty() ? NULL : &buffer[0];
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            data = static_cast<const char *>(records[i].unpack(data));
+        }
+        dataset.add_table(key);
+        if (!records.empty())
+        {
+            dataset.session_wr(key)->add(records);
+        }
+    }
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_MIGRATION_H */
@@ -0,0 +1,81 @@
+#include <pthread.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <string.h>
+
+#include "ouroboros/mmapfile.h"
+
+namespace ouroboros
+{
+
+static __thread sigjmp_buf *s_jump = NULL; ///< the return point of the copying of the thread
+static struct sigaction s_previous; ///< the previous handler of SIGBUS
+static pthread_once_t s_once = PTHREAD_ONCE_INIT; ///< the sign that the handler is installed
+
+/**
+ * Handle SIGBUS, the copying of the mapping is interrupted; the signal
+ * raised by other code is passed to the previous handler
+ * @param sig the signal
+ * @param info the information about the signal
+ * @param context the context of the signal
+ */
+static void bus_handler(int sig, siginfo_t *info, void *context)
+{
+    if (s_jump != NULL)
+    {
+        siglongjmp(*s_jump, 1);
+    }
+    if (s_previous.sa_flags & SA_SIGINFO)
+    {
+        s_previous.sa_sigaction(sig, info, context);
+    }
+    else if (SIG_DFL == s_previous.sa_handler || SIG_IGN == s_previous.sa_handler)
+    {
+        // the faulting access is repeated with the default action
+        sigaction(SIGBUS, &s_previous, NULL);
+    }
+    else
+    {
+        s_previous.sa_handler(sig);
+    }
+}
+
+/**
+ * Install the handler of SIGBUS
+ */
+static void install_handler()
+{
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = bus_handler;
+    // the signal isn't blocked, so the handler can leave by siglongjmp
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGBUS, &action, &s_previous);
+}
+
+/**
+ * Copy the data from the mapping of the file, the access to the mapping
+ * beyond the end of the file (the file was sized down by other process)
+ * raises SIGBUS, such copying is interrupted
+ * @param buffer the buffer of the data
+ * @param data the data of the mapping
+ * @param size the size of the data
+ * @return false if the data is beyond the end of the file
+ */
+bool copy_mapping(void *buffer, const void *data, const size_type size)
+{
+    pthread_once(&s_once, install_handler);
+    sigjmp_buf jump;
+    if (sigsetjmp(jump, 0) != 0)
+    {
+        s_jump = NULL;
+        return false;
+    }
+    s_jump = &jump;
+    memcpy(buffer, data, size);
+    s_jump = NULL;
+    return true;
+}
+
+}   //namespace ouroboros
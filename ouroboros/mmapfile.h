@@ -0,0 +1,171 @@
+/**
+ * @file   mmapfile.h
+ * The file that is read through the memory mapping
+ */
+
+#ifndef OUROBOROS_MMAPFILE_H
+#define	OUROBOROS_MMAPFILE_H
+
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include "ouroboros/filelock.h"
+
+namespace ouroboros
+{
+
+bool copy_mapping(void *buffer, const void *data, const size_type size); ///< copy the data from the mapping of the file
+
+/**
+ * The file with support of locking that is read through the memory mapping,
+ * the data inside the mapping is copied without the system calls; the data
+ * is written by the system calls as before, so the journal and the
+ * synchronization of the file work without changes. The pages are still
+ * copied to the cache of the file, because the pages of the cache must stay
+ * stable during the transaction, so only the system call and the copying
+ * of the kernel are removed.
+ * @attention the file is mapped again when its size is changed or the data
+ * beyond the mapping is read (the file was sized up by other process); the
+ * access to the mapping beyond the end of the file (the file was sized down
+ * by other process) raises SIGBUS, the signal interrupts the copying and
+ * the data is read by the system call
+ */
+template <typename FilePage>
+class mmap_file : public file_lock<FilePage>
+{
+    typedef file_lock<FilePage> base_class;
+public:
+    typedef typename base_class::simple_file simple_file;
+    typedef typename base_class::file_region_type file_region_type;
+    explicit mmap_file(const std::string& name);
+    mmap_file(const std::string& name, const file_region_type& region);
+    virtual ~mmap_file();
+protected:
+    virtual void do_read(void *buffer, size_type size, const pos_type pos) const; ///< read data
+    virtual size_type do_resize(const size_type size); ///< change the size of the file
+    void map() const; ///< map the file to the memory
+    void unmap() const; ///< unmap the file from the memory
+private:
+    mutable void *m_data; ///< the mapping of the file
+    mutable size_type m_size; ///< the size of the mapping
+};
+
+//==============================================================================
+//  mmap_file
+//==============================================================================
+/**
+ * Constructor
+ * @param name the name of the file
+ */
+template <typename FilePage>
+mmap_file<FilePage>::mmap_file(const std::string& name) :
+    base_class(name),
+    m_data(NULL),
+    m_size(0)
+{
+}
+
+/**
+ * Constructor
+ * @param name the name of a file
+ * @param region the region of a file
+ */
+template <typename FilePage>
+mmap_file<FilePage>::mmap_file(const std::string& name, const file_region_type& region) :
+    base_class(name, region),
+    m_data(NULL),
+    m_size(0)
+{
+}
+
+/**
+ * Destructor
+ */
+//virtual
+template <typename FilePage>
+mmap_file<FilePage>::~mmap_file()
+{
+    unmap();
+}
+
+/**
+ * Map the file to the memory, the whole file is mapped
+ */
+template <typename FilePage>
+void mmap_file<FilePage>::map() const
+{
+    unmap();
+    const size_type size = simple_file::do_size();
+    if (size > 0)
+    {
+        void *data = ::mmap(NULL, size, PROT_READ, MAP_SHARED, base_class::fd(), 0);
+        if (MAP_FAILED == data)
+        {
+            OUROBOROS_THROW_ERROR(io_error, "error of mapping: " << PR(base_class::name()) <<
+                PR(size) << PE(errno));
+        }
+        m_data = data;
+        m_size = size;
+    }
+}
+
+/**
+ * Unmap the file from the memory
+ */
+template <typename FilePage>
+void mmap_file<FilePage>::unmap() const
+{
+    if (m_data != NULL)
+    {
+        if (::munmap(m_data, m_size) == -1)
+        {
+            OUROBOROS_ERROR("error of unmapping: " << PR(base_class::name()) << PR(m_size) << PE(errno));
+        }
+        m_data = NULL;
+        m_size = 0;
+    }
+}
+
+/**
+ * Read data
+ * @param buffer the buffer of the data
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+//virtual
+template <typename FilePage>
+void mmap_file<FilePage>::do_read(void *buffer, size_type size, const pos_type pos) const
+{
+    if (pos + size > m_size)
+    {
+        map();
+        if (pos + size > m_size)
+        {
+            base_class::do_read(buffer, size, pos);
+            return;
+        }
+    }
+    if (!copy_mapping(buffer, static_cast<const char *>(m_data) + pos, size))
+    {
+        // the data is beyond the end of the file
+        base_class::do_read(buffer, size, pos);
+    }
+}
+
+/**
+ * Change the size of the file, the file will be mapped again by the next
+ * reading
+ * @param size the size of the file
+ * @return the size of the file
+ */
+//virtual
+template <typename FilePage>
+size_type mmap_file<FilePage>::do_resize(const size_type size)
+{
+    unmap();
+    return base_class::do_resize(size);
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_MMAPFILE_H */
@@ -18,7 +18,7 @@ namespace ouroboros
 template <typename Node, typename Table>
 class node_cache
 {
-    friend class cache <node_cache, sizeof(Node), 64>;
+    friend class basic_cache<node_cache, sizeof(Node), 64, hash_map>;
 public:
     typedef Node node_type;
     typedef Table table_type;
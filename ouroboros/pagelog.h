@@ -0,0 +1,119 @@
+/**
+ * @file   pagelog.h
+ * The log of the changed pages of a file
+ */
+
+#ifndef OUROBOROS_PAGELOG_H
+#define	OUROBOROS_PAGELOG_H
+
+#include "ouroboros/global.h"
+
+namespace ouroboros
+{
+
+/**
+ * The log of the changed pages of a file, a writer publishes the ranges of
+ * the pages that are changed by a transaction, thus a reader releases only
+ * these pages from its cache instead of all pages of a table
+ * @attention the log keeps only last logSize ranges, if a reader falls behind
+ * then it has to release all pages
+ */
+template <int logSize = OUROBOROS_PAGE_LOG_SIZE>
+class page_log
+{
+public:
+    enum { LOG_SIZE = logSize };
+
+    inline page_log();
+
+    inline revision_type head() const; ///< get the number of the next range
+    inline revision_type publish(const pos_type beg, const pos_type end); ///< publish the range of the changed pages
+    inline bool read(const revision_type seq, pos_type& beg, pos_type& end) const; ///< read the range of the changed pages
+private:
+    /** the range of the changed pages */
+    struct range_type
+    {
+        volatile revision_type seq; ///< the number of the range + 1 (0 if the range is being written)
+        volatile pos_type beg; ///< the first changed page
+        volatile pos_type end; ///< the page after the last changed page
+    };
+    volatile revision_type m_head; ///< the number of the next range
+    range_type m_ranges[LOG_SIZE]; ///< the ranges of the changed pages
+};
+
+//==============================================================================
+//  page_log
+//==============================================================================
+/**
+ * Constructor
+ */
+template <int logSize>
+inline page_log<logSize>::page_log() :
+    m_head(0)
+{
+    for (size_t i = 0; i < LOG_SIZE; ++i)
+    {
+        m_ranges[i].seq = 0;
+        m_ranges[i].beg = 0;
+        m_ranges[i].end = 0;
+    }
+}
+
+/**
+ * Get the number of the next range
+ * @return the number of the next range
+ */
+template <int logSize>
+inline revision_type page_log<logSize>::head() const
+{
+    const revision_type result = m_head;
+    __sync_synchronize();
+    return result;
+}
+
+/**
+ * Publish the range of the changed pages
+ * @param beg the first changed page
+ * @param end the page after the last changed page
+ * @return the number of the range
+ */
+template <int logSize>
+inline revision_type page_log<logSize>::publish(const pos_type beg, const pos_type end)
+{
+    const revision_type seq = __sync_fetch_and_add(&m_head, 1);
+    range_type& range = m_ranges[seq % LOG_SIZE];
+    range.seq = 0;
+    __sync_synchronize();
+    range.beg = beg;
+    range.end = end;
+    __sync_synchronize();
+    range.seq = seq + 1;
+    return seq;
+}
+
+/**
+ * Read the range of the changed pages
+ * @param seq the number of the range
+ * @param beg the first changed page
+ * @param end the page after the last changed page
+ * @return the result of the reading (false if the range is overwritten or
+ * isn't written yet)
+ */
+template <int logSize>
+inline bool page_log<logSize>::read(const revision_type seq, pos_type& beg, pos_type& end) const
+{
+    const range_type& range = m_ranges[seq % LOG_SIZE];
+    if (range.seq != seq + 1)
+    {
+        return false;
+    }
+    __sync_synchronize();
+    beg = range.beg;
+    end = range.end;
+    __sync_synchronize();
+    return range.seq == seq + 1;
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_PAGELOG_H */
@@ -0,0 +1,171 @@
+/**
+ * @file   parallel.h
+ * The parallel execution of the independent tasks
+ */
+
+#ifndef OUROBOROS_PARALLEL_H
+#define	OUROBOROS_PARALLEL_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "ouroboros/global.h"
+#include "ouroboros/error.h"
+
+namespace ouroboros
+{
+
+/**
+ * The parallel execution of the independent tasks, the worker threads and
+ * the calling thread take the tasks one by one until all tasks are done;
+ * the error of a task stops the taking of the tasks and it is thrown after
+ * the end of all threads
+ * @attention the task (the method operator()(const pos_type number)) must
+ * be safe for the concurrent calls with the different numbers
+ */
+template <typename Task>
+class parallel_tasks
+{
+public:
+    parallel_tasks(Task& task, const count_type count);
+    void run(const count_type thread_count); ///< execute all tasks
+protected:
+    static void* thread_func(void *arg); ///< the function of the worker thread
+    void execute(); ///< execute the tasks until all tasks are taken
+    void set_error(const bool bug, const char *message); ///< set the error of the task
+private:
+    Task& m_task; ///< the task
+    const count_type m_count; ///< the count of the tasks
+    volatile count_type m_next; ///< the number of the next task
+    volatile int32_t m_failed; ///< the sign of the error
+    bool m_bug; ///< the sign that the error is a bug
+    std::string m_error; ///< the message of the first error
+};
+
+/**
+ * Execute the tasks in parallel
+ * @param task the task (the method operator()(const pos_type number))
+ * @param count the count of the tasks
+ * @param thread_count the maximum count of the threads
+ */
+template <typename Task>
+inline void parallel_for(Task& task, const count_type count, const count_type thread_count)
+{
+    parallel_tasks<Task> tasks(task, count);
+    tasks.run(thread_count);
+}
+
+//==============================================================================
+//  parallel_tasks
+//==============================================================================
+/**
+ * Constructor
+ * @param task the task (the method operator()(const pos_type number))
+ * @param count the count of the tasks
+ */
+template <typename Task>
+parallel_tasks<Task>::parallel_tasks(Task& task, const count_type count) :
+    m_task(task),
+    m_count(count),
+    m_next(0),
+    m_failed(0),
+    m_bug(false)
+{
+}
+
+/**
+ * The function of the worker thread
+ * @param arg the pointer to the tasks
+ * @return NULL
+ */
+//static
+template <typename Task>
+void* parallel_tasks<Task>::thread_func(void *arg)
+{
+    static_cast<parallel_tasks<Task> *>(arg)->execute();
+    return NULL;
+}
+
+/**
+ * Set the error of the task, only the first error is kept
+ * @param bug the sign that the error is a bug
+ * @param message the message of the error
+ */
+template <typename Task>
+void parallel_tasks<Task>::set_error(const bool bug, const char *message)
+{
+    if (__sync_bool_compare_and_swap(&m_failed, 0, 1))
+    {
+        m_bug = bug;
+        m_error = message;
+    }
+}
+
+/**
+ * Execute the tasks until all tasks are taken or an error occurs
+ */
+template <typename Task>
+void parallel_tasks<Task>::execute()
+{
+    for (count_type number = __sync_fetch_and_add(&m_next, 1); number < m_count && 0 == m_failed;
+        number = __sync_fetch_and_add(&m_next, 1))
+    {
+        try
+        {
+            m_task(number);
+        }
+        catch (bug_error& e)
+        {
+            set_error(true, e.what());
+        }
+        catch (std::exception& e)
+        {
+            set_error(false, e.what());
+        }
+        catch (...)
+        {
+            set_error(false, "unknown error");
+        }
+    }
+}
+
+/**
+ * Execute all tasks, the calling thread is one of the workers
+ * @param thread_count the maximum count of the threads
+ */
+template <typename Task>
+void parallel_tasks<Task>::run(const count_type thread_count)
+{
+    const count_type count = thread_count < m_count ? thread_count : m_count;
+    std::vector<pthread_t> threads;
+    threads.reserve(count);
+    for (count_type i = 1; i < count; ++i)
+    {
+        pthread_t thread;
+        // if the thread can't be created the other threads execute its tasks
+        if (pthread_create(&thread, NULL, thread_func, this) == 0)
+        {
+            threads.push_back(thread);
+        }
+    }
+    execute();
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    if (m_failed != 0)
+    {
+        if (m_bug)
+        {
+            OUROBOROS_THROW_BUG(m_error);
+        }
+        OUROBOROS_THROW_ERROR(io_error, m_error);
+    }
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_PARALLEL_H */
@@ -0,0 +1,581 @@
+/**
+ * @file   probemap.h
+ * The class probe map (the hash map with open addressing)
+ */
+
+#ifndef OUROBOROS_PROBEMAP_H
+#define	OUROBOROS_PROBEMAP_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "ouroboros/global.h"
+
+namespace ouroboros
+{
+
+/**
+ * The default capacity of a probe_map container, it is the power of two that
+ * is not less than the double count of items, thus the load factor isn't
+ * greater than 0.5
+ */
+template <int count, int capacity = 1, bool enough = (capacity >= 2 * count)>
+struct probe_capacity
+{
+    enum { VALUE = probe_capacity<count, 2 * capacity>::VALUE };
+};
+
+template <int count, int capacity>
+struct probe_capacity<count, capacity, true>
+{
+    enum { VALUE = capacity };
+};
+
+template <typename Key, typename Value, int itemCount>
+class probe_map;
+
+/**
+ * The item iterator of a probe_map container
+ */
+template <typename Map>
+class probe_iterator
+{
+    template <typename Key, typename Value, int itemCount> friend class probe_map;
+    typedef probe_iterator<Map> self_type;
+    typedef Map map_type;
+public:
+    typedef typename map_type::key_type key_type;
+    typedef typename map_type::mapped_type mapped_type;
+    typedef typename map_type::value_type value_type;
+    probe_iterator();
+    explicit probe_iterator(const map_type *map);
+    probe_iterator(const map_type *map, const size_t slot);
+    probe_iterator(const self_type& iter);
+    self_type& operator++ ();
+    self_type operator++ (int );
+
+    self_type& operator= (const self_type& iter);
+    const self_type& operator++ () const;
+    const self_type operator++ (int ) const;
+
+    bool operator== (const self_type& iter) const;
+    bool operator!= (const self_type& iter) const;
+
+    value_type* operator-> ();
+    value_type& operator* ();
+    const value_type* operator-> () const;
+    const value_type& operator* () const;
+private:
+    const map_type *m_map;
+    mutable size_t m_slot;
+};
+
+/**
+ * The probe_map container is the hash map with open addressing (linear
+ * probing, Robin Hood hashing) that keeps the items in the array of slots
+ * allocated in advance, so inserting doesn't allocate memory; the count of
+ * items must not exceed the itemCount argument or the count that is reserved
+ * @attention inserting or erasing of an item invalidates the iterators
+ */
+template <typename Key, typename Value, int itemCount>
+class probe_map
+{
+    typedef probe_map<Key, Value, itemCount> self_type;
+    friend class probe_iterator<self_type>;
+public:
+    enum
+    {
+        ITEM_COUNT = itemCount,
+        SLOT_COUNT = probe_capacity<itemCount>::VALUE
+    };
+    typedef probe_iterator<self_type> iterator;
+    typedef const iterator const_iterator;
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef std::pair<key_type, mapped_type> value_type;
+
+    probe_map();
+
+    void reserve(const size_t count); ///< set the count of items, the container is cleared
+    size_t capacity() const; ///< get the count of items that can be inserted
+
+    iterator find(const key_type& key) const;
+    void insert(const value_type& value);
+    void erase(const key_type& key);
+    void erase(const_iterator& it);
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+protected:
+    inline size_t home_slot(const key_type& key) const; ///< get the home slot of the key
+    inline size_t distance(const size_t beg, const size_t end) const; ///< get the distance between slots
+    inline size_t find_slot(const key_type& key) const; ///< find the slot of the key
+    inline size_t next_slot(size_t slot) const; ///< find the busy slot after the slot
+    void erase_slot(size_t slot); ///< erase the item from the slot
+private:
+    mutable std::vector<value_type> m_items;
+    std::vector<char> m_busy;
+    size_t m_item_count; ///< the count of items that can be inserted
+    size_t m_slot_count; ///< the count of slots (the power of two)
+    size_t m_count;
+};
+
+//==============================================================================
+//  probe_iterator
+//==============================================================================
+/**
+ * Constructor
+ */
+template <typename Map>
+probe_iterator<Map>::probe_iterator() :
+    m_map(NULL),
+    m_slot(0)
+{
+}
+
+/**
+ * Constructor
+ * @param map the probe_map container
+ */
+template <typename Map>
+probe_iterator<Map>::probe_iterator(const map_type *map) :
+    m_map(map),
+    m_slot(map->m_slot_count)
+{
+}
+
+/**
+ * Constructor
+ * @param map the probe_map container
+ * @param slot the slot of the item
+ */
+template <typename Map>
+probe_iterator<Map>::probe_iterator(const map_type *map, const size_t slot) :
+    m_map(map),
+    m_slot(slot)
+{
+}
+
+/**
+ * Constructor
+ * @param iter the copied iterator
+ */
+template <typename Map>
+probe_iterator<Map>::probe_iterator(const self_type& iter) :
+    m_map(iter.m_map),
+    m_slot(iter.m_slot)
+{
+}
+
+/**
+ * Increment operator
+ * @return the iterator on the current item
+ */
+template <typename Map>
+typename probe_iterator<Map>::self_type& probe_iterator<Map>::operator++ ()
+{
+    m_slot = m_map->next_slot(m_slot);
+    return *this;
+}
+
+/**
+ * Increment operator
+ * @return the iterator on the previous item
+ */
+template <typename Map>
+typename probe_iterator<Map>::self_type probe_iterator<Map>::operator++ (int )
+{
+    self_type temp(*this);
+    operator++();
+    return self_type(temp);
+}
+
+/**
+ * Operator =
+ * @param iter the copied iterator
+ * @return the iterator
+ */
+template <typename Map>
+typename probe_iterator<Map>::self_type& probe_iterator<Map>::operator= (const self_type& iter)
+{
+    m_map = iter.m_map;
+    m_slot = iter.m_slot;
+    return *this;
+}
+
+/**
+ * Increment operator
+ * @return the iterator on the current item
+ */
+template <typename Map>
+const typename probe_iterator<Map>::self_type& probe_iterator<Map>::operator++ () const
+{
+    m_slot = m_map->next_slot(m_slot);
+    return *this;
+}
+
+/**
+ * Increment operator
+ * @return the iterator on the previous item
+ */
+template <typename Map>
+const typename probe_iterator<Map>::self_type probe_iterator<Map>::operator++ (int ) const
+{
+    self_type temp(*this);
+    operator++();
+    return self_type(temp);
+}
+
+/**
+ * Operator ==
+ * @param iter the iterator for comparing
+ * @return the result of the comparing
+ */
+template <typename Map>
+bool probe_iterator<Map>::operator== (const self_type& iter) const
+{
+    return (m_map == iter.m_map) && (m_slot == iter.m_slot);
+}
+
+/**
+ * Operator !=
+ * @param iter the iterator for comparing
+ * @return the result of the comparing
+ */
+template <typename Map>
+bool probe_iterator<Map>::operator!= (const self_type& iter) const
+{
+    return (m_map != iter.m_map) || (m_slot != iter.m_slot);
+}
+
+/**
+ * Operator->
+ * @return pointer to yourself
+ */
+template <typename Map>
+typename probe_iterator<Map>::value_type* probe_iterator<Map>::operator-> ()
+{
+    return &m_map->m_items[m_slot];
+}
+
+/**
+ * Operator*
+ * @return reference to yourself
+ */
+template <typename Map>
+typename probe_iterator<Map>::value_type& probe_iterator<Map>::operator* ()
+{
+    return m_map->m_items[m_slot];
+}
+
+/**
+ * Operator->
+ * @return pointer to yourself
+ */
+template <typename Map>
+const typename probe_iterator<Map>::value_type* probe_iterator<Map>::operator-> () const
+{
+    return &m_map->m_items[m_slot];
+}
+
+/**
+ * Operator*
+ * @return reference to yourself
+ */
+template <typename Map>
+const typename probe_iterator<Map>::value_type& probe_iterator<Map>::operator* () const
+{
+    return m_map->m_items[m_slot];
+}
+
+//==============================================================================
+//  probe_map
+//==============================================================================
+/**
+ * Constructor
+ */
+template <typename Key, typename Value, int itemCount>
+probe_map<Key, Value, itemCount>::probe_map() :
+    m_items(SLOT_COUNT),
+    m_busy(SLOT_COUNT, 0),
+    m_item_count(ITEM_COUNT),
+    m_slot_count(SLOT_COUNT),
+    m_count(0)
+{
+}
+
+/**
+ * Set the count of items that can be inserted, the container is cleared
+ * @param count the count of items
+ */
+template <typename Key, typename Value, int itemCount>
+void probe_map<Key, Value, itemCount>::reserve(const size_t count)
+{
+    size_t slot_count = 1;
+    while (slot_count < 2 * count)
+    {
+        slot_count *= 2;
+    }
+    m_items.assign(slot_count, value_type());
+    m_busy.assign(slot_count, 0);
+    m_item_count = count;
+    m_slot_count = slot_count;
+    m_count = 0;
+}
+
+/**
+ * Get the count of items that can be inserted
+ * @return the count of items
+ */
+template <typename Key, typename Value, int itemCount>
+size_t probe_map<Key, Value, itemCount>::capacity() const
+{
+    return m_item_count;
+}
+
+/**
+ * Get the home slot of the key
+ * @param key the key
+ * @return the home slot of the key
+ */
+template <typename Key, typename Value, int itemCount>
+inline size_t probe_map<Key, Value, itemCount>::home_slot(const key_type& key) const
+{
+    return size_t(key) & (m_slot_count - 1);
+}
+
+/**
+ * Get the distance between slots
+ * @param beg the first slot
+ * @param end the last slot
+ * @return the distance from the first slot to the last slot
+ */
+template <typename Key, typename Value, int itemCount>
+inline size_t probe_map<Key, Value, itemCount>::distance(const size_t beg, const size_t end) const
+{
+    return (end - beg) & (m_slot_count - 1);
+}
+
+/**
+ * Find the slot of the key, the search is stopped when the item that is
+ * closer to its home slot than the key is met
+ * @param key the key
+ * @return the slot of the key or the count of slots if the key isn't found
+ */
+template <typename Key, typename Value, int itemCount>
+inline size_t probe_map<Key, Value, itemCount>::find_slot(const key_type& key) const
+{
+    size_t slot = home_slot(key);
+    size_t dist = 0;
+    while (m_busy[slot])
+    {
+        if (key == m_items[slot].first)
+        {
+            return slot;
+        }
+        if (distance(home_slot(m_items[slot].first), slot) < dist)
+        {
+            break;
+        }
+        slot = (slot + 1) & (m_slot_count - 1);
+        ++dist;
+    }
+    return m_slot_count;
+}
+
+/**
+ * Find the busy slot after the slot
+ * @param slot the slot
+ * @return the busy slot or the count of slots if there isn't any busy slot
+ */
+template <typename Key, typename Value, int itemCount>
+inline size_t probe_map<Key, Value, itemCount>::next_slot(size_t slot) const
+{
+    while (++slot < m_slot_count)
+    {
+        if (m_busy[slot])
+        {
+            break;
+        }
+    }
+    return slot;
+}
+
+/**
+ * Find an item of the container by the key
+ * @param key the key
+ * @return the iterator on the found item
+ */
+template <typename Key, typename Value, int itemCount>
+typename probe_map<Key, Value, itemCount>::iterator
+    probe_map<Key, Value, itemCount>::find(const key_type& key) const
+{
+    return iterator(this, find_slot(key));
+}
+
+/**
+ * Insert the item to the container, the item takes the slot of any item
+ * that is closer to its home slot (Robin Hood hashing), and the displaced
+ * item is inserted further
+ * @param value the key and the value
+ */
+template <typename Key, typename Value, int itemCount>
+void probe_map<Key, Value, itemCount>::insert(const value_type& value)
+{
+    if (find_slot(value.first) != m_slot_count)
+    {
+        return;
+    }
+    if (m_item_count == m_count)
+    {
+        OUROBOROS_THROW_BUG("the probe map is full " << PR(m_count));
+    }
+    value_type item = value;
+    size_t slot = home_slot(item.first);
+    size_t dist = 0;
+    while (m_busy[slot])
+    {
+        const size_t item_dist = distance(home_slot(m_items[slot].first), slot);
+        if (item_dist < dist)
+        {
+            std::swap(item, m_items[slot]);
+            dist = item_dist;
+        }
+        slot = (slot + 1) & (m_slot_count - 1);
+        ++dist;
+    }
+    m_items[slot] = item;
+    m_busy[slot] = true;
+    ++m_count;
+}
+
+/**
+ * Erase the item from the slot, the following items of the probe sequence
+ * are shifted back until an item in its home slot, so the container doesn't
+ * need any tombstones
+ * @param slot the slot of the item
+ */
+template <typename Key, typename Value, int itemCount>
+void probe_map<Key, Value, itemCount>::erase_slot(size_t slot)
+{
+    size_t next = (slot + 1) & (m_slot_count - 1);
+    while (m_busy[next] && home_slot(m_items[next].first) != next)
+    {
+        m_items[slot] = m_items[next];
+        slot = next;
+        next = (next + 1) & (m_slot_count - 1);
+    }
+    m_busy[slot] = false;
+    --m_count;
+}
+
+/**
+ * Erase an item by the key
+ * @param key the key
+ */
+template <typename Key, typename Value, int itemCount>
+void probe_map<Key, Value, itemCount>::erase(const key_type& key)
+{
+    const size_t slot = find_slot(key);
+    if (slot != m_slot_count)
+    {
+        erase_slot(slot);
+    }
+}
+
+/**
+ * Erase an item
+ * @param it the iterator on the item
+ */
+template <typename Key, typename Value, int itemCount>
+void probe_map<Key, Value, itemCount>::erase(const_iterator& it)
+{
+    if (it.m_slot != m_slot_count)
+    {
+        erase_slot(it.m_slot);
+    }
+}
+
+/**
+ * Clear the container
+ */
+template <typename Key, typename Value, int itemCount>
+void probe_map<Key, Value, itemCount>::clear()
+{
+    m_busy.assign(m_slot_count, 0);
+    m_count = 0;
+}
+
+/**
+ * Get the count of items in the container
+ * @return the count of items
+ */
+template <typename Key, typename Value, int itemCount>
+size_t probe_map<Key, Value, itemCount>::size() const
+{
+    return m_count;
+}
+
+/**
+ * Check the container is empty
+ * @return the result of the checking
+ */
+template <typename Key, typename Value, int itemCount>
+bool probe_map<Key, Value, itemCount>::empty() const
+{
+    return 0 == m_count;
+}
+
+/**
+ * Get the iterator on the first item
+ * @return the iterator on the first item
+ */
+template <typename Key, typename Value, int itemCount>
+typename probe_map<Key, Value, itemCount>::iterator
+    probe_map<Key, Value, itemCount>::begin()
+{
+    return iterator(this, 0 == m_count ? m_slot_count : m_busy[0] ? 0 : next_slot(0));
+}
+
+/**
+ * Get the iterator on the end of the container
+ * @return the iterator on the end of the container
+ */
+template <typename Key, typename Value, int itemCount>
+typename probe_map<Key, Value, itemCount>::iterator
+    probe_map<Key, Value, itemCount>::end()
+{
+    return iterator(this);
+}
+
+/**
+ * Get the iterator on the first item
+ * @return the iterator on the first item
+ */
+template <typename Key, typename Value, int itemCount>
+typename probe_map<Key, Value, itemCount>::const_iterator
+    probe_map<Key, Value, itemCount>::begin() const
+{
+    return iterator(this, 0 == m_count ? m_slot_count : m_busy[0] ? 0 : next_slot(0));
+}
+
+/**
+ * Get the iterator on the end of the container
+ * @return the iterator on the end of the container
+ */
+template <typename Key, typename Value, int itemCount>
+typename probe_map<Key, Value, itemCount>::const_iterator
+    probe_map<Key, Value, itemCount>::end() const
+{
+    return const_iterator(this);
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_PROBEMAP_H */
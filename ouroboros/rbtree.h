@@ -992,7 +992,7 @@ void rbtree<PNode>::verify_path(pnode_type pnode, count_type black_count, count_
     }
     else
     {
-        if (NIL == path_black_count)
+        if (count_type(NIL) == path_black_count)
         {
             path_black_count = black_count;
         }
@@ -1010,7 +1010,7 @@ void rbtree<PNode>::verify_path(pnode_type pnode, count_type black_count, count_
 template <typename PNode>
 void rbtree<PNode>::verify_path(pnode_type pnode) const
 {
-    count_type path_black_count = NIL;
+    count_type path_black_count = count_type(NIL);
     verify_path(pnode, 0, path_black_count);
 }
 #endif
@@ -33,6 +33,7 @@ public:
     inline size_type size() const;
     inline field1_type field1() const;
     inline void field1(const field1_type& field);
+    static inline field1_type unpack_field1(const void *in);
 
     inline bool operator == (const record_type& o) const;
     inline bool operator != (const record_type& o) const;
@@ -64,6 +65,7 @@ public:
     inline size_type size() const;
     inline field2_type field2() const;
     inline void field2(const field2_type& field);
+    static inline field2_type unpack_field2(const void *in);
 
     inline bool operator == (const record_type& o) const;
     inline bool operator != (const record_type& o) const;
@@ -96,6 +98,7 @@ public:
     inline size_type size() const;
     inline field3_type field3() const;
     inline void field3(const field3_type& field);
+    static inline field3_type unpack_field3(const void *in);
 
     inline bool operator == (const record_type& o) const;
     inline bool operator != (const record_type& o) const;
@@ -129,6 +132,7 @@ public:
     inline size_type size() const;
     inline field4_type field4() const;
     inline void field4(const field4_type& field);
+    static inline field4_type unpack_field4(const void *in);
 
     inline bool operator == (const record_type& o) const;
     inline bool operator != (const record_type& o) const;
@@ -163,6 +167,7 @@ public:
     inline size_type size() const;
     inline field5_type field5() const;
     inline void field5(const field5_type& field);
+    static inline field5_type unpack_field5(const void *in);
 
     inline bool operator == (const record_type& o) const;
     inline bool operator != (const record_type& o) const;
@@ -198,6 +203,7 @@ public:
     inline size_type size() const;
     inline field6_type field6() const;
     inline void field6(const field6_type& field);
+    static inline field6_type unpack_field6(const void *in);
 
     inline bool operator == (const record_type& o) const;
     inline bool operator != (const record_type& o) const;
@@ -265,6 +271,15 @@ inline typename record1<F1>::field1_type record1<F1>::field1() const
     return m_field1.data();
 }
 
+//static
+template <typename F1>
+inline typename record1<F1>::field1_type record1<F1>::unpack_field1(const void *in)
+{
+    F1 field;
+    field.unpack(in);
+    return field.data();
+}
+
 template <typename F1>
 inline bool record1<F1>::operator == (const record_type& o) const
 {
@@ -354,6 +369,15 @@ inline typename record2<F1, F2>::field2_type record2<F1, F2>::field2() const
     return m_field2.data();
 }
 
+//static
+template <typename F1, typename F2>
+inline typename record2<F1, F2>::field2_type record2<F1, F2>::unpack_field2(const void *in)
+{
+    F2 field;
+    field.unpack(static_cast<const char *>(in) + base_class::static_size());
+    return field.data();
+}
+
 template <typename F1, typename F2>
 inline bool record2<F1, F2>::operator == (const record_type& o) const
 {
@@ -446,6 +470,15 @@ inline typename record3<F1, F2, F3>::field3_type record3<F1, F2, F3>::field3() c
     return m_field3.data();
 }
 
+//static
+template <typename F1, typename F2, typename F3>
+inline typename record3<F1, F2, F3>::field3_type record3<F1, F2, F3>::unpack_field3(const void *in)
+{
+    F3 field;
+    field.unpack(static_cast<const char *>(in) + base_class::static_size());
+    return field.data();
+}
+
 template <typename F1, typename F2, typename F3>
 inline bool record3<F1, F2, F3>::operator == (const record_type& o) const
 {
@@ -540,6 +573,15 @@ inline typename record4<F1, F2, F3, F4>::field4_type record4<F1, F2, F3, F4>::fi
     return m_field4.data();
 }
 
+//static
+template <typename F1, typename F2, typename F3, typename F4>
+inline typename record4<F1, F2, F3, F4>::field4_type record4<F1, F2, F3, F4>::unpack_field4(const void *in)
+{
+    F4 field;
+    field.unpack(static_cast<const char *>(in) + base_class::static_size());
+    return field.data();
+}
+
 template <typename F1, typename F2, typename F3, typename F4>
 inline bool record4<F1, F2, F3, F4>::operator == (const record_type& o) const
 {
@@ -635,6 +677,15 @@ inline typename record5<F1, F2, F3, F4, F5>::field5_type record5<F1, F2, F3, F4,
     return m_field5.data();
 }
 
+//static
+template <typename F1, typename F2, typename F3, typename F4, typename F5>
+inline typename record5<F1, F2, F3, F4, F5>::field5_type record5<F1, F2, F3, F4, F5>::unpack_field5(const void *in)
+{
+    F5 field;
+    field.unpack(static_cast<const char *>(in) + base_class::static_size());
+    return field.data();
+}
+
 template <typename F1, typename F2, typename F3, typename F4, typename F5>
 inline bool record5<F1, F2, F3, F4, F5>::operator == (const record_type& o) const
 {
@@ -731,6 +782,15 @@ inline typename record6<F1, F2, F3, F4, F5, F6>::field6_type record6<F1, F2, F3,
     return m_field6.data();
 }
 
+//static
+template <typename F1, typename F2, typename F3, typename F4, typename F5, typename F6>
+inline typename record6<F1, F2, F3, F4, F5, F6>::field6_type record6<F1, F2, F3, F4, F5, F6>::unpack_field6(const void *in)
+{
+    F6 field;
+    field.unpack(static_cast<const char *>(in) + base_class::static_size());
+    return field.data();
+}
+
 template <typename F1, typename F2, typename F3, typename F4, typename F5, typename F6>
 inline bool record6<F1, F2, F3, F4, F5, F6>::operator == (const record_type& o) const
 {
@@ -0,0 +1,663 @@
+/**
+ * @file   redofile.h
+ * The file with support of the redo log
+ */
+
+#ifndef OUROBOROS_REDOFILE_H
+#define	OUROBOROS_REDOFILE_H
+
+#include <string.h>
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include "ouroboros/cachefile.h"
+
+namespace ouroboros
+{
+
+/** the header of a block of the redo log, the block has the records of one transaction */
+struct redo_block_header
+{
+    uint32_t magic;     ///< the signature of the block
+    uint32_t checksum;  ///< the checksum of the records
+    size_type size;     ///< the size of the records
+};
+
+/** the header of a record of the redo log */
+struct redo_record_header
+{
+    pos_type pos;       ///< the position of the changed data
+    size_type size;     ///< the size of the changed data
+};
+
+/**
+ * Calculate the checksum of the records (FNV-1a)
+ * @param data the records
+ * @param size the size of the records
+ * @return the checksum
+ */
+inline uint32_t redo_checksum(const void *data, const size_type size)
+{
+    const unsigned char *ptr = static_cast<const unsigned char *>(data);
+    uint32_t result = 2166136261u;
+    for (size_type i = 0; i < size; ++i)
+    {
+        result = (result ^ ptr[i]) * 16777619u;
+    }
+    return result;
+}
+
+/**
+ * The file with support of caching, with full support of transactions
+ * mechanism through the redo log
+ * @attention the changed data of a transaction is appended to the log (the
+ * file with the suffix ".wal") by one block when the transaction is
+ * stopped, the changed pages stay in the cache and they are stored in the
+ * file when the cache needs free pages or the log is full (the checkpoint),
+ * after that the log is cleared. The data of the transaction that is not
+ * stopped never gets into the file: when the cache page changed by the
+ * transaction is replaced, it's kept in the local memory until the end of
+ * the transaction. The log is replayed when the file is opened.
+ * The checkpoint is executed by the stop of the transaction that fills the
+ * log, so this stop waits for the writing of all changed pages of the
+ * cache and for the synchronization of the file; to avoid the delay of the
+ * transactions, the checkpoint size can be set bigger than the log can
+ * grow and the checkpoint can be called when the file is idle.
+ * The file doesn't share the changed pages, so the dataset must be used by
+ * one object of the file (the local interface).
+ */
+template <typename FilePage, int pageCount = 1024, typename File = file_lock<FilePage>,
+        template <typename, int, int> class Cache = cache>
+class redo_file : public cache_file<FilePage, pageCount, File, Cache>
+{
+    typedef File simple_file;
+    typedef typename File::simple_file log_file;
+    typedef cache_file<FilePage, pageCount, File, Cache> base_class;
+public:
+    typedef FilePage file_page_type;
+    typedef typename base_class::file_region_type file_region_type;
+    typedef typename base_class::page_status_type page_status_type;
+    enum { REDO_MAGIC = 0x4f444552 }; ///< the signature of the block of the log ("REDO")
+    explicit redo_file(const std::string& name);
+    redo_file(const std::string& name, const file_region_type& region);
+    virtual ~redo_file();
+    bool init(); ///< initialize
+
+    void stop();   ///< stop the transaction
+    void cancel(); ///< cancel the transaction
+    void checkpoint(); ///< store the changed pages in the file and clear the log
+    void set_checkpoint_size(const size_type size); ///< set the size of the log that starts the checkpoint
+    size_type checkpoint_size() const; ///< get the size of the log that starts the checkpoint
+    size_type log_size() const; ///< get the size of the log
+
+    static void remove(const std::string& name); ///< remove a file by the name
+    static void copy(const std::string& source, const std::string& dest); ///< copy a file
+    virtual void save_page(const pos_type index, void *data); ///< save data of the cache page
+protected:
+    virtual void do_write(const void *buffer, size_type size, const pos_type pos); ///< write data
+    virtual void do_refresh(size_type size, const pos_type pos); ///< refresh data
+    virtual void *get_page(const pos_type index); ///< get the buffer of the cache page
+    virtual void *get_page(const pos_type index) const; ///< get the buffer of the cache page
+    virtual bool can_read_ahead(const pos_type index) const; ///< check the page can be read ahead from the file
+    virtual void save_page(const file_page_type& page); ///< save data of the file page
+    void add_record(const void *buffer, size_type size, const pos_type pos); ///< add the record to the block of the transaction
+    void write_block(); ///< append the block of the transaction to the log
+    bool replay(); ///< replay the log
+    void publish_changes(); ///< publish the ranges of the changed pages
+    virtual void do_set_durability(const durability_level level); ///< set the level of the durability
+
+    typedef std::vector<char> page_image; ///< the copy of the page
+    typedef std::map<pos_type, page_image> image_list; ///< the copies of the pages
+protected:
+    log_file m_log; ///< the redo log
+    size_type m_log_size; ///< the size of the log
+    size_type m_checkpoint_size; ///< the size of the log that starts the checkpoint
+    std::vector<char> m_block; ///< the block of the transaction
+    image_list m_images; ///< the pages changed by the transaction (with the committed data if it's not stored in the file)
+    mutable image_list m_spill; ///< the replaced pages changed by the transaction
+    bool m_recovered; ///< the log was replayed by the opening
+};
+
+//==============================================================================
+//  redo_file
+//==============================================================================
+/**
+ * Remove a file by the name
+ * @param name the name of the file
+ */
+//static
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::remove(const std::string& name)
+{
+    base_class::remove(name + ".wal");
+    base_class::remove(name);
+}
+
+/**
+ * Copy a file
+ * @param source the source file name
+ * @param dest the dest file name
+ */
+//static
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::copy(const std::string& source,
+    const std::string& dest)
+{
+    base_class::copy(source + ".wal", dest + ".wal");
+    base_class::copy(source, dest);
+}
+
+/**
+ * Constructor
+ * @param name the name of the file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+redo_file<FilePage, pageCount, File, Cache>::redo_file(const std::string& name) :
+    base_class(name),
+    m_log(name + ".wal"),
+    m_log_size(0),
+    m_checkpoint_size(OUROBOROS_REDO_LOG_SIZE),
+    m_recovered(false)
+{
+    m_log.set_durability(base_class::durability());
+    m_recovered = replay();
+}
+
+/**
+ * Constructor
+ * @param name the name of a file
+ * @param region the region of a file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+redo_file<FilePage, pageCount, File, Cache>::redo_file(const std::string& name,
+        const file_region_type& region) :
+    base_class(name, region),
+    m_log(name + ".wal"),
+    m_log_size(0),
+    m_checkpoint_size(OUROBOROS_REDO_LOG_SIZE),
+    m_recovered(false)
+{
+    m_log.set_durability(base_class::durability());
+    m_recovered = replay();
+}
+
+/**
+ * Destructor, the changed pages are stored in the file
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+redo_file<FilePage, pageCount, File, Cache>::~redo_file()
+{
+    if (base_class::m_trans != TR_STARTED)
+    {
+        try
+        {
+            checkpoint();
+        }
+        catch (const std::exception& e)
+        {
+            OUROBOROS_ERROR("error of the checkpoint: " << PR(base_class::name()) << PE(e.what()));
+        }
+    }
+}
+
+/**
+ * Initialize
+ * @return false if the log was replayed by the opening of the file
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+bool redo_file<FilePage, pageCount, File, Cache>::init()
+{
+    base_class::init();
+    const bool result = !m_recovered;
+    m_recovered = false;
+    return result;
+}
+
+/**
+ * Replay the log, the blocks of the stopped transactions are written to
+ * the file, the rest of the log is dropped
+ * @return true if the log had the blocks
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+bool redo_file<FilePage, pageCount, File, Cache>::replay()
+{
+    const size_type size = m_log.size();
+    if (0 == size)
+    {
+        return false;
+    }
+    OUROBOROS_INFO("replay the log of the file " << base_class::name());
+    std::vector<char> log(size);
+    m_log.read(&log[0], size, 0);
+    bool result = false;
+    size_type pos = 0;
+    redo_block_header block;
+    while (pos + sizeof(block) <= size)
+    {
+        memcpy(&block, &log[pos], sizeof(block));
+        const char *beg = &log[pos] + sizeof(block);
+        if (block.magic != REDO_MAGIC || block.size > size - pos - sizeof(block) ||
+            block.checksum != redo_checksum(beg, block.size))
+        {
+            // the block of the transaction that was not stopped
+            break;
+        }
+        const char *end = beg + block.size;
+        while (beg < end)
+        {
+            redo_record_header record;
+            memcpy(&record, beg, sizeof(record));
+            beg += sizeof(record);
+            base_class::do_write(beg, record.size, record.pos);
+            beg += record.size;
+        }
+        pos += sizeof(block) + block.size;
+        result = true;
+    }
+    checkpoint();
+    OUROBOROS_INFO("replay completed");
+    return result;
+}
+
+/**
+ * Stop the transaction, the block of the transaction is appended to the log
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::stop()
+{
+    if (TR_STARTED != base_class::m_trans)
+    {
+        OUROBOROS_THROW_BUG("there isn't any transaction");
+    }
+    write_block();
+    // the replaced pages have the committed data now
+    typename image_list::const_iterator end = m_spill.end();
+    for (typename image_list::const_iterator it = m_spill.begin(); it != end; ++it)
+    {
+        simple_file::do_write(&it->second[0], base_class::CACHE_PAGE_SIZE, it->first * base_class::CACHE_PAGE_SIZE);
+    }
+    m_spill.clear();
+    publish_changes();
+    base_class::m_trans = TR_STOPPED;
+    if (m_log_size >= m_checkpoint_size)
+    {
+        checkpoint();
+    }
+}
+
+/**
+ * Cancel the transaction, the pages changed by the transaction are released
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::cancel()
+{
+    if (TR_STARTED != base_class::m_trans)
+    {
+        OUROBOROS_THROW_BUG("there isn't any transaction");
+    }
+    base_class::m_trans = TR_CANCELED;
+    m_block.clear();
+    m_spill.clear();
+    typename image_list::const_iterator end = m_images.end();
+    for (typename image_list::const_iterator it = m_images.begin(); it != end; ++it)
+    {
+        base_class::m_cache.free_page(it->first);
+        if (!it->second.empty())
+        {
+            // the committed data that was not stored in the file
+            simple_file::do_write(&it->second[0], base_class::CACHE_PAGE_SIZE, it->first * base_class::CACHE_PAGE_SIZE);
+        }
+    }
+    publish_changes();
+}
+
+/**
+ * Publish the ranges of the pages changed by the transaction
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::publish_changes()
+{
+    pos_type beg = NIL;
+    pos_type end = NIL;
+    typename image_list::const_iterator itend = m_images.end();
+    for (typename image_list::const_iterator it = m_images.begin(); it != itend; ++it)
+    {
+        if (it->first != end)
+        {
+            if (beg != NIL)
+            {
+                base_class::publish_pages(beg, end);
+            }
+            beg = it->first;
+        }
+        end = it->first + 1;
+    }
+    if (beg != NIL)
+    {
+        base_class::publish_pages(beg, end);
+    }
+    m_images.clear();
+}
+
+/**
+ * Set the level of the durability of the file and the log, the log has
+ * no copies of the pages so the commit level is enough for it
+ * @param level the level of the durability
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::do_set_durability(const durability_level level)
+{
+    base_class::do_set_durability(level);
+    m_log.set_durability(level);
+}
+
+/**
+ * Store the changed pages in the file and clear the log, the method is
+ * executed in the calling thread and its time depends on the count of the
+ * changed pages in the cache
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::checkpoint()
+{
+    if (TR_STARTED == base_class::m_trans)
+    {
+        OUROBOROS_THROW_BUG("the transaction is in progress");
+    }
+    base_class::clean();
+    if (m_log_size > 0 || m_log.size() > 0)
+    {
+        if (base_class::durability() >= DURABILITY_COMMIT)
+        {
+            base_class::sync();
+        }
+        m_log.resize(0);
+        m_log_size = 0;
+    }
+}
+
+/**
+ * Set the size of the log that starts the checkpoint
+ * @param size the size of the log
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::set_checkpoint_size(const size_type size)
+{
+    m_checkpoint_size = size;
+}
+
+/**
+ * Get the size of the log that starts the checkpoint
+ * @return the size of the log
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+size_type redo_file<FilePage, pageCount, File, Cache>::checkpoint_size() const
+{
+    return m_checkpoint_size;
+}
+
+/**
+ * Get the size of the log
+ * @return the size of the log
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+size_type redo_file<FilePage, pageCount, File, Cache>::log_size() const
+{
+    return m_log_size;
+}
+
+/**
+ * Add the record to the block of the transaction
+ * @param buffer the buffer of the data
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::add_record(const void *buffer, size_type size,
+    const pos_type pos)
+{
+    if (m_block.empty())
+    {
+        m_block.resize(sizeof(redo_block_header));
+    }
+    redo_record_header record;
+    record.pos = pos;
+    record.size = size;
+    const char *data = reinterpret_cast<const char *>(&record);
+    m_block.insert(m_block.end(), data, data + sizeof(record));
+    data = static_cast<const char *>(buffer);
+    m_block.insert(m_block.end(), data, data + size);
+}
+
+/**
+ * Append the block of the transaction to the log
+ */
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::write_block()
+{
+    if (m_block.empty())
+    {
+        return;
+    }
+    redo_block_header block;
+    block.magic = REDO_MAGIC;
+    block.size = m_block.size() - sizeof(block);
+    block.checksum = redo_checksum(&m_block[sizeof(block)], block.size);
+    memcpy(&m_block[0], &block, sizeof(block));
+    m_log.write(&m_block[0], m_block.size(), m_log_size);
+    m_log_size += m_block.size();
+    m_block.clear();
+    if (base_class::durability() >= DURABILITY_COMMIT)
+    {
+        base_class::commit_sync(m_log);
+    }
+}
+
+/**
+ * Write data, the data is added to the block of the transaction, the data
+ * written without the transaction is appended to the log at once
+ * @param buffer the buffer of the data
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::do_write(const void *buffer, size_type size,
+    const pos_type pos)
+{
+    add_record(buffer, size, pos);
+    base_class::do_write(buffer, size, pos);
+    if (TR_STARTED != base_class::m_trans)
+    {
+        write_block();
+        if (m_log_size >= m_checkpoint_size)
+        {
+            checkpoint();
+        }
+    }
+}
+
+/**
+ * Save data of the file page, the page stays in the cache until the
+ * checkpoint
+ * @param page the file page
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::save_page(const file_page_type& page)
+{
+    if (TR_STARTED != base_class::m_trans)
+    {
+        base_class::publish_pages(page.index(), page.index() + 1);
+    }
+}
+
+/**
+ * Save data of the cache page, the page changed by the transaction is kept
+ * in the local memory, the data of the canceled transaction is dropped
+ * @param index the index of the cache page
+ * @param page the cache page
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::save_page(const pos_type index, void *page)
+{
+    OUROBOROS_ASSERT(page != NULL);
+    if (m_images.find(index) == m_images.end())
+    {
+        simple_file::do_write(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+    }
+    else if (TR_STARTED == base_class::m_trans)
+    {
+        const char *data = static_cast<const char *>(page);
+        m_spill[index].assign(data, data + base_class::CACHE_PAGE_SIZE);
+    }
+}
+
+/**
+ * Get the buffer of the cache page for write
+ * @param index the index of the cache page
+ * @return the pointer to the buffer of the cache page for write
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void *redo_file<FilePage, pageCount, File, Cache>::get_page(const pos_type index)
+{
+    const page_status_type status = base_class::m_cache.page_exists(index);
+    const bool dirty = status.state() == PG_DIRTY;
+    void *page = NULL;
+    if (status.state() == PG_DETACHED)
+    {
+        typename image_list::iterator it = m_spill.find(index);
+        if (it != m_spill.end())
+        {
+            page = base_class::m_cache.get_page(status);
+            memcpy(page, &it->second[0], base_class::CACHE_PAGE_SIZE);
+            m_spill.erase(it);
+        }
+        else
+        {
+            const char *ahead = base_class::load_ahead(index);
+            page = base_class::m_cache.get_page(status);
+            if (ahead != NULL)
+            {
+                memcpy(page, ahead, base_class::CACHE_PAGE_SIZE);
+            }
+            else
+            {
+                simple_file::do_read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+            }
+        }
+        base_class::m_cache.page_loaded(index);
+    }
+    else
+    {
+        page = base_class::m_cache.get_page(status);
+    }
+    // check if the page is changed by the transaction for the first time
+    if (TR_STARTED == base_class::m_trans && m_images.find(index) == m_images.end())
+    {
+        page_image& image = m_images[index];
+        if (dirty)
+        {
+            // keep the committed data that is not stored in the file
+            const char *data = static_cast<const char *>(page);
+            image.assign(data, data + base_class::CACHE_PAGE_SIZE);
+        }
+    }
+    return page;
+}
+
+/**
+ * Get the buffer of the cache page for read
+ * @param index the index of the cache page
+ * @return the pointer to the buffer of the cache page for read
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void *redo_file<FilePage, pageCount, File, Cache>::get_page(const pos_type index) const
+{
+    const page_status_type status = base_class::m_cache.page_exists(index);
+    if (status.state() != PG_DETACHED)
+    {
+        return base_class::m_cache.get_page(status);
+    }
+    void *page = NULL;
+    typename image_list::iterator it = m_spill.find(index);
+    if (it != m_spill.end())
+    {
+        // the page is dirty until the end of the transaction
+        page = const_cast<typename base_class::cache_type&>(base_class::m_cache).get_page(status);
+        memcpy(page, &it->second[0], base_class::CACHE_PAGE_SIZE);
+        m_spill.erase(it);
+    }
+    else
+    {
+        const char *ahead = base_class::load_ahead(index);
+        page = base_class::m_cache.get_page(status);
+        if (ahead != NULL)
+        {
+            memcpy(page, ahead, base_class::CACHE_PAGE_SIZE);
+        }
+        else
+        {
+            simple_file::do_read(page, base_class::CACHE_PAGE_SIZE, index * base_class::CACHE_PAGE_SIZE);
+        }
+    }
+    base_class::m_cache.page_loaded(index);
+    return page;
+}
+
+/**
+ * Check the page can be read ahead from the file, the spilled pages
+ * are not stored in the file
+ * @param index the index of the page
+ * @return the result of the checking
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+bool redo_file<FilePage, pageCount, File, Cache>::can_read_ahead(const pos_type index) const
+{
+    return m_spill.find(index) == m_spill.end();
+}
+
+/**
+ * Refresh data, the changed pages are kept by the transaction
+ * @param size the size of the data
+ * @param pos the position of the data
+ */
+//virtual
+template <typename FilePage, int pageCount, typename File,
+    template <typename, int, int> class Cache>
+void redo_file<FilePage, pageCount, File, Cache>::do_refresh(size_type size, const pos_type pos)
+{
+    base_class::release_pages(size, pos);
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_REDOFILE_H */
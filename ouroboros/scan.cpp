@@ -0,0 +1,462 @@
+#include <string.h>
+#include <algorithm>
+#ifdef OUROBOROS_SIMD_ENABLED
+#include <immintrin.h>
+#endif
+
+#include "ouroboros/scan.h"
+
+namespace ouroboros
+{
+
+/**
+ * Get the instruction set that is supported by the processor
+ * @return the instruction set
+ */
+static scan_isa detect_isa()
+{
+#ifdef OUROBOROS_SIMD_ENABLED
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SCAN_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return SCAN_SSE2;
+    }
+#endif
+    return SCAN_SCALAR;
+}
+
+static const scan_isa s_supported_isa = detect_isa(); ///< the instruction set of the processor
+static scan_isa s_isa = s_supported_isa; ///< the instruction set of the scanning
+
+//==============================================================================
+//  scanner
+//==============================================================================
+/**
+ * Constructor
+ * @param field the field of the record
+ * @param stride the distance between the records
+ */
+scanner::scanner(const scan_field& field, const size_type stride) :
+    m_field(field),
+    m_stride(stride),
+    m_value(field.size + SCAN_PADDING, 0),
+    m_group16(0),
+    m_group32(0),
+    m_care16(0),
+    m_care32(0),
+    m_first16(0),
+    m_first32(0)
+{
+    OUROBOROS_ASSERT(field.offset + field.size <= stride);
+    memcpy(&m_value[0], field.value, field.size);
+    memset(m_pattern, 0, sizeof(m_pattern));
+    memset(m_records16, 0, sizeof(m_records16));
+    memset(m_records32, 0, sizeof(m_records32));
+    init_group(16, m_group16, m_care16, m_first16, m_records16);
+    init_group(32, m_group32, m_care32, m_first32, m_records32);
+}
+
+/**
+ * Calculate the masks of the records whose fields fit in the vector that
+ * starts at the first of them, the values of the fields are placed in
+ * the pattern of the vector
+ * @param width the size of the vector
+ * @param count the count of the records
+ * @param care the mask of the bytes of the fields
+ * @param first the mask of the first bytes of the fields
+ * @param records the masks of the fields of the records
+ */
+void scanner::init_group(const count_type width, count_type& count, uint32_t& care, uint32_t& first,
+    uint32_t *records)
+{
+    if (0 == m_field.size || m_field.offset + m_field.size > width)
+    {
+        return;
+    }
+    count = (width - m_field.offset - m_field.size) / m_stride + 1;
+    for (count_type j = 0; j < count; ++j)
+    {
+        const size_type pos = j * m_stride + m_field.offset;
+        for (size_type b = 0; b < m_field.size; ++b)
+        {
+            records[j] |= uint32_t(1) << (pos + b);
+            m_pattern[pos + b] = m_value[b];
+        }
+        care |= records[j];
+        first |= uint32_t(1) << pos;
+    }
+}
+
+/**
+ * Compare the field of the record with the value
+ * @param record the record
+ * @return the result of the comparing
+ */
+inline bool scanner::equal(const char *record) const
+{
+    return memcmp(record + m_field.offset, &m_value[0], m_field.size) == 0;
+}
+
+/**
+ * Find the first record whose field is equal to the value
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+pos_type scanner::find(const char *data, const count_type count) const
+{
+    if (0 == count || 0 == m_field.size)
+    {
+        return 0 == count ? NIL : 0;
+    }
+    switch (s_isa)
+    {
+#ifdef OUROBOROS_SIMD_ENABLED
+        case SCAN_AVX2:
+            return find_avx2(data, count);
+        case SCAN_SSE2:
+            return find_sse2(data, count);
+#endif
+        default:
+            return find_scalar(data, count);
+    }
+}
+
+/**
+ * Find the last record whose field is equal to the value
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+pos_type scanner::rfind(const char *data, const count_type count) const
+{
+    if (0 == count || 0 == m_field.size)
+    {
+        return 0 == count ? NIL : count - 1;
+    }
+    switch (s_isa)
+    {
+#ifdef OUROBOROS_SIMD_ENABLED
+        case SCAN_AVX2:
+            return rfind_avx2(data, count);
+        case SCAN_SSE2:
+            return rfind_sse2(data, count);
+#endif
+        default:
+            return rfind_scalar(data, count);
+    }
+}
+
+/**
+ * Find the first record by memcmp
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+pos_type scanner::find_scalar(const char *data, const count_type count) const
+{
+    for (count_type i = 0; i < count; ++i)
+    {
+        if (equal(data + i * m_stride))
+        {
+            return i;
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Find the last record by memcmp
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+pos_type scanner::rfind_scalar(const char *data, const count_type count) const
+{
+    for (count_type i = count; i > 0; --i)
+    {
+        if (equal(data + (i - 1) * m_stride))
+        {
+            return i - 1;
+        }
+    }
+    return NIL;
+}
+
+#ifdef OUROBOROS_SIMD_ENABLED
+/**
+ * Compare the field of the record with the value by 16 bytes
+ * @param field the field of the record
+ * @param value the value of the field
+ * @param size the size of the field
+ * @return the result of the comparing
+ */
+__attribute__((target("sse2")))
+static inline bool equal_sse2(const char *field, const char *value, size_type size)
+{
+    for (; size >= 16; size -= 16, field += 16, value += 16)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(field));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+    if (0 == size)
+    {
+        return true;
+    }
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(field));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value));
+    const uint32_t mask = (uint32_t(1) << size) - 1;
+    return (uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & mask) == mask;
+}
+
+/**
+ * Compare the field of the record with the value by 32 bytes
+ * @param field the field of the record
+ * @param value the value of the field
+ * @param size the size of the field
+ * @return the result of the comparing
+ */
+__attribute__((target("avx2")))
+static inline bool equal_avx2(const char *field, const char *value, size_type size)
+{
+    for (; size >= 32; size -= 32, field += 32, value += 32)
+    {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(field));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value));
+        if (uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+    if (0 == size)
+    {
+        return true;
+    }
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(field));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value));
+    const uint32_t mask = (uint32_t(1) << size) - 1;
+    return (uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) & mask) == mask;
+}
+
+/**
+ * Find the first record by SSE2, the records whose fields fit in 16 bytes
+ * are compared by one instruction
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+__attribute__((target("sse2")))
+pos_type scanner::find_sse2(const char *data, const count_type count) const
+{
+    if (0 == m_group16)
+    {
+        for (count_type i = 0; i < count; ++i)
+        {
+            if (equal_sse2(data + i * m_stride + m_field.offset, &m_value[0], m_field.size))
+            {
+                return i;
+            }
+        }
+        return NIL;
+    }
+    const __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_pattern));
+    for (count_type i = 0; i < count; i += m_group16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * m_stride));
+        const uint32_t miss = ~uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, pattern))) & m_care16;
+        // all fields differ by the first byte
+        if ((miss & m_first16) == m_first16)
+        {
+            continue;
+        }
+        const count_type n = std::min(m_group16, count - i);
+        for (count_type j = 0; j < n; ++j)
+        {
+            if (0 == (miss & m_records16[j]))
+            {
+                return i + j;
+            }
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Find the last record by SSE2, the records whose fields fit in 16 bytes
+ * are compared by one instruction
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+__attribute__((target("sse2")))
+pos_type scanner::rfind_sse2(const char *data, const count_type count) const
+{
+    if (0 == m_group16)
+    {
+        for (count_type i = count; i > 0; --i)
+        {
+            if (equal_sse2(data + (i - 1) * m_stride + m_field.offset, &m_value[0], m_field.size))
+            {
+                return i - 1;
+            }
+        }
+        return NIL;
+    }
+    const __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_pattern));
+    for (count_type i = (count - 1) / m_group16 * m_group16 + m_group16; i > 0; i -= m_group16)
+    {
+        const count_type beg = i - m_group16;
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + beg * m_stride));
+        const uint32_t miss = ~uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, pattern))) & m_care16;
+        if ((miss & m_first16) == m_first16)
+        {
+            continue;
+        }
+        for (count_type j = std::min(m_group16, count - beg); j > 0; --j)
+        {
+            if (0 == (miss & m_records16[j - 1]))
+            {
+                return beg + j - 1;
+            }
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Find the first record by AVX2, the records whose fields fit in 32 bytes
+ * are compared by one instruction
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+__attribute__((target("avx2")))
+pos_type scanner::find_avx2(const char *data, const count_type count) const
+{
+    if (0 == m_group32)
+    {
+        for (count_type i = 0; i < count; ++i)
+        {
+            if (equal_avx2(data + i * m_stride + m_field.offset, &m_value[0], m_field.size))
+            {
+                return i;
+            }
+        }
+        return NIL;
+    }
+    const __m256i pattern = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_pattern));
+    for (count_type i = 0; i < count; i += m_group32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i * m_stride));
+        const uint32_t miss = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, pattern))) & m_care32;
+        // all fields differ by the first byte
+        if ((miss & m_first32) == m_first32)
+        {
+            continue;
+        }
+        const count_type n = std::min(m_group32, count - i);
+        for (count_type j = 0; j < n; ++j)
+        {
+            if (0 == (miss & m_records32[j]))
+            {
+                return i + j;
+            }
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Find the last record by AVX2, the records whose fields fit in 32 bytes
+ * are compared by one instruction
+ * @param data the records
+ * @param count the count of the records
+ * @return the index of the found record or NIL
+ */
+__attribute__((target("avx2")))
+pos_type scanner::rfind_avx2(const char *data, const count_type count) const
+{
+    if (0 == m_group32)
+    {
+        for (count_type i = count; i > 0; --i)
+        {
+            if (equal_avx2(data + (i - 1) * m_stride + m_field.offset, &m_value[0], m_field.size))
+            {
+                return i - 1;
+            }
+        }
+        return NIL;
+    }
+    const __m256i pattern = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m_pattern));
+    for (count_type i = (count - 1) / m_group32 * m_group32 + m_group32; i > 0; i -= m_group32)
+    {
+        const count_type beg = i - m_group32;
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + beg * m_stride));
+        const uint32_t miss = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, pattern))) & m_care32;
+        if ((miss & m_first32) == m_first32)
+        {
+            continue;
+        }
+        for (count_type j = std::min(m_group32, count - beg); j > 0; --j)
+        {
+            if (0 == (miss & m_records32[j - 1]))
+            {
+                return beg + j - 1;
+            }
+        }
+    }
+    return NIL;
+}
+#endif
+
+/**
+ * Get the instruction set of the scanning
+ * @return the instruction set
+ */
+//static
+scan_isa scanner::isa()
+{
+    return s_isa;
+}
+
+/**
+ * Restrict the instruction set of the scanning, the set that isn't
+ * supported by the processor is replaced by the best supported one
+ * @param isa the instruction set
+ * @return the instruction set of the scanning
+ */
+//static
+scan_isa scanner::set_isa(const scan_isa isa)
+{
+    s_isa = std::min(isa, s_supported_isa);
+    return s_isa;
+}
+
+/**
+ * Get the name of the instruction set
+ * @param isa the instruction set
+ * @return the name of the instruction set
+ */
+//static
+const char *scanner::isa_name(const scan_isa isa)
+{
+    switch (isa)
+    {
+        case SCAN_AVX2:
+            return "avx2";
+        case SCAN_SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+}   //namespace ouroboros
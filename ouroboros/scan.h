@@ -0,0 +1,99 @@
+/**
+ * @file   scan.h
+ * The scanning of the contiguous records by SIMD
+ */
+
+#ifndef OUROBOROS_SCAN_H
+#define	OUROBOROS_SCAN_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ouroboros/global.h"
+
+namespace ouroboros
+{
+
+/** The instruction set of the scanning */
+enum scan_isa
+{
+    SCAN_SCALAR,    ///< the records are compared by memcmp
+    SCAN_SSE2,      ///< the records are compared by 16 bytes
+    SCAN_AVX2       ///< the records are compared by 32 bytes
+};
+
+enum
+{
+    SCAN_VECTOR_SIZE = 32,  ///< the maximum size of the vector of the scanning
+    SCAN_PADDING = SCAN_VECTOR_SIZE ///< the size of the memory after the records that can be read by the scanning
+};
+
+/**
+ * The field of the record that is compared by the scanning, the record
+ * is found if the bytes [offset, offset + size) of it are equal to the value
+ */
+struct scan_field
+{
+    scan_field(const void *value, const size_type offset, const size_type size) :
+        value(value),
+        offset(offset),
+        size(size)
+    {}
+    const void *value;  ///< the value of the field
+    size_type offset;   ///< the offset of the field in the record
+    size_type size;     ///< the size of the field
+};
+
+/**
+ * The scanner of the contiguous records, the field is compared with
+ * the value by the vectors: if the fields of some records fit in one vector
+ * then these records are compared by one instruction, otherwise the field
+ * of each record is compared by the vectors. The instruction set is selected
+ * by the processor when the library is loaded (the library is built with
+ * OUROBOROS_SIMD_ENABLED), the scalar comparison is used otherwise.
+ * @attention the memory of the records must have SCAN_PADDING bytes after
+ * the last record
+ */
+class scanner
+{
+public:
+    scanner(const scan_field& field, const size_type stride);
+
+    pos_type find(const char *data, const count_type count) const; ///< find the first record
+    pos_type rfind(const char *data, const count_type count) const; ///< find the last record
+
+    static scan_isa isa(); ///< get the instruction set of the scanning
+    static scan_isa set_isa(const scan_isa isa); ///< restrict the instruction set of the scanning
+    static const char *isa_name(const scan_isa isa); ///< get the name of the instruction set
+protected:
+    void init_group(const count_type width, count_type& count, uint32_t& care, uint32_t& first,
+        uint32_t *records); ///< calculate the masks of the records that fit in the vector
+    bool equal(const char *record) const; ///< compare the field of the record
+    pos_type find_scalar(const char *data, const count_type count) const; ///< find the first record by memcmp
+    pos_type rfind_scalar(const char *data, const count_type count) const; ///< find the last record by memcmp
+#ifdef OUROBOROS_SIMD_ENABLED
+    pos_type find_sse2(const char *data, const count_type count) const; ///< find the first record by SSE2
+    pos_type rfind_sse2(const char *data, const count_type count) const; ///< find the last record by SSE2
+    pos_type find_avx2(const char *data, const count_type count) const; ///< find the first record by AVX2
+    pos_type rfind_avx2(const char *data, const count_type count) const; ///< find the last record by AVX2
+#endif
+private:
+    scanner();
+private:
+    const scan_field m_field; ///< the field of the record
+    const size_type m_stride; ///< the distance between the records
+    std::vector<char> m_value; ///< the value of the field that can be read by the vectors
+    char m_pattern[SCAN_VECTOR_SIZE]; ///< the values of the fields of the records that fit in the vector
+    count_type m_group16; ///< the count of the records that fit in 16 bytes
+    count_type m_group32; ///< the count of the records that fit in 32 bytes
+    uint32_t m_care16; ///< the mask of the bytes of the fields in 16 bytes
+    uint32_t m_care32; ///< the mask of the bytes of the fields in 32 bytes
+    uint32_t m_first16; ///< the mask of the first bytes of the fields in 16 bytes
+    uint32_t m_first32; ///< the mask of the first bytes of the fields in 32 bytes
+    uint32_t m_records16[SCAN_VECTOR_SIZE]; ///< the masks of the fields of the records in 16 bytes
+    uint32_t m_records32[SCAN_VECTOR_SIZE]; ///< the masks of the fields of the records in 32 bytes
+};
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_SCAN_H */
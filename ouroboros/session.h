@@ -390,6 +390,11 @@ void base_session<Table, GlobalLock>::stop()
         assert(m_table->scoped_count() == 0);
     }
 #endif
+    // the data is synchronized without the lock
+    if (m_table != NULL)
+    {
+        m_table->sync_commit();
+    }
     OUROBOROS_SAFE_END;
 }
 
@@ -412,6 +417,11 @@ void base_session<Table, GlobalLock>::cancel()
         assert(m_table->scoped_count() == 0);
     }
 #endif
+    // the data is synchronized without the lock
+    if (m_table != NULL)
+    {
+        m_table->sync_commit();
+    }
     OUROBOROS_SAFE_END;
 }
 
@@ -0,0 +1,844 @@
+/**
+ * @file   sharedcache.h
+ * The cache whose pages are shared between processes
+ */
+
+#ifndef OUROBOROS_SHAREDCACHE_H
+#define	OUROBOROS_SHAREDCACHE_H
+
+#ifndef OUROBOROS_BOOST_ENABLED
+#error Can not use sharedcache (OUROBOROS_BOOST_ENABLED)
+#endif
+
+#include <set>
+#include <string.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include "ouroboros/global.h"
+#include "ouroboros/log.h"
+#include "ouroboros/file.h"
+#include "ouroboros/cache.h"
+#include "ouroboros/object.h"
+#include "ouroboros/sharedobject.h"
+
+namespace ouroboros
+{
+
+/**
+ * The pool of the pages which is placed in the shared memory, each page of
+ * a file is stored in the slot whose number is the index of the page modulo
+ * the count of the slots
+ * @attention a slot has the version stamp that is odd while the slot is
+ * being changed, the stamp is increased by 2 when a process starts changing
+ * the page of the slot; the data of the slot can be used only if the slot
+ * isn't busy (there aren't any processes changing the page) and its stamp
+ * isn't changed while the data is copied (like a seqlock); the pool has
+ * the generation that is increased when the pool is cleared, the busy counts
+ * that were taken before the clearing aren't released
+ */
+template <int pageSize, int slotCount = OUROBOROS_SHARED_PAGE_COUNT>
+struct shared_page_pool
+{
+    enum { SLOT_COUNT = slotCount };
+
+    /** the slot of the shared page */
+    struct slot_type
+    {
+        volatile revision_type stamp; ///< the version stamp of the slot
+        volatile count_type busy; ///< the count of the processes that are changing the page
+        volatile pos_type index; ///< the index of the page (NIL if the slot is empty)
+        char data[pageSize]; ///< data of the page
+    };
+
+    inline shared_page_pool(const dev_t dev, const ino_t ino);
+
+    inline bool fetch(const pos_type index, void *data) const; ///< copy data of the page from the pool
+    inline bool begin_load(const pos_type index, revision_type& stamp) const; ///< begin loading the page from the file
+    inline void end_load(const pos_type index, const revision_type stamp, const void *data); ///< put the loaded page to the pool
+    inline void acquire(const pos_type index); ///< begin changing the page
+    inline void release(const pos_type index, const revision_type gen); ///< end changing the page, the page isn't changed
+    inline void release(const pos_type index, const revision_type gen, const void *data); ///< end changing the page and put the new data to the pool
+    inline void invalidate(const pos_type index, const revision_type gen); ///< end changing the page and remove the page from the pool
+    inline void clear(); ///< remove all pages and release all slots
+
+    count_type attached; ///< the count of the attached caches
+    volatile revision_type generation; ///< the generation of the pool, it is increased when the pool is cleared
+    const dev_t dev; ///< the device of the file
+    const ino_t ino; ///< the inode of the file
+private:
+    inline slot_type& slot(const pos_type index); ///< get the slot of the page
+    inline const slot_type& slot(const pos_type index) const; ///< get the slot of the page
+    inline revision_type lock(slot_type& s); ///< lock the slot for changing
+    inline void remove(const pos_type index); ///< remove the page from the pool
+private:
+    slot_type m_slots[SLOT_COUNT];
+};
+
+/**
+ * The cache whose pages are shared between processes
+ * The pages that are read by a process are kept in the local cache as usual,
+ * besides the pages loaded from the file and the pages saved by the transaction
+ * are copied to the pool of pages in the shared memory, thus other processes
+ * take the pages from the shared memory instead of reading the file
+ * @attention all processes that use the file must use the shared cache
+ */
+template <typename Saver, int pageSize = 1024, int pageCount = 1024>
+class shared_cache
+{
+public:
+    enum
+    {
+        CACHE_PAGE_SIZE = pageSize,   ///< the size of the page
+        CACHE_PAGE_COUNT = pageCount  ///< the count of the pages
+    };
+    typedef Saver saver_type;
+    typedef shared_cache<Saver, pageSize, pageCount> cache_type;
+    typedef cache<cache_type, pageSize, pageCount> local_cache_type;
+    typedef typename local_cache_type::page_status_type page_status_type;
+    typedef shared_page_pool<pageSize> page_pool_type;
+
+    inline shared_cache();
+    explicit inline shared_cache(saver_type& saver);
+    inline ~shared_cache();
+
+    inline page_status_type page_exists(const pos_type index) const; ///< check the page exists
+    inline void* get_page(const pos_type index); ///< get data of the page
+    inline void* get_page(const page_status_type& status); ///< get data of the page
+    inline void* get_page(const pos_type index) const; ///< get data of the page
+    inline void* get_page(const page_status_type& status) const; ///< get data of the page
+    inline void page_loaded(const pos_type index) const; ///< the page is loaded from the file
+    inline size_type aligned_size(const size_type size); ///< change the size of the cache object
+    inline size_type size() const; ///< get the size of the cache
+    inline bool empty() const; ///< chech the cache is empty
+    inline bool dirty() const; ///< chech the cache is dirty
+    inline bool shared() const; ///< check the pages are shared between processes
+#ifdef OUROBOROS_TEST_ENABLED
+    count_type test_pool_page_count() const; ///< test the count of the page in the cache pool
+#endif
+    inline void clean(); ///< clean all dirty pages
+    inline void free(); ///< release the cache
+    inline void free_page(const pos_type index); ///< release the page from the pool
+    inline void set_capacity(const count_type count); ///< change the count of the local pages
+    inline count_type capacity() const; ///< get the count of the local pages
+    inline void reset_shared(); ///< clear the pool of the shared pages
+
+    void save_page(const pos_type index, void *data); ///< save data of the page of the local cache
+private:
+    typedef std::set<pos_type> page_list;
+    inline void attach(const std::string& name); ///< attach the pool of the shared pages
+    inline void detach(); ///< detach the pool of the shared pages
+    inline void acquire(const pos_type index); ///< begin changing the page
+    inline void invalidate(); ///< end changing of all pages
+    inline bool canceled() const; ///< check the transaction of the saver is canceled
+    shared_cache(const shared_cache&);
+    shared_cache& operator=(const shared_cache&);
+private:
+    saver_type *m_saver; ///< the saver of the pages
+    mutable local_cache_type m_cache; ///< the local cache
+    page_pool_type *m_pool; ///< the pool of the shared pages
+    std::string m_pool_name; ///< the name of the pool of the shared pages
+    page_list m_changed; ///< the pages that are being changed by the process
+    page_list m_evicted; ///< the changed pages that are saved before the end of the transaction
+    page_list m_published; ///< the changed pages that are put to the pool while cleaning
+    revision_type m_generation; ///< the generation of the pool when the changed pages were acquired
+    bool m_cleaning; ///< the sign of cleaning the dirty pages
+    mutable pos_type m_load_index; ///< the index of the page that is being loaded from the file
+    mutable revision_type m_load_stamp; ///< the stamp of the page that is being loaded from the file
+    mutable void *m_load_data; ///< the buffer of the page that is being loaded from the file
+};
+
+/**
+ * Get the lock of the pools of the shared pages
+ * @return the lock of the pools
+ */
+inline boost::interprocess::interprocess_mutex& shared_page_pool_lock()
+{
+    static object<boost::interprocess::interprocess_mutex, shared_object> lock("shared_cache.lock");
+    return lock();
+}
+
+//==============================================================================
+//  shared_page_pool
+//==============================================================================
+/**
+ * Constructor
+ * @param dev the device of the file
+ * @param ino the inode of the file
+ */
+template <int pageSize, int slotCount>
+inline shared_page_pool<pageSize, slotCount>::shared_page_pool(const dev_t dev, const ino_t ino) :
+    attached(0),
+    generation(0),
+    dev(dev),
+    ino(ino)
+{
+    for (size_t i = 0; i < SLOT_COUNT; ++i)
+    {
+        m_slots[i].stamp = 0;
+        m_slots[i].busy = 0;
+        m_slots[i].index = NIL;
+    }
+}
+
+/**
+ * Get the slot of the page
+ * @param index the index of the page
+ * @return the slot of the page
+ */
+template <int pageSize, int slotCount>
+inline typename shared_page_pool<pageSize, slotCount>::slot_type&
+    shared_page_pool<pageSize, slotCount>::slot(const pos_type index)
+{
+    return m_slots[index % SLOT_COUNT];
+}
+
+/**
+ * Get the slot of the page
+ * @param index the index of the page
+ * @return the slot of the page
+ */
+template <int pageSize, int slotCount>
+inline const typename shared_page_pool<pageSize, slotCount>::slot_type&
+    shared_page_pool<pageSize, slotCount>::slot(const pos_type index) const
+{
+    return m_slots[index % SLOT_COUNT];
+}
+
+/**
+ * Lock the slot for changing
+ * @param s the slot
+ * @return the stamp of the locked slot
+ */
+template <int pageSize, int slotCount>
+inline revision_type shared_page_pool<pageSize, slotCount>::lock(slot_type& s)
+{
+    for (;;)
+    {
+        const revision_type stamp = s.stamp;
+        if (0 == (stamp & 1) && __sync_bool_compare_and_swap(&s.stamp, stamp, stamp + 1))
+        {
+            return stamp + 1;
+        }
+        sched_yield();
+    }
+}
+
+/**
+ * Copy data of the page from the pool
+ * @param index the index of the page
+ * @param data the buffer for data of the page
+ * @return the result of the copying
+ */
+template <int pageSize, int slotCount>
+inline bool shared_page_pool<pageSize, slotCount>::fetch(const pos_type index, void *data) const
+{
+    const slot_type& s = slot(index);
+    const revision_type stamp = s.stamp;
+    __sync_synchronize();
+    if ((stamp & 1) != 0 || s.busy != 0 || s.index != index)
+    {
+        return false;
+    }
+    memcpy(data, s.data, pageSize);
+    __sync_synchronize();
+    return stamp == s.stamp;
+}
+
+/**
+ * Begin loading the page from the file
+ * @param index the index of the page
+ * @param stamp the stamp of the slot of the page
+ * @return the result of the beginning (false if the page is being changed)
+ */
+template <int pageSize, int slotCount>
+inline bool shared_page_pool<pageSize, slotCount>::begin_load(const pos_type index, revision_type& stamp) const
+{
+    const slot_type& s = slot(index);
+    stamp = s.stamp;
+    __sync_synchronize();
+    return 0 == (stamp & 1) && 0 == s.busy;
+}
+
+/**
+ * Put the page that is loaded from the file to the pool, the page is put only
+ * if nobody has started changing the page since the beginning of loading
+ * @param index the index of the page
+ * @param stamp the stamp of the slot at the beginning of loading
+ * @param data data of the page
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::end_load(const pos_type index,
+    const revision_type stamp, const void *data)
+{
+    slot_type& s = slot(index);
+    if (__sync_bool_compare_and_swap(&s.stamp, stamp, stamp + 1))
+    {
+        if (0 == s.busy)
+        {
+            memcpy(s.data, data, pageSize);
+            s.index = index;
+        }
+        __sync_fetch_and_add(&s.stamp, 1);
+    }
+}
+
+/**
+ * Begin changing the page
+ * @param index the index of the page
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::acquire(const pos_type index)
+{
+    slot_type& s = slot(index);
+    __sync_fetch_and_add(&s.busy, 1);
+    __sync_fetch_and_add(&s.stamp, 2);
+}
+
+/**
+ * Remove the page from the pool
+ * @param index the index of the page
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::remove(const pos_type index)
+{
+    slot_type& s = slot(index);
+    lock(s);
+    if (s.index == index)
+    {
+        s.index = NIL;
+    }
+    __sync_fetch_and_add(&s.stamp, 1);
+}
+
+/**
+ * End changing the page, the page isn't changed
+ * @param index the index of the page
+ * @param gen the generation of the pool when the page was acquired
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::release(const pos_type index, const revision_type gen)
+{
+    if (gen == generation)
+    {
+        __sync_fetch_and_sub(&slot(index).busy, 1);
+    }
+}
+
+/**
+ * End changing the page and put the new data of the page to the pool, if
+ * the pool was cleared after acquiring then the page is only removed
+ * @param index the index of the page
+ * @param gen the generation of the pool when the page was acquired
+ * @param data data of the page
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::release(const pos_type index, const revision_type gen,
+    const void *data)
+{
+    if (gen != generation)
+    {
+        remove(index);
+        return;
+    }
+    slot_type& s = slot(index);
+    lock(s);
+    memcpy(s.data, data, pageSize);
+    s.index = index;
+    __sync_fetch_and_add(&s.stamp, 1);
+    __sync_fetch_and_sub(&s.busy, 1);
+}
+
+/**
+ * End changing the page and remove the page from the pool
+ * @param index the index of the page
+ * @param gen the generation of the pool when the page was acquired
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::invalidate(const pos_type index, const revision_type gen)
+{
+    remove(index);
+    release(index, gen);
+}
+
+/**
+ * Remove all pages and release all slots, the slots that are left busy or
+ * locked by a crashed process become free, the generation is increased so
+ * the busy counts taken before aren't released twice
+ * @attention nobody may change the pages while the pool is cleared
+ */
+template <int pageSize, int slotCount>
+inline void shared_page_pool<pageSize, slotCount>::clear()
+{
+    __sync_fetch_and_add(&generation, 1);
+    for (size_t i = 0; i < SLOT_COUNT; ++i)
+    {
+        slot_type& s = m_slots[i];
+        s.index = NIL;
+        s.busy = 0;
+        // the stamp is changed so the pages that are being loaded aren't put
+        s.stamp = (s.stamp + 2) & ~revision_type(1);
+    }
+    __sync_synchronize();
+}
+
+//==============================================================================
+//  shared_cache
+//==============================================================================
+/**
+ * Constructor, the pages aren't shared without a saver
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline shared_cache<Saver, pageSize, pageCount>::shared_cache() :
+    m_saver(NULL),
+    m_cache(*this),
+    m_pool(NULL),
+    m_generation(0),
+    m_cleaning(false),
+    m_load_index(NIL),
+    m_load_stamp(0),
+    m_load_data(NULL)
+{
+}
+
+/**
+ * Constructor
+ * @param saver the saver of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline shared_cache<Saver, pageSize, pageCount>::shared_cache(saver_type& saver) :
+    m_saver(&saver),
+    m_cache(*this),
+    m_pool(NULL),
+    m_generation(0),
+    m_cleaning(false),
+    m_load_index(NIL),
+    m_load_stamp(0),
+    m_load_data(NULL)
+{
+    attach(saver.name());
+}
+
+/**
+ * Destructor
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline shared_cache<Saver, pageSize, pageCount>::~shared_cache()
+{
+    invalidate();
+    detach();
+}
+
+/**
+ * Attach the pool of the shared pages, the pool is created by the first
+ * process that opens the file and is removed by the last process, the pool
+ * isn't used if there is the pool of another file with the same name
+ * @param name the name of the file
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::attach(const std::string& name)
+{
+    struct stat st;
+    if (stat(name.c_str(), &st) != 0)
+    {
+        OUROBOROS_INFO("the pages of the file " << name << " aren't shared");
+        return;
+    }
+    m_pool_name = make_object_name(name, "cache");
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> guard(shared_page_pool_lock());
+    page_pool_type *pool = shared_memory::instance().mem().find_or_construct<page_pool_type>(
+        m_pool_name.c_str())(st.st_dev, st.st_ino);
+    if (pool->dev == st.st_dev && pool->ino == st.st_ino)
+    {
+        ++pool->attached;
+        m_pool = pool;
+        m_generation = pool->generation;
+    }
+    else
+    {
+        OUROBOROS_INFO("the pages of the file " << name << " aren't shared");
+    }
+}
+
+/**
+ * Detach the pool of the shared pages
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::detach()
+{
+    if (m_pool != NULL)
+    {
+        boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> guard(shared_page_pool_lock());
+        if (0 == --m_pool->attached)
+        {
+            shared_memory::instance().mem().destroy<page_pool_type>(m_pool_name.c_str());
+        }
+        m_pool = NULL;
+    }
+}
+
+/**
+ * Check the transaction of the saver is canceled
+ * @return the result of the checking
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline bool shared_cache<Saver, pageSize, pageCount>::canceled() const
+{
+    return m_saver != NULL && TR_CANCELED == m_saver->state();
+}
+
+/**
+ * Begin changing the page, if the pool was cleared then all pages that are
+ * being changed are acquired again
+ * @param index the index of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::acquire(const pos_type index)
+{
+    if (NULL == m_pool || !m_changed.insert(index).second)
+    {
+        return;
+    }
+    const revision_type generation = m_pool->generation;
+    if (generation == m_generation)
+    {
+        m_pool->acquire(index);
+        return;
+    }
+    m_generation = generation;
+    const page_list::const_iterator end = m_changed.end();
+    for (page_list::const_iterator it = m_changed.begin(); it != end; ++it)
+    {
+        m_pool->acquire(*it);
+    }
+}
+
+/**
+ * End changing of all pages, the pages are removed from the pool
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::invalidate()
+{
+    if (m_pool != NULL)
+    {
+        const page_list::const_iterator end = m_changed.end();
+        for (page_list::const_iterator it = m_changed.begin(); it != end; ++it)
+        {
+            m_pool->invalidate(*it, m_generation);
+        }
+    }
+    m_changed.clear();
+    m_evicted.clear();
+    m_published.clear();
+}
+
+/**
+ * Check the page exists, if the page isn't in the local cache then it is
+ * copied from the pool of the shared pages
+ * @param index the index of the page
+ * @return the status of the cache page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline typename shared_cache<Saver, pageSize, pageCount>::page_status_type
+    shared_cache<Saver, pageSize, pageCount>::page_exists(const pos_type index) const
+{
+    const page_status_type status = m_cache.page_exists(index);
+    if (status.state() != PG_DETACHED || NULL == m_pool)
+    {
+        return status;
+    }
+    void *page = const_cast<const local_cache_type&>(m_cache).get_page(status);
+    if (m_pool->fetch(index, page))
+    {
+        return m_cache.page_exists(index);
+    }
+    m_cache.free_page(index);
+    return m_cache.page_exists(index);
+}
+
+/**
+ * Get data of the page for writing
+ * @param index the index of the page
+ * @return data of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void* shared_cache<Saver, pageSize, pageCount>::get_page(const pos_type index)
+{
+    return get_page(page_exists(index));
+}
+
+/**
+ * Get data of the page for writing
+ * @param status the status of the page
+ * @return data of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void* shared_cache<Saver, pageSize, pageCount>::get_page(const page_status_type& status)
+{
+    acquire(status.index());
+    m_load_index = NIL;
+    return m_cache.get_page(status);
+}
+
+/**
+ * Get data of the page for reading
+ * @param index the index of the page
+ * @return data of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void* shared_cache<Saver, pageSize, pageCount>::get_page(const pos_type index) const
+{
+    return get_page(page_exists(index));
+}
+
+/**
+ * Get data of the page for reading, if the page will be loaded from the file
+ * then the page can be put to the pool of the shared pages
+ * @param status the status of the page
+ * @return data of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void* shared_cache<Saver, pageSize, pageCount>::get_page(const page_status_type& status) const
+{
+    void *page = const_cast<const local_cache_type&>(m_cache).get_page(status);
+    m_load_index = NIL;
+    if (PG_DETACHED == status.state() && m_pool != NULL &&
+        m_pool->begin_load(status.index(), m_load_stamp))
+    {
+        m_load_index = status.index();
+        m_load_data = page;
+    }
+    return page;
+}
+
+/**
+ * The page is loaded from the file, put it to the pool of the shared pages
+ * @param index the index of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::page_loaded(const pos_type index) const
+{
+    if (index == m_load_index)
+    {
+        m_load_index = NIL;
+        m_pool->end_load(index, m_load_stamp, m_load_data);
+    }
+}
+
+/**
+ * Get the aligned size of object
+ * @param size the size of object
+ * @return the aligned size of object
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline size_type shared_cache<Saver, pageSize, pageCount>::aligned_size(const size_type size)
+{
+    return m_cache.aligned_size(size);
+}
+
+/**
+ * Get the size of the cache
+ * @return the size of the cache
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline size_type shared_cache<Saver, pageSize, pageCount>::size() const
+{
+    return m_cache.size();
+}
+
+/**
+ * Check the cache is empty
+ * @return the result of the checking
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline bool shared_cache<Saver, pageSize, pageCount>::empty() const
+{
+    return m_cache.empty();
+}
+
+/**
+ * Check the cache is dirty
+ * @return the result of the checking
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline bool shared_cache<Saver, pageSize, pageCount>::dirty() const
+{
+    return m_cache.dirty();
+}
+
+/**
+ * Check the pages are shared between processes
+ * @return the result of the checking
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline bool shared_cache<Saver, pageSize, pageCount>::shared() const
+{
+    return m_pool != NULL;
+}
+
+#ifdef OUROBOROS_TEST_ENABLED
+/**
+ * Test the count of the page in the cache pool
+ * @return the count of the pages in the cache pool
+ */
+template <typename Saver, int pageSize, int pageCount>
+count_type shared_cache<Saver, pageSize, pageCount>::test_pool_page_count() const
+{
+    return m_cache.test_pool_page_count();
+}
+#endif
+
+/**
+ * Save data of the page of the local cache, the page that is saved while
+ * cleaning is put to the pool of the shared pages, the page that is saved
+ * before the end of the transaction is kept as changing until the end
+ * @param index the index of the page
+ * @param data data of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+void shared_cache<Saver, pageSize, pageCount>::save_page(const pos_type index, void *data)
+{
+    if (m_saver != NULL)
+    {
+        m_saver->save_page(index, data);
+    }
+    const page_list::iterator it = m_changed.find(index);
+    if (NULL == m_pool || m_changed.end() == it)
+    {
+        return;
+    }
+    if (!m_cleaning)
+    {
+        m_evicted.insert(index);
+    }
+    else if (!canceled())
+    {
+        m_pool->release(index, m_generation, data);
+        m_changed.erase(it);
+        m_evicted.erase(index);
+        m_published.insert(index);
+    }
+    else if (m_evicted.find(index) == m_evicted.end())
+    {
+        // the file isn't changed
+        m_pool->release(index, m_generation);
+        m_changed.erase(it);
+    }
+}
+
+/**
+ * Clean all dirty pages, if the cleaning fails then the pages that were put
+ * to the pool are acquired again, because the transaction will be canceled
+ * and the pages will be restored
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::clean()
+{
+    m_published.clear();
+    m_cleaning = true;
+    try
+    {
+        m_cache.clean();
+    }
+    catch (...)
+    {
+        m_cleaning = false;
+        const page_list::const_iterator end = m_published.end();
+        for (page_list::const_iterator it = m_published.begin(); it != end; ++it)
+        {
+            acquire(*it);
+        }
+        m_published.clear();
+        throw;
+    }
+    m_cleaning = false;
+    m_published.clear();
+    if (!canceled())
+    {
+        // the pages that were saved before the end of the transaction
+        page_list evicted;
+        evicted.swap(m_evicted);
+        const page_list::const_iterator end = evicted.end();
+        for (page_list::const_iterator it = evicted.begin(); it != end; ++it)
+        {
+            if (m_pool != NULL)
+            {
+                m_pool->invalidate(*it, m_generation);
+            }
+            m_changed.erase(*it);
+        }
+    }
+}
+
+/**
+ * Release the cache
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::free()
+{
+    m_cache.free();
+    invalidate();
+}
+
+/**
+ * Change the count of the pages of the local cache, the cache is released
+ * @param count the count of the pages
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::set_capacity(const count_type count)
+{
+    m_cache.set_capacity(count);
+    invalidate();
+}
+
+/**
+ * Get the count of the pages of the local cache
+ * @return the count of the pages
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline count_type shared_cache<Saver, pageSize, pageCount>::capacity() const
+{
+    return m_cache.capacity();
+}
+
+/**
+ * Clear the pool of the shared pages, the pages of the pool can be rolled back
+ * by the recovery of the file and the slots can be left busy by a crashed process
+ * @attention nobody may change the pages of the file while the pool is cleared
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::reset_shared()
+{
+    if (m_pool != NULL)
+    {
+        boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> guard(shared_page_pool_lock());
+        m_pool->clear();
+    }
+}
+
+/**
+ * Release the page from the pool, if the page was changed by the process then
+ * it is also removed from the pool of the shared pages
+ * @param index the index of the page
+ */
+template <typename Saver, int pageSize, int pageCount>
+inline void shared_cache<Saver, pageSize, pageCount>::free_page(const pos_type index)
+{
+    m_cache.free_page(index);
+    const page_list::iterator it = m_changed.find(index);
+    if (it != m_changed.end())
+    {
+        if (m_pool != NULL)
+        {
+            m_pool->invalidate(index, m_generation);
+        }
+        m_changed.erase(it);
+        m_evicted.erase(index);
+    }
+}
+
+}   //namespace ouroboros
+
+#endif	/* OUROBOROS_SHAREDCACHE_H */
@@ -14,6 +14,7 @@
 #include "ouroboros/sharedobject.h"
 #include "ouroboros/sharedcontainer.h"
 #include "ouroboros/sharedlocker.h"
+#include "ouroboros/sharedcache.h"
 #include "ouroboros/interface.h"
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 
@@ -22,17 +23,22 @@ namespace ouroboros
 
 /**
  * The base interface for working with a table stored in shared memory
+ * @param pageCount the count of cache pages
+ * @param Lock the type of the interprocess lock of a table
+ * @param Cache the type of the cache of a file
+ * @param File the type of the file (file_lock, mmap_file)
  */
-template <int pageCount = OUROBOROS_PAGE_COUNT>
+template <int pageCount = OUROBOROS_PAGE_COUNT, typename Lock = mutex_lock,
+    template <typename, int, int> class Cache = cache, template <typename> class File = file_lock>
 struct base_table_shared_interface
 {
     template <typename T> struct object_type : public shared_object<T> {};
     typedef file_page<OUROBOROS_PAGE_SIZE, sizeof(journal_status_type)> file_page_type;
-    typedef journal_file<file_page_type, pageCount> file_type;
-    struct locker_type : public locker<mutex_lock>
+    typedef journal_file<file_page_type, pageCount, File<file_page_type>, Cache> file_type;
+    struct locker_type : public locker<Lock>
     {
         locker_type(const std::string& name, count_type& scoped_count, count_type& sharable_count) :
-            locker<mutex_lock>(name, scoped_count, sharable_count)
+            locker<Lock>(name, scoped_count, sharable_count)
         {}
     };
     typedef gateway<boost::interprocess::interprocess_mutex> gateway_type;
@@ -52,8 +58,10 @@ struct base_dataset_shared_interface
  * The base interface for working with a dataset in shared memory
  * (with separation between processes)
  */
-template <template <template <typename, typename, typename> class, typename, template <typename> class, typename, typename> class Table, int pageCount = OUROBOROS_PAGE_COUNT>
-struct base_shared_interface : public base_interface<base_table_shared_interface<pageCount>, Table>,
+template <template <template <typename, typename, typename> class, typename, template <typename> class, typename, typename> class Table,
+    int pageCount = OUROBOROS_PAGE_COUNT, typename Lock = mutex_lock, template <typename, int, int> class Cache = cache,
+    template <typename> class File = file_lock>
+struct base_shared_interface : public base_interface<base_table_shared_interface<pageCount, Lock, Cache, File>, Table>,
     public base_dataset_shared_interface {};
 
 /**
@@ -62,6 +70,35 @@ struct base_shared_interface : public base_interface<base_table_shared_interface
  */
 typedef base_shared_interface<indexed_table> shared_interface;
 
+/**
+ * The interface for working with a dataset in shared memory
+ * (with separation between processes), the waiting processes are parked
+ * on a futex instead of polling
+ */
+typedef base_shared_interface<indexed_table, OUROBOROS_PAGE_COUNT, futex_mutex_lock> futex_shared_interface;
+
+/**
+ * The interface for working with a dataset in shared memory
+ * (with separation between processes), the table locks are set in order of
+ * requests, thus neither readers nor writers can be starved
+ */
+typedef base_shared_interface<indexed_table, OUROBOROS_PAGE_COUNT, policy_mutex_lock<fifo_policy> > fair_shared_interface;
+
+/**
+ * The interface for working with a dataset in shared memory
+ * (with separation between processes), the cache pages are shared between
+ * processes, thus a page read or written by one process isn't read from
+ * the file by others
+ */
+typedef base_shared_interface<indexed_table, OUROBOROS_PAGE_COUNT, mutex_lock, shared_cache> cached_shared_interface;
+
+/**
+ * The interface for working with a dataset in shared memory
+ * (with separation between processes), the file is read through
+ * the memory mapping
+ */
+typedef base_shared_interface<indexed_table, OUROBOROS_PAGE_COUNT, mutex_lock, cache, mmap_file> mmap_shared_interface;
+
 }   //namespace ouroboros
 
 #endif	/* OUROBOROS_SHAREDINTERFACE_H */
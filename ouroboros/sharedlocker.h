@@ -22,6 +22,7 @@
 #include "ouroboros/sharedobject.h"
 #include "ouroboros/filelock.h"
 #include "ouroboros/sharedlock.h"
+#include "ouroboros/futexlock.h"
 
 namespace ouroboros
 {
@@ -41,6 +42,8 @@ public:
     inline bool lock_sharable(); ///< set the shared lock
     inline bool lock_sharable(const size_t timeout); ///< set the shared lock with a timeout
     inline bool unlock_sharable(); ///< remove the shared lock
+    inline bool read_begin(revision_type& seq) const; ///< begin the optimistic reading
+    inline bool read_validate(const revision_type seq) const; ///< validate the optimistic reading
     inline const char* name() const; ///< get the name of the locker
 private:
     enum lock_state
@@ -52,6 +55,7 @@ private:
 private:
     typedef TMutex lock_type;
     object<lock_type, shared_object> m_lock;
+    object<revision_type, shared_object> m_seq; ///< the sequence of writing (odd while the exclusive lock is set)
     lock_state m_locked;
 };
 
@@ -75,6 +79,51 @@ struct simple_mutex_lock : public base_mutex_lock<shared_lock>
     {}
 };
 
+/**
+ * The lock based the futex_lock
+ */
+struct futex_mutex_lock : public base_mutex_lock<futex_lock>
+{
+    explicit inline futex_mutex_lock(const std::string& name) :
+        base_mutex_lock<futex_lock>(name)
+    {}
+};
+
+/**
+ * The policy of the lock that prefers readers (a writer can be starved)
+ */
+struct reader_preferring_policy
+{
+    typedef read_futex_lock lock_type;
+};
+
+/**
+ * The policy of the lock that prefers writers (a reader can be starved)
+ */
+struct writer_preferring_policy
+{
+    typedef futex_lock lock_type;
+};
+
+/**
+ * The policy of the lock that sets the lock in order of requests
+ */
+struct fifo_policy
+{
+    typedef ticket_futex_lock lock_type;
+};
+
+/**
+ * The lock based the futex lock with the given fairness policy
+ */
+template <typename Policy>
+struct policy_mutex_lock : public base_mutex_lock<typename Policy::lock_type>
+{
+    explicit inline policy_mutex_lock(const std::string& name) :
+        base_mutex_lock<typename Policy::lock_type>(name)
+    {}
+};
+
 //==============================================================================
 //  base_mutex_lock
 //==============================================================================
@@ -85,6 +134,7 @@ struct simple_mutex_lock : public base_mutex_lock<shared_lock>
 template <typename TMutex>
 inline base_mutex_lock<TMutex>::base_mutex_lock(const std::string& name) :
     m_lock(make_object_name(name, "lock")),
+    m_seq(make_object_name(name, "seq"), 0),
     m_locked(LS_NONE)
 {
 }
@@ -109,6 +159,10 @@ inline bool base_mutex_lock<TMutex>::lock(const size_t timeout)
 {
     assert(LS_NONE == m_locked);
     m_locked = m_lock->timed_lock(boost::get_system_time() + boost::posix_time::millisec(timeout)) ? LS_SCOPED : LS_NONE;
+    if (LS_SCOPED == m_locked)
+    {
+        __sync_fetch_and_add(&m_seq(), 1);
+    }
     return m_locked != LS_NONE;
 }
 
@@ -120,6 +174,7 @@ template <typename TMutex>
 inline bool base_mutex_lock<TMutex>::unlock()
 {
     assert(LS_SCOPED == m_locked);
+    __sync_fetch_and_add(&m_seq(), 1);
     m_lock->unlock();
     m_locked = LS_NONE;
     return true;
@@ -161,6 +216,31 @@ inline bool base_mutex_lock<TMutex>::unlock_sharable()
     return true;
 }
 
+/**
+ * Begin the optimistic reading of the data protected by the lock
+ * @param seq the sequence of writing that should be validated after reading
+ * @return the result of the beginning (false if the exclusive lock is set)
+ */
+template <typename TMutex>
+inline bool base_mutex_lock<TMutex>::read_begin(revision_type& seq) const
+{
+    seq = *static_cast<const volatile revision_type*>(&m_seq());
+    __sync_synchronize();
+    return 0 == (seq & 1);
+}
+
+/**
+ * Validate the optimistic reading of the data protected by the lock
+ * @param seq the sequence of writing that was got at the beginning
+ * @return the result of the validation (false if the data could be changed)
+ */
+template <typename TMutex>
+inline bool base_mutex_lock<TMutex>::read_validate(const revision_type seq) const
+{
+    __sync_synchronize();
+    return seq == *static_cast<const volatile revision_type*>(&m_seq());
+}
+
 /**
  * Get the name of the locker
  * @return the name of the locker
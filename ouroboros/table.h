@@ -8,8 +8,10 @@
 
 #include <stddef.h>
 #include <string.h>
+#include <algorithm>
 
 #include "ouroboros/basic.h"
+#include "ouroboros/scan.h"
 
 namespace ouroboros
 {
@@ -44,13 +46,26 @@ public:
     pos_type read_back(void *data, const count_type count) const; ///< read the last records
     pos_type find(const void *data, const pos_type beg, const count_type count) const; ///< find a record [beg, beg + count)
     pos_type rfind(const void *data, const pos_type end, const count_type count) const; ///< reverse find a record [end - count, end)
+    pos_type find(const scan_field& field, const pos_type beg, const count_type count) const; ///< find a record by the field [beg, beg + count)
+    pos_type rfind(const scan_field& field, const pos_type end, const count_type count) const; ///< reverse find a record by the field [end - count, end)
+    template <typename Scanner>
+    pos_type scan(Scanner& scanner, const pos_type beg, const count_type count) const; ///< find a record by the scanner of the blocks [beg, beg + count)
+    template <typename Scanner>
+    pos_type rscan(Scanner& scanner, const pos_type end, const count_type count) const; ///< reverse find a record by the scanner of the blocks [end - count, end)
+    template <typename Predicate>
+    pos_type lower_bound(const Predicate& pred, const pos_type beg, const count_type count) const; ///< find the first record that isn't matched by the predicate [beg, beg + count)
+    void prefetch(const pos_type beg, const count_type count) const; ///< read the records [beg, beg + count) ahead
 
     inline count_type distance(const pos_type beg, const pos_type end) const; ///< calculate the count of pages in the range [beg, end)
 protected:
     inline void do_remove(const pos_type beg, const pos_type end); ///< remove records [beg, end)
-    inline pos_type do_find(const void *data, const pos_type beg, const pos_type end) const; ///< find a record [beg, end)
-    inline pos_type do_rfind(const void *data, const pos_type beg, const pos_type end) const; ///< reverse find a record [beg. end)
+    template <typename Scanner>
+    inline pos_type do_scan(Scanner& scanner, const pos_type beg, const pos_type end) const; ///< find a record by the scanner [beg, end)
+    template <typename Scanner>
+    inline pos_type do_rscan(Scanner& scanner, const pos_type beg, const pos_type end) const; ///< reverse find a record by the scanner [beg. end)
 
+    template <typename Predicate>
+    inline count_type do_lower_bound(const Predicate& pred, const pos_type beg, const count_type count) const; ///< count the records that are matched by the predicate [beg, beg + count)
     inline bool valid_pos(const pos_type pos) const; ///< check the position is valid
     inline bool valid_range(const pos_type beg, const pos_type end) const; ///< check the range [beg, end) is valid
 private:
@@ -123,11 +138,13 @@ public:
     inline void start();  ///< start the transaction
     inline void stop();   ///< stop the transaction
     inline void cancel(); ///< cancel the transaction
+    inline void sync_commit(); ///< synchronize the data of the stopped transaction
     inline transaction_state state() const; ///< get the state of the transaction
 
     inline void read(void *data, const size_type size, const offset_type offset); ///< read raw data
     inline void write(const void *data, const size_type size, const offset_type offset); ///< write raw data
     inline void refresh(const offset_type offset); /// refresh data of the table
+    inline void prefetch(const size_type size, const offset_type offset); ///< read raw data ahead
 
     static void remove(const std::string& name); ///< remove the source
     static void copy(const std::string& source, const std::string& dest); ///< copy the source to dest
@@ -204,6 +221,29 @@ pos_type table<Source, Key>::read(void *data, const pos_type beg, const count_ty
     return end;
 }
 
+/**
+ * Read the records in the range [beg, beg + count) ahead, so the following
+ * reading of the records doesn't wait for the file
+ * @param beg the begin position of the records
+ * @param count the count of the records
+ */
+template <typename Source, typename Key>
+void table<Source, Key>::prefetch(const pos_type beg, const count_type count) const
+{
+    OUROBOROS_RANGE_ASSERT(beg < base_class::limit());
+    const size_type rec_size = base_class::rec_size() + base_class::rec_space();
+    const count_type max = base_class::limit();
+    const count_type head = std::min(count, count_type(max - beg));
+    if (head > 0)
+    {
+        base_class::prefetch(rec_size * head, base_class::rec_offset(beg));
+    }
+    if (count > head)
+    {
+        base_class::prefetch(rec_size * std::min(count - head, count_type(beg)), base_class::rec_offset(0));
+    }
+}
+
 /**
  * Reverse read a record
  * @param data data of the record
@@ -570,49 +610,65 @@ pos_type table<Source, Key>::read_back(void* data, const count_type count) const
 }
 
 /**
- * Find a record in the range [beg, end)
- * @param data data of the record
+ * Find a record in the range [beg, end), the blocks of the records are read
+ * from the file by one call and they are passed to the scanner
+ * @attention the blocks are copied to the buffer: the pages of the file end
+ * with the service data, the records cross the pages and the sources of the
+ * table are read only by copying
+ * @param scanner the scanner of the blocks
  * @param beg the begin position of the records
  * @param end the end position of the records
  * @return the position of the found record
  */
 template <typename Source, typename Key>
-inline pos_type table<Source, Key>::do_find(const void *data, const pos_type beg, const pos_type end) const
+template <typename Scanner>
+inline pos_type table<Source, Key>::do_scan(Scanner& scanner, const pos_type beg, const pos_type end) const
 {
-    const size_type rec_size = base_class::rec_size();
-    scoped_buffer<void> buffer(rec_size);
-    for (pos_type pos = beg; pos < end; ++pos)
+    const size_type rec_size = base_class::rec_size() + base_class::rec_space();
+    const count_type block = std::min(std::max(count_type(OUROBOROS_SCAN_BLOCK / rec_size), count_type(1)),
+        count_type(end - beg));
+    scoped_buffer<char> buffer(rec_size * block + SCAN_PADDING);
+    for (pos_type pos = beg; pos < end; pos += block)
     {
-        base_class::read(buffer.get(), rec_size, base_class::rec_offset(pos));
-        if (memcmp(buffer.get(), data, rec_size) == 0)
+        const count_type count = std::min(block, count_type(end - pos));
+        base_class::read(buffer.get(), rec_size * count, base_class::rec_offset(pos));
+        const pos_type index = scanner.find(buffer.get(), count);
+        if (index != NIL)
         {
-            return pos;
+            return pos + index;
         }
     }
     return NIL;
 }
 
 /**
- * Reverse find a record in the range [beg, end)
- * @param data data of the record
+ * Reverse find a record in the range [beg, end), the blocks of the records
+ * are read from the file by one call and they are passed to the scanner
+ * from the last block to the first one
+ * @param scanner the scanner of the blocks
  * @param beg the begin position of the records
  * @param end the end position of the records
  * @return the position of the found record
  */
 template <typename Source, typename Key>
-inline pos_type table<Source, Key>::do_rfind(const void *data, const pos_type beg, const pos_type end) const
+template <typename Scanner>
+inline pos_type table<Source, Key>::do_rscan(Scanner& scanner, const pos_type beg, const pos_type end) const
 {
-    const size_type rec_size = base_class::rec_size();
-    scoped_buffer<void> buffer(rec_size);
-    pos_type pos = base_class::dec_pos(end);
-    do
+    const size_type rec_size = base_class::rec_size() + base_class::rec_space();
+    const count_type block = std::min(std::max(count_type(OUROBOROS_SCAN_BLOCK / rec_size), count_type(1)),
+        count_type(end - beg));
+    scoped_buffer<char> buffer(rec_size * block + SCAN_PADDING);
+    for (pos_type pos = end; pos > beg; )
     {
-        base_class::read(buffer.get(), rec_size, base_class::rec_offset(pos));
-        if (memcmp(buffer.get(), data, rec_size) == 0)
+        const count_type count = std::min(block, count_type(pos - beg));
+        pos -= count;
+        base_class::read(buffer.get(), rec_size * count, base_class::rec_offset(pos));
+        const pos_type index = scanner.rfind(buffer.get(), count);
+        if (index != NIL)
         {
-            return pos;
+            return pos + index;
         }
-    } while (--pos != beg);
+    }
     return NIL;
 }
 
@@ -625,43 +681,159 @@ inline pos_type table<Source, Key>::do_rfind(const void *data, const pos_type be
  */
 template <typename Source, typename Key>
 pos_type table<Source, Key>::find(const void *data, const pos_type beg, const count_type count) const
+{
+    return find(scan_field(data, 0, base_class::rec_size()), beg, count);
+}
+
+/**
+ * Reverse find a record in the range [end - count, end)
+ * @param data data of the record
+ * @param end the end position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <typename Source, typename Key>
+pos_type table<Source, Key>::rfind(const void *data, const pos_type end, const count_type count) const
+{
+    return rfind(scan_field(data, 0, base_class::rec_size()), end, count);
+}
+
+/**
+ * Find a record by the field in the range [beg, beg + count)
+ * @param field the field of the record
+ * @param beg the begin position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <typename Source, typename Key>
+pos_type table<Source, Key>::find(const scan_field& field, const pos_type beg, const count_type count) const
+{
+    const scanner field_scanner(field, base_class::rec_size() + base_class::rec_space());
+    return scan(field_scanner, beg, count);
+}
+
+/**
+ * Reverse find a record by the field in the range [end - count, end)
+ * @param field the field of the record
+ * @param end the end position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <typename Source, typename Key>
+pos_type table<Source, Key>::rfind(const scan_field& field, const pos_type end, const count_type count) const
+{
+    const scanner field_scanner(field, base_class::rec_size() + base_class::rec_space());
+    return rscan(field_scanner, end, count);
+}
+
+/**
+ * Find a record by the scanner in the range [beg, beg + count), the blocks
+ * of the contiguous records are passed to the scanner in the order of
+ * the records: the scanner has the method
+ * pos_type find(const char *data, const count_type count) that returns
+ * the index of the found record in the block or NIL
+ * @param scanner the scanner of the blocks
+ * @param beg the begin position of the records
+ * @param count the count of the find records
+ * @return the position of the found record
+ */
+template <typename Source, typename Key>
+template <typename Scanner>
+pos_type table<Source, Key>::scan(Scanner& scanner, const pos_type beg, const count_type count) const
 {
     OUROBOROS_RANGE_ASSERT(count > 0);
     const pos_type end = base_class::inc_pos(beg, count);
     if (end > beg)
     {
-        return do_find(data, beg, end);
+        return do_scan(scanner, beg, end);
     }
-    const pos_type pos = do_find(data, beg, base_class::limit());
+    const pos_type pos = do_scan(scanner, beg, base_class::limit());
     if (pos != NIL)
     {
         return pos;
     }
-    return do_find(data, 0, end);
+    return 0 == end ? NIL : do_scan(scanner, 0, end);
 }
 
 /**
- * Reverse find a record in the range [end - count, end)
- * @param data data of the record
+ * Reverse find a record by the scanner in the range [end - count, end),
+ * the blocks of the contiguous records are passed to the scanner in
+ * the reverse order of the records: the scanner has the method
+ * pos_type rfind(const char *data, const count_type count) that returns
+ * the index of the found record in the block or NIL
+ * @param scanner the scanner of the blocks
  * @param end the end position of the records
  * @param count the count of the find records
  * @return the position of the found record
  */
 template <typename Source, typename Key>
-pos_type table<Source, Key>::rfind(const void *data, const pos_type end, const count_type count) const
+template <typename Scanner>
+pos_type table<Source, Key>::rscan(Scanner& scanner, const pos_type end, const count_type count) const
 {
     OUROBOROS_RANGE_ASSERT(count > 0);
     const pos_type beg = base_class::dec_pos(end, count);
     if (end > beg)
     {
-        return do_rfind(data, beg, end);
+        return do_rscan(scanner, beg, end);
     }
-    const pos_type pos = (0 == end) ? NIL : do_rfind(data, 0, end);
+    const pos_type pos = (0 == end) ? NIL : do_rscan(scanner, 0, end);
     if (pos != NIL)
     {
         return pos;
     }
-    return do_rfind(data, beg, base_class::limit());
+    return do_rscan(scanner, beg, base_class::limit());
+}
+
+/**
+ * Find the first record that isn't matched by the predicate in the range
+ * [beg, beg + count) by the binary search, the records that are matched
+ * by the predicate must precede the others in the order of the ring:
+ * the predicate has the method bool operator()(const void *data) const
+ * that is called for the packed record, so only the records that are
+ * halving the range are read
+ * @param pred the predicate
+ * @param beg the begin position of the records
+ * @param count the count of the records
+ * @return the position of the found record or the end of the range
+ */
+template <typename Source, typename Key>
+template <typename Predicate>
+pos_type table<Source, Key>::lower_bound(const Predicate& pred, const pos_type beg, const count_type count) const
+{
+    return base_class::inc_pos(beg, do_lower_bound(pred, beg, count));
+}
+
+/**
+ * Count the records that are matched by the predicate in the range
+ * [beg, beg + count) by the binary search, the count is used instead
+ * of the position because the end of the full table is its begin
+ * @param pred the predicate
+ * @param beg the begin position of the records
+ * @param count the count of the records
+ * @return the count of the records before the first record that isn't matched
+ */
+template <typename Source, typename Key>
+template <typename Predicate>
+inline count_type table<Source, Key>::do_lower_bound(const Predicate& pred, const pos_type beg, const count_type count) const
+{
+    scoped_buffer<char> buffer(base_class::rec_size());
+    count_type first = 0;
+    count_type rest = count;
+    while (rest > 0)
+    {
+        const count_type half = rest / 2;
+        base_class::read(buffer.get(), base_class::rec_size(), base_class::rec_offset(base_class::inc_pos(beg, first + half)));
+        if (pred(static_cast<const void *>(buffer.get())))
+        {
+            first += half + 1;
+            rest -= half + 1;
+        }
+        else
+        {
+            rest = half;
+        }
+    }
+    return first;
 }
 
 /**
@@ -984,6 +1156,17 @@ inline void source<File>::refresh(const offset_type offset)
     m_file->refresh(table_size(), offset);
 }
 
+/**
+ * Read raw data ahead
+ * @param size the size of the data
+ * @param offset the offset of the data
+ */
+template <typename File>
+inline void source<File>::prefetch(const size_type size, const offset_type offset)
+{
+    m_file->prefetch(size, offset);
+}
+
 /**
  * Change the size of the data source
  */
@@ -1073,7 +1256,7 @@ inline size_type source<File>::rec_size() const
  * @return the count of the records in the table
  */
 template <typename File>
-inline size_type source<File>::rec_count() const
+inline count_type source<File>::rec_count() const
 {
     return m_rec_count;
 }
@@ -1125,6 +1308,15 @@ inline void source<File>::cancel()
     m_file->cancel();
 }
 
+/**
+ * Synchronize the data of the stopped transaction
+ */
+template <typename File>
+inline void source<File>::sync_commit()
+{
+    m_file->sync_commit();
+}
+
 /**
  * Get the state of the transaction
  * @return the state of the transaction
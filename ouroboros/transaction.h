@@ -84,6 +84,8 @@ public:
     static bool lock(); ///< set the global lazy lock
     static bool lock(const size_t timeout); ///< set the global lazy lock with a timeout
     static bool unlock(); ///< remove the global lazy lock
+    static bool read_begin(revision_type& seq); ///< begin the optimistic reading instead of the lazy lock
+    static bool read_validate(const revision_type seq); ///< validate the optimistic reading
 };
 
 /**
@@ -386,6 +388,30 @@ bool global_lazy_lock<Interface>::unlock()
     return locker_type::instance().unlock_sharable();
 }
 
+/**
+ * Begin the optimistic reading instead of setting the global lazy lock
+ * @param seq the sequence of the global writing
+ * @return the result of the beginning (false if the global lock is set)
+ */
+//static
+template <typename Interface>
+bool global_lazy_lock<Interface>::read_begin(revision_type& seq)
+{
+    return locker_type::instance().read_begin(seq);
+}
+
+/**
+ * Validate the optimistic reading
+ * @param seq the sequence of the global writing that was got at the beginning
+ * @return the result of the validation (false if the global lock was set)
+ */
+//static
+template <typename Interface>
+bool global_lazy_lock<Interface>::read_validate(const revision_type seq)
+{
+    return locker_type::instance().read_validate(seq);
+}
+
 //==============================================================================
 //  locked_transaction
 //==============================================================================
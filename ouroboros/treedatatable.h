@@ -93,6 +93,7 @@ public:
     template <typename Finder>
     pos_type rfind(Finder& finder, const pos_type end, const count_type count) const; ///< reverse find a record [beg, end)
     count_type get_range_size(const field_type& beg, const field_type& end) const; ///< get a count of records that have index in range [beg, end)
+    using base_class::aggregate; ///< aggregate the field of the records [beg, beg + count)
 
     inline bool refresh(); ///< refresh the metadata of the table by the key
     inline void update(); ///< update the key by the metadata of the table
@@ -124,7 +125,10 @@ protected:
     inline pos_type unsafe_read_back(record_type& record) const; ///< read the last record
     inline pos_type unsafe_read_back(record_list& records) const; ///< read the last records
 protected:
-    /** hide the parents methods */
+    /** hide the parents methods, the removing moves the records, so the order of the positions isn't the order of a field */
+    using base_class::lower_bound_by;
+    using base_class::upper_bound_by;
+    using base_class::read_by;
     pos_type read(indexed_record_type& record, const pos_type pos) const;
     pos_type read(indexed_record_list& records, const pos_type pos) const;
     pos_type rread(indexed_record_type& record, const pos_type pos) const;
@@ -0,0 +1,169 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE archive_test
+#include <boost/test/unit_test.hpp>
+
+#include "ouroboros/key.h"
+#include "ouroboros/archive.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/session.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+#define ARCHIVE_NAME "ouroboros_archive"
+typedef record2< FIELD_INT64, FIELD_INT32 > sample_type;
+typedef archive_set<simple_key, sample_type, index1, index2, local_interface> archive_type;
+typedef archive_type::record_list record_list;
+typedef archive_type::archive_list archive_list;
+
+/**
+ * Make the definitions of the archives
+ * @return the definitions of the archives
+ */
+static archive_list make_archives()
+{
+    archive_list archives;
+    archives.push_back(archive_def(1, 100, CONSOLIDATION_AVERAGE));
+    archives.push_back(archive_def(10, 30, CONSOLIDATION_AVERAGE));
+    archives.push_back(archive_def(10, 30, CONSOLIDATION_MAX));
+    archives.push_back(archive_def(60, 5, CONSOLIDATION_LAST));
+    return archives;
+}
+
+/**
+ * Add the samples [beg, end) to the archives, the value of the sample is the time
+ * @param archives the archives
+ * @param beg the time of the first sample
+ * @param end the time after the last sample
+ */
+static void add_samples(archive_type& archives, const int64_t beg, const int64_t end)
+{
+    for (int64_t time = beg; time < end; ++time)
+    {
+        archives.add(0, sample_type(time, int32_t(time)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(consolidation_test)
+{
+    const archive_list defs = make_archives();
+    archive_type::remove(ARCHIVE_NAME, defs.size());
+    {
+        archive_type archives(ARCHIVE_NAME, 1, defs);
+        archives.add_table(0);
+        add_samples(archives, 0, 95);
+        // the archives of the different depth are fed by each record
+        BOOST_CHECK_EQUAL(95, archives.dataset(0).session_rd(0)->count());
+        BOOST_CHECK_EQUAL(10, archives.dataset(1).session_rd(0)->count());
+        BOOST_CHECK_EQUAL(10, archives.dataset(2).session_rd(0)->count());
+        BOOST_CHECK_EQUAL(2, archives.dataset(3).session_rd(0)->count());
+        record_list records(10);
+        archives.dataset(1).session_rd(0)->read_front(records);
+        for (size_t n = 0; n < records.size(); ++n)
+        {
+            BOOST_CHECK_EQUAL(int64_t(n * 10), records[n].field1());
+            BOOST_CHECK_EQUAL(int32_t(n < 9 ? n * 10 + 4 : 92), records[n].field2());
+        }
+        archives.dataset(2).session_rd(0)->read_front(records);
+        for (size_t n = 0; n < records.size(); ++n)
+        {
+            BOOST_CHECK_EQUAL(int32_t(n < 9 ? n * 10 + 9 : 94), records[n].field2());
+        }
+        records.resize(2);
+        archives.dataset(3).session_rd(0)->read_front(records);
+        BOOST_CHECK_EQUAL(60, records[1].field1());
+        BOOST_CHECK_EQUAL(94, records[1].field2());
+        // the time can't decrease
+        BOOST_CHECK_THROW(archives.add(0, sample_type(89, 0)), ouroboros::range_error);
+        BOOST_CHECK_EQUAL(95, archives.dataset(0).session_rd(0)->count());
+    }
+    {
+        // the consolidation continues from the last records
+        archive_type archives(ARCHIVE_NAME, 1, defs);
+        add_samples(archives, 95, 100);
+        sample_type record;
+        // the average is consolidated with the count of the records of the step
+        archives.dataset(1).session_rd(0)->read_back(record);
+        BOOST_CHECK_EQUAL(90, record.field1());
+        BOOST_CHECK_EQUAL(94, record.field2());
+        archives.dataset(2).session_rd(0)->read_back(record);
+        BOOST_CHECK_EQUAL(90, record.field1());
+        BOOST_CHECK_EQUAL(99, record.field2());
+        archives.dataset(3).session_rd(0)->read_back(record);
+        BOOST_CHECK_EQUAL(60, record.field1());
+        BOOST_CHECK_EQUAL(99, record.field2());
+        BOOST_CHECK_EQUAL(2, archives.dataset(3).session_rd(0)->count());
+    }
+    {
+        // the archives must have the same definitions
+        archive_list other = defs;
+        other[2].function = CONSOLIDATION_MIN;
+        BOOST_CHECK_THROW(archive_type archives(ARCHIVE_NAME, 1, other), ouroboros::compatibility_error);
+    }
+    archive_type::remove(ARCHIVE_NAME, defs.size());
+}
+
+BOOST_AUTO_TEST_CASE(fetch_test)
+{
+    const archive_list defs = make_archives();
+    archive_type::remove(ARCHIVE_NAME, defs.size());
+    {
+        archive_type archives(ARCHIVE_NAME, 1, defs);
+        archives.add_table(0);
+        add_samples(archives, 0, 100);
+        record_list records;
+        // the archive of the required step keeps the range
+        BOOST_CHECK_EQUAL(0, archives.fetch(0, CONSOLIDATION_AVERAGE, 50, 99, 1, records));
+        BOOST_REQUIRE_EQUAL(50, records.size());
+        BOOST_CHECK_EQUAL(50, records.front().field1());
+        BOOST_CHECK_EQUAL(99, records.back().field1());
+        BOOST_CHECK_EQUAL(1, archives.fetch(0, CONSOLIDATION_AVERAGE, 0, 99, 30, records));
+        BOOST_CHECK_EQUAL(10, records.size());
+        // the range begins inside the step
+        BOOST_CHECK_EQUAL(2, archives.fetch(0, CONSOLIDATION_MAX, 15, 40, 1, records));
+        BOOST_REQUIRE_EQUAL(4, records.size());
+        BOOST_CHECK_EQUAL(10, records.front().field1());
+        BOOST_CHECK_EQUAL(19, records.front().field2());
+        BOOST_CHECK_EQUAL(pos_type(NIL), archives.fetch(0, CONSOLIDATION_MIN, 0, 99, 1, records));
+        BOOST_CHECK(records.empty());
+
+        // the first archive doesn't keep the begin of the range
+        add_samples(archives, 100, 200);
+        BOOST_CHECK_EQUAL(1, archives.fetch(0, CONSOLIDATION_AVERAGE, 0, 199, 1, records));
+        BOOST_CHECK_EQUAL(20, records.size());
+        BOOST_CHECK_EQUAL(0, archives.fetch(0, CONSOLIDATION_AVERAGE, 150, 199, 1, records));
+        BOOST_CHECK_EQUAL(50, records.size());
+        // the archive that keeps the oldest records is read
+        add_samples(archives, 200, 400);
+        BOOST_CHECK_EQUAL(1, archives.fetch(0, CONSOLIDATION_AVERAGE, 0, 399, 1, records));
+        BOOST_CHECK_EQUAL(30, records.size());
+        BOOST_CHECK_EQUAL(100, records.front().field1());
+    }
+    archive_type::remove(ARCHIVE_NAME, defs.size());
+}
+
+BOOST_AUTO_TEST_CASE(transaction_test)
+{
+    const archive_list defs = make_archives();
+    archive_type::remove(ARCHIVE_NAME, defs.size());
+    {
+        archive_type archives(ARCHIVE_NAME, 1, defs);
+        archives.add_table(0);
+        add_samples(archives, 0, 15);
+        archives.start();
+        add_samples(archives, 15, 25);
+        archives.cancel();
+        BOOST_CHECK_EQUAL(15, archives.dataset(0).session_rd(0)->count());
+        // the consolidation is read from the tables after the cancel
+        add_samples(archives, 15, 16);
+        sample_type record;
+        archives.dataset(1).session_rd(0)->read_back(record);
+        BOOST_CHECK_EQUAL(10, record.field1());
+        BOOST_CHECK_EQUAL(12, record.field2());
+        archives.dataset(2).session_rd(0)->read_back(record);
+        BOOST_CHECK_EQUAL(10, record.field1());
+        BOOST_CHECK_EQUAL(15, record.field2());
+        BOOST_CHECK_EQUAL(2, archives.dataset(2).session_rd(0)->count());
+    }
+    archive_type::remove(ARCHIVE_NAME, defs.size());
+}
@@ -16,4 +16,46 @@ typedef backup_file<file_page_type, 8> file_type;
 typedef file_type::file_region_type file_region_type;
 
 #define TEST_FULL_TRANSACTION
-#include "cachefile_test.h"
\ No newline at end of file
+#include "cachefile_test.h"
+
+//==============================================================================
+//  Check the adjacent pages of the transaction are written by one call
+//==============================================================================
+BOOST_AUTO_TEST_CASE(write_back_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t page_size = file_page_type::DATA_SIZE;
+    const size_t page_count = file_type::CACHE_PAGE_COUNT - 2;
+    char outbuf[page_size * page_count];
+    memset(outbuf, 1, sizeof(outbuf));
+    file_region_type file_region(0, sizeof(outbuf));
+    file_type file(TEST_FILE_NAME, file_region);
+    file.resize(sizeof(outbuf));
+    file.start();
+    file.write(outbuf, sizeof(outbuf), 0);
+    file.stop();
+
+    char stubbuf[sizeof(outbuf)];
+    memset(stubbuf, 2, sizeof(stubbuf));
+    file_stats before = base_file::stats();
+    file.start();
+    file.write(stubbuf, sizeof(stubbuf), 0);
+    file.stop();
+    file_stats after = base_file::stats();
+    // the copies of the pages and the pages are written by one call each
+    BOOST_CHECK_EQUAL(after.writes - before.writes, 2);
+    char inbuf[sizeof(outbuf)];
+    file.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(stubbuf, ARRAY_END(stubbuf), inbuf, ARRAY_END(inbuf));
+
+    before = base_file::stats();
+    file.start();
+    file.write(outbuf, sizeof(outbuf), 0);
+    file.cancel();
+    after = base_file::stats();
+    // the pages are not saved, the pages are restored by one call
+    BOOST_CHECK_EQUAL(after.writes - before.writes, 2);
+    file.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(stubbuf, ARRAY_END(stubbuf), inbuf, ARRAY_END(inbuf));
+}
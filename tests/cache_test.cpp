@@ -4,6 +4,7 @@
 
 #include "ouroboros/interface.h"
 #include "ouroboros/cache.h"
+#include "ouroboros/cachepool.h"
 
 using namespace ouroboros;
 
@@ -281,6 +282,144 @@ void test_cache(Cache& cache, typename Cache::saver_type& saver)
     check_pagecache_detached(cache, 0, DATA_COUNT);
 }
 
+/**
+ * Check the hot pages survive a scan of the pages
+ * @param cache the cache
+ * @param hot the hot pages must stay in the cache
+ */
+template <typename Cache>
+void test_scan(const Cache& cache, const bool hot)
+{
+    const pos_type hot_count = Cache::CACHE_PAGE_COUNT / 4;
+    const pos_type scan_beg = 100 * Cache::CACHE_PAGE_COUNT;
+
+    /* request the pages [0; hot_count) between the new pages */
+    BOOST_TEST_MESSAGE("### test_scan 1");
+    pos_type index = 10 * Cache::CACHE_PAGE_COUNT;
+    for (pos_type n = 0; n < 20; ++n)
+    {
+        for (pos_type i = 0; i < hot_count; ++i)
+        {
+            cache.get_page(i);
+        }
+        for (pos_type i = 0; i < Cache::CACHE_PAGE_COUNT / 2; ++i)
+        {
+            cache.get_page(index++);
+        }
+    }
+    check_pagecache_attached(cache, 0, hot_count);
+
+    /* scan the pages, each page is requested several times */
+    BOOST_TEST_MESSAGE("### test_scan 2");
+    for (pos_type i = scan_beg; i < scan_beg + 10 * Cache::CACHE_PAGE_COUNT; ++i)
+    {
+        for (pos_type n = 0; n < 4; ++n)
+        {
+            cache.get_page(i);
+        }
+        BOOST_REQUIRE(cache.test_pool_page_count() <= Cache::CACHE_PAGE_COUNT);
+    }
+    if (hot)
+    {
+        check_pagecache_attached(cache, 0, hot_count);
+    }
+    else
+    {
+        check_pagecache_detached(cache, 0, hot_count);
+    }
+}
+
+/**
+ * Check the work of a dirty cache with any replacement policy
+ * @param cache the cache
+ * @param saver the saver of the slave cache
+ */
+template <typename Cache, int DATA_COUNT>
+void test_policy_cache(Cache& cache, typename Cache::saver_type& saver)
+{
+    char data[Cache::CACHE_PAGE_SIZE * DATA_COUNT];
+    for (pos_type i = 0; i < sizeof(data); i++)
+    {
+        data[i] = rand() % 100;
+    }
+    std::vector<pos_type> pages;
+    for (pos_type i = 0; i < DATA_COUNT; ++i)
+    {
+        pages.push_back(i);
+    }
+
+    /* modify the pages in random order with the repeated requests,
+     * the all pages must be saved */
+    for (pos_type n = 0; n < 3; ++n)
+    {
+        std::random_shuffle(pages.begin(), pages.end());
+        for (pos_type i = 0; i < DATA_COUNT; ++i)
+        {
+            const pos_type index = pages[i];
+            modify_cache(cache, data, index, index + 1);
+            const pos_type old_index = pages[rand() % (i + 1)];
+            modify_cache(cache, data, old_index, old_index + 1);
+            BOOST_REQUIRE(cache.test_pool_page_count() <= Cache::CACHE_PAGE_COUNT);
+        }
+        cache.clean();
+        saver.CheckPages(0, DATA_COUNT, data);
+        cache.free();
+        BOOST_REQUIRE(saver.empty());
+        check_pagecache_detached(cache, 0, DATA_COUNT);
+    }
+}
+
+/**
+ * Check the work of a cache after the count of the pages is changed
+ * @param cache the cache
+ * @param saver the saver of the slave cache
+ * @param count the new count of the pages
+ * @param lru the cache has LRU replacement policy
+ */
+template <typename Cache, int DATA_COUNT>
+void test_capacity(Cache& cache, typename Cache::saver_type& saver, const count_type count,
+    const bool lru)
+{
+    char data[Cache::CACHE_PAGE_SIZE * DATA_COUNT];
+    for (pos_type i = 0; i < sizeof(data); i++)
+    {
+        data[i] = rand() % 100;
+    }
+
+    /* the modified pages must be saved when the count of the pages is changed */
+    BOOST_TEST_MESSAGE("### test_capacity 1");
+    modify_cache(cache, data, 0, Cache::CACHE_PAGE_COUNT);
+    BOOST_REQUIRE_THROW(cache.set_capacity(1), range_error);
+    cache.set_capacity(count);
+    BOOST_REQUIRE_EQUAL(cache.capacity(), count);
+    saver.CheckPages(0, Cache::CACHE_PAGE_COUNT, data);
+    check_pagecache_detached(cache, 0, DATA_COUNT);
+
+    /* fill the pages [0; 100), the cache with LRU policy must have only
+     * the last pages */
+    BOOST_TEST_MESSAGE("### test_capacity 2");
+    fill_cache(cache, data, 0, DATA_COUNT);
+    BOOST_REQUIRE_EQUAL(cache.test_pool_page_count(), count);
+    if (lru)
+    {
+        check_pagecache_detached(cache, 0, DATA_COUNT - count);
+        check_pagecache_attached(cache, DATA_COUNT - count, DATA_COUNT);
+    }
+    cache.free();
+
+    /* modify the pages in random order, the all pages must be saved */
+    BOOST_TEST_MESSAGE("### test_capacity 3");
+    for (pos_type n = 0; n < DATA_COUNT; ++n)
+    {
+        const pos_type index = rand() % DATA_COUNT;
+        modify_cache(cache, data, index, index + 1);
+        BOOST_REQUIRE(cache.test_pool_page_count() <= count);
+    }
+    cache.free();
+    BOOST_REQUIRE(cache.empty());
+    saver.clear();
+}
+
 //==============================================================================
 //  Check the cache filling with data
 //==============================================================================
@@ -311,3 +450,150 @@ BOOST_AUTO_TEST_CASE(dirty_cache_test)
     test_cache<cache_type, data_count>(cache, saver);
 }
 
+
+//==============================================================================
+//  Check the cache with the map of pages with open addressing
+//==============================================================================
+BOOST_AUTO_TEST_CASE(probe_cache_test)
+{
+    const count_type page_count = 10;
+    const size_type page_size  = 1024;
+    const count_type data_count = 100;
+
+    typedef probe_cache<CacheSaver<page_size, data_count>, page_size, page_count> cache_type;
+    cache_type cache;
+    test_cache<cache_type, data_count>(cache);
+}
+
+//==============================================================================
+//  Check the cache with the map of pages with open addressing filling with
+//  dirty data
+//==============================================================================
+BOOST_AUTO_TEST_CASE(dirty_probe_cache_test)
+{
+    const count_type page_count = 10;
+    const size_type page_size  = 1024;
+    const count_type data_count = 100;
+
+    typedef probe_cache<CacheSaver<page_size, data_count>, page_size, page_count> cache_type;
+
+    CacheSaver<page_size, data_count> saver;
+    cache_type cache(saver);
+    test_cache<cache_type, data_count>(cache, saver);
+}
+
+//==============================================================================
+//  Check the cache with 2Q replacement policy
+//==============================================================================
+BOOST_AUTO_TEST_CASE(twoq_cache_test)
+{
+    const count_type page_count = 16;
+    const size_type page_size  = 64;
+    const count_type data_count = 100;
+
+    typedef twoq_cache<CacheSaver<page_size, data_count>, page_size, page_count> cache_type;
+
+    CacheSaver<page_size, data_count> saver;
+    cache_type cache(saver);
+    test_policy_cache<cache_type, data_count>(cache, saver);
+
+    cache_type scan_cache;
+    test_scan(scan_cache, true);
+}
+
+//==============================================================================
+//  Check the cache with ARC replacement policy
+//==============================================================================
+BOOST_AUTO_TEST_CASE(arc_cache_test)
+{
+    const count_type page_count = 16;
+    const size_type page_size  = 64;
+    const count_type data_count = 100;
+
+    typedef arc_cache<CacheSaver<page_size, data_count>, page_size, page_count> cache_type;
+
+    CacheSaver<page_size, data_count> saver;
+    cache_type cache(saver);
+    test_policy_cache<cache_type, data_count>(cache, saver);
+
+    cache_type scan_cache;
+    test_scan(scan_cache, true);
+}
+
+//==============================================================================
+//  Check the scan replaces the hot pages of the cache with LRU policy
+//==============================================================================
+BOOST_AUTO_TEST_CASE(lru_scan_test)
+{
+    const count_type page_count = 16;
+    const size_type page_size  = 64;
+    const count_type data_count = 100;
+
+    typedef cache<CacheSaver<page_size, data_count>, page_size, page_count> cache_type;
+    cache_type cache;
+    test_scan(cache, false);
+}
+
+//==============================================================================
+//  Check the count of the pages of the cache is changed at run time
+//==============================================================================
+BOOST_AUTO_TEST_CASE(capacity_test)
+{
+    const count_type page_count = 10;
+    const size_type page_size  = 64;
+    const count_type data_count = 100;
+
+    typedef CacheSaver<page_size, data_count> saver_type;
+    typedef cache<saver_type, page_size, page_count> lru_cache_type;
+    typedef probe_cache<saver_type, page_size, page_count> probe_cache_type;
+    typedef twoq_cache<saver_type, page_size, page_count> twoq_cache_type;
+    typedef arc_cache<saver_type, page_size, page_count> arc_cache_type;
+
+    saver_type saver;
+    lru_cache_type lru(saver);
+    test_capacity<lru_cache_type, data_count>(lru, saver, 25, true);
+    probe_cache_type probe(saver);
+    test_capacity<probe_cache_type, data_count>(probe, saver, 25, true);
+    twoq_cache_type twoq(saver);
+    test_capacity<twoq_cache_type, data_count>(twoq, saver, 25, false);
+    arc_cache_type arc(saver);
+    test_capacity<arc_cache_type, data_count>(arc, saver, 25, false);
+}
+
+//==============================================================================
+//  Check the data of the cache pages is aligned for the direct I/O
+//==============================================================================
+template <typename Cache>
+void test_alignment(Cache& cache, const count_type count)
+{
+    for (pos_type index = 0; index < count; ++index)
+    {
+        const size_t address = reinterpret_cast<size_t>(cache.get_page(index));
+        BOOST_REQUIRE_EQUAL(address % OUROBOROS_PAGE_ALIGNMENT, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(alignment_test)
+{
+    const count_type page_count = 10;
+    const size_type page_size  = OUROBOROS_PAGE_ALIGNMENT;
+    const count_type data_count = 20;
+
+    typedef CacheSaver<page_size, data_count> saver_type;
+    typedef cache<saver_type, page_size, page_count> lru_cache_type;
+    typedef twoq_cache<saver_type, page_size, page_count> twoq_cache_type;
+    typedef arc_cache<saver_type, page_size, page_count> arc_cache_type;
+
+    lru_cache_type lru;
+    test_alignment(lru, data_count);
+    lru.set_capacity(2 * page_count);
+    test_alignment(lru, data_count);
+    twoq_cache_type twoq;
+    test_alignment(twoq, data_count);
+    twoq.set_capacity(2 * page_count);
+    test_alignment(twoq, data_count);
+    arc_cache_type arc;
+    test_alignment(arc, data_count);
+    arc.set_capacity(2 * page_count);
+    test_alignment(arc, data_count);
+}
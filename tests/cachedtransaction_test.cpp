@@ -0,0 +1,15 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE cachedtransaction_test
+#include <boost/test/unit_test.hpp>
+
+#include "ouroboros/key.h"
+#include "ouroboros/journalfile.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/transaction.h"
+#include "ouroboros/sharedinterface.h"
+#include "test.h"
+
+typedef cached_shared_interface interface_type;
+typedef data_set<simple_key, record_type, index_null, interface_type> dataset_type;
+
+#include "transaction_test.h"
@@ -15,4 +15,23 @@ typedef file_page<1024> file_page_type;
 typedef cache_file<file_page_type, 8> file_type;
 typedef file_type::file_region_type file_region_type;
 
-#include "cachefile_test.h"
\ No newline at end of file
+#include "cachefile_test.h"
+BOOST_AUTO_TEST_CASE(direct_test)
+{
+    base_file::remove(TEST_FILE_NAME);
+    {
+        // the pages of 1 KiB aren't aligned for the direct I/O
+        file_type file(TEST_FILE_NAME);
+        BOOST_REQUIRE(!file.set_direct(true));
+        BOOST_REQUIRE(!file.direct());
+    }
+    base_file::remove(TEST_FILE_NAME);
+    {
+        typedef cache_file<file_page<OUROBOROS_PAGE_ALIGNMENT>, 8> aligned_file_type;
+        aligned_file_type file(TEST_FILE_NAME);
+        const bool direct = file.set_direct(true);
+        BOOST_REQUIRE_EQUAL(direct, file.direct());
+        BOOST_REQUIRE(!file.set_direct(false));
+    }
+    base_file::remove(TEST_FILE_NAME);
+}
@@ -587,4 +587,60 @@ BOOST_AUTO_TEST_CASE(rollback_test)
         BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
     }
 }
-#endif
\ No newline at end of file
+#endif
+//==============================================================================
+//  Check for the reading ahead of the pages
+//  W - whole file
+//  R - in parts of size CACHE_PAGE_SIZE / 4 sequentially
+//==============================================================================
+BOOST_AUTO_TEST_CASE(read_ahead_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t page_count = 64;
+    const size_t block_size = file_page_type::DATA_SIZE / 4;
+    std::vector<char> outbuf(file_page_type::DATA_SIZE * page_count);
+    for (size_t i = 0; i < outbuf.size(); i++)
+    {
+        outbuf[i] = i * 7;
+    }
+
+    file_region_type file_region(0, outbuf.size());
+    {
+        file_type file(TEST_FILE_NAME, file_region);
+        file.resize(outbuf.size());
+        file.start();
+        file.write(&outbuf[0], outbuf.size(), 0);
+        file.stop();
+    }
+
+    size_t reads[2] = { 0 };
+    for (size_t n = 0; n < 2; ++n)
+    {
+        file_type file(TEST_FILE_NAME, file_region);
+        file.set_cache_capacity(2 * page_count);
+        // the second reading doesn't read the pages ahead
+        file.set_read_ahead(0 == n ? OUROBOROS_READ_AHEAD : 0);
+        const file_stats before = base_file::stats();
+        char inbuf[block_size];
+        for (size_t i = 0; i < outbuf.size() / block_size; i++)
+        {
+            file.read(inbuf, sizeof(inbuf), i * block_size);
+            const char *beg = &outbuf[i * block_size];
+            BOOST_CHECK_EQUAL_COLLECTIONS(beg, beg + block_size, inbuf, ARRAY_END(inbuf));
+        }
+        reads[n] = base_file::stats().reads - before.reads;
+    }
+    BOOST_CHECK(reads[0] < page_count / 4);
+    BOOST_CHECK(reads[1] >= page_count);
+
+    // the prefetched pages are read without the reading of the file
+    file_type file(TEST_FILE_NAME, file_region);
+    file.set_cache_capacity(2 * page_count);
+    file.prefetch(outbuf.size(), 0);
+    const file_stats before = base_file::stats();
+    std::vector<char> inbuf(outbuf.size());
+    file.read(&inbuf[0], inbuf.size(), 0);
+    BOOST_CHECK_EQUAL(base_file::stats().reads - before.reads, 0);
+    BOOST_CHECK(inbuf == outbuf);
+}
@@ -0,0 +1,157 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE commitgroup_test
+#include <boost/test/unit_test.hpp>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "ouroboros/commitgroup.h"
+
+using namespace ouroboros;
+
+/**
+ * The data that is shared between processes
+ */
+struct shared_data
+{
+    commit_group group;
+    uint64_t syncs;
+    uint64_t errors;
+};
+
+/**
+ * The file that counts the synchronizations
+ */
+struct sync_file
+{
+    explicit sync_file(shared_data& data) :
+        m_data(data)
+    {}
+    void sync() const
+    {
+        usleep(1000);
+        __sync_fetch_and_add(&m_data.syncs, 1);
+    }
+    shared_data& m_data;
+};
+
+/**
+ * Create the data that is shared between processes
+ * @return the pointer to the data
+ */
+static shared_data *create_shared_data()
+{
+    void *ptr = mmap(NULL, sizeof(shared_data), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    BOOST_REQUIRE(ptr != MAP_FAILED);
+    shared_data *data = new(ptr) shared_data();
+    data->syncs = 0;
+    data->errors = 0;
+    return data;
+}
+
+/**
+ * Destroy the data that is shared between processes
+ * @param data the pointer to the data
+ */
+static void destroy_shared_data(shared_data *data)
+{
+    munmap(data, sizeof(shared_data));
+}
+
+/**
+ * Wait for the end of the process
+ * @param pid the identifier of the process
+ * @return the result of the process
+ */
+static bool wait_process(const pid_t pid)
+{
+    int status = -1;
+    return waitpid(pid, &status, 0) == pid && WIFEXITED(status) && 0 == WEXITSTATUS(status);
+}
+
+/**
+ * Commit the data by the processes
+ * @param data the data that is shared between processes
+ * @param proc_count the count of the processes
+ * @param commit_count the count of the commits of each process
+ */
+static void commit_processes(shared_data *data, const size_t proc_count, const size_t commit_count)
+{
+    std::vector<pid_t> pids;
+    for (size_t i = 0; i < proc_count; ++i)
+    {
+        const pid_t pid = fork();
+        BOOST_REQUIRE(pid != -1);
+        if (0 == pid)
+        {
+            sync_file file(*data);
+            for (size_t n = 0; n < commit_count; ++n)
+            {
+                const uint64_t syncs = data->syncs;
+                data->group.commit(file);
+                // the commit returns after the synchronization
+                if (data->syncs == syncs)
+                {
+                    __sync_fetch_and_add(&data->errors, 1);
+                }
+            }
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+    for (size_t i = 0; i < pids.size(); ++i)
+    {
+        BOOST_REQUIRE(wait_process(pids[i]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(single_test)
+{
+    shared_data *data = create_shared_data();
+    sync_file file(*data);
+    data->group.set_window(100);
+    for (size_t n = 0; n < 10; ++n)
+    {
+        data->group.commit(file);
+    }
+    const commit_stats stats = data->group.stats();
+    BOOST_REQUIRE_EQUAL(stats.commits, 10);
+    BOOST_REQUIRE_EQUAL(stats.syncs, 10);
+    BOOST_REQUIRE_EQUAL(stats.max_batch, 1);
+    BOOST_REQUIRE_EQUAL(data->syncs, 10);
+    destroy_shared_data(data);
+}
+
+BOOST_AUTO_TEST_CASE(group_test)
+{
+    const size_t proc_count = 8;
+    const size_t commit_count = 50;
+    shared_data *data = create_shared_data();
+    data->group.set_window(2000);
+    data->group.set_batch(proc_count);
+    BOOST_REQUIRE_EQUAL(data->group.window(), 2000);
+    BOOST_REQUIRE_EQUAL(data->group.batch(), proc_count);
+    commit_processes(data, proc_count, commit_count);
+    const commit_stats stats = data->group.stats();
+    BOOST_REQUIRE_EQUAL(data->errors, 0);
+    BOOST_REQUIRE_EQUAL(stats.commits, proc_count * commit_count);
+    BOOST_REQUIRE_EQUAL(stats.syncs, data->syncs);
+    BOOST_REQUIRE_LT(stats.syncs, stats.commits);
+    BOOST_REQUIRE_GT(stats.max_batch, 1);
+    BOOST_REQUIRE_LE(stats.max_batch, proc_count);
+    destroy_shared_data(data);
+}
+
+BOOST_AUTO_TEST_CASE(disabled_test)
+{
+    const size_t proc_count = 4;
+    const size_t commit_count = 20;
+    shared_data *data = create_shared_data();
+    data->group.set_batch(1);
+    commit_processes(data, proc_count, commit_count);
+    const commit_stats stats = data->group.stats();
+    BOOST_REQUIRE_EQUAL(data->errors, 0);
+    BOOST_REQUIRE_EQUAL(stats.commits, proc_count * commit_count);
+    BOOST_REQUIRE_EQUAL(stats.syncs, stats.commits);
+    BOOST_REQUIRE_EQUAL(data->syncs, stats.commits);
+    destroy_shared_data(data);
+}
@@ -5,8 +5,74 @@
 #include "ouroboros/key.h"
 #include "ouroboros/dataset.h"
 #include "ouroboros/interface.h"
+#include "ouroboros/migration.h"
 #include "test.h"
 
 typedef data_set<simple_key, record_type, index_null, local_interface> dataset_type;
 
-#include "dataset_test.h"
\ No newline at end of file
+#include "dataset_test.h"
+//==============================================================================
+//  Check the migration of the dataset through the dump
+//==============================================================================
+BOOST_AUTO_TEST_CASE(migration_test)
+{
+    const std::string name = DATASET_NAME "_migrated";
+    dataset_type::remove(DATASET_NAME);
+    dataset_type::remove(name);
+
+    const size_t tbl_count = 3;
+    const size_t rec_count = 100;
+    const char user_data[] = "user data";
+    std::stringstream dump;
+    {
+        dataset_type dataset(DATASET_NAME, tbl_count, rec_count, 2, user_data, sizeof(user_data));
+        for (size_t index = 0; index < tbl_count; ++index)
+        {
+            dataset.add_table(index);
+            record_list records;
+            // the last table is overwritten, the first record isn't at the begin
+            fill_records(records, rec_count / 2 + index * rec_count / 2, index * rec_count);
+            dataset_type::session_write session = dataset.session_wr(index);
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                session->add(records[i]);
+            }
+        }
+        export_dataset(dataset, dump);
+    }
+
+    import_dataset<dataset_type>(name, dump);
+    dataset_type dataset(name);
+    dataset.open();
+    BOOST_REQUIRE_EQUAL(dataset.table_count(), tbl_count);
+    BOOST_REQUIRE_EQUAL(dataset.rec_count(), rec_count);
+    BOOST_REQUIRE_EQUAL(dataset.version(), revision_type(2));
+    char data[sizeof(user_data)];
+    dataset.get_user_data(data, sizeof(data));
+    BOOST_REQUIRE_EQUAL(std::string(data), std::string(user_data));
+    for (size_t index = 0; index < tbl_count; ++index)
+    {
+        BOOST_TEST_MESSAGE(PE(index));
+        record_list records_wr;
+        fill_records(records_wr, rec_count / 2 + index * rec_count / 2, index * rec_count);
+        const size_t count = std::min(records_wr.size(), rec_count);
+        records_wr.erase(records_wr.begin(), records_wr.end() - count);
+        record_list records_rd(count);
+        dataset.session_rd(index)->read_front(records_rd);
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.begin(), records_wr.end(),
+            records_rd.begin(), records_rd.end());
+    }
+    dataset_type::remove(name);
+}
+
+#ifndef OUROBOROS_64BIT_OFFSETS
+//==============================================================================
+//  Check the dataset that is too big for 32-bit positions
+//==============================================================================
+BOOST_AUTO_TEST_CASE(too_big_test)
+{
+    dataset_type::remove(DATASET_NAME);
+    BOOST_REQUIRE_THROW(dataset_type(DATASET_NAME, 1000, 10000000), range_error);
+    dataset_type::remove(DATASET_NAME);
+}
+#endif
@@ -480,6 +480,52 @@ BOOST_AUTO_TEST_CASE(check_wrong_ver_test)
     }
 }
 
+//==============================================================================
+//  Check the optimistic reading of records
+//==============================================================================
+BOOST_AUTO_TEST_CASE(read_optimistic_test)
+{
+    dataset_type::remove(DATASET_NAME);
+
+    const size_t tbl_count = 3;
+    const size_t rec_count = 100;
+    dataset_type dataset(DATASET_NAME, tbl_count, rec_count);
+    for (size_t index = 0; index < tbl_count - 1; ++index)
+    {
+        BOOST_TEST_MESSAGE("add a table " << PE(index));
+        dataset.add_table(index);
+    }
+
+    for (size_t index = 0; index < tbl_count - 1; ++index)
+    {
+        BOOST_TEST_MESSAGE(PE(index));
+        record_list records_wr;
+        fill_records(records_wr, rec_count / 2 + index, index * rec_count);
+        dataset.session_wr(index)->add(records_wr);
+
+        record_list records_rd;
+        records_reader<record_list> reader(records_rd);
+        BOOST_REQUIRE(dataset.read_optimistic(index, reader));
+        BOOST_CHECK_EQUAL(reader.calls, size_t(1));
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.begin(), records_wr.end(),
+            records_rd.begin(), records_rd.end());
+
+        // the table that is being written is read in the session
+        dataset_type::session_write session = dataset.session_wr(index);
+        session->add(records_wr.front());
+        records_wr.push_back(records_wr.front());
+        BOOST_REQUIRE(dataset.read_optimistic(index, reader));
+        BOOST_CHECK_EQUAL(reader.calls, size_t(2));
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.begin(), records_wr.end(),
+            records_rd.begin(), records_rd.end());
+    }
+
+    record_list records_rd;
+    records_reader<record_list> reader(records_rd);
+    BOOST_CHECK(!dataset.read_optimistic(tbl_count - 1, reader));
+    BOOST_CHECK_EQUAL(reader.calls, size_t(0));
+}
+
 //==============================================================================
 //  Check the reopening of the dataset
 //==============================================================================
@@ -508,4 +554,37 @@ BOOST_AUTO_TEST_CASE(reopen_test)
             BOOST_CHECK(dataset.table_exists(index));
         }
     }
-}
\ No newline at end of file
+}
+//==============================================================================
+//  Check the changing of the count of the cache pages of the dataset
+//==============================================================================
+BOOST_AUTO_TEST_CASE(cache_capacity_test)
+{
+    dataset_type::remove(DATASET_NAME);
+
+    const size_t tbl_count = 2;
+    const size_t rec_count = 1000;
+    dataset_type dataset(DATASET_NAME, tbl_count, rec_count);
+    const count_type capacity = 3 * dataset.cache_capacity();
+    dataset.set_cache_capacity(capacity);
+    BOOST_CHECK_EQUAL(capacity, dataset.cache_capacity());
+    for (size_t index = 0; index < tbl_count; ++index)
+    {
+        BOOST_TEST_MESSAGE("add a table " << PE(index));
+        dataset.add_table(index);
+        record_list records_wr;
+        fill_records(records_wr, rec_count, index * rec_count);
+        dataset.session_wr(index)->add(records_wr);
+    }
+
+    dataset.set_cache_capacity(2);
+    for (size_t index = 0; index < tbl_count; ++index)
+    {
+        record_list records_wr;
+        fill_records(records_wr, rec_count, index * rec_count);
+        record_list records_rd(rec_count);
+        dataset.session_rd(index)->read(records_rd, 0);
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.begin(), records_wr.end(),
+            records_rd.begin(), records_rd.end());
+    }
+}
@@ -17,4 +17,111 @@ typedef simple_key skey_type;
 typedef data_source<interface_table, record_type, local_interface> datasource_type;
 typedef data_table<interface_table, record_type, skey_type, local_interface> datatable_type;
 
-#include "datatable_test.h"
\ No newline at end of file
+#include "datatable_test.h"
+
+//==============================================================================
+//  Check for the aggregation of the fields of the records
+//      the records are wrapped around the end of the table
+//==============================================================================
+BOOST_AUTO_TEST_CASE(aggregate_test)
+{
+    datasource_type::remove(DATASOURCE_NAME);
+    const size_t tbl_count = 4;
+    const size_t rec_count = 100;
+    datasource_type source(DATASOURCE_NAME, tbl_count, rec_count, options);
+    file_region_type file_region(tbl_count, source.table_size());
+    source.set_file_region(file_region);
+    skey_type skey(1, 1, 0, 0, 0, 0);
+    datatable_type table(source, skey);
+    table.clear();
+    BOOST_REQUIRE_EQUAL(table.aggregate<index1>(table.beg_pos(), table.count()).count, 0);
+    record_list records_wr;
+    fill_records(records_wr, rec_count, 0);
+    table.add(records_wr);
+    record_list records_add;
+    fill_records(records_add, rec_count / 2, rec_count);
+    table.add(records_add);
+
+    // the records [rec_count / 2, 3 * rec_count / 2)
+    const aggregate_result<int32_t> result1 = table.aggregate<index1>(table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result1.count, rec_count);
+    BOOST_REQUIRE_EQUAL(result1.sum, 9950);
+    BOOST_REQUIRE_EQUAL(result1.min, 50);
+    BOOST_REQUIRE_EQUAL(result1.max, 149);
+    BOOST_REQUIRE_EQUAL(result1.last, 149);
+    BOOST_REQUIRE_CLOSE(result1.avg(), 99.5, 0.001);
+    const aggregate_result<float> result2 = table.aggregate<index2>(table.beg_pos(), table.count());
+    BOOST_REQUIRE_CLOSE(result2.sum, 10050.0, 0.001);
+    BOOST_REQUIRE_CLOSE(result2.max, 150.0, 0.001);
+    const aggregate_result<int32_t> result3 = table.aggregate<index1>(table.beg_pos(), rec_count / 10);
+    BOOST_REQUIRE_EQUAL(result3.count, rec_count / 10);
+    BOOST_REQUIRE_EQUAL(result3.sum, 545);
+
+    // the filtered aggregation
+    typedef comp_greater_equal<record_type, index1> greater_equal_type;
+    typedef fields_comparator<record_type, index1, index2, op_less> fields_type;
+    const aggregate_result<int32_t> result4 = table.aggregate<index1>(comb_and<greater_equal_type, fields_type>(
+        greater_equal_type(140), fields_type()), table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result4.count, 10);
+    BOOST_REQUIRE_EQUAL(result4.sum, 1445);
+    BOOST_REQUIRE_EQUAL(result4.min, 140);
+    const aggregate_result<int32_t> result5 = table.aggregate<index1>(comp_less<record_type, index1>(0),
+        table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result5.count, 0);
+    BOOST_REQUIRE_EQUAL(result5.avg(), 0.0);
+    // the comparator without the packed form
+    const aggregate_result<int32_t> result6 = table.aggregate<index1>(comp_even<record_type>(),
+        table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result6.count, rec_count / 2);
+    BOOST_REQUIRE_EQUAL(result6.sum, 4950);
+    BOOST_REQUIRE_EQUAL(result6.max, 148);
+}
+
+//==============================================================================
+//  Check for the binary search by the field that doesn't decrease
+//==============================================================================
+BOOST_AUTO_TEST_CASE(bound_test)
+{
+    datasource_type::remove(DATASOURCE_NAME);
+    const size_t tbl_count = 4;
+    const size_t rec_count = 100;
+    datasource_type source(DATASOURCE_NAME, tbl_count, rec_count, options);
+    file_region_type file_region(tbl_count, source.table_size());
+    source.set_file_region(file_region);
+    skey_type skey(1, 1, 0, 0, 0, 0);
+    datatable_type table(source, skey);
+    table.clear();
+    record_list records;
+    BOOST_REQUIRE_EQUAL(table.lower_bound_by<index1>(0), table.end_pos());
+    BOOST_REQUIRE_EQUAL(table.read_by<index1>(records, 0, 10), table.end_pos());
+    BOOST_REQUIRE(records.empty());
+    record_list records_wr;
+    fill_records(records_wr, rec_count, 0);
+    table.add(records_wr);
+    record_list records_add;
+    fill_records(records_add, rec_count / 2, rec_count);
+    table.add(records_add);
+
+    // the records [rec_count / 2, 3 * rec_count / 2) wrap around the end of the ring
+    const pos_type beg = table.beg_pos();
+    BOOST_REQUIRE_EQUAL(table.lower_bound_by<index1>(-5), beg);
+    BOOST_REQUIRE_EQUAL(table.lower_bound_by<index1>(50), beg);
+    BOOST_REQUIRE_EQUAL(table.lower_bound_by<index1>(120), table.inc_pos(beg, 70));
+    BOOST_REQUIRE_EQUAL(table.upper_bound_by<index1>(120), table.inc_pos(beg, 71));
+    BOOST_REQUIRE_EQUAL(table.lower_bound_by<index1>(1000), table.end_pos());
+    BOOST_REQUIRE_EQUAL(table.upper_bound_by<index1>(149), table.end_pos());
+
+    BOOST_REQUIRE_EQUAL(table.read_by<index1>(records, 95, 104), table.inc_pos(beg, 55));
+    BOOST_REQUIRE_EQUAL(records.size(), 10);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(records_wr.begin() + 95, records_wr.end(), records.begin(), records.begin() + 5);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(records_add.begin(), records_add.begin() + 5, records.begin() + 5, records.end());
+    table.read_by<index1>(records, 140, 1000);
+    BOOST_REQUIRE_EQUAL(records.size(), 10);
+    BOOST_REQUIRE_EQUAL(records.back().field1(), 149);
+    table.read_by<index1>(records, -10, 1000);
+    BOOST_REQUIRE_EQUAL(records.size(), rec_count);
+    table.read_by<index1>(records, 0, 49);
+    BOOST_REQUIRE(records.empty());
+    table.read_by<index1>(records, 60, 55);
+    BOOST_REQUIRE(records.empty());
+}
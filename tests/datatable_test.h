@@ -398,4 +398,35 @@ BOOST_AUTO_TEST_CASE(wr_d_onblk_rd_test)
         table.read(records_rd, table.beg_pos());
         BOOST_REQUIRE_EQUAL_COLLECTIONS(records_wr.begin(), records_wr.end(), records_rd.begin(), records_rd.end());
     }
-}
\ No newline at end of file
+}
+//==============================================================================
+//  Check for the reading ahead of the records
+//      the records are wrapped around the end of the table
+//==============================================================================
+BOOST_AUTO_TEST_CASE(prefetch_test)
+{
+    datasource_type::remove(DATASOURCE_NAME);
+    const size_t tbl_count = 4;
+    const size_t rec_count = 100;
+    datasource_type source(DATASOURCE_NAME, tbl_count, rec_count, options);
+    file_region_type file_region(tbl_count, source.table_size());
+    source.set_file_region(file_region);
+    skey_type skey(1, 1, 0, 0, 0, 0);
+    datatable_type table(source, skey);
+    table.clear();
+    record_list records_wr;
+    fill_records(records_wr, rec_count, 0);
+    table.add(records_wr);
+    record_list records_add;
+    fill_records(records_add, rec_count / 2, rec_count);
+    table.add(records_add);
+    records_wr.insert(records_wr.end(), records_add.begin(), records_add.end());
+    records_wr.erase(records_wr.begin(), records_wr.begin() + rec_count / 2);
+    BOOST_REQUIRE(table.beg_pos() > 0);
+
+    table.prefetch(table.beg_pos(), table.count());
+    table.prefetch(table.beg_pos(), 1);
+    record_list records_rd(table.count());
+    table.read(records_rd, table.beg_pos());
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(records_wr.begin(), records_wr.end(), records_rd.begin(), records_rd.end());
+}
@@ -2,8 +2,15 @@
 #define BOOST_TEST_MODULE file_test
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "ouroboros/table.h"
+#include "ouroboros/mmapfile.h"
+#include "ouroboros/ioring.h"
 
 using namespace ouroboros;
 
@@ -43,3 +50,333 @@ BOOST_AUTO_TEST_CASE(test1)
     base_file::remove(filename.c_str());
     BOOST_REQUIRE(!boost::filesystem::exists(filename));
 }
+
+BOOST_AUTO_TEST_CASE(mmap_test)
+{
+    typedef mmap_file<file_page<1> > file_type;
+    const size_type size = 1024;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        file_type file(filename.c_str());
+        file_type other(filename.c_str());
+        BOOST_REQUIRE_EQUAL(size, file.resize(size));
+
+        char out[2 * size] = { 0 };
+        char in[2 * size] = { 0 };
+        for (size_t i = 0; i < 2 * size; ++i)
+        {
+            out[i] = i;
+        }
+        file.write(out, size, 0);
+        file.read(in, size, 0);
+        BOOST_REQUIRE(memcmp(out, in, size) == 0);
+        for (size_t i = 0; i < size; ++i)
+        {
+            out[i] = i + 1;
+            file.write(&out[i], 1, i);
+            file.read(&in[i], 1, i);
+            BOOST_REQUIRE_EQUAL(out[i], in[i]);
+        }
+
+        // the file is sized up by other file, the mapping is changed by reading
+        other.read(in, size, 0);
+        BOOST_REQUIRE(memcmp(out, in, size) == 0);
+        BOOST_REQUIRE_EQUAL(2 * size, other.resize(2 * size));
+        other.write(&out[size], size, size);
+        file.read(in, 2 * size, 0);
+        BOOST_REQUIRE(memcmp(out, in, 2 * size) == 0);
+
+        // the data beyond the file can't be read
+        BOOST_REQUIRE_THROW(file.read(in, size, 2 * size), io_error);
+
+        // the file is sized down by other file, the data beyond the end
+        // isn't copied from the mapping
+        const size_type page = sysconf(_SC_PAGESIZE);
+        std::vector<char> buffer(4 * page);
+        BOOST_REQUIRE_EQUAL(4 * page, other.resize(4 * page));
+        file.read(&buffer[0], 4 * page, 0);
+        BOOST_REQUIRE_EQUAL(size, other.resize(size));
+        BOOST_REQUIRE_THROW(file.read(&buffer[0], page, 2 * page), io_error);
+        file.read(in, size, 0);
+        BOOST_REQUIRE(memcmp(out, in, size) == 0);
+    }
+    base_file::remove(filename.c_str());
+    BOOST_REQUIRE(!boost::filesystem::exists(filename));
+}
+
+BOOST_AUTO_TEST_CASE(writev_test)
+{
+    const size_type size = 1024;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        base_file file(filename.c_str());
+        BOOST_REQUIRE_EQUAL(4 * size, file.resize(4 * size));
+
+        char out[3][size];
+        struct iovec iov[3];
+        for (size_t n = 0; n < 3; ++n)
+        {
+            memset(out[n], n + 1, size);
+            iov[n].iov_base = out[n];
+            iov[n].iov_len = size;
+        }
+        const file_stats before = base_file::stats();
+        file.writev(iov, 3, size);
+        const file_stats after = base_file::stats();
+        // the adjacent buffers are written by one call
+        BOOST_REQUIRE_EQUAL(after.writes - before.writes, 1);
+        char in[4 * size];
+        file.read(in, sizeof(in), 0);
+        BOOST_REQUIRE_EQUAL(in[0], 0);
+        for (size_t n = 0; n < 3; ++n)
+        {
+            BOOST_REQUIRE(memcmp(out[n], in + (n + 1) * size, size) == 0);
+        }
+    }
+    base_file::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(submit_test)
+{
+    const size_type size = 512;
+    const size_t count = 3 * OUROBOROS_IO_RING_SIZE / 2;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        base_file file(filename.c_str());
+        BOOST_REQUIRE_EQUAL(count * size, file.resize(count * size));
+
+        // the requests don't fit in the ring, so the ring is waited
+        std::vector<char> out(count * size);
+        for (size_t n = 0; n < count; ++n)
+        {
+            memset(&out[n * size], n + 1, size);
+        }
+        const file_stats before = base_file::stats();
+        for (size_t n = 0; n < count - 2; ++n)
+        {
+            file.submit_write(&out[n * size], size, n * size);
+        }
+        struct iovec iov[2];
+        for (size_t n = 0; n < 2; ++n)
+        {
+            iov[n].iov_base = &out[(count - 2 + n) * size];
+            iov[n].iov_len = size;
+        }
+        file.submit_writev(iov, 2, (count - 2) * size);
+        file.sync();
+        const file_stats after = base_file::stats();
+        BOOST_REQUIRE_EQUAL(after.writes - before.writes, count - 1);
+#ifdef OUROBOROS_IO_URING_ENABLED
+        BOOST_REQUIRE(after.submits > before.submits);
+#endif
+        std::vector<char> in(count * size);
+        for (size_t n = 0; n < count; ++n)
+        {
+            file.submit_read(&in[n * size], size, n * size);
+        }
+        file.complete();
+        BOOST_REQUIRE(in == out);
+    }
+    base_file::remove(filename.c_str());
+}
+
+#ifdef OUROBOROS_IO_URING_ENABLED
+/**
+ * The file that submits the requests of the ring without waiting for them
+ */
+class submit_file : public base_file
+{
+public:
+    explicit submit_file(const char *name) :
+        base_file(name)
+    {}
+    bool submit() const
+    {
+        io_ring *ring = base_file::ring();
+        if (ring != NULL)
+        {
+            ring->submit();
+        }
+        return ring != NULL;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(short_write_test)
+{
+    const size_type size = 8192;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        submit_file file(filename.c_str());
+        std::vector<char> out(size, 1);
+        // the limit of the size makes the write of the ring short
+        struct rlimit limit;
+        BOOST_REQUIRE_EQUAL(getrlimit(RLIMIT_FSIZE, &limit), 0);
+        struct rlimit low = limit;
+        low.rlim_cur = size / 2;
+        void (*handler)(int) = signal(SIGXFSZ, SIG_IGN);
+        BOOST_REQUIRE_EQUAL(setrlimit(RLIMIT_FSIZE, &low), 0);
+        const file_stats before = base_file::stats();
+        file.submit_write(&out[0], size, 0);
+        const bool submitted = file.submit();
+        struct stat st;
+        for (size_t n = 0; submitted && n < 1000; ++n)
+        {
+            BOOST_REQUIRE_EQUAL(stat(filename.c_str(), &st), 0);
+            if (st.st_size == static_cast<off_t>(size / 2))
+            {
+                break;
+            }
+            usleep(1000);
+        }
+        BOOST_REQUIRE_EQUAL(setrlimit(RLIMIT_FSIZE, &limit), 0);
+        signal(SIGXFSZ, handler);
+        // the rest of the write is executed after the synchronization of
+        // the ring, so the data is synchronized again
+        file.sync();
+        const file_stats after = base_file::stats();
+        BOOST_REQUIRE_EQUAL(file.size(), size);
+        if (submitted)
+        {
+            BOOST_REQUIRE_EQUAL(after.syncs - before.syncs, 2);
+        }
+        std::vector<char> in(size);
+        file.read(&in[0], size, 0);
+        BOOST_REQUIRE(in == out);
+    }
+    base_file::remove(filename.c_str());
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(direct_test)
+{
+    const size_type size = OUROBOROS_PAGE_ALIGNMENT;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        base_file file(filename.c_str());
+        BOOST_REQUIRE_EQUAL(4 * size, file.resize(4 * size));
+        if (!file.set_direct(true))
+        {
+            BOOST_TEST_MESSAGE("the direct I/O is not supported by the file system");
+            return;
+        }
+        BOOST_REQUIRE(file.direct());
+
+        void *memory = NULL;
+        BOOST_REQUIRE_EQUAL(posix_memalign(&memory, OUROBOROS_PAGE_ALIGNMENT, 2 * size), 0);
+        char *page = static_cast<char *>(memory);
+        // the aligned data is written by the direct I/O
+        memset(page, 1, 2 * size);
+        file.write(page, 2 * size, size);
+        // the unaligned data is written through the page cache
+        const char value = 2;
+        file.write(&value, sizeof(value), size + 1);
+        file.read(page, 2 * size, size);
+        BOOST_REQUIRE_EQUAL(page[0], 1);
+        BOOST_REQUIRE_EQUAL(page[1], 2);
+        BOOST_REQUIRE_EQUAL(page[2 * size - 1], 1);
+        char in[3] = { 0 };
+        file.read(in, sizeof(in), size);
+        BOOST_REQUIRE_EQUAL(in[0], 1);
+        BOOST_REQUIRE_EQUAL(in[1], 2);
+        BOOST_REQUIRE_EQUAL(in[2], 1);
+        free(memory);
+
+        BOOST_REQUIRE(!file.set_direct(false));
+        BOOST_REQUIRE(!file.direct());
+    }
+    base_file::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(allocate_test)
+{
+    const size_type size = 64 << 20;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        base_file file(filename.c_str());
+        const char value = 1;
+        BOOST_REQUIRE_EQUAL(size / 2, file.resize(size / 2));
+        file.write(&value, sizeof(value), size / 2 - 1);
+        // the growth is read as zeros
+        BOOST_REQUIRE_EQUAL(size, file.resize(size));
+        BOOST_REQUIRE_EQUAL(size, file.size());
+        char in[2] = { 0 };
+        file.read(in, sizeof(in), size / 2 - 1);
+        BOOST_REQUIRE_EQUAL(in[0], 1);
+        BOOST_REQUIRE_EQUAL(in[1], 0);
+        file.read(in, sizeof(in), size - sizeof(in));
+        BOOST_REQUIRE_EQUAL(in[0], 0);
+        BOOST_REQUIRE_EQUAL(in[1], 0);
+#ifdef OUROBOROS_FALLOCATE_ENABLED
+        // the file is not sparse if the file system supports the preallocation
+        const std::string probename = "probe.dat";
+        const int fd = open(probename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        BOOST_REQUIRE(fd != -1);
+        const int probe = fallocate(fd, 0, 0, OUROBOROS_PAGE_ALIGNMENT);
+        const int err = errno;
+        close(fd);
+        base_file::remove(probename.c_str());
+        if (-1 == probe && EOPNOTSUPP == err)
+        {
+            BOOST_TEST_MESSAGE("the preallocation is not supported by the file system");
+        }
+        else
+        {
+            BOOST_REQUIRE_EQUAL(probe, 0);
+            struct stat st;
+            BOOST_REQUIRE_EQUAL(stat(filename.c_str(), &st), 0);
+            BOOST_REQUIRE_GE(st.st_blocks * 512, static_cast<off_t>(size));
+        }
+#endif
+        // the truncated data is zeroed when the file is sized up again
+        BOOST_REQUIRE_EQUAL(size / 4, file.resize(size / 4));
+        file.write(&value, sizeof(value), size / 4 - 1);
+        BOOST_REQUIRE_EQUAL(size, file.resize(size));
+        file.read(in, sizeof(in), size / 2 - 1);
+        BOOST_REQUIRE_EQUAL(in[0], 0);
+        file.read(in, sizeof(in), size / 4 - 1);
+        BOOST_REQUIRE_EQUAL(in[0], 1);
+        BOOST_REQUIRE_EQUAL(in[1], 0);
+    }
+    base_file::remove(filename.c_str());
+}
+
+#ifdef OUROBOROS_64BIT_OFFSETS
+BOOST_AUTO_TEST_CASE(offset64_test)
+{
+    const size_type size = 1024;
+    const pos_type pos = pos_type(5) << 30;
+    const std::string filename = "test.dat";
+
+    base_file::remove(filename.c_str());
+    {
+        base_file file(filename.c_str());
+        BOOST_REQUIRE_EQUAL(pos + size, file.resize(pos + size));
+        BOOST_REQUIRE_EQUAL(pos + size, file.size());
+
+        char out[size] = { 0 };
+        char in[size] = { 0 };
+        for (size_t i = 0; i < size; ++i)
+        {
+            out[i] = i;
+        }
+        file.write(out, size, pos);
+        file.read(in, size, pos);
+        BOOST_REQUIRE(memcmp(out, in, size) == 0);
+        file.read(in, size, pos - size);
+        BOOST_REQUIRE_EQUAL(in[0], 0);
+    }
+    base_file::remove(filename.c_str());
+}
+#endif
@@ -13,6 +13,49 @@
 typedef data_set<simple_key, record_type, index_null, local_interface> dataset_type;
 typedef dataset_type::record_list record_list;
 
+/**
+ * The comparator of the even first field that compares only the unpacked
+ * records, it counts the comparing
+ */
+struct even_comparator
+{
+    typedef ::record_type record_type;
+    inline bool operator ()(const record_type& record) const
+    {
+        ++s_count;
+        return 0 == record.field1() % 2;
+    }
+    static count_type s_count;
+};
+
+count_type even_comparator::s_count = 0;
+
+/**
+ * The comparator (field1 >= value) that also compares the packed records,
+ * it counts the comparing of the unpacked records
+ */
+struct counted_comparator
+{
+    typedef ::record_type record_type;
+    typedef packed_compare_tag compare_category;
+    explicit counted_comparator(const int32_t value) :
+        value(value)
+    {}
+    inline bool operator ()(const record_type& record) const
+    {
+        ++s_count;
+        return record.field1() >= value;
+    }
+    inline bool operator ()(const void *data) const
+    {
+        return index1<record_type>::value(data) >= value;
+    }
+    int32_t value;
+    static count_type s_count;
+};
+
+count_type counted_comparator::s_count = 0;
+
 BOOST_AUTO_TEST_CASE(find_test)
 {
     dataset_type::remove(DATASET_NAME);
@@ -97,3 +140,135 @@ BOOST_AUTO_TEST_CASE(find_test)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(packed_test)
+{
+    dataset_type::remove(DATASET_NAME);
+
+    const size_t count = 100;
+    dataset_type dataset(DATASET_NAME, 1, count);
+
+    // the ring of the records is wrapped, the records are [count / 2, 3 * count / 2)
+    dataset.add_table(0);
+    record_list records_wr;
+    fill_records(records_wr, 3 * count / 2, 0);
+    dataset.session_wr(0)->add(record_list(records_wr.begin(), records_wr.begin() + count));
+    dataset.session_wr(0)->add(record_list(records_wr.begin() + count, records_wr.end()));
+
+    {
+        // the comparators give the same result for the packed records
+        typedef comp_greater_equal<record_type, index1> comparator1_type;
+        typedef fields_comparator<record_type, index1, index2, op_less> comparator2_type;
+        typedef comp_equal<record_type, index3> comparator3_type;
+        typedef comb_or<comb_and<comparator1_type, comparator2_type>, comparator3_type> comparator_type;
+        const comparator_type comp(comb_and<comparator1_type, comparator2_type>(comparator1_type(count), comparator2_type()),
+            comparator3_type("none"));
+        std::vector<char> buffer(record_type::static_size());
+        for (size_t i = 0; i < records_wr.size(); ++i)
+        {
+            records_wr[i].pack(&buffer[0]);
+            BOOST_REQUIRE_EQUAL(comp(records_wr[i]), comp(static_cast<const void *>(&buffer[0])));
+            BOOST_REQUIRE_EQUAL(record_type::unpack_field3(&buffer[0]), records_wr[i].field3());
+        }
+    }
+
+    {
+        typedef comp_greater_equal<record_type, index1> comparator_type;
+        typedef finder<comparator_type> finder_type;
+        finder_type finder(comparator_type(count + count / 5), 5);
+        dataset_type::session_read session = dataset.session_rd(0);
+        // the finder is stopped by the limit of the records
+        BOOST_REQUIRE_EQUAL(session->find(finder, session->beg_pos(), session->count()), (count + count / 5 + 4) % count);
+        BOOST_REQUIRE_EQUAL(finder.pos(), (count + count / 5 + 5) % count);
+        const finder_type::result_type& result = finder.result();
+        BOOST_REQUIRE_EQUAL(result.size(), 5);
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.begin() + count + count / 5, records_wr.begin() + count + count / 5 + 5,
+            result.begin(), result.end());
+    }
+
+    {
+        typedef comp_less<record_type, index1> comparator_type;
+        typedef finder<comparator_type> finder_type;
+        finder_type finder(comparator_type(count / 2 + 10), 5);
+        dataset_type::session_read session = dataset.session_rd(0);
+        BOOST_REQUIRE_EQUAL(session->rfind(finder, session->end_pos(), session->count()), count / 2 + 5);
+        BOOST_REQUIRE_EQUAL(finder.pos(), count / 2 + 4);
+        const finder_type::result_type& result = finder.result();
+        BOOST_REQUIRE_EQUAL(result.size(), 5);
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.rbegin() + count - 10, records_wr.rbegin() + count - 5,
+            result.begin(), result.end());
+    }
+
+    {
+        // all records are found in the reverse order, the finder isn't stopped
+        typedef comp_equal<record_type, index3> comparator_type;
+        typedef finder<comparator_type> finder_type;
+        finder_type finder(comparator_type("test"));
+        dataset_type::session_read session = dataset.session_rd(0);
+        BOOST_REQUIRE_EQUAL(session->rfind(finder, session->end_pos(), session->count()), NIL);
+        BOOST_REQUIRE_EQUAL(finder.pos(), count / 2 - 1);
+        const finder_type::result_type& result = finder.result();
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.rbegin(), records_wr.rbegin() + count, result.begin(), result.end());
+    }
+    dataset_type::remove(DATASET_NAME);
+}
+
+BOOST_AUTO_TEST_CASE(unpacked_test)
+{
+    dataset_type::remove(DATASET_NAME);
+
+    const size_t count = 100;
+    dataset_type dataset(DATASET_NAME, 1, count);
+
+    // the ring of the records is wrapped, the records are [count / 2, 3 * count / 2)
+    dataset.add_table(0);
+    record_list records_wr;
+    fill_records(records_wr, 3 * count / 2, 0);
+    dataset.session_wr(0)->add(record_list(records_wr.begin(), records_wr.begin() + count));
+    dataset.session_wr(0)->add(record_list(records_wr.begin() + count, records_wr.end()));
+
+    {
+        // the comparator without the packed form compares each record once
+        typedef finder<even_comparator> finder_type;
+        finder_type finder((even_comparator()));
+        even_comparator::s_count = 0;
+        dataset_type::session_read session = dataset.session_rd(0);
+        BOOST_REQUIRE_EQUAL(session->find(finder, session->beg_pos(), session->count()), NIL);
+        BOOST_CHECK_EQUAL(even_comparator::s_count, count);
+        const finder_type::result_type& result = finder.result();
+        BOOST_REQUIRE_EQUAL(result.size(), count / 2);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(result[i], records_wr[count / 2 + 2 * i]);
+        }
+    }
+
+    {
+        typedef comp_greater_equal<record_type, index1> greater_equal_type;
+        typedef comb_and<greater_equal_type, even_comparator> comparator_type;
+        typedef finder<comparator_type> finder_type;
+        finder_type finder(comparator_type(greater_equal_type(count), even_comparator()), 5);
+        dataset_type::session_read session = dataset.session_rd(0);
+        BOOST_REQUIRE_EQUAL(session->rfind(finder, session->end_pos(), session->count()), count / 2 - 10);
+        const finder_type::result_type& result = finder.result();
+        BOOST_REQUIRE_EQUAL(result.size(), 5);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(result[i], records_wr[3 * count / 2 - 2 - 2 * i]);
+        }
+    }
+
+    {
+        // the records found on the packed form aren't compared again
+        typedef finder<counted_comparator> finder_type;
+        const counted_comparator comp(count);
+        finder_type finder(comp);
+        counted_comparator::s_count = 0;
+        dataset_type::session_read session = dataset.session_rd(0);
+        BOOST_REQUIRE_EQUAL(session->find(finder, session->beg_pos(), session->count()), NIL);
+        BOOST_CHECK_EQUAL(counted_comparator::s_count, 0);
+        const finder_type::result_type& result = finder.result();
+        BOOST_CHECK_EQUAL_COLLECTIONS(records_wr.begin() + count, records_wr.end(), result.begin(), result.end());
+    }
+    dataset_type::remove(DATASET_NAME);
+}
@@ -0,0 +1,252 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE futexlock_test
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "ouroboros/futexlock.h"
+
+using namespace ouroboros;
+
+/**
+ * Get the time after the timeout
+ * @param timeout the timeout (ms)
+ * @return the time after the timeout
+ */
+static boost::posix_time::ptime time_after(const size_t timeout)
+{
+    return boost::get_system_time() + boost::posix_time::millisec(timeout);
+}
+
+/**
+ * The data that is shared between processes
+ */
+template <typename Lock>
+struct shared_data
+{
+    Lock lock;
+    size_t counter;
+};
+
+/**
+ * Create the data that is shared between processes
+ * @return the pointer to the data
+ */
+template <typename Lock>
+static shared_data<Lock> *create_shared_data()
+{
+    void *ptr = mmap(NULL, sizeof(shared_data<Lock>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    BOOST_REQUIRE(ptr != MAP_FAILED);
+    shared_data<Lock> *data = new(ptr) shared_data<Lock>();
+    data->counter = 0;
+    return data;
+}
+
+/**
+ * Destroy the data that is shared between processes
+ * @param data the pointer to the data
+ */
+template <typename Lock>
+static void destroy_shared_data(shared_data<Lock> *data)
+{
+    munmap(data, sizeof(shared_data<Lock>));
+}
+
+/**
+ * Wait for the end of the process
+ * @param pid the identifier of the process
+ * @return the result of the process
+ */
+static bool wait_process(const pid_t pid)
+{
+    int status = -1;
+    return waitpid(pid, &status, 0) == pid && WIFEXITED(status) && 0 == WEXITSTATUS(status);
+}
+
+/**
+ * Wait until the processes wait for the lock
+ * @param lock the lock
+ * @param count the count of the waiting processes
+ * @return the processes are waiting
+ */
+template <typename Lock>
+static bool wait_waiters(const Lock& lock, const int32_t count)
+{
+    const boost::posix_time::ptime abs_time = time_after(5000);
+    while (lock.waiters() < count)
+    {
+        if (boost::get_system_time() >= abs_time)
+        {
+            return false;
+        }
+        sched_yield();
+    }
+    return true;
+}
+
+typedef boost::mpl::list<futex_lock, read_futex_lock, ticket_futex_lock> lock_types;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simple_test, Lock, lock_types)
+{
+    Lock lock;
+    BOOST_REQUIRE(lock.try_lock());
+    BOOST_REQUIRE(!lock.try_lock());
+    BOOST_REQUIRE(!lock.try_lock_sharable());
+    BOOST_REQUIRE(!lock.timed_lock(time_after(10)));
+    BOOST_REQUIRE(!lock.timed_lock_sharable(time_after(10)));
+    lock.unlock();
+    BOOST_REQUIRE(lock.timed_lock_sharable(time_after(10)));
+    BOOST_REQUIRE(lock.try_lock_sharable());
+    BOOST_REQUIRE(!lock.try_lock());
+    BOOST_REQUIRE(!lock.timed_lock(time_after(10)));
+    BOOST_REQUIRE(lock.try_lock_sharable());
+    lock.unlock_sharable();
+    lock.unlock_sharable();
+    lock.unlock_sharable();
+    BOOST_REQUIRE(lock.timed_lock(time_after(10)));
+    lock.unlock();
+    lock.lock_sharable();
+    lock.unlock_sharable();
+    lock.lock();
+    lock.unlock();
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(wakeup_test, Lock, lock_types)
+{
+    shared_data<Lock> *data = create_shared_data<Lock>();
+    data->lock.lock();
+    const pid_t pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (0 == pid)
+    {
+        if (!data->lock.timed_lock_sharable(time_after(5000)))
+        {
+            _exit(1);
+        }
+        const bool result = 1 == data->counter;
+        data->lock.unlock_sharable();
+        _exit(result ? 0 : 1);
+    }
+    usleep(50000);
+    data->counter = 1;
+    data->lock.unlock();
+    BOOST_REQUIRE(wait_process(pid));
+    BOOST_REQUIRE(data->lock.try_lock());
+    data->lock.unlock();
+    destroy_shared_data(data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(policy_test, Lock, lock_types)
+{
+    shared_data<Lock> *data = create_shared_data<Lock>();
+    data->lock.lock_sharable();
+    const pid_t pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (0 == pid)
+    {
+        const bool result = data->lock.timed_lock(time_after(5000));
+        data->counter = 1;
+        data->lock.unlock();
+        _exit(result ? 0 : 1);
+    }
+    // the writer is waiting, only the lock that prefers readers lets the new reader in
+    BOOST_REQUIRE(wait_waiters(data->lock, 1));
+    const bool reader = data->lock.try_lock_sharable();
+    BOOST_REQUIRE_EQUAL(reader, (boost::is_same<Lock, read_futex_lock>::value));
+    if (reader)
+    {
+        data->lock.unlock_sharable();
+    }
+    data->lock.unlock_sharable();
+    BOOST_REQUIRE(wait_process(pid));
+    BOOST_REQUIRE_EQUAL(data->counter, size_t(1));
+    BOOST_REQUIRE(data->lock.try_lock_sharable());
+    data->lock.unlock_sharable();
+    destroy_shared_data(data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(process_test, Lock, lock_types)
+{
+    static const size_t proc_count = 8;
+    static const size_t itr_count = 1000;
+    shared_data<Lock> *data = create_shared_data<Lock>();
+    pid_t pids[proc_count];
+    for (size_t i = 0; i < proc_count; ++i)
+    {
+        pids[i] = fork();
+        BOOST_REQUIRE(pids[i] >= 0);
+        if (0 == pids[i])
+        {
+            bool result = true;
+            for (size_t j = 0; j < itr_count; ++j)
+            {
+                if (j % 2 != 0)
+                {
+                    result = result && data->lock.timed_lock(time_after(5000));
+                    const size_t counter = data->counter;
+                    sched_yield();
+                    data->counter = counter + 1;
+                    data->lock.unlock();
+                }
+                else
+                {
+                    result = result && data->lock.timed_lock_sharable(time_after(5000));
+                    const size_t counter = data->counter;
+                    sched_yield();
+                    result = result && counter == data->counter;
+                    data->lock.unlock_sharable();
+                }
+            }
+            _exit(result ? 0 : 1);
+        }
+    }
+    for (size_t i = 0; i < proc_count; ++i)
+    {
+        BOOST_REQUIRE(wait_process(pids[i]));
+    }
+    BOOST_REQUIRE_EQUAL(data->counter, proc_count * itr_count / 2);
+    destroy_shared_data(data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(abandon_test, Lock, lock_types)
+{
+    Lock lock;
+    lock.lock();
+    // the timed out processes abandon more tickets than the slots of the tickets
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        BOOST_REQUIRE(!lock.timed_lock(time_after(0)));
+        BOOST_REQUIRE(!lock.timed_lock_sharable(time_after(0)));
+    }
+    lock.unlock();
+    BOOST_REQUIRE(lock.try_lock());
+    lock.unlock();
+    BOOST_REQUIRE(lock.try_lock_sharable());
+    lock.unlock_sharable();
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(dead_test, Lock, lock_types)
+{
+    shared_data<Lock> *data = create_shared_data<Lock>();
+    data->lock.lock();
+    const pid_t pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (0 == pid)
+    {
+        data->lock.lock();
+        _exit(1);
+    }
+    // the process is killed while it waits for the lock
+    BOOST_REQUIRE(wait_waiters(data->lock, 1));
+    kill(pid, SIGKILL);
+    BOOST_REQUIRE(!wait_process(pid));
+    data->lock.unlock();
+    BOOST_REQUIRE(data->lock.timed_lock(time_after(5000)));
+    data->lock.unlock();
+    BOOST_REQUIRE(data->lock.timed_lock_sharable(time_after(5000)));
+    data->lock.unlock_sharable();
+    destroy_shared_data(data);
+}
@@ -4,19 +4,21 @@
 
 #include <map>
 #include "ouroboros/hashmap.h"
+#include "ouroboros/probemap.h"
 
 using namespace ouroboros;
 
-typedef hash_map<size_t, size_t, 8> test_map_type;
 typedef std::map<size_t, size_t> sample_map_type;
 
 const size_t count = 100;
-void require_equal_map(sample_map_type& sample_map, test_map_type& test_map)
+template <typename Map>
+void require_equal_map(sample_map_type& sample_map, Map& test_map)
 {
+    typedef Map test_map_type;
     for (size_t i = 0; i < count; ++i)
     {
         sample_map_type::iterator sample_it = sample_map.find(i);
-        test_map_type::iterator test_it = test_map.find(i);
+        typename test_map_type::iterator test_it = test_map.find(i);
         BOOST_REQUIRE_EQUAL(sample_it != sample_map.end(), test_it != test_map.end());
         if (sample_it != sample_map.end())
         {
@@ -26,8 +28,10 @@ void require_equal_map(sample_map_type& sample_map, test_map_type& test_map)
     }
 }
 
-BOOST_AUTO_TEST_CASE(stg_simple_test)
+template <typename Map>
+void check_map()
 {
+    typedef Map test_map_type;
     test_map_type test_map;
     sample_map_type sample_map;
 
@@ -75,7 +79,7 @@ BOOST_AUTO_TEST_CASE(stg_simple_test)
     for (size_t i = 0; i < 10 * count; ++i)
     {
         int32_t val = std::rand() % count;
-        test_map_type::iterator stg_it = test_map.find(val);
+        typename test_map_type::iterator stg_it = test_map.find(val);
         sample_map_type::iterator std_it = sample_map.find(val);
         BOOST_REQUIRE_EQUAL(stg_it != test_map.end(), std_it != sample_map.end());
         if (stg_it != test_map.end() || std_it != sample_map.end())
@@ -95,7 +99,7 @@ BOOST_AUTO_TEST_CASE(stg_simple_test)
     for (size_t i = 0; i < count; ++i)
     {
         int32_t val = i;
-        test_map_type::iterator stg_it = test_map.find(val);
+        typename test_map_type::iterator stg_it = test_map.find(val);
         sample_map_type::iterator std_it = sample_map.find(val);
         BOOST_REQUIRE_EQUAL(stg_it != test_map.end(), std_it != sample_map.end());
         if (stg_it != test_map.end() || std_it != sample_map.end())
@@ -106,3 +110,39 @@ BOOST_AUTO_TEST_CASE(stg_simple_test)
         require_equal_map(sample_map, test_map);
     }
 }
+
+BOOST_AUTO_TEST_CASE(stg_simple_test)
+{
+    check_map<hash_map<size_t, size_t, 8> >();
+}
+
+BOOST_AUTO_TEST_CASE(probe_simple_test)
+{
+    check_map<probe_map<size_t, size_t, count> >();
+}
+
+BOOST_AUTO_TEST_CASE(probe_collision_test)
+{
+    // all keys have the same home slot
+    typedef probe_map<size_t, size_t, 8> test_map_type;
+    test_map_type test_map;
+    sample_map_type sample_map;
+    const size_t step = test_map_type::SLOT_COUNT;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        test_map.insert(std::make_pair(i * step, i));
+        sample_map.insert(std::make_pair(i * step, i));
+    }
+    BOOST_REQUIRE_THROW(test_map.insert(std::make_pair(8 * step, 8)), bug_error);
+    for (size_t i = 0; i < 8; i += 3)
+    {
+        test_map.erase(i * step);
+        sample_map.erase(i * step);
+        for (size_t j = 0; j < 8; ++j)
+        {
+            BOOST_REQUIRE_EQUAL(test_map.find(j * step) != test_map.end(),
+                sample_map.find(j * step) != sample_map.end());
+        }
+    }
+    BOOST_REQUIRE_EQUAL(test_map.size(), sample_map.size());
+}
@@ -18,4 +18,39 @@ typedef data_source<interface_table, record_type, local_interface> datasource_ty
 typedef indexed_table<interface_table, record_type, index1, skey_type, local_interface> datatable_type;
 
 #include "datatable_test.h"
-//@todo need to add specific test for IndexTable
\ No newline at end of file
+//@todo need to add specific test for IndexTable
+
+//==============================================================================
+//  Check for the aggregation of the fields of the records by the index
+//==============================================================================
+BOOST_AUTO_TEST_CASE(aggregate_test)
+{
+    datasource_type::remove(DATASOURCE_NAME);
+    const size_t tbl_count = 4;
+    const size_t rec_count = 100;
+    datasource_type source(DATASOURCE_NAME, tbl_count, rec_count, options);
+    file_region_type file_region(tbl_count, source.table_size());
+    source.set_file_region(file_region);
+    skey_type skey(1, 1, 0, 0, 0, 0);
+    datatable_type table(source, skey);
+    table.clear();
+    record_list records_wr;
+    fill_records(records_wr, rec_count, 0);
+    table.add(records_wr);
+
+    const aggregate_result<float> result1 = table.aggregate_by_index<index2>(10, 19);
+    BOOST_REQUIRE_EQUAL(result1.count, 10);
+    BOOST_REQUIRE_CLOSE(result1.sum, 155.0, 0.001);
+    BOOST_REQUIRE_CLOSE(result1.min, 11.0, 0.001);
+    BOOST_REQUIRE_CLOSE(result1.last, 20.0, 0.001);
+    const aggregate_result<int32_t> result2 = table.aggregate<index1>(table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result2.sum, 4950);
+    const aggregate_result<int32_t> result3 = table.aggregate_by_index<index1>(
+        comp_greater<record_type, index2>(15), 10, 19);
+    BOOST_REQUIRE_EQUAL(result3.count, 5);
+    BOOST_REQUIRE_EQUAL(result3.sum, 85);
+    const aggregate_result<int32_t> result4 = table.aggregate_by_index<index1>(comp_even<record_type>(), 10, 19);
+    BOOST_REQUIRE_EQUAL(result4.count, 5);
+    BOOST_REQUIRE_EQUAL(result4.sum, 70);
+    BOOST_REQUIRE_EQUAL(table.aggregate_by_index<index1>(200, 300).count, 0);
+}
\ No newline at end of file
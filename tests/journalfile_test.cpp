@@ -80,4 +80,211 @@ BOOST_AUTO_TEST_CASE(recovery_test)
 
         BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
     }
-}
\ No newline at end of file
+}
+//==============================================================================
+//  Check the manifest keeps only the pages of the last transactions and
+//  the recovery scans the whole file without the manifest
+//==============================================================================
+BOOST_AUTO_TEST_CASE(manifest_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t page_size = file_page_type::DATA_SIZE;
+    const size_t page_count = file_type::CACHE_PAGE_COUNT * 2;
+    char outbuf[page_size * page_count];
+    memset(outbuf, 1, sizeof(outbuf));
+    file_region_type file_region(0, sizeof(outbuf));
+    {
+        file_type file(TEST_FILE_NAME, file_region);
+        file.resize(sizeof(outbuf));
+        for (size_t i = 0; i < 10; ++i)
+        {
+            file.start();
+            file.write(outbuf, sizeof(outbuf), 0);
+            file.stop();
+        }
+        // the indexes of the finished transactions are removed by the next one
+        ouroboros::file<> manifest(TEST_FILE_NAME ".jnl");
+        BOOST_CHECK_EQUAL(manifest.size(), sizeof(journal_manifest_header) + page_count * sizeof(pos_type));
+    }
+    {
+        file_type file(TEST_FILE_NAME, file_region);
+        BOOST_CHECK(file.init());
+    }
+
+    for (int scan = 0; scan < 2; ++scan)
+    {
+        {
+            file_type file(TEST_FILE_NAME, file_region);
+            char stubbuf[sizeof(outbuf)];
+            memset(stubbuf, 2, sizeof(stubbuf));
+            file.start();
+            file.write(stubbuf, sizeof(stubbuf), 0);
+            // WITHOUT STOP
+        }
+        if (scan)
+        {
+            base_file::remove(TEST_FILE_NAME ".jnl");
+        }
+        file_type file(TEST_FILE_NAME, file_region);
+        BOOST_CHECK(!file.init());
+        char inbuf[sizeof(outbuf)];
+        file.read(inbuf, sizeof(inbuf), 0);
+        BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+        ouroboros::file<> manifest(TEST_FILE_NAME ".jnl");
+        BOOST_CHECK_EQUAL(manifest.size(), sizeof(journal_manifest_header));
+    }
+}
+
+//==============================================================================
+//  Check the full scan restores and commits the transactions across the blocks
+//==============================================================================
+BOOST_AUTO_TEST_CASE(block_recovery_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    typedef file_type::status_file_page_type status_file_page_type;
+    const size_t page_size = file_type::CACHE_PAGE_SIZE;
+    const size_t page_total = 2 * OUROBOROS_RECOVERY_BLOCK / page_size + 100;
+    const size_t block_end = OUROBOROS_RECOVERY_BLOCK / page_size;
+    // the pages of the transaction that is restored, they cross the block
+    const pos_type restored[] = { block_end - 3, block_end - 2, block_end - 1, block_end, block_end + 1,
+        page_total - 50 };
+    // the pages of the transaction that is committed, the first page is fixed
+    const pos_type committed[] = { 3, 4, 5, page_total - 1 };
+
+    std::vector<char> data(page_size * page_total, 1);
+    std::vector<char> backup(data.size(), 2);
+    for (size_t index = 0; index < page_total; ++index)
+    {
+        status_file_page_type(&data[index * page_size]).set_status(journal_status_type());
+        status_file_page_type(&backup[index * page_size]).set_status(journal_status_type());
+    }
+    std::vector<char> expected(data);
+    for (size_t i = 0; i < ARRAY_SIZE(restored); ++i)
+    {
+        const pos_type index = restored[i];
+        memcpy(&expected[index * page_size], &backup[index * page_size], page_size);
+        status_file_page_type(&data[index * page_size]).set_status(journal_status_type(100, JS_DIRTY));
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(committed); ++i)
+    {
+        status_file_page_type(&data[committed[i] * page_size]).set_status(
+            journal_status_type(200, 0 == i ? JS_FIXED : JS_DIRTY));
+    }
+    {
+        ouroboros::file<> file(TEST_FILE_NAME);
+        file.resize(data.size());
+        file.write(&data[0], data.size(), 0);
+        ouroboros::file<> backup_file(TEST_FILE_NAME ".bak");
+        backup_file.resize(backup.size());
+        backup_file.write(&backup[0], backup.size(), 0);
+    }
+    {
+        // without the manifest the whole file is scanned
+        file_type file(TEST_FILE_NAME);
+        BOOST_CHECK(!file.init());
+    }
+    {
+        ouroboros::file<> file(TEST_FILE_NAME);
+        std::vector<char> inbuf(data.size());
+        file.read(&inbuf[0], inbuf.size(), 0);
+        BOOST_CHECK(inbuf == expected);
+    }
+    file_type file(TEST_FILE_NAME);
+    BOOST_CHECK(file.init());
+}
+
+//==============================================================================
+//  Check the refreshing releases only the pages published by the log
+//==============================================================================
+BOOST_AUTO_TEST_CASE(page_log_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t page_size = file_page_type::DATA_SIZE;
+    char outbuf[page_size * 4];
+    memset(outbuf, 0, sizeof(outbuf));
+
+    file_region_type file_region(0, sizeof(outbuf));
+    file_type::page_log_type log;
+    file_type writer(TEST_FILE_NAME, file_region);
+    file_type reader(TEST_FILE_NAME, file_region);
+    // the file that changes the pages without publishing
+    file_type stranger(TEST_FILE_NAME, file_region);
+    writer.set_page_log(log);
+    reader.set_page_log(log);
+    writer.resize(sizeof(outbuf));
+    writer.start();
+    writer.write(outbuf, sizeof(outbuf), 0);
+    writer.stop();
+
+    char inbuf[sizeof(outbuf)];
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+
+    const char value = 1;
+    stranger.start();
+    stranger.write(&value, sizeof(value), page_size);
+    stranger.stop();
+    writer.start();
+    writer.write(&value, sizeof(value), 2 * page_size);
+    writer.stop();
+
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL(inbuf[page_size], 0);
+    BOOST_CHECK_EQUAL(inbuf[2 * page_size], value);
+
+    // the reader falls behind the log, so all pages are released
+    for (size_t i = 0; i <= file_type::page_log_type::LOG_SIZE; ++i)
+    {
+        writer.start();
+        writer.write(&value, sizeof(value), 3 * page_size);
+        writer.stop();
+    }
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL(inbuf[page_size], value);
+    BOOST_CHECK_EQUAL(inbuf[3 * page_size], value);
+}
+
+//==============================================================================
+//  Check the levels of the durability synchronize the files
+//==============================================================================
+BOOST_AUTO_TEST_CASE(durability_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t page_size = file_page_type::DATA_SIZE;
+    char outbuf[page_size * file_type::CACHE_PAGE_COUNT * 2];
+    file_region_type file_region(0, sizeof(outbuf));
+    file_type file(TEST_FILE_NAME, file_region);
+    BOOST_CHECK_EQUAL(file.durability(), OUROBOROS_DURABILITY);
+    file.resize(sizeof(outbuf));
+
+    const durability_level levels[] = { DURABILITY_NONE, DURABILITY_COMMIT, DURABILITY_SYNC, DURABILITY_FULL };
+    uint64_t syncs[ARRAY_SIZE(levels)] = { 0 };
+    for (size_t i = 0; i < ARRAY_SIZE(levels); ++i)
+    {
+        file.set_durability(levels[i]);
+        BOOST_CHECK_EQUAL(file.durability(), levels[i]);
+        memset(outbuf, i + 1, sizeof(outbuf));
+        const file_stats before = base_file::stats();
+        // the pages don't fit in the cache, so the copies are saved within the transaction
+        file.start();
+        file.write(outbuf, sizeof(outbuf), 0);
+        file.stop();
+        file.sync_commit();
+        syncs[i] = base_file::stats().syncs - before.syncs;
+        char inbuf[sizeof(outbuf)];
+        file.read(inbuf, sizeof(inbuf), 0);
+        BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+    }
+    BOOST_CHECK_EQUAL(syncs[0], 0);
+    BOOST_CHECK(syncs[1] > syncs[0]);
+    BOOST_CHECK(syncs[2] > syncs[1]);
+    BOOST_CHECK(syncs[3] > syncs[2]);
+    file.set_durability(OUROBOROS_DURABILITY);
+}
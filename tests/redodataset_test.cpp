@@ -0,0 +1,13 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE redodataset_test
+#include <boost/test/unit_test.hpp>
+
+#include "ouroboros/key.h"
+#include "ouroboros/datatable.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/interface.h"
+#include "test.h"
+
+typedef data_set<simple_key, record_type, index1, redo_local_interface> dataset_type;
+
+#include "dataset_test.h"
@@ -0,0 +1,179 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE redofile_test
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include "ouroboros/cache.h"
+#include "ouroboros/redofile.h"
+#include "ouroboros/journalfile.h"
+#include "ouroboros/page.h"
+
+using namespace ouroboros;
+
+#define TEST_FILE_NAME "test.dat"
+#define TEST_COPY_NAME "test.copy.dat"
+
+typedef file_page<1024, sizeof(journal_status_type)> file_page_type;
+typedef redo_file<file_page_type, 8> file_type;
+typedef file_type::file_region_type file_region_type;
+
+#define TEST_FULL_TRANSACTION
+#include "cachefile_test.h"
+
+//==============================================================================
+//  Check the data of the transaction that is not stopped doesn't get into
+//  the file when the process crashes
+//==============================================================================
+BOOST_AUTO_TEST_CASE(recovery_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t blockSize = file_page_type::DATA_SIZE;
+    char outbuf[blockSize * file_type::CACHE_PAGE_COUNT * 2];
+    for (size_t i = 0; i < sizeof(outbuf); i++)
+    {
+        outbuf[i] = i;
+    }
+
+    {
+        file_region_type file_region(0, sizeof(outbuf));
+        file_type file(TEST_FILE_NAME, file_region);
+        file.resize(sizeof(outbuf));
+
+        file.start();
+        file.write(outbuf, sizeof(outbuf), 0);
+        file.stop();
+    }
+
+    {
+        file_region_type file_region(0, sizeof(outbuf));
+        file_type file(TEST_FILE_NAME, file_region);
+        char stubbuf[sizeof(outbuf)];
+        for (size_t i = 0; i < sizeof(outbuf); i++)
+        {
+            stubbuf[i] = std::rand();
+        }
+
+        file.start();
+        for (size_t i = 0; i < sizeof(outbuf) /  blockSize; i++)
+        {
+            file.write(&stubbuf[i * blockSize], blockSize, i * blockSize);
+        }
+        // WITHOUT STOP
+    }
+
+    {
+        file_region_type file_region(0, sizeof(outbuf));
+        file_type file(TEST_FILE_NAME, file_region);
+        BOOST_CHECK(file.init());
+        char inbuf[sizeof(outbuf)];
+        file.read(inbuf, sizeof(inbuf), 0);
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+    }
+}
+
+//==============================================================================
+//  Check the stopped transactions are restored from the log when the process
+//  crashes before the checkpoint
+//==============================================================================
+BOOST_AUTO_TEST_CASE(replay_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+    file_type::remove(TEST_COPY_NAME);
+
+    const size_t blockSize = file_page_type::DATA_SIZE;
+    char outbuf[blockSize * file_type::CACHE_PAGE_COUNT / 2];
+    for (size_t i = 0; i < sizeof(outbuf); i++)
+    {
+        outbuf[i] = i;
+    }
+
+    {
+        file_region_type file_region(0, sizeof(outbuf));
+        file_type file(TEST_FILE_NAME, file_region);
+        file.resize(sizeof(outbuf));
+        for (size_t i = 0; i < sizeof(outbuf); i += 16)
+        {
+            file.start();
+            file.write(&outbuf[i], 16, i);
+            file.stop();
+        }
+        // the pages are in the cache, the changes are in the log only
+        BOOST_CHECK(file.log_size() > 0);
+        file_type::copy(TEST_FILE_NAME, TEST_COPY_NAME);
+        // the block of the transaction that is not stopped
+        const char garbage[] = "garbage";
+        base_file log(std::string(TEST_COPY_NAME) + ".wal");
+        log.write(garbage, sizeof(garbage), file.log_size());
+    }
+
+    {
+        file_region_type file_region(0, sizeof(outbuf));
+        file_type file(TEST_COPY_NAME, file_region);
+        BOOST_CHECK(!file.init());
+        BOOST_CHECK_EQUAL(file.log_size(), 0);
+        char inbuf[sizeof(outbuf)];
+        file.read(inbuf, sizeof(inbuf), 0);
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+    }
+
+    {
+        file_region_type file_region(0, sizeof(outbuf));
+        file_type file(TEST_FILE_NAME, file_region);
+        BOOST_CHECK(file.init());
+        char inbuf[sizeof(outbuf)];
+        file.read(inbuf, sizeof(inbuf), 0);
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+    }
+    file_type::remove(TEST_COPY_NAME);
+}
+
+//==============================================================================
+//  Check the log is cleared by the checkpoint and the cancel keeps
+//  the committed data that is not stored in the file
+//==============================================================================
+BOOST_AUTO_TEST_CASE(checkpoint_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    const size_t blockSize = file_page_type::DATA_SIZE;
+    char outbuf[blockSize * 4];
+    memset(outbuf, 0, sizeof(outbuf));
+
+    file_region_type file_region(0, sizeof(outbuf));
+    file_type file(TEST_FILE_NAME, file_region);
+    file.set_checkpoint_size(1024);
+    BOOST_CHECK_EQUAL(file.checkpoint_size(), 1024);
+    file.resize(sizeof(outbuf));
+    file.start();
+    file.write(outbuf, sizeof(outbuf), 0);
+    file.stop();
+    // the size of the log exceeded the limit
+    BOOST_CHECK_EQUAL(file.log_size(), 0);
+
+    const char value = 1;
+    file.start();
+    file.write(&value, sizeof(value), blockSize);
+    file.stop();
+    BOOST_CHECK(file.log_size() > 0);
+    outbuf[blockSize] = value;
+
+    const char stub = 2;
+    file.start();
+    file.write(&stub, sizeof(stub), blockSize + 1);
+    file.write(&stub, sizeof(stub), 2 * blockSize);
+    file.cancel();
+
+    char inbuf[sizeof(outbuf)];
+    file.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+
+    file.checkpoint();
+    BOOST_CHECK_EQUAL(file.log_size(), 0);
+    file.reset();
+    file.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+}
@@ -0,0 +1,110 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE scan_test
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#include "ouroboros/scan.h"
+
+using namespace ouroboros;
+
+/**
+ * Find the first record by memcmp
+ * @param data the records
+ * @param count the count of the records
+ * @param stride the distance between the records
+ * @param field the field of the record
+ * @return the index of the found record or NIL
+ */
+pos_type simple_find(const std::vector<char>& data, const count_type count, const size_type stride,
+    const scan_field& field)
+{
+    for (count_type i = 0; i < count; ++i)
+    {
+        if (memcmp(&data[i * stride + field.offset], field.value, field.size) == 0)
+        {
+            return i;
+        }
+    }
+    return NIL;
+}
+
+/**
+ * Find the last record by memcmp
+ * @param data the records
+ * @param count the count of the records
+ * @param stride the distance between the records
+ * @param field the field of the record
+ * @return the index of the found record or NIL
+ */
+pos_type simple_rfind(const std::vector<char>& data, const count_type count, const size_type stride,
+    const scan_field& field)
+{
+    for (count_type i = count; i > 0; --i)
+    {
+        if (memcmp(&data[(i - 1) * stride + field.offset], field.value, field.size) == 0)
+        {
+            return i - 1;
+        }
+    }
+    return NIL;
+}
+
+BOOST_AUTO_TEST_CASE(isa_test)
+{
+    const scan_isa isa = scanner::isa();
+    BOOST_REQUIRE_EQUAL(scanner::set_isa(SCAN_SCALAR), SCAN_SCALAR);
+    BOOST_REQUIRE_EQUAL(scanner::isa(), SCAN_SCALAR);
+    BOOST_REQUIRE(scanner::set_isa(SCAN_AVX2) <= SCAN_AVX2);
+    BOOST_REQUIRE_EQUAL(scanner::set_isa(isa), isa);
+    BOOST_TEST_MESSAGE("the instruction set of the scanning: " << scanner::isa_name(isa));
+}
+
+BOOST_AUTO_TEST_CASE(find_test)
+{
+    const scan_isa isa = scanner::isa();
+    const count_type count = 100;
+    const size_type strides[] = { 1, 3, 4, 8, 13, 16, 24, 40, 100 };
+    const size_type sizes[] = { 1, 2, 4, 7, 8, 16, 17, 33 };
+    for (size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s)
+    {
+        const size_type stride = strides[s];
+        // the records that differ only by the last byte of the field
+        std::vector<char> data(count * stride + SCAN_PADDING, 1);
+        for (size_t z = 0; z < sizeof(sizes) / sizeof(sizes[0]) && sizes[z] <= stride; ++z)
+        {
+            const size_type size = sizes[z];
+            for (size_type offset = 0; offset + size <= stride; offset += std::max(size_type(1), stride / 4))
+            {
+                std::vector<char> value(size, 1);
+                value[size - 1] = 2;
+                const scan_field field(&value[0], offset, size);
+                for (count_type n = 0; n <= count; n += 11)
+                {
+                    std::fill(data.begin(), data.end(), 1);
+                    // the matched records are n, n + 1 and count - 1 - n
+                    const count_type matched[] = { n, n + 1, count - 1 - n };
+                    for (size_t m = 0; m < sizeof(matched) / sizeof(matched[0]); ++m)
+                    {
+                        if (matched[m] < count)
+                        {
+                            data[matched[m] * stride + offset + size - 1] = 2;
+                        }
+                    }
+                    for (int i = SCAN_SCALAR; i <= SCAN_AVX2; ++i)
+                    {
+                        scanner::set_isa(scan_isa(i));
+                        const scanner scan(field, stride);
+                        for (count_type c = 0; c <= count; c += 7)
+                        {
+                            BOOST_REQUIRE_EQUAL(scan.find(&data[0], c), simple_find(data, c, stride, field));
+                            BOOST_REQUIRE_EQUAL(scan.rfind(&data[0], c), simple_rfind(data, c, stride, field));
+                        }
+                        BOOST_REQUIRE_EQUAL(scan.find(&data[0], count), simple_find(data, count, stride, field));
+                        BOOST_REQUIRE_EQUAL(scan.rfind(&data[0], count), simple_rfind(data, count, stride, field));
+                    }
+                }
+            }
+        }
+    }
+    scanner::set_isa(isa);
+}
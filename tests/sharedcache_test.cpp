@@ -0,0 +1,233 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE sharedcache_test
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <stdio.h>
+#include "ouroboros/sharedcache.h"
+#include "ouroboros/cachefile.h"
+#include "ouroboros/journalfile.h"
+#include "ouroboros/page.h"
+
+using namespace ouroboros;
+
+#define TEST_FILE_NAME "test.dat"
+
+typedef file_page<1024> file_page_type;
+typedef cache_file<file_page_type, 8, file_lock<file_page_type>, shared_cache> file_type;
+typedef file_type::file_region_type file_region_type;
+
+#include "cachefile_test.h"
+
+#define TEST_PAGE_COUNT 4
+
+/**
+ * Fill the buffer
+ * @param buffer the buffer
+ * @param size the size of the buffer
+ * @param value the first value
+ */
+static void fill_buffer(char *buffer, const size_t size, const char value)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        buffer[i] = value + i;
+    }
+}
+
+/**
+ * Write data directly to the file bypassing all caches
+ * @param buffer the buffer of data
+ * @param size the size of data
+ */
+static void write_directly(const char *buffer, const size_t size)
+{
+    FILE *file = fopen(TEST_FILE_NAME, "r+b");
+    BOOST_REQUIRE(file != NULL);
+    BOOST_REQUIRE_EQUAL(fwrite(buffer, 1, size, file), size);
+    fclose(file);
+}
+
+//==============================================================================
+//  Check the pages saved by the transaction are taken from the shared memory
+//==============================================================================
+BOOST_AUTO_TEST_CASE(shared_commit_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    char outbuf[file_page_type::DATA_SIZE * TEST_PAGE_COUNT];
+    fill_buffer(outbuf, sizeof(outbuf), 0);
+    char stubbuf[sizeof(outbuf)];
+    fill_buffer(stubbuf, sizeof(stubbuf), 1);
+
+    file_type writer(TEST_FILE_NAME);
+    writer.resize(sizeof(outbuf));
+    writer.start();
+    writer.write(outbuf, sizeof(outbuf), 0);
+    writer.stop();
+
+    // the file is changed but the pages are in the shared memory
+    write_directly(stubbuf, sizeof(stubbuf));
+
+    file_type reader(TEST_FILE_NAME);
+    char inbuf[sizeof(outbuf)];
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+}
+
+//==============================================================================
+//  Check the pages loaded from the file are taken from the shared memory
+//==============================================================================
+BOOST_AUTO_TEST_CASE(shared_load_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    char outbuf[file_page_type::DATA_SIZE * TEST_PAGE_COUNT];
+    fill_buffer(outbuf, sizeof(outbuf), 0);
+    char stubbuf[sizeof(outbuf)];
+    fill_buffer(stubbuf, sizeof(stubbuf), 1);
+
+    file_type loader(TEST_FILE_NAME);
+    loader.resize(sizeof(outbuf));
+    write_directly(outbuf, sizeof(outbuf));
+
+    char inbuf[sizeof(outbuf)];
+    loader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+
+    // the file is changed but the pages are in the shared memory
+    write_directly(stubbuf, sizeof(stubbuf));
+
+    file_type reader(TEST_FILE_NAME);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+}
+
+//==============================================================================
+//  Check the pages that are changed by the transaction aren't shared until
+//  the transaction is stopped, and they are shared after the refreshing
+//==============================================================================
+BOOST_AUTO_TEST_CASE(shared_transaction_test)
+{
+    file_type::remove(TEST_FILE_NAME);
+
+    char outbuf[file_page_type::DATA_SIZE * TEST_PAGE_COUNT];
+    fill_buffer(outbuf, sizeof(outbuf), 0);
+    char stubbuf[sizeof(outbuf)];
+    fill_buffer(stubbuf, sizeof(stubbuf), 1);
+
+    file_type writer(TEST_FILE_NAME);
+    writer.resize(sizeof(outbuf));
+    writer.start();
+    writer.write(outbuf, sizeof(outbuf), 0);
+    writer.stop();
+
+    file_type reader(TEST_FILE_NAME);
+    char inbuf[sizeof(outbuf)];
+
+    writer.start();
+    writer.write(stubbuf, sizeof(stubbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+    writer.cancel();
+
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+
+    writer.start();
+    writer.write(stubbuf, sizeof(stubbuf), 0);
+    writer.stop();
+
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(stubbuf, ARRAY_END(stubbuf), inbuf, ARRAY_END(inbuf));
+}
+
+//==============================================================================
+//  Check the pages saved by the journal transaction are taken from the shared
+//  memory
+//==============================================================================
+BOOST_AUTO_TEST_CASE(shared_journal_test)
+{
+    typedef file_page<1024, sizeof(journal_status_type)> journal_page_type;
+    typedef journal_file<journal_page_type, 8, file_lock<journal_page_type>, shared_cache> journal_type;
+    journal_type::remove(TEST_FILE_NAME);
+
+    char outbuf[journal_page_type::DATA_SIZE * TEST_PAGE_COUNT];
+    fill_buffer(outbuf, sizeof(outbuf), 0);
+    char stubbuf[sizeof(outbuf)];
+    fill_buffer(stubbuf, sizeof(stubbuf), 1);
+
+    journal_type writer(TEST_FILE_NAME);
+    writer.resize(journal_page_type::TOTAL_SIZE * TEST_PAGE_COUNT);
+    writer.start();
+    writer.write(outbuf, sizeof(outbuf), 0);
+    writer.stop();
+
+    journal_type reader(TEST_FILE_NAME);
+    char inbuf[sizeof(outbuf)];
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+
+    writer.start();
+    writer.write(stubbuf, sizeof(stubbuf), 0);
+    writer.cancel();
+
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+
+    writer.start();
+    writer.write(stubbuf, sizeof(stubbuf), 0);
+    writer.stop();
+
+    reader.refresh(sizeof(inbuf), 0);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(stubbuf, ARRAY_END(stubbuf), inbuf, ARRAY_END(inbuf));
+}
+
+//==============================================================================
+//  Check the initialization of the journal file clears the pool, the slots
+//  that are left busy are released and the pages that are changed before
+//  the clearing don't break the slots
+//==============================================================================
+BOOST_AUTO_TEST_CASE(shared_reset_test)
+{
+    typedef file_page<1024, sizeof(journal_status_type)> journal_page_type;
+    typedef journal_file<journal_page_type, 8, file_lock<journal_page_type>, shared_cache> journal_type;
+    journal_type::remove(TEST_FILE_NAME);
+
+    char outbuf[journal_page_type::DATA_SIZE * TEST_PAGE_COUNT];
+    fill_buffer(outbuf, sizeof(outbuf), 0);
+    char stubbuf[sizeof(outbuf)];
+    fill_buffer(stubbuf, sizeof(stubbuf), 1);
+    char inbuf[sizeof(outbuf)];
+
+    journal_type writer(TEST_FILE_NAME);
+    writer.resize(journal_page_type::TOTAL_SIZE * TEST_PAGE_COUNT);
+    writer.start();
+    writer.write(outbuf, sizeof(outbuf), 0);
+    writer.stop();
+
+    // the pages are being changed, as if the process is crashed
+    writer.start();
+    writer.write(stubbuf, sizeof(stubbuf), 0);
+    {
+        journal_type recoverer(TEST_FILE_NAME);
+        recoverer.init();
+    }
+
+    writer.cancel();
+
+    // the pages loaded from the file are shared, the cancel doesn't release
+    // the slots that are cleared
+    journal_type loader(TEST_FILE_NAME);
+    loader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+    write_directly(stubbuf, sizeof(stubbuf));
+
+    journal_type reader(TEST_FILE_NAME);
+    reader.read(inbuf, sizeof(inbuf), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(outbuf, ARRAY_END(outbuf), inbuf, ARRAY_END(inbuf));
+}
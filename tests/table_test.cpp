@@ -88,3 +88,64 @@ BOOST_AUTO_TEST_CASE(test1)
     file_type::remove(filename.c_str());
     BOOST_REQUIRE(!boost::filesystem::exists(filename));
 }
+
+BOOST_AUTO_TEST_CASE(find_test)
+{
+    typedef simple_key skey_type;
+    typedef source<file<> > source_type;
+    typedef typename source_type::file_type file_type;
+    typedef table<source_type, skey_type> table_type;
+
+    const size_type rec_size = 12;
+    const count_type rec_count = 10000;
+    const size_type size = rec_size * rec_count;
+    const std::string filename = "test.dat";
+    const scan_isa isa = scanner::isa();
+
+    file_type::remove(filename.c_str());
+    {
+        file_type file(filename.c_str());
+        BOOST_REQUIRE_EQUAL(size, file.resize(size));
+        source_type source(file, 1, rec_count, rec_size);
+        skey_type key;
+        table_type table(source, key);
+        // the ring of the records is wrapped, the keys of the records are
+        // [rec_count / 2, 3 * rec_count / 2) and the values are key % 10
+        for (uint32_t j = 0; j < 3 * rec_count / 2; ++j)
+        {
+            uint32_t rec[rec_size / sizeof(uint32_t)] = { j, j % 10, 0 };
+            table.add(rec);
+        }
+        BOOST_REQUIRE_EQUAL(table.beg_pos(), rec_count / 2);
+        for (int i = SCAN_SCALAR; i <= SCAN_AVX2; ++i)
+        {
+            scanner::set_isa(scan_isa(i));
+            for (uint32_t j = rec_count / 2; j < 3 * rec_count / 2; j += 997)
+            {
+                const pos_type pos = j % rec_count;
+                uint32_t rec[rec_size / sizeof(uint32_t)] = { j, j % 10, 0 };
+                BOOST_REQUIRE_EQUAL(table.find(rec, table.beg_pos(), table.count()), pos);
+                BOOST_REQUIRE_EQUAL(table.rfind(rec, table.end_pos(), table.count()), pos);
+                BOOST_REQUIRE_EQUAL(table.find(scan_field(&j, 0, sizeof(j)), table.beg_pos(), table.count()), pos);
+                BOOST_REQUIRE_EQUAL(table.rfind(scan_field(&j, 0, sizeof(j)), table.end_pos(), table.count()), pos);
+                // the first and the last records of the range are found
+                BOOST_REQUIRE_EQUAL(table.find(rec, pos, 1), pos);
+                BOOST_REQUIRE_EQUAL(table.rfind(rec, table.inc_pos(pos, 1), 1), pos);
+                BOOST_REQUIRE_EQUAL(table.find(rec, table.inc_pos(pos, 1), rec_count - 1), NIL);
+                BOOST_REQUIRE_EQUAL(table.rfind(rec, pos, rec_count - 1), NIL);
+            }
+            // the records are found by the field at the offset
+            const uint32_t value = 3;
+            const scan_field field(&value, sizeof(uint32_t), sizeof(value));
+            BOOST_REQUIRE_EQUAL(table.find(field, table.beg_pos(), table.count()), 5003);
+            BOOST_REQUIRE_EQUAL(table.rfind(field, table.end_pos(), table.count()), 4993);
+            BOOST_REQUIRE_EQUAL(table.find(field, 0, rec_count / 2), 3);
+            BOOST_REQUIRE_EQUAL(table.rfind(field, 0, rec_count / 2), 9993);
+            const uint32_t missed = 10;
+            BOOST_REQUIRE_EQUAL(table.find(scan_field(&missed, sizeof(uint32_t), sizeof(missed)),
+                table.beg_pos(), table.count()), NIL);
+        }
+        scanner::set_isa(isa);
+    }
+    file_type::remove(filename.c_str());
+}
@@ -24,5 +24,42 @@ static void fill_records(TRecords& records, const size_t count, const size_t val
     }
 }
 
+/**
+ * The comparator that has only the unpacked form: the first field is even
+ */
+template <typename Record>
+struct comp_even
+{
+    typedef Record record_type;
+    inline bool operator ()(const record_type& record) const
+    {
+        return 0 == record.field1() % 2;
+    }
+};
+
+/**
+ * The reader of all records of a table
+ */
+template <typename TRecords>
+struct records_reader
+{
+    explicit records_reader(TRecords& records) :
+        records(records),
+        calls(0)
+    {}
+    template <typename Table>
+    void operator()(Table& table)
+    {
+        ++calls;
+        records.resize(table.count());
+        if (!records.empty())
+        {
+            table.read_front(records);
+        }
+    }
+    TRecords& records;
+    size_t calls;
+};
+
 #endif	/* OUROBOROS_TEST_H */
 
@@ -28,6 +28,16 @@ struct test_interface : public base_interface<test_table_interface, indexed_tabl
 typedef test_interface interface_type;
 typedef data_set<simple_key, record_type, index_null, interface_type> dataset_type;
 
+// the names of the lockers are made of the offsets of the tables in the file
+#define KEY_LOCKER_NAME "ouroboros.dat.784.locker"
+#ifdef OUROBOROS_64BIT_OFFSETS
+#define TABLE0_LOCKER_NAME "ouroboros.dat.824.locker"
+#define TABLE1_LOCKER_NAME "ouroboros.dat.8064.locker"
+#else
+#define TABLE0_LOCKER_NAME "ouroboros.dat.812.locker"
+#define TABLE1_LOCKER_NAME "ouroboros.dat.8040.locker"
+#endif
+
 #include "transaction_test.h"
 
 template <typename Transaction>
@@ -105,7 +115,7 @@ BOOST_AUTO_TEST_CASE(session_blocked_test)
         BOOST_CHECK_EQUAL(db().state(), TR_STOPPED);
     }
     // lock the table 0
-    mutex_lock locker0("ouroboros.dat.812.locker");
+    mutex_lock locker0(TABLE0_LOCKER_NAME);
     locker0.lock();
     // check that only the table 0 is locked
     for (size_t index = 0; index < tbl_count; ++index)
@@ -133,7 +143,7 @@ BOOST_AUTO_TEST_CASE(session_blocked_test)
         BOOST_CHECK_EQUAL(db().state(), TR_STOPPED);
     }
     // lock the table 1
-    mutex_lock locker1("ouroboros.dat.8040.locker");
+    mutex_lock locker1(TABLE1_LOCKER_NAME);
     locker1.lock();
     // check that only the table 1 is locked
     for (size_t index = 0; index < tbl_count; ++index)
@@ -209,7 +219,7 @@ BOOST_AUTO_TEST_CASE(session_blocked_test)
         BOOST_CHECK_EQUAL(db().state(), TR_STOPPED);
     }
     // lock the key table
-    mutex_lock klocker("ouroboros.dat.784.locker");
+    mutex_lock klocker(KEY_LOCKER_NAME);
     klocker.lock();
     try
     {
@@ -308,3 +318,72 @@ BOOST_AUTO_TEST_CASE(session_blocked_test)
     BOOST_CHECK_EQUAL(base_global_locker::sharable_count(), 0);
     BOOST_CHECK_EQUAL(base_global_locker::scoped_count(), 0);
 }
+
+/**
+ * The reader of all records of a table that tries to write the table at
+ * the first reading
+ */
+struct conflict_reader : public records_reader<record_list>
+{
+    conflict_reader(record_list& records, mutex_lock& locker) :
+        records_reader<record_list>(records),
+        locker(locker),
+        locked(false)
+    {}
+    template <typename Table>
+    void operator()(Table& table)
+    {
+        records_reader<record_list>::operator()(table);
+        if (1 == calls)
+        {
+            // the exclusive lock can be set only if the reader doesn't hold the shared lock
+            locked = locker.lock(10);
+            if (locked)
+            {
+                locker.unlock();
+            }
+        }
+    }
+    mutex_lock& locker;
+    bool locked;
+};
+
+//==============================================================================
+//  Check the optimistic reading of a table
+//==============================================================================
+BOOST_AUTO_TEST_CASE(read_optimistic_test)
+{
+    record_list records_wr;
+    fill_records(records_wr, rec_count / 2, rec_count);
+    db().session_wr(0)->add(records_wr);
+    record_list records;
+    {
+        dataset_type::session_read session = db().session_rd(0);
+        records.resize(session->count());
+        session->read_front(records);
+    }
+    mutex_lock locker0(TABLE0_LOCKER_NAME);
+    // the writing of the table is detected by the sequence
+    revision_type seq = 0;
+    BOOST_REQUIRE(locker0.read_begin(seq));
+    BOOST_CHECK(locker0.read_validate(seq));
+    locker0.lock();
+    revision_type seq_wr = 0;
+    BOOST_CHECK(!locker0.read_begin(seq_wr));
+    BOOST_CHECK(!locker0.read_validate(seq));
+    locker0.unlock();
+    BOOST_REQUIRE(locker0.read_begin(seq_wr));
+    BOOST_CHECK_EQUAL(seq_wr, seq + 2);
+    // the table is read without the lock and the reading is repeated after the writing
+    record_list records_rd;
+    conflict_reader reader(records_rd, locker0);
+    BOOST_REQUIRE(db().read_optimistic(0, reader));
+    BOOST_CHECK(reader.locked);
+    BOOST_CHECK_EQUAL(reader.calls, size_t(2));
+    BOOST_CHECK_EQUAL_COLLECTIONS(records.begin(), records.end(),
+        records_rd.begin(), records_rd.end());
+    typename dataset_type::table_type& table = static_cast<dataset_type::table_type&>(db().session_rd(0).table());
+    BOOST_CHECK_EQUAL(table.sharable_count(), 0);
+    BOOST_CHECK_EQUAL(table.scoped_count(), 0);
+    BOOST_CHECK_EQUAL(base_global_locker::sharable_count(), 0);
+}
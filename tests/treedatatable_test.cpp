@@ -20,4 +20,49 @@ typedef data_source<interface_table, indexed_record_type, test_interface> dataso
 typedef tree_data_table<interface_table, indexed_record_type, skey_type, test_interface> datatable_type;
 
 #include "datatable_test.h"
+
+//==============================================================================
+//  Check for the fields of the packed indexed records
+//==============================================================================
+BOOST_AUTO_TEST_CASE(packed_fields_test)
+{
+    const record_type record(10, 11.0, "test");
+    indexed_record_type::node_type node(record, 1, RED);
+    node.left(2);
+    node.right(3);
+    std::vector<char> buffer(indexed_record_type::static_size());
+    indexed_record_type(node).pack(&buffer[0]);
+    BOOST_REQUIRE_EQUAL(index1<indexed_record_type>::value(&buffer[0]), 10);
+    BOOST_REQUIRE_CLOSE(index2<indexed_record_type>::value(&buffer[0]), 11.0, 0.001);
+    BOOST_REQUIRE_EQUAL(index3<indexed_record_type>::value(&buffer[0]), std::string("test"));
+
+    datasource_type::remove(DATASOURCE_NAME);
+    const size_t tbl_count = 4;
+    const size_t rec_count = 100;
+    datasource_type source(DATASOURCE_NAME, tbl_count, rec_count, options);
+    file_region_type file_region(tbl_count, source.table_size());
+    source.set_file_region(file_region);
+    skey_type skey(1, 1, 0, 0, 0, 0);
+    datatable_type table(source, skey);
+    table.clear();
+    record_list records_wr;
+    fill_records(records_wr, rec_count / 2, 0);
+    table.add(records_wr);
+
+    const aggregate_result<int32_t> result1 = table.aggregate<index1>(table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result1.count, rec_count / 2);
+    BOOST_REQUIRE_EQUAL(result1.sum, 1225);
+    BOOST_REQUIRE_EQUAL(result1.min, 0);
+    BOOST_REQUIRE_EQUAL(result1.max, 49);
+    const aggregate_result<int32_t> result2 = table.aggregate<index1>(
+        comp_greater_equal<indexed_record_type, index1>(40), table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result2.count, 10);
+    BOOST_REQUIRE_EQUAL(result2.sum, 445);
+    // the comparator without the packed form unpacks the node and the record
+    const aggregate_result<int32_t> result3 = table.aggregate<index1>(
+        comp_even<indexed_record_type>(), table.beg_pos(), table.count());
+    BOOST_REQUIRE_EQUAL(result3.count, rec_count / 4);
+    BOOST_REQUIRE_EQUAL(result3.sum, 600);
+}
+
 //@todo need to add specific test for TreeDataTable
\ No newline at end of file
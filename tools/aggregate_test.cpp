@@ -0,0 +1,170 @@
+/**
+ * The test tool for checking the aggregation of the fields of the records:
+ * -    the dataset of one table of the records is created;
+ * -    the process calculates min, max and average of one field of all records
+ *      and of the records that are matched by the comparator;
+ * -    the test is run by reading all records to the list (read_front) and
+ *      calculating the aggregates by the list, and by the aggregation of
+ *      the table that reads the blocks of the packed records;
+ * -    the count of the records per second is measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/session.h"
+#include "ouroboros/find.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record4< FIELD_INT64, FIELD_INT32, FIELD_INT32, FIELD_DOUBLE > record_type;
+typedef data_set<simple_key, record_type, index_null, local_interface> dataset_type;
+typedef dataset_type::record_list record_list;
+typedef dataset_type::session_read session_read;
+typedef aggregate_result<double> result_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    count_type rec_count; ///< the count of the records
+    size_t repeat;      ///< the count of the repeats of the aggregation
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Aggregate the field of the records by reading all records to the list
+ * @param session the session of the table
+ * @param comp the comparator
+ * @return the aggregates
+ */
+template <typename Comparator>
+result_type aggregate_list(session_read& session, const Comparator& comp)
+{
+    record_list records(session->count());
+    session->read_front(records);
+    result_type result;
+    for (typename record_list::const_iterator it = records.begin(); it != records.end(); ++it)
+    {
+        if (comp(*it))
+        {
+            result.add(it->field4());
+        }
+    }
+    return result;
+}
+
+/**
+ * Aggregate the field of the records that are matched by the comparator
+ * @param name the name of the comparator
+ * @param comp the comparator
+ * @param dataset the dataset
+ * @param options the options of the test
+ */
+template <typename Comparator>
+void run_test(const char *name, const Comparator& comp, dataset_type& dataset, const test_options& options)
+{
+    uint64_t time[2] = { 0, 0 };
+    result_type result[2];
+    for (int packed = 0; packed < 2; ++packed)
+    {
+        for (size_t n = 0; n < options.repeat; ++n)
+        {
+            session_read session = dataset.session_rd(0);
+            const uint64_t beg = time_us();
+            result[packed] = packed ? session->aggregate<index4>(comp, session->beg_pos(), session->count()) :
+                aggregate_list(session, comp);
+            time[packed] += time_us() - beg;
+        }
+    }
+    if (result[0].count != result[1].count || result[0].min != result[1].min || result[0].max != result[1].max)
+    {
+        std::cerr << "the results differ" << std::endl;
+        exit(1);
+    }
+    std::cout << "\t" << std::left << std::setw(12) << name << std::right << std::setw(10) << result[0].count <<
+        std::setw(16) << uint64_t(options.rec_count) * options.repeat * 1000000 / time[0] <<
+        std::setw(16) << uint64_t(options.rec_count) * options.repeat * 1000000 / time[1] << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "aggregate_test";
+    options.rec_count = 10000000;
+    options.repeat = 3;
+    if (argc > 1)
+    {
+        const char *opts = "n:r:c:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<count_type>(optarg);
+                    break;
+                case 'c':
+                    options.repeat = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of records:     " << options.rec_count << std::endl;
+    std::cout << "\t size of the record:   " << record_type::static_size() << std::endl;
+    std::cout << "\t count of repeats:     " << options.repeat << std::endl;
+    std::cout << std::endl;
+
+    dataset_type::remove(options.name);
+    {
+        dataset_type dataset(options.name, 1, options.rec_count);
+        dataset.add_table(0);
+        const count_type block = 1000000;
+        record_list records;
+        records.reserve(block);
+        for (count_type i = 0; i < options.rec_count; i += block)
+        {
+            records.clear();
+            for (count_type n = i; n < std::min(i + block, options.rec_count); ++n)
+            {
+                records.push_back(record_type(n, n % 100, n % 7, n * 0.5));
+            }
+            dataset.session_wr(0)->add(records);
+        }
+
+        std::cout << "records         found         list / s      packed / s" << std::endl;
+        run_test("all", comp_any<record_type>(), dataset, options);
+        run_test("filtered", comp_equal<record_type, index2>(42), dataset, options);
+    }
+    dataset_type::remove(options.name);
+    return 0;
+}
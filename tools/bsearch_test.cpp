@@ -0,0 +1,171 @@
+/**
+ * The test tool for checking the binary search by the time field:
+ * -    the dataset of one table of the records is created, the table is
+ *      overwritten by the half, so the records wrap around the end of it;
+ * -    the process reads the records of the random ranges of the time
+ *      by the finder that compares all records and by read_by that finds
+ *      the bounds of the range by the binary search;
+ * -    the count of the queries per second and the count of the reads
+ *      of the file per query are measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/session.h"
+#include "ouroboros/find.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record2< FIELD_INT64, FIELD_DOUBLE > record_type;
+typedef data_set<simple_key, record_type, index_null, local_interface> dataset_type;
+typedef dataset_type::record_list record_list;
+typedef dataset_type::session_read session_read;
+typedef comp_greater_equal<record_type, index1> greater_equal_type;
+typedef comp_less_equal<record_type, index1> less_equal_type;
+typedef comb_and<greater_equal_type, less_equal_type> comparator_type;
+typedef finder<comparator_type> finder_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    count_type rec_count; ///< the count of the records
+    count_type range;   ///< the count of the records in the range
+    size_t query_count; ///< the count of the queries
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Read the records of the random ranges of the time
+ * @param name the name of the mode
+ * @param search the sign that the bounds are found by the binary search
+ * @param dataset the dataset
+ * @param options the options of the test
+ */
+void run_test(const char *name, const bool search, dataset_type& dataset, const test_options& options)
+{
+    srand(1);
+    size_t found = 0;
+    const file_stats before = base_file::stats();
+    const uint64_t beg = time_us();
+    for (size_t n = 0; n < options.query_count; ++n)
+    {
+        // the records [rec_count / 2, 3 * rec_count / 2) are kept by the table
+        const int64_t from = options.rec_count / 2 + rand() % (options.rec_count - options.range);
+        const int64_t to = from + options.range - 1;
+        session_read session = dataset.session_rd(0);
+        if (search)
+        {
+            record_list records;
+            session->read_by<index1>(records, from, to);
+            found += records.size();
+        }
+        else
+        {
+            const greater_equal_type greater_equal(from);
+            const less_equal_type less_equal(to);
+            const comparator_type comp(greater_equal, less_equal);
+            finder_type finder(comp);
+            session->find(finder, session->beg_pos(), session->count());
+            found += finder.result().size();
+        }
+    }
+    const uint64_t time = time_us() - beg;
+    const file_stats after = base_file::stats();
+    if (found != options.query_count * options.range)
+    {
+        std::cerr << "the count of the found records is wrong " << found << std::endl;
+        exit(1);
+    }
+    std::cout << "\t" << std::left << std::setw(10) << name << std::right <<
+        std::setw(14) << uint64_t(options.query_count) * 1000000 / time <<
+        std::setw(14) << (after.reads - before.reads) / options.query_count << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "bsearch_test";
+    options.rec_count = 1000000;
+    options.range = 100;
+    options.query_count = 100;
+    if (argc > 1)
+    {
+        const char *opts = "n:r:g:q:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<count_type>(optarg);
+                    break;
+                case 'g':
+                    options.range = boost::lexical_cast<count_type>(optarg);
+                    break;
+                case 'q':
+                    options.query_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of records:     " << options.rec_count << std::endl;
+    std::cout << "\t size of the record:   " << record_type::static_size() << std::endl;
+    std::cout << "\t records in the range: " << options.range << std::endl;
+    std::cout << "\t count of queries:     " << options.query_count << std::endl;
+    std::cout << std::endl;
+
+    dataset_type::remove(options.name);
+    {
+        dataset_type dataset(options.name, 1, options.rec_count);
+        dataset.add_table(0);
+        const count_type block = 100000;
+        record_list records;
+        records.reserve(block);
+        for (count_type i = 0; i < options.rec_count + options.rec_count / 2; i += block)
+        {
+            records.clear();
+            for (count_type n = i; n < std::min(i + block, options.rec_count + options.rec_count / 2); ++n)
+            {
+                records.push_back(record_type(n, n * 0.5));
+            }
+            dataset.session_wr(0)->add(records);
+        }
+
+        std::cout << "mode          queries / s   reads / query" << std::endl;
+        run_test("finder", false, dataset, options);
+        run_test("read_by", true, dataset, options);
+    }
+    dataset_type::remove(options.name);
+    return 0;
+}
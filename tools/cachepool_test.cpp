@@ -0,0 +1,185 @@
+/**
+ * The test tool for checking the replacement policies of the cache:
+ * -    the requests of pages of a dataset are replayed: the writers append
+ *      records to the tails of the tables (the key page, the info page and
+ *      the tail page of a table are requested), sometimes the whole table
+ *      is read;
+ * -    the hit ratio of all requests and the hit ratio of the requests
+ *      of the writers are measured for each policy.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#include "ouroboros/cache.h"
+#include "ouroboros/cachepool.h"
+
+using namespace ouroboros;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    size_t tbl_count;   ///< the count of tables
+    size_t tbl_size;    ///< the count of pages of a table
+    size_t rec_count;   ///< the count of records in a page
+    size_t itr_count;   ///< the count of appended records
+    size_t scan_rate;   ///< a table is read after this count of records
+};
+
+/**
+ * The statistics of requests
+ */
+struct test_stats
+{
+    test_stats() :
+        count(0),
+        hits(0),
+        tail_count(0),
+        tail_hits(0)
+    {}
+    size_t count;       ///< the count of all requests
+    size_t hits;        ///< the count of all hits
+    size_t tail_count;  ///< the count of requests of the writers
+    size_t tail_hits;   ///< the count of hits of the writers
+};
+
+/**
+ * The saver of the pages which doesn't save anything
+ */
+struct null_saver
+{
+    void save_page(const pos_type index, void *page)
+    {
+        OUROBOROS_UNUSED(index);
+        OUROBOROS_UNUSED(page);
+    }
+};
+
+/**
+ * Request the page of the cache
+ * @param cache the cache
+ * @param index the index of the page
+ * @param tail the page is requested by a writer
+ * @param stats the statistics
+ */
+template <typename Cache>
+void request(const Cache& cache, const pos_type index, const bool tail, test_stats& stats)
+{
+    const bool hit = cache.page_exists(index).state() != PG_DETACHED;
+    ++stats.count;
+    stats.hits += hit;
+    if (tail)
+    {
+        ++stats.tail_count;
+        stats.tail_hits += hit;
+    }
+    cache.get_page(index);
+}
+
+/**
+ * Run the test for the cache
+ * @param name the name of the policy
+ * @param options the options of the test
+ */
+template <typename Cache>
+void run_cache(const char *name, const test_options& options)
+{
+    srand(1);
+    Cache cache;
+    test_stats stats;
+    // the page of keys, the pages of infos and the pages of tables
+    const pos_type info_beg = 1;
+    const pos_type table_beg = info_beg + options.tbl_count / 16 + 1;
+    std::vector<size_t> tails(options.tbl_count, 0);
+    for (size_t i = 0; i < options.itr_count; ++i)
+    {
+        const size_t table = rand() % options.tbl_count;
+        const pos_type tail = table_beg + table * options.tbl_size +
+            (tails[table]++ / options.rec_count) % options.tbl_size;
+        request(cache, 0, true, stats);
+        request(cache, info_beg + table / 16, true, stats);
+        request(cache, tail, true, stats);
+        if (options.scan_rate > 0 && (i + 1) % options.scan_rate == 0)
+        {
+            const size_t scanned = rand() % options.tbl_count;
+            const pos_type beg = table_beg + scanned * options.tbl_size;
+            for (pos_type index = beg; index < beg + options.tbl_size; ++index)
+            {
+                for (size_t n = 0; n < options.rec_count; ++n)
+                {
+                    request(cache, index, false, stats);
+                }
+            }
+        }
+    }
+    std::cout << "\t" << std::left << std::setw(8) << name << std::right << std::fixed <<
+        std::setprecision(2) << std::setw(8) << 100.0 * stats.hits / stats.count << "%" <<
+        std::setw(12) << 100.0 * stats.tail_hits / stats.tail_count << "%" << std::endl;
+}
+
+/**
+ * Run the test for the count of pages
+ * @param options the options of the test
+ */
+template <int pageCount>
+void run_test(const test_options& options)
+{
+    std::cout << pageCount << " pages:      all     writers" << std::endl;
+    run_cache<cache<null_saver, OUROBOROS_PAGE_SIZE, pageCount> >("lru", options);
+    run_cache<twoq_cache<null_saver, OUROBOROS_PAGE_SIZE, pageCount> >("2q", options);
+    run_cache<arc_cache<null_saver, OUROBOROS_PAGE_SIZE, pageCount> >("arc", options);
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.tbl_count = 32;
+    options.tbl_size = 256;
+    options.rec_count = 16;
+    options.itr_count = 1000000;
+    options.scan_rate = 200;
+    if (argc > 1)
+    {
+        const char *opts = "t:s:r:i:f:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 't':
+                    options.tbl_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 's':
+                    options.tbl_size = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'i':
+                    options.itr_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'f':
+                    options.scan_rate = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of tables:         " << options.tbl_count << std::endl;
+    std::cout << "\t count of pages of table: " << options.tbl_size << std::endl;
+    std::cout << "\t count of records in page: " << options.rec_count << std::endl;
+    std::cout << "\t count of records:        " << options.itr_count << std::endl;
+    std::cout << "\t table is read after:     " << options.scan_rate << std::endl;
+    std::cout << std::endl;
+
+    run_test<OUROBOROS_PAGE_COUNT>(options);
+    run_test<64>(options);
+    run_test<256>(options);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * The test tool for checking the group commit:
+ * -    a lot of processes add the records to the own tables of a dataset,
+ *      each record is added by the own transaction (the session of writing);
+ * -    the data is synchronized at the end of each transaction
+ *      (OUROBOROS_SYNC_ENABLED);
+ * -    the dataset without the group commit (each commit synchronizes the
+ *      file itself) and the dataset with the group commit are tested;
+ * -    the count of the commits per second, the count of the synchronizations
+ *      and the average count of the commits per synchronization are measured.
+ */
+#define OUROBOROS_SYNC_ENABLED
+
+#include <stdio.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/sharedinterface.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record3< FIELD_INT32, FIELD_FLOAT, FIELD_INT32 > record_type;
+typedef data_set<simple_key, record_type, index1, futex_shared_interface> dataset_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    size_t proc_count;  ///< the count of the processes
+    size_t itr_count;   ///< the count of the commits of each process
+    uint32_t window;    ///< the window of the group commit (us)
+    uint32_t batch;     ///< the maximum count of the commits in the window
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Add the records to the table of the process, the dataset is opened
+ * before the start of the test
+ * @param ds_name the name of the dataset
+ * @param options the options of the test
+ * @param key the key of the table
+ * @param ready the pipe of the signal that the dataset is opened
+ * @param start the pipe of the signal of the start
+ */
+void run_process(const std::string& ds_name, const test_options& options, const size_t key,
+    const int ready, const int start)
+{
+    dataset_type dataset(ds_name);
+    dataset.open();
+    char signal = 0;
+    if (write(ready, &signal, 1) != 1 || read(start, &signal, 1) < 0)
+    {
+        return;
+    }
+    for (size_t i = 0; i < options.itr_count; ++i)
+    {
+        const record_type record(i, i + 1, i + 2);
+        dataset.session_wr(key)->add(record);
+    }
+}
+
+/**
+ * Run the test of the group commit
+ * @param name the name of the mode
+ * @param options the options of the test
+ * @param batch the maximum count of the commits in the window
+ */
+void run_test(const char *name, const test_options& options, const uint32_t batch)
+{
+    // the shared objects of the dataset are different for each mode
+    const std::string ds_name = options.name + "_" + name;
+    dataset_type::remove(ds_name);
+    dataset_type dataset(ds_name, options.proc_count, options.itr_count + 1);
+    for (size_t key = 0; key < options.proc_count; ++key)
+    {
+        dataset.add_table(key);
+    }
+    dataset.set_group_commit(options.window, batch);
+    int ready[2];
+    int start[2];
+    if (pipe(ready) != 0 || pipe(start) != 0)
+    {
+        std::cerr << "error of creating the pipe" << std::endl;
+        return;
+    }
+    std::vector<pid_t> pids;
+    for (size_t key = 0; key < options.proc_count; ++key)
+    {
+        const pid_t pid = fork();
+        if (0 == pid)
+        {
+            close(start[1]);
+            try
+            {
+                run_process(ds_name, options, key, ready[1], start[0]);
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << e.what() << std::endl;
+                _exit(1);
+            }
+            _exit(0);
+        }
+        pids.push_back(pid);
+        // the processes open the dataset one by one
+        char signal = 0;
+        if (read(ready[0], &signal, 1) != 1)
+        {
+            std::cerr << "error of opening the dataset" << std::endl;
+        }
+    }
+    const commit_stats before = dataset.group_commit_stats();
+    const uint64_t beg = time_us();
+    close(start[1]);
+    for (size_t i = 0; i < pids.size(); ++i)
+    {
+        int status = 0;
+        waitpid(pids[i], &status, 0);
+    }
+    const uint64_t time = time_us() - beg;
+    close(start[0]);
+    close(ready[0]);
+    close(ready[1]);
+    const commit_stats after = dataset.group_commit_stats();
+    const uint64_t commits = after.commits - before.commits;
+    const uint64_t syncs = after.syncs - before.syncs;
+    std::cout << "\t" << std::left << std::setw(8) << name << std::right << std::fixed <<
+        std::setprecision(0) << std::setw(12) << double(commits) * 1000000 / time <<
+        std::setw(10) << syncs << std::setprecision(1) << std::setw(12) <<
+        (syncs > 0 ? double(commits) / syncs : 0.0) << std::setw(12) <<
+        (commits > 0 ? double(after.wait_time - before.wait_time) / commits : 0.0) << std::endl;
+    dataset_type::remove(ds_name);
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "commit_test";
+    options.proc_count = 8;
+    options.itr_count = 200;
+    options.window = OUROBOROS_COMMIT_WINDOW;
+    options.batch = OUROBOROS_COMMIT_BATCH;
+    if (argc > 1)
+    {
+        const char *opts = "n:p:i:w:b:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'p':
+                    options.proc_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'i':
+                    options.itr_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'w':
+                    options.window = boost::lexical_cast<uint32_t>(optarg);
+                    break;
+                case 'b':
+                    options.batch = boost::lexical_cast<uint32_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of processes:       " << options.proc_count << std::endl;
+    std::cout << "\t count of commits:         " << options.itr_count << std::endl;
+    std::cout << "\t window of commits (us):   " << options.window << std::endl;
+    std::cout << "\t batch of commits:         " << options.batch << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "mode       commits/s     syncs   commits/sync  us/commit" << std::endl;
+    run_test("single", options, 1);
+    run_test("group", options, options.batch);
+    return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * The test tool for checking the memory usage of the direct I/O:
+ * -    the big file is created and it is dropped from the page cache;
+ * -    the process reads and changes the records of the file through
+ *      the cache of the file (the most of the requests get the hot pages);
+ * -    the throughput, the resident memory of the process (VmRSS) and
+ *      the pages of the file that are cached by the system are measured
+ *      with the buffered I/O and with the direct I/O;
+ * -    each mode is run by the own process.
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/cachefile.h"
+
+using namespace ouroboros;
+
+typedef file_page<OUROBOROS_PAGE_ALIGNMENT> file_page_type;
+typedef cache_file<file_page_type, 1024> file_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the file
+    size_t size;        ///< the size of the file (MiB)
+    size_t page_count;  ///< the count of the cache pages
+    size_t op_count;    ///< the count of the operations
+    size_t write_share; ///< the share of the writes (%)
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Get the resident memory of the process
+ * @return the resident memory (KiB)
+ */
+size_t rss_kb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmRSS:") == 0)
+        {
+            std::istringstream value(line.substr(6));
+            size_t result = 0;
+            value >> result;
+            return result;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Get the size of the file that is cached by the system
+ * @param name the name of the file
+ * @return the size of the cached pages (KiB)
+ */
+size_t cached_kb(const std::string& name)
+{
+    const int fd = open(name.c_str(), O_RDONLY);
+    const off_t size = lseek(fd, 0, SEEK_END);
+    void *addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    std::vector<unsigned char> pages((size + page_size - 1) / page_size);
+    size_t count = 0;
+    if (addr != MAP_FAILED && mincore(addr, size, &pages[0]) == 0)
+    {
+        for (size_t i = 0; i < pages.size(); ++i)
+        {
+            count += pages[i] & 1;
+        }
+    }
+    if (addr != MAP_FAILED)
+    {
+        munmap(addr, size);
+    }
+    close(fd);
+    return count * page_size / 1024;
+}
+
+/**
+ * Drop the pages of the file from the page cache of the system
+ * @param name the name of the file
+ */
+void drop_cache(const std::string& name)
+{
+    const int fd = open(name.c_str(), O_RDWR);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+/**
+ * Create the file
+ * @param options the options of the test
+ */
+void create_file(const test_options& options)
+{
+    base_file::remove(options.name);
+    ouroboros::file<> data(options.name);
+    std::vector<char> block(1 << 20, 0);
+    for (size_t n = 0; n < options.size; ++n)
+    {
+        data.write(&block[0], block.size(), size_type(n) << 20);
+    }
+}
+
+/**
+ * Read and change the records of the file, a half of the operations
+ * gets 1/16 of the file
+ * @param name the name of the mode
+ * @param direct the sign of the direct I/O
+ * @param options the options of the test
+ */
+void run_process(const char *name, const bool direct, const test_options& options)
+{
+    drop_cache(options.name);
+    const pid_t pid = fork();
+    if (0 == pid)
+    {
+        file_type file(options.name);
+        file.set_cache_capacity(options.page_count);
+        file.set_direct(direct);
+        const size_type record_size = 64;
+        const size_type record_count = (size_type(options.size) << 20) / record_size;
+        const size_type hot_count = record_count / 16;
+        char record[record_size] = { 0 };
+        srand(1);
+        const uint64_t beg = time_us();
+        for (size_t n = 0; n < options.op_count; ++n)
+        {
+            const size_type count = (n & 1) ? hot_count : record_count;
+            const pos_type pos = ((size_type(rand()) << 16) ^ size_type(rand())) % count * record_size;
+            if (size_t(rand() % 100) < options.write_share)
+            {
+                memset(record, int(n), sizeof(record));
+                file.write(record, sizeof(record), pos);
+            }
+            else
+            {
+                file.read(record, sizeof(record), pos);
+            }
+        }
+        file.start();
+        file.stop();
+        const uint64_t time = time_us() - beg;
+        std::cout << "\t" << std::left << std::setw(10) << name << std::right << std::setw(8) <<
+            (file.direct() ? "yes" : "no") << std::setw(14) << options.op_count * 1000000 / time <<
+            std::setw(12) << rss_kb() / 1024 << std::setw(12) << cached_kb(options.name) / 1024 << std::endl;
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "direct_test.dat";
+    options.size = 512;
+    options.page_count = 4096;
+    options.op_count = 1000000;
+    options.write_share = 20;
+    if (argc > 1)
+    {
+        const char *opts = "n:s:p:r:w:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 's':
+                    options.size = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'p':
+                    options.page_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'r':
+                    options.op_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'w':
+                    options.write_share = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t size of the file (MiB):   " << options.size << std::endl;
+    std::cout << "\t count of cache pages:     " << options.page_count << std::endl;
+    std::cout << "\t size of the page:         " << file_type::CACHE_PAGE_SIZE << std::endl;
+    std::cout << "\t count of operations:      " << options.op_count << std::endl;
+    std::cout << "\t share of writes (%):      " << options.write_share << std::endl;
+    std::cout << std::endl;
+
+    create_file(options);
+    std::cout << "mode        direct     ops / s    RSS (MiB) cached (MiB)" << std::endl;
+    run_process("buffered", false, options);
+    run_process("direct", true, options);
+    base_file::remove(options.name);
+    return 0;
+}
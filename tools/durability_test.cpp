@@ -0,0 +1,142 @@
+/**
+ * The test tool for checking the levels of the durability:
+ * -    the process adds the records to the tables of a dataset, each
+ *      transaction adds some records to a random table;
+ * -    the test is run with each level of the durability of the dataset
+ *      (none, commit, sync, full);
+ * -    the count of the commits per second and the count of
+ *      the synchronizations per commit are measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record3< FIELD_INT32, FIELD_FLOAT, FIELD_INT32 > record_type;
+typedef data_set<simple_key, record_type, index1, local_interface> dataset_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    size_t tbl_count;   ///< the count of the tables
+    size_t rec_count;   ///< the count of the records of a table
+    size_t itr_count;   ///< the count of the commits
+    size_t rec_commit;  ///< the count of the records of a commit
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Run the test with the level of the durability
+ * @param name the name of the level
+ * @param level the level of the durability
+ * @param options the options of the test
+ */
+void run_test(const char *name, const durability_level level, const test_options& options)
+{
+    dataset_type::remove(options.name);
+    {
+        dataset_type dataset(options.name, options.tbl_count, options.rec_count);
+        for (size_t key = 0; key < options.tbl_count; ++key)
+        {
+            dataset.add_table(key);
+        }
+    }
+    dataset_type dataset(options.name);
+    dataset.open();
+    dataset.set_durability(level);
+    srand(1);
+    const file_stats before = base_file::stats();
+    const uint64_t beg = time_us();
+    for (size_t i = 0; i < options.itr_count; ++i)
+    {
+        dataset_type::session_write session = dataset.session_wr(rand() % options.tbl_count);
+        for (size_t n = 0; n < options.rec_commit; ++n)
+        {
+            const record_type record(i, n, i + n);
+            session->add(record);
+        }
+    }
+    const uint64_t time = time_us() - beg;
+    const file_stats after = base_file::stats();
+    std::cout << "\t" << std::left << std::setw(8) << name << std::right << std::fixed <<
+        std::setprecision(0) << std::setw(12) << double(options.itr_count) * 1000000 / time <<
+        std::setprecision(2) << std::setw(14) << double(after.syncs - before.syncs) / options.itr_count <<
+        std::setw(14) << double(after.writes - before.writes) / options.itr_count << std::endl;
+    dataset_type::remove(options.name);
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "durability_test";
+    options.tbl_count = 32;
+    options.rec_count = 100000;
+    options.itr_count = 2000;
+    options.rec_commit = 100;
+    if (argc > 1)
+    {
+        const char *opts = "n:t:r:i:c:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 't':
+                    options.tbl_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'i':
+                    options.itr_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'c':
+                    options.rec_commit = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of tables:          " << options.tbl_count << std::endl;
+    std::cout << "\t count of records:         " << options.rec_count << std::endl;
+    std::cout << "\t count of commits:         " << options.itr_count << std::endl;
+    std::cout << "\t records of commit:        " << options.rec_commit << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "level      commits/s   syncs/commit  writes/commit" << std::endl;
+    run_test("none", DURABILITY_NONE, options);
+    run_test("commit", DURABILITY_COMMIT, options);
+    run_test("sync", DURABILITY_SYNC, options);
+    run_test("full", DURABILITY_FULL, options);
+    return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * The test tool for checking the interprocess locks under contention:
+ * -    a lot of process set the exclusive/sharable lock of the same table
+ *      lock which is placed in the shared memory;
+ * -    the time of acquisition and the time of wake-up (the time between
+ *      removing the lock and setting the lock by a waiting process) are
+ *      measured;
+ * -    the CPU time that is spent by all processes is measured.
+ */
+#include <stdio.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "ouroboros/sharedlocker.h"
+
+using namespace ouroboros;
+
+const char *progname = "lock_test";
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * The statistics which is collected by all processes
+ */
+struct lock_stats
+{
+    enum { BUCKET_COUNT = 40 };
+    lock_stats() :
+        stamp(0)
+    {
+        memset(acquire, 0, sizeof(acquire));
+        memset(acquire_rd, 0, sizeof(acquire_rd));
+        memset(acquire_wr, 0, sizeof(acquire_wr));
+        memset(wakeup, 0, sizeof(wakeup));
+    }
+    static size_t bucket(uint64_t value)
+    {
+        size_t result = 0;
+        while (value > 0 && result < BUCKET_COUNT - 1)
+        {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+    }
+    static uint64_t percentile(const uint64_t *hist, const double rate)
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            total += hist[i];
+        }
+        uint64_t count = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            count += hist[i];
+            if (count >= total * rate)
+            {
+                return i > 0 ? uint64_t(1) << i : 0;
+            }
+        }
+        return 0;
+    }
+    volatile uint64_t stamp; ///< the time of the last removing of the lock
+    uint64_t acquire[BUCKET_COUNT]; ///< the histogram of the acquisition time (log2 us)
+    uint64_t acquire_rd[BUCKET_COUNT]; ///< the histogram of the acquisition time of readers
+    uint64_t acquire_wr[BUCKET_COUNT]; ///< the histogram of the acquisition time of writers
+    uint64_t wakeup[BUCKET_COUNT]; ///< the histogram of the wake-up time (log2 us)
+};
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string lock;
+    size_t proc_count;
+    size_t itr_count;
+    size_t writer_rate;
+    size_t hold_time;
+};
+
+/**
+ * Hold the lock for some time
+ * @param time the time (us)
+ */
+void hold(const size_t time)
+{
+    const uint64_t end = time_us() + time;
+    while (time_us() < end)
+    {
+    }
+}
+
+/**
+ * Run the worker
+ * @param options the options of the test
+ * @param stats the statistics
+ * @param seed the seed of the random generator
+ * @return the result of the work
+ */
+template <typename Lock>
+int run_worker(const test_options& options, lock_stats& stats, const unsigned int seed)
+{
+    srand(seed);
+    Lock lock(progname);
+    for (size_t i = 0; i < options.itr_count; ++i)
+    {
+        const bool writer = size_t(rand() % 100) < options.writer_rate;
+        const uint64_t start = time_us();
+        if (!(writer ? lock.lock() : lock.lock_sharable()))
+        {
+            return 1;
+        }
+        const uint64_t now = time_us();
+        const uint64_t stamp = stats.stamp;
+        const size_t bucket = lock_stats::bucket(now - start);
+        __sync_fetch_and_add(&stats.acquire[bucket], 1);
+        __sync_fetch_and_add(writer ? &stats.acquire_wr[bucket] : &stats.acquire_rd[bucket], 1);
+        if (stamp > start && now > stamp)
+        {
+            __sync_fetch_and_add(&stats.wakeup[lock_stats::bucket(now - stamp)], 1);
+        }
+        hold(options.hold_time);
+        stats.stamp = time_us();
+        if (!(writer ? lock.unlock() : lock.unlock_sharable()))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Run the test
+ * @param options the options of the test
+ * @return the result of the test
+ */
+template <typename Lock>
+int run_test(const test_options& options)
+{
+    lock_stats& stats = *shared_memory::instance().mem().find_or_construct<lock_stats>("lock_stats")();
+    {
+        Lock lock(progname);
+    }
+    std::vector<pid_t> pids;
+    const uint64_t start = time_us();
+    for (size_t i = 0; i < options.proc_count; ++i)
+    {
+        const pid_t pid = fork();
+        if (0 == pid)
+        {
+            _exit(run_worker<Lock>(options, stats, i + 1));
+        }
+        else if (pid < 0)
+        {
+            std::cout << "Error: can't create the worker" << std::endl;
+            return -1;
+        }
+        pids.push_back(pid);
+    }
+    int result = 0;
+    for (size_t i = 0; i < pids.size(); ++i)
+    {
+        int status = -1;
+        waitpid(pids[i], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            result = -1;
+        }
+    }
+    const uint64_t total = time_us() - start;
+    struct rusage usage;
+    getrusage(RUSAGE_CHILDREN, &usage);
+    const uint64_t cpu = uint64_t(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+        usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    std::cout << "total time:       " << total << " us" << std::endl;
+    std::cout << "cpu time:         " << cpu << " us" << std::endl;
+    std::cout << "lock rate:        " << std::fixed << std::setprecision(0) <<
+        1e6 * options.proc_count * options.itr_count / total << " per second" << std::endl;
+    std::cout << "acquisition p50:  " << lock_stats::percentile(stats.acquire, 0.50) << " us" << std::endl;
+    std::cout << "acquisition p99:  " << lock_stats::percentile(stats.acquire, 0.99) << " us" << std::endl;
+    std::cout << "reader p99:       " << lock_stats::percentile(stats.acquire_rd, 0.99) << " us" << std::endl;
+    std::cout << "writer p99:       " << lock_stats::percentile(stats.acquire_wr, 0.99) << " us" << std::endl;
+    std::cout << "writer max:       " << lock_stats::percentile(stats.acquire_wr, 1.0) << " us" << std::endl;
+    std::cout << "wake-up p50:      " << lock_stats::percentile(stats.wakeup, 0.50) << " us" << std::endl;
+    std::cout << "wake-up p99:      " << lock_stats::percentile(stats.wakeup, 0.99) << " us" << std::endl;
+    if (result != 0)
+    {
+        std::cout << "Error: the lock is failed" << std::endl;
+    }
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.lock = "futex";
+    options.proc_count = 32;
+    options.itr_count = 1000;
+    options.writer_rate = 50;
+    options.hold_time = 10;
+    if (argc > 1)
+    {
+        const char *opts = "l:p:i:w:t:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'l':
+                    options.lock = optarg;
+                    break;
+                case 'p':
+                    options.proc_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'i':
+                    options.itr_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'w':
+                    options.writer_rate = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 't':
+                    options.hold_time = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t type of lock:       " << options.lock << std::endl;
+    std::cout << "\t count of processes: " << options.proc_count << std::endl;
+    std::cout << "\t count of repeats:   " << options.itr_count << std::endl;
+    std::cout << "\t rate of writers:    " << options.writer_rate << "%" << std::endl;
+    std::cout << "\t time of holding:    " << options.hold_time << std::endl;
+    std::cout << std::endl;
+
+    shared_memory::set_name(progname);
+    shared_memory::remove();
+    if ("futex" == options.lock)
+    {
+        return run_test<futex_mutex_lock>(options);
+    }
+    else if ("reader" == options.lock)
+    {
+        return run_test<policy_mutex_lock<reader_preferring_policy> >(options);
+    }
+    else if ("writer" == options.lock)
+    {
+        return run_test<policy_mutex_lock<writer_preferring_policy> >(options);
+    }
+    else if ("fifo" == options.lock)
+    {
+        return run_test<policy_mutex_lock<fifo_policy> >(options);
+    }
+    else if ("simple" == options.lock)
+    {
+        return run_test<simple_mutex_lock>(options);
+    }
+    else if ("mutex" == options.lock)
+    {
+        return run_test<mutex_lock>(options);
+    }
+    std::cout << "Error: unknown type of lock " << options.lock << std::endl;
+    return -1;
+}
@@ -0,0 +1,126 @@
+/**
+ * The test tool for checking the maps of cache pages:
+ * -    the map is filled by the indexes of pages (the count of items is
+ *      equal to the count of cache pages);
+ * -    the time of looking up of cached and not cached pages is measured;
+ * -    the time of replacing of the oldest page by a new page (erase + insert)
+ *      is measured, this is the work done by the cache on each cache miss.
+ */
+#include <stdio.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <boost/lexical_cast.hpp>
+
+#include "ouroboros/hashmap.h"
+#include "ouroboros/probemap.h"
+
+using namespace ouroboros;
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Print the rate of operations
+ * @param name the name of the operation
+ * @param count the count of operations
+ * @param time the time of operations (us)
+ */
+void print_rate(const char *name, const size_t count, const uint64_t time)
+{
+    std::cout << "\t" << std::left << std::setw(16) << name << std::right << std::setw(8) <<
+        std::fixed << std::setprecision(2) << (time > 0 ? 1e3 * time / count : 0.0) <<
+        " ns/op" << std::endl;
+}
+
+/**
+ * Run the test for the map
+ * @param name the name of the map
+ * @param itr_count the count of repeats
+ */
+template <typename Map, pos_type count>
+void run_map(const char *name, const size_t itr_count)
+{
+    Map map;
+    size_t dummy = 0;
+    char page = 0;
+
+    // fill the map by the window of pages
+    for (pos_type i = 0; i < count; ++i)
+    {
+        map.insert(std::make_pair(i, &page));
+    }
+
+    uint64_t start = time_us();
+    for (size_t n = 0; n < itr_count; ++n)
+    {
+        for (pos_type i = 0; i < count; ++i)
+        {
+            dummy += map.find(i) != map.end();
+        }
+    }
+    const uint64_t hit = time_us() - start;
+
+    start = time_us();
+    for (size_t n = 0; n < itr_count; ++n)
+    {
+        for (pos_type i = count; i < 2 * count; ++i)
+        {
+            dummy += map.find(i) != map.end();
+        }
+    }
+    const uint64_t miss = time_us() - start;
+
+    // move the window of pages
+    start = time_us();
+    pos_type beg = 0;
+    for (size_t n = 0; n < itr_count; ++n)
+    {
+        for (pos_type i = 0; i < count; ++i, ++beg)
+        {
+            map.erase(beg);
+            map.insert(std::make_pair(beg + count, &page));
+        }
+    }
+    const uint64_t replace = time_us() - start;
+    dummy += map.size();
+
+    std::cout << name << " (" << count << " pages, " << dummy << "):" << std::endl;
+    print_rate("find (hit)", itr_count * count, hit);
+    print_rate("find (miss)", itr_count * count, miss);
+    print_rate("erase + insert", itr_count * count, replace);
+}
+
+/**
+ * Run the test for the count of pages
+ * @param itr_count the count of repeats
+ */
+template <int pageCount>
+void run_test(const size_t itr_count)
+{
+    run_map<hash_map<pos_type, char *, pageCount>, pageCount>("hash_map", itr_count);
+    run_map<probe_map<pos_type, char *, pageCount>, pageCount>("probe_map", itr_count);
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t itr_count = 10000;
+    if (argc > 1)
+    {
+        itr_count = boost::lexical_cast<size_t>(argv[1]);
+    }
+    std::cout << "The count of repeats: " << itr_count << std::endl << std::endl;
+    run_test<OUROBOROS_PAGE_COUNT>(itr_count);
+    run_test<256>(itr_count);
+    run_test<4096>(itr_count / 16 + 1);
+    return 0;
+}
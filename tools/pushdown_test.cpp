@@ -0,0 +1,186 @@
+/**
+ * The test tool for checking the searching of the records by the comparators
+ * of find.h:
+ * -    the dataset of one table of the records is created;
+ * -    the process finds all records that are matched by the comparator:
+ *      the selective comparator of one field, the combination of the field
+ *      range and the comparing of two fields, and the comparator that matches
+ *      all records;
+ * -    the test is run by reading, unpacking and comparing the records one by
+ *      one (the previous searching) and by the searching of the table that
+ *      evaluates the comparator on the packed records of the blocks;
+ * -    the count of the records per second is measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/session.h"
+#include "ouroboros/find.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record4< FIELD_INT64, FIELD_INT32, FIELD_INT32, FIELD_DOUBLE > record_type;
+typedef data_set<simple_key, record_type, index_null, local_interface> dataset_type;
+typedef dataset_type::record_list record_list;
+typedef dataset_type::session_read session_read;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    count_type rec_count; ///< the count of the records
+    size_t repeat;      ///< the count of the repeats of the searching
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Find the records by reading, unpacking and comparing the records one by one
+ * @param session the session of the table
+ * @param finder the finder
+ */
+template <typename Finder>
+void find_record(session_read& session, Finder& finder)
+{
+    pos_type pos = session->beg_pos();
+    for (count_type n = session->count(); n > 0; --n)
+    {
+        pos = session->read(finder.record(pos), pos);
+        if (!finder())
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * Find all records that are matched by the comparator
+ * @param name the name of the comparator
+ * @param comp the comparator
+ * @param dataset the dataset
+ * @param options the options of the test
+ */
+template <typename Comparator>
+void run_test(const char *name, const Comparator& comp, dataset_type& dataset, const test_options& options)
+{
+    typedef finder<Comparator> finder_type;
+    uint64_t time[2] = { 0, 0 };
+    size_t found[2] = { 0, 0 };
+    for (int packed = 0; packed < 2; ++packed)
+    {
+        for (size_t n = 0; n < options.repeat; ++n)
+        {
+            finder_type finder(comp);
+            session_read session = dataset.session_rd(0);
+            const uint64_t beg = time_us();
+            if (packed)
+            {
+                session->find(finder, session->beg_pos(), session->count());
+            }
+            else
+            {
+                find_record(session, finder);
+            }
+            time[packed] += time_us() - beg;
+            found[packed] = finder.result().size();
+        }
+    }
+    if (found[0] != found[1])
+    {
+        std::cerr << "the results differ: " << found[0] << " " << found[1] << std::endl;
+        exit(1);
+    }
+    std::cout << "\t" << std::left << std::setw(12) << name << std::right << std::setw(10) << found[0] <<
+        std::setw(16) << uint64_t(options.rec_count) * options.repeat * 1000000 / time[0] <<
+        std::setw(16) << uint64_t(options.rec_count) * options.repeat * 1000000 / time[1] << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "pushdown_test";
+    options.rec_count = 10000000;
+    options.repeat = 3;
+    if (argc > 1)
+    {
+        const char *opts = "n:r:c:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<count_type>(optarg);
+                    break;
+                case 'c':
+                    options.repeat = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of records:     " << options.rec_count << std::endl;
+    std::cout << "\t size of the record:   " << record_type::static_size() << std::endl;
+    std::cout << "\t count of repeats:     " << options.repeat << std::endl;
+    std::cout << std::endl;
+
+    dataset_type::remove(options.name);
+    {
+        dataset_type dataset(options.name, 1, options.rec_count);
+        dataset.add_table(0);
+        const count_type block = 1000000;
+        record_list records;
+        records.reserve(block);
+        for (count_type i = 0; i < options.rec_count; i += block)
+        {
+            records.clear();
+            for (count_type n = i; n < std::min(i + block, options.rec_count); ++n)
+            {
+                records.push_back(record_type(n, n % 100, n % 7, n * 0.5));
+            }
+            dataset.session_wr(0)->add(records);
+        }
+
+        typedef comp_equal<record_type, index2> equal_type;
+        typedef comp_greater_equal<record_type, index1> greater_equal_type;
+        typedef comp_less<record_type, index1> less_type;
+        typedef fields_comparator<record_type, index2, index3, op_less> fields_type;
+        typedef comb_and<comb_and<greater_equal_type, less_type>, fields_type> range_type;
+        typedef comp_not_equal<record_type, index4> all_type;
+        std::cout << "comparator      found       record / s      packed / s" << std::endl;
+        run_test("equal", equal_type(42), dataset, options);
+        run_test("range", range_type(comb_and<greater_equal_type, less_type>(greater_equal_type(options.rec_count / 4),
+            less_type(options.rec_count / 2)), fields_type()), dataset, options);
+        run_test("all", all_type(-1.0), dataset, options);
+    }
+    dataset_type::remove(options.name);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * The test tool for checking the reading ahead of the cache pages:
+ * -    the file of the records is created;
+ * -    the process reads the records one by one from the begin to the end
+ *      through the cache of the file;
+ * -    the test is run without the reading ahead, with the reading ahead
+ *      and with the prefetching of the blocks of the records, the file is
+ *      dropped from the page cache of the system before each run (or
+ *      the file is read by the direct I/O);
+ * -    the count of the records per second and the count of the reads
+ *      of the file are measured.
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/cachefile.h"
+
+using namespace ouroboros;
+
+typedef file_page<OUROBOROS_PAGE_ALIGNMENT> file_page_type;
+typedef cache_file<file_page_type, 1024> file_type;
+
+/**
+ * The mode of the reading
+ */
+enum read_mode
+{
+    READ_PAGE,      ///< the pages are read one by one
+    READ_AHEAD,     ///< the pages are read ahead
+    READ_PREFETCH   ///< the blocks of the records are prefetched
+};
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the file
+    size_t rec_count;   ///< the count of the records
+    size_t rec_size;    ///< the size of the record
+    size_t page_count;  ///< the count of the cache pages
+    bool cold;          ///< the sign that the file is dropped from the page cache
+    bool direct;        ///< the sign of the direct I/O
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Drop the pages of the file from the page cache of the system
+ * @param name the name of the file
+ */
+void drop_cache(const std::string& name)
+{
+    const int fd = open(name.c_str(), O_RDWR);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+/**
+ * Create the file of the records
+ * @param options the options of the test
+ */
+void create_file(const test_options& options)
+{
+    base_file::remove(options.name);
+    file_type file(options.name);
+    const size_type size = size_type(options.rec_count) * options.rec_size;
+    file.resize(calc_cache_size(size, file_type::CACHE_PAGE_SIZE));
+    std::vector<char> block(1 << 20);
+    for (pos_type pos = 0; pos < size; pos += block.size())
+    {
+        const size_type count = std::min(size_type(block.size()), size - pos);
+        memset(&block[0], int(pos >> 20), count);
+        file.write(&block[0], count, pos);
+    }
+    file.start();
+    file.stop();
+}
+
+/**
+ * Read the records of the file one by one
+ * @param name the name of the mode
+ * @param mode the mode of the reading
+ * @param options the options of the test
+ */
+void run_test(const char *name, const read_mode mode, const test_options& options)
+{
+    if (options.cold)
+    {
+        drop_cache(options.name);
+    }
+    file_type file(options.name);
+    file.set_cache_capacity(options.page_count);
+    file.set_direct(options.direct);
+    file.set_read_ahead(READ_PAGE == mode ? 0 : OUROBOROS_READ_AHEAD);
+    const size_t block_count = (options.page_count / 2) * file_type::CACHE_PAGE_SIZE / options.rec_size;
+    std::vector<char> record(options.rec_size);
+    const file_stats before = base_file::stats();
+    const uint64_t beg = time_us();
+    for (size_t n = 0; n < options.rec_count; ++n)
+    {
+        if (READ_PREFETCH == mode && n % block_count == 0)
+        {
+            file.prefetch(size_type(block_count) * options.rec_size, pos_type(n) * options.rec_size);
+        }
+        file.read(&record[0], options.rec_size, pos_type(n) * options.rec_size);
+    }
+    const uint64_t time = time_us() - beg;
+    const file_stats after = base_file::stats();
+    std::cout << "\t" << std::left << std::setw(10) << name << std::right << std::setw(14) <<
+        uint64_t(options.rec_count) * 1000000 / time << std::setw(10) << after.reads - before.reads << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "readahead_test.dat";
+    options.rec_count = 100000;
+    options.rec_size = 64;
+    options.page_count = 1024;
+    options.cold = true;
+    options.direct = false;
+    if (argc > 1)
+    {
+        const char *opts = "n:r:s:p:wd";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 's':
+                    options.rec_size = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'p':
+                    options.page_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'w':
+                    options.cold = false;
+                    break;
+                case 'd':
+                    options.direct = true;
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of records:         " << options.rec_count << std::endl;
+    std::cout << "\t size of the record:       " << options.rec_size << std::endl;
+    std::cout << "\t count of cache pages:     " << options.page_count << std::endl;
+    std::cout << "\t size of the page:         " << file_type::CACHE_PAGE_SIZE << std::endl;
+    std::cout << "\t page cache of the system: " << (options.cold ? "cold" : "warm") << std::endl;
+    std::cout << "\t direct I/O:               " << (options.direct ? "yes" : "no") << std::endl;
+    std::cout << std::endl;
+
+    create_file(options);
+    std::cout << "mode          records / s     reads" << std::endl;
+    run_test("page", READ_PAGE, options);
+    run_test("ahead", READ_AHEAD, options);
+    run_test("prefetch", READ_PREFETCH, options);
+    base_file::remove(options.name);
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * The test tool for checking the time of the recovery of the journal file:
+ * -    the big file is created, the processes change some pages of the file
+ *      in the transactions and crash (the changed pages are written to
+ *      the file and marked by the transactions);
+ * -    the time of the initialization of the file (the recovery) is measured
+ *      with the manifest of the journal and without it (the whole file is
+ *      scanned);
+ * -    the time of the initialization after the clean shutdown is measured;
+ * -    the full scan reads the file by the big blocks and the transactions
+ *      are recovered in parallel (OUROBOROS_RECOVERY_BLOCK,
+ *      OUROBOROS_RECOVERY_THREADS).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/journalfile.h"
+
+using namespace ouroboros;
+
+typedef file_page<OUROBOROS_PAGE_SIZE, sizeof(journal_status_type)> file_page_type;
+typedef journal_file<file_page_type, OUROBOROS_PAGE_COUNT> file_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the file
+    size_t size;        ///< the size of the file (MiB)
+    size_t page_count;  ///< the count of the pages changed by the transaction
+    size_t trans_count; ///< the count of the crashed transactions
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Create the file and fill it by the clean pages
+ * @param options the options of the test
+ */
+void create_file(const test_options& options)
+{
+    file_type::remove(options.name);
+    file_type file(options.name);
+    const size_type size = size_type(options.size) << 20;
+    file.resize(size);
+    file.init();
+    std::vector<char> block(1 << 20, 0);
+    ouroboros::file<> data(options.name);
+    for (size_type pos = 0; pos < size; pos += block.size())
+    {
+        data.write(&block[0], block.size(), pos);
+    }
+}
+
+/**
+ * Change the pages of the file in the transaction and crash
+ * @param options the options of the test
+ * @param number the number of the transaction (the offset of the pages)
+ */
+void crash_process(const test_options& options, const size_t number)
+{
+    const pid_t pid = fork();
+    if (0 == pid)
+    {
+        file_type file(options.name);
+        const size_type page_total = file.size() / file_type::CACHE_PAGE_SIZE;
+        const size_type step = page_total / options.page_count;
+        const char value = 1;
+        file.start();
+        for (size_t i = 0; i < options.page_count; ++i)
+        {
+            // the status of the journal is at the end of the page
+            file.write(&value, sizeof(value), (i * step + number) * file_type::CACHE_PAGE_SIZE);
+        }
+        // the pages that don't fit in the cache are written to the file
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+/**
+ * Crash the transactions, each transaction is crashed by the own process
+ * @param options the options of the test
+ */
+void crash_processes(const test_options& options)
+{
+    for (size_t number = 0; number < options.trans_count; ++number)
+    {
+        crash_process(options, number);
+    }
+}
+
+/**
+ * Measure the time of the initialization of the file
+ * @param name the name of the mode
+ * @param options the options of the test
+ */
+void run_init(const char *name, const test_options& options)
+{
+    const uint64_t beg = time_us();
+    file_type file(options.name);
+    const bool clean = file.init();
+    const uint64_t time = time_us() - beg;
+    std::cout << "\t" << std::left << std::setw(20) << name << std::right << std::setw(8) <<
+        (clean ? "clean" : "restored") << std::fixed << std::setprecision(1) <<
+        std::setw(14) << double(time) / 1000 << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "recovery_test.dat";
+    options.size = 2048;
+    options.page_count = OUROBOROS_PAGE_COUNT * 4;
+    options.trans_count = 8;
+    if (argc > 1)
+    {
+        const char *opts = "n:s:p:t:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 's':
+                    options.size = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'p':
+                    options.page_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 't':
+                    options.trans_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t size of the file (MiB):   " << options.size << std::endl;
+    std::cout << "\t count of changed pages:   " << options.page_count << std::endl;
+    std::cout << "\t count of transactions:    " << options.trans_count << std::endl;
+    std::cout << "\t size of the page:         " << file_type::CACHE_PAGE_SIZE << std::endl;
+    std::cout << "\t count of threads:         " << OUROBOROS_RECOVERY_THREADS << std::endl;
+    std::cout << std::endl;
+
+    create_file(options);
+    std::cout << "mode                   result    init (ms)" << std::endl;
+    crash_processes(options);
+    run_init("crash, manifest", options);
+    run_init("clean, manifest", options);
+    crash_processes(options);
+    base_file::remove(options.name + ".jnl");
+    run_init("crash, full scan", options);
+    base_file::remove(options.name + ".jnl");
+    run_init("clean, full scan", options);
+    file_type::remove(options.name);
+    return 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * The test tool for checking the round-robin archives of the consolidated records:
+ * -    the process adds the samples of one series (one sample per second)
+ *      to one table of the raw samples and to the archives of the steps
+ *      1 s, 1 min and 1 h that consolidate the average values;
+ * -    the average values of the hours of the whole series are calculated
+ *      by reading all raw samples and by fetching the records of the archive
+ *      that is selected by the step;
+ * -    the count of the added samples per second and the count of the queries
+ *      per second are measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/archive.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/session.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record2< FIELD_INT64, FIELD_DOUBLE > record_type;
+typedef data_set<simple_key, record_type, index_null, local_interface> dataset_type;
+typedef archive_set<simple_key, record_type, index1, index2, local_interface> archive_type;
+typedef dataset_type::record_list record_list;
+
+enum
+{
+    HOUR = 3600,        ///< the step of the query
+    BLOCK = 1000        ///< the count of the samples in the transaction
+};
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    count_type rec_count; ///< the count of the samples
+    size_t repeat;      ///< the count of the repeats of the query
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Make the sample
+ * @param time the time of the sample
+ * @return the sample
+ */
+inline record_type make_sample(const count_type time)
+{
+    return record_type(time, time % 1000);
+}
+
+/**
+ * Add the samples to the table of the raw samples
+ * @param dataset the dataset of the raw samples
+ * @param options the options of the test
+ * @return the time of the adding (us)
+ */
+uint64_t add_raw(dataset_type& dataset, const test_options& options)
+{
+    const uint64_t beg = time_us();
+    for (count_type time = 0; time < options.rec_count; ++time)
+    {
+        if (time % BLOCK == 0)
+        {
+            dataset.start();
+        }
+        dataset.session_wr(0)->add(make_sample(time));
+        if (time % BLOCK == BLOCK - 1 || time + 1 == options.rec_count)
+        {
+            dataset.stop();
+        }
+    }
+    return time_us() - beg;
+}
+
+/**
+ * Add the samples to the archives
+ * @param archives the archives
+ * @param options the options of the test
+ * @return the time of the adding (us)
+ */
+uint64_t add_archive(archive_type& archives, const test_options& options)
+{
+    const uint64_t beg = time_us();
+    for (count_type time = 0; time < options.rec_count; ++time)
+    {
+        if (time % BLOCK == 0)
+        {
+            archives.start();
+        }
+        archives.add(0, make_sample(time));
+        if (time % BLOCK == BLOCK - 1 || time + 1 == options.rec_count)
+        {
+            archives.stop();
+        }
+    }
+    return time_us() - beg;
+}
+
+/**
+ * Calculate the average values of the hours by reading all raw samples
+ * @param dataset the dataset of the raw samples
+ * @param [out] result the average values of the hours
+ */
+void query_raw(dataset_type& dataset, std::vector<double>& result)
+{
+    dataset_type::session_read session = dataset.session_rd(0);
+    record_list records(session->count());
+    session->read_front(records);
+    std::vector<count_type> counts;
+    result.clear();
+    for (record_list::const_iterator it = records.begin(); it != records.end(); ++it)
+    {
+        const size_t hour = it->field1() / HOUR;
+        if (hour >= result.size())
+        {
+            result.resize(hour + 1, 0.0);
+            counts.resize(hour + 1, 0);
+        }
+        result[hour] += it->field2();
+        ++counts[hour];
+    }
+    for (size_t n = 0; n < result.size(); ++n)
+    {
+        result[n] /= counts[n];
+    }
+}
+
+/**
+ * Fetch the average values of the hours from the archives
+ * @param archives the archives
+ * @param options the options of the test
+ * @param [out] result the average values of the hours
+ */
+void query_archive(archive_type& archives, const test_options& options, std::vector<double>& result)
+{
+    record_list records;
+    archives.fetch(0, CONSOLIDATION_AVERAGE, 0, options.rec_count - 1, HOUR, records);
+    result.clear();
+    for (record_list::const_iterator it = records.begin(); it != records.end(); ++it)
+    {
+        result.push_back(it->field2());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "rollup_test";
+    options.rec_count = 86400;
+    options.repeat = 10;
+    if (argc > 1)
+    {
+        const char *opts = "n:r:c:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<count_type>(optarg);
+                    break;
+                case 'c':
+                    options.repeat = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    archive_type::archive_list defs;
+    defs.push_back(archive_def(1, options.rec_count, CONSOLIDATION_AVERAGE));
+    defs.push_back(archive_def(60, options.rec_count / 60 + 1, CONSOLIDATION_AVERAGE));
+    defs.push_back(archive_def(HOUR, options.rec_count / HOUR + 1, CONSOLIDATION_AVERAGE));
+
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of samples:     " << options.rec_count << std::endl;
+    std::cout << "\t count of archives:    " << defs.size() << std::endl;
+    std::cout << "\t count of repeats:     " << options.repeat << std::endl;
+    std::cout << std::endl;
+
+    dataset_type::remove(options.name);
+    archive_type::remove(options.name, defs.size());
+    {
+        dataset_type dataset(options.name, 1, options.rec_count);
+        dataset.add_table(0);
+        archive_type archives(options.name, 1, defs);
+        archives.add_table(0);
+        const uint64_t add_time[2] = { add_raw(dataset, options), add_archive(archives, options) };
+        uint64_t query_time[2] = { 0, 0 };
+        std::vector<double> result[2];
+        for (size_t n = 0; n < options.repeat; ++n)
+        {
+            uint64_t beg = time_us();
+            query_raw(dataset, result[0]);
+            query_time[0] += time_us() - beg;
+            beg = time_us();
+            query_archive(archives, options, result[1]);
+            query_time[1] += time_us() - beg;
+        }
+        if (result[0] != result[1])
+        {
+            std::cerr << "the results differ" << std::endl;
+            exit(1);
+        }
+        std::cout << "mode          samples / s     queries / s" << std::endl;
+        const char *names[2] = { "raw", "archive" };
+        for (int n = 0; n < 2; ++n)
+        {
+            std::cout << "\t" << std::left << std::setw(10) << names[n] << std::right <<
+                std::setw(14) << uint64_t(options.rec_count) * 1000000 / add_time[n] <<
+                std::setw(16) << uint64_t(options.repeat) * 1000000 / query_time[n] << std::endl;
+        }
+    }
+    dataset_type::remove(options.name);
+    archive_type::remove(options.name, defs.size());
+    return 0;
+}
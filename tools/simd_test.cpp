@@ -0,0 +1,208 @@
+/**
+ * The test tool for checking the scanning of the records by SIMD:
+ * -    the table of the records is created, the records are kept in the cache
+ *      of the file;
+ * -    the process finds the record that is absent in the table, so all
+ *      records of the table are compared;
+ * -    the test is run by reading and comparing the records one by one
+ *      and by the scanning with each instruction set that is supported
+ *      by the processor, the record and the field at the offset are found;
+ * -    the count of the records per second is measured.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/cachefile.h"
+#include "ouroboros/table.h"
+#include "ouroboros/key.h"
+
+using namespace ouroboros;
+
+typedef file_page<OUROBOROS_PAGE_ALIGNMENT> file_page_type;
+typedef cache_file<file_page_type, 1024> file_type;
+typedef source<file_type> source_type;
+typedef table<source_type, simple_key> table_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the file
+    count_type rec_count; ///< the count of the records
+    size_type rec_size; ///< the size of the record
+    size_type offset;   ///< the offset of the field
+    size_type size;     ///< the size of the field
+    size_t repeat;      ///< the count of the repeats of the finding
+    size_t page_count;  ///< the count of the cache pages
+};
+
+/**
+ * Get monotonic time
+ * @return monotonic time (us)
+ */
+uint64_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return uint64_t(res.tv_sec) * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Find the record by reading and comparing the records one by one
+ * @param table the table
+ * @param field the field of the record
+ * @param rec_size the size of the record
+ * @return the position of the found record
+ */
+pos_type find_record(const table_type& table, const scan_field& field, const size_type rec_size)
+{
+    std::vector<char> record(rec_size);
+    pos_type pos = table.beg_pos();
+    for (count_type n = 0; n < table.count(); ++n)
+    {
+        table.read(&record[0], pos);
+        if (memcmp(&record[field.offset], field.value, field.size) == 0)
+        {
+            return pos;
+        }
+        pos = table.inc_pos(pos);
+    }
+    return NIL;
+}
+
+/**
+ * Find the absent record in the table
+ * @param name the name of the mode
+ * @param isa the instruction set of the scanning or -1 for the reading
+ * of the records one by one
+ * @param table the table
+ * @param field the field of the record
+ * @param options the options of the test
+ */
+void run_test(const char *name, const int isa, const table_type& table, const scan_field& field,
+    const test_options& options)
+{
+    if (isa >= 0 && scanner::set_isa(scan_isa(isa)) != isa)
+    {
+        return;
+    }
+    const uint64_t beg = time_us();
+    for (size_t n = 0; n < options.repeat; ++n)
+    {
+        const pos_type pos = isa < 0 ? find_record(table, field, options.rec_size) :
+            table.find(field, table.beg_pos(), table.count());
+        if (pos != NIL)
+        {
+            std::cerr << "the absent record is found" << std::endl;
+            exit(1);
+        }
+    }
+    const uint64_t time = time_us() - beg;
+    std::cout << "\t" << std::left << std::setw(10) << name << std::right << std::setw(16) <<
+        uint64_t(options.rec_count) * options.repeat * 1000000 / time << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "simd_test.dat";
+    options.rec_count = 1000000;
+    options.rec_size = 32;
+    options.offset = 8;
+    options.size = 8;
+    options.repeat = 10;
+    options.page_count = 8192;
+    if (argc > 1)
+    {
+        const char *opts = "n:r:s:o:f:c:p:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<count_type>(optarg);
+                    break;
+                case 's':
+                    options.rec_size = boost::lexical_cast<size_type>(optarg);
+                    break;
+                case 'o':
+                    options.offset = boost::lexical_cast<size_type>(optarg);
+                    break;
+                case 'f':
+                    options.size = boost::lexical_cast<size_type>(optarg);
+                    break;
+                case 'c':
+                    options.repeat = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'p':
+                    options.page_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    if (options.offset + options.size > options.rec_size)
+    {
+        std::cerr << "the field is out of the record" << std::endl;
+        return 1;
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of records:     " << options.rec_count << std::endl;
+    std::cout << "\t size of the record:   " << options.rec_size << std::endl;
+    std::cout << "\t offset of the field:  " << options.offset << std::endl;
+    std::cout << "\t size of the field:    " << options.size << std::endl;
+    std::cout << "\t count of repeats:     " << options.repeat << std::endl;
+    std::cout << "\t count of cache pages: " << options.page_count << std::endl;
+    std::cout << std::endl;
+
+    base_file::remove(options.name);
+    {
+        file_type file(options.name);
+        file.set_cache_capacity(options.page_count);
+        const size_type size = size_type(options.rec_count) * options.rec_size;
+        file.resize(calc_cache_size(size, file_type::CACHE_PAGE_SIZE));
+        source_type source(file, 1, options.rec_count, options.rec_size);
+        simple_key key;
+        table_type table(source, key);
+        std::vector<char> record(options.rec_size, 0);
+        for (count_type n = 0; n < options.rec_count; ++n)
+        {
+            memcpy(&record[0], &n, sizeof(n));
+            table.add(&record[0]);
+        }
+        const scan_isa isa = scanner::isa();
+        std::vector<char> value(options.rec_size, 0);
+        value[options.offset] = 1;
+        std::cout << "record        records / s" << std::endl;
+        run_test("record", -1, table, scan_field(&value[0], 0, options.rec_size), options);
+        for (int i = SCAN_SCALAR; i <= SCAN_AVX2; ++i)
+        {
+            run_test(scanner::isa_name(scan_isa(i)), i, table, scan_field(&value[0], 0, options.rec_size), options);
+        }
+        std::cout << "field         records / s" << std::endl;
+        const scan_field field(&value[options.offset], options.offset, options.size);
+        run_test("record", -1, table, field, options);
+        for (int i = SCAN_SCALAR; i <= SCAN_AVX2; ++i)
+        {
+            run_test(scanner::isa_name(scan_isa(i)), i, table, field, options);
+        }
+        scanner::set_isa(isa);
+    }
+    base_file::remove(options.name);
+    return 0;
+}
@@ -86,9 +86,10 @@ int main(int argc, char *argv[])
     size_t tbl_count = 10;
     size_t rec_count = 1000;
     bool is_session = false;
+    size_t page_count = 0;
     if (argc > 1)
     {
-        const char *options = "n:t:r:i:s";
+        const char *options = "n:t:r:i:sp:";
         int opt;
         while ((opt = getopt(argc, argv, options)) != -1)
         {
@@ -109,6 +110,9 @@ int main(int argc, char *argv[])
                 case 's':
                     is_session = true;
                     break;
+                case 'p':
+                    page_count = boost::lexical_cast<size_t>(optarg);
+                    break;
             }
         }
     }
@@ -117,18 +121,28 @@ int main(int argc, char *argv[])
     std::cout << "\t count of tables:  " << tbl_count << std::endl;
     std::cout << "\t count of records: " << rec_count << std::endl;
     std::cout << "\t single session:   " << (is_session ? "yes" : "no") << std::endl;
+    std::cout << "\t count of pages:   " << (page_count ? page_count : size_t(OUROBOROS_PAGE_COUNT)) << std::endl;
 
     std::cout << std::endl;
     std::cout << "Test the ouroboros: " << std::endl;
 
     dataset_type::remove(name);
     dataset_type dataset(name, tbl_count, rec_count);
+    if (page_count > 0)
+    {
+        dataset.set_cache_capacity(page_count);
+    }
     for (size_t itr = 0; itr < itrCount; ++itr)
     {
         std::cout << std::endl;
         std::cout << "Repeat: " << itr << std::endl;
         size_t wrTime = 0;
         size_t rdTime = 0;
+        size_t commitTime = 0;
+        size_t commitCount = 0;
+        uint64_t wrCalls = 0;
+        uint64_t rdCalls = 0;
+        uint64_t submitCalls = 0;
         for (size_t index = 0; index < tbl_count; index++)
         {
             std::cout << "\tTable: " << index << std::endl;
@@ -138,6 +152,7 @@ int main(int argc, char *argv[])
             }
             record_list wrList;
             fill_records(wrList, rec_count, rec_count * index);
+            const file_stats wrStats = base_file::stats();
             const size_t wrTime1 = time_us();
             if (is_session)
             {
@@ -146,15 +161,26 @@ int main(int argc, char *argv[])
                 {
                     session->add(wrList[i]);
                 }
+                // the dirty pages of the transaction are written by the commit
+                const size_t commitTime1 = time_us();
+                session.stop();
+                commitTime += time_us() - commitTime1;
+                ++commitCount;
             }
             else
             {
                 for (size_t i = 0; i < rec_count; i++)
                 {
+                    const size_t commitTime1 = time_us();
                     dataset.session_wr(index)->add(wrList[i]);
+                    commitTime += time_us() - commitTime1;
+                    ++commitCount;
                 }
             }
             wrTime += time_us() - wrTime1;
+            wrCalls += base_file::stats().writes - wrStats.writes;
+            rdCalls += base_file::stats().reads - wrStats.reads;
+            submitCalls += base_file::stats().submits - wrStats.submits;
             record_list rdList(rec_count);
             const size_t rdTime1 = time_us();
             if (is_session)
@@ -185,6 +211,10 @@ int main(int argc, char *argv[])
         std::cout << "time of WR: " << wrTime << std::endl;
         std::cout << "time of RD: " << rdTime << std::endl;
         std::cout << "total time: " << (wrTime + rdTime) << std::endl;
+        std::cout << "time of commit: " << commitTime / commitCount << std::endl;
+        std::cout << "writes per commit: " << double(wrCalls) / commitCount << std::endl;
+        std::cout << "reads per commit:  " << double(rdCalls) / commitCount << std::endl;
+        std::cout << "submits per commit: " << double(submitCalls) / commitCount << std::endl;
     }
     return 0;
 }
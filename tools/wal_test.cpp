@@ -0,0 +1,155 @@
+/**
+ * The test tool for checking the write amplification of the transactional
+ * files:
+ * -    the records are added to the tables of a dataset, each record is
+ *      added by the own transaction (the session of writing);
+ * -    the bytes that are written by the process (wchar of /proc/self/io)
+ *      are measured until the dataset is closed, they are compared with
+ *      the size of the added records;
+ * -    the dataset with the backup file (journal_file) and the dataset with
+ *      the redo log (redo_file) are tested.
+ */
+#include <stdio.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <string>
+#include <boost/lexical_cast.hpp>
+
+#define OUROBOROS_LOG
+#define OUROBOROS_INFO(msg)
+#define OUROBOROS_ERROR(msg)
+#define OUROBOROS_DEBUG(msg)
+
+#include "ouroboros/key.h"
+#include "ouroboros/dataset.h"
+#include "ouroboros/interface.h"
+#include "ouroboros/field_types.h"
+
+using namespace ouroboros;
+
+typedef record3< FIELD_INT32, FIELD_FLOAT, FIELD_INT32 > record_type;
+
+/**
+ * The options of the test
+ */
+struct test_options
+{
+    std::string name;   ///< the name of the dataset
+    size_t tbl_count;   ///< the count of tables
+    size_t rec_count;   ///< the count of records in a table
+    size_t itr_count;   ///< the count of added records
+};
+
+/**
+ * Get the count of bytes written by the process
+ * @return the count of bytes
+ */
+size_t written_bytes()
+{
+    std::ifstream io("/proc/self/io");
+    std::string name;
+    size_t value = 0;
+    while (io >> name >> value)
+    {
+        if ("wchar:" == name)
+        {
+            return value;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Get monotonic time
+ * @return monotonic time
+ */
+size_t time_us()
+{
+    struct timespec res = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return res.tv_sec * 1000000 + res.tv_nsec / 1000;
+}
+
+/**
+ * Run the test for the dataset
+ * @param name the name of the mode
+ * @param options the options of the test
+ */
+template <typename DataSet>
+void run_dataset(const char *name, const test_options& options)
+{
+    DataSet::remove(options.name);
+    size_t time = 0;
+    size_t max_time = 0;
+    size_t bytes = 0;
+    {
+        DataSet dataset(options.name, options.tbl_count, options.rec_count);
+        for (size_t index = 0; index < options.tbl_count; ++index)
+        {
+            dataset.add_table(index);
+        }
+        const size_t bytes1 = written_bytes();
+        const size_t time1 = time_us();
+        for (size_t i = 0; i < options.itr_count; ++i)
+        {
+            const record_type record(i, i + 1, i + 2);
+            const size_t time2 = time_us();
+            dataset.session_wr(i % options.tbl_count)->add(record);
+            max_time = std::max(max_time, time_us() - time2);
+        }
+        time = time_us() - time1;
+        bytes = bytes1;
+    }
+    bytes = written_bytes() - bytes;
+    const size_t user = options.itr_count * record_type::static_size();
+    std::cout << "\t" << std::left << std::setw(8) << name << std::right << std::fixed <<
+        std::setprecision(1) << std::setw(12) << double(bytes) / options.itr_count <<
+        std::setw(10) << double(bytes) / user << std::setw(12) << double(time) / options.itr_count <<
+        std::setw(12) << max_time << std::endl;
+    DataSet::remove(options.name);
+}
+
+int main(int argc, char *argv[])
+{
+    test_options options;
+    options.name = "wal_test";
+    options.tbl_count = 10;
+    options.rec_count = 10000;
+    options.itr_count = 100000;
+    if (argc > 1)
+    {
+        const char *opts = "n:t:r:i:";
+        int opt;
+        while ((opt = getopt(argc, argv, opts)) != -1)
+        {
+            switch (opt)
+            {
+                case 'n':
+                    options.name = optarg;
+                    break;
+                case 't':
+                    options.tbl_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'r':
+                    options.rec_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+                case 'i':
+                    options.itr_count = boost::lexical_cast<size_t>(optarg);
+                    break;
+            }
+        }
+    }
+    std::cout << "The options:" << std::endl;
+    std::cout << "\t count of tables:          " << options.tbl_count << std::endl;
+    std::cout << "\t count of records in table: " << options.rec_count << std::endl;
+    std::cout << "\t count of added records:   " << options.itr_count << std::endl;
+    std::cout << "\t size of record:           " << record_type::static_size() << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "mode      bytes/record   amplif.  us/record  max us" << std::endl;
+    run_dataset<data_set<simple_key, record_type, index1, local_interface> >("journal", options);
+    run_dataset<data_set<simple_key, record_type, index1, redo_local_interface> >("redo", options);
+    return 0;
+}